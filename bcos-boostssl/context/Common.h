@@ -19,13 +19,15 @@
  */
 
 #pragma once
+#include <bcos-boostssl/interfaces/Common.h>
 #include <bcos-utilities/BoostLog.h>
 #include <openssl/bio.h>
 #include <openssl/pem.h>
 
 
-#define CONTEXT_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[BOOSTSSL][CTX]"
-#define NODEINFO_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[BOOSTSSL][NODEINFO]"
+#define CONTEXT_LOG(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[BOOSTSSL][CTX]"
+#define NODEINFO_LOG(LEVEL) \
+    BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[BOOSTSSL][NODEINFO]"
 
 namespace bcos
 {  // namespace bcos
@@ -21,6 +21,7 @@
 #include <bcos-boostssl/context/Common.h>
 #include <bcos-boostssl/context/ContextBuilder.h>
 #include <bcos-boostssl/context/ContextConfig.h>
+#include <bcos-boostssl/context/SslSessionCache.h>
 #include <bcos-utilities/BoostLog.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/filesystem.hpp>
@@ -65,22 +66,36 @@ std::shared_ptr<boost::asio::ssl::context> ContextBuilder::buildSslContext(
 std::shared_ptr<boost::asio::ssl::context> ContextBuilder::buildSslContext(
     bool _server, const ContextConfig& _contextConfig)
 {
+    std::shared_ptr<boost::asio::ssl::context> sslContext = nullptr;
     if (_contextConfig.isCertPath())
     {
         if (_contextConfig.sslType() != "sm_ssl")
         {
-            return buildSslContext(_contextConfig.certConfig());
+            sslContext = buildSslContext(_contextConfig.certConfig());
+        }
+        else
+        {
+            sslContext = buildSslContext(_server, _contextConfig.smCertConfig());
         }
-        return buildSslContext(_server, _contextConfig.smCertConfig());
     }
     else
     {
         if (_contextConfig.sslType() != "sm_ssl")
         {
-            return buildSslContextByCertContent(_contextConfig.certConfig());
+            sslContext = buildSslContextByCertContent(_contextConfig.certConfig());
+        }
+        else
+        {
+            sslContext = buildSslContextByCertContent(_server, _contextConfig.smCertConfig());
         }
-        return buildSslContextByCertContent(_server, _contextConfig.smCertConfig());
     }
+
+    if (_contextConfig.sessionResumption())
+    {
+        SslSessionCache::initContext(_server, *sslContext);
+        CONTEXT_LOG(INFO) << LOG_DESC("initSessionResumption") << LOG_KV("server", _server);
+    }
+    return sslContext;
 }
 
 std::shared_ptr<boost::asio::ssl::context> ContextBuilder::buildSslContext(
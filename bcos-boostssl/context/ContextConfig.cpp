@@ -35,6 +35,7 @@ void ContextConfig::initConfig(std::string const& _configPath)
         }
 
         m_sslType = sslType;
+        m_sessionResumption = pt.get<bool>("common.session_resumption", false);
     }
     catch (const std::exception& e)
     {
@@ -50,6 +51,7 @@ void ContextConfig::initConfig(std::string const& _configPath)
     }
 
     CONTEXT_LOG(INFO) << LOG_DESC("initConfig") << LOG_KV("sslType", m_sslType)
+                      << LOG_KV("sessionResumption", m_sessionResumption)
                       << LOG_KV("configPath", _configPath);
 }
 
@@ -70,6 +70,9 @@ public:
     const SMCertConfig& smCertConfig() const { return m_smCertConfig; }
     void setSmCertConfig(const SMCertConfig& _smCertConfig) { m_smCertConfig = _smCertConfig; }
 
+    bool sessionResumption() const { return m_sessionResumption; }
+    void setSessionResumption(bool _sessionResumption) { m_sessionResumption = _sessionResumption; }
+
     std::string moduleName() { return m_moduleName; }
     void setModuleName(std::string _moduleName) { m_moduleName = _moduleName; }
 
@@ -82,6 +85,9 @@ private:
     // cert config for ssl
     CertConfig m_certConfig;
     SMCertConfig m_smCertConfig;
+    // the client offers the ssl session of its last connection to the same endpoint, and the
+    // server caches the sessions so that the reconnections skip the full handshake
+    bool m_sessionResumption = false;
     std::string m_moduleName = "DEFAULT";
 };
 
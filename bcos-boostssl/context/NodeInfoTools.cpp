@@ -94,6 +94,28 @@ std::function<bool(bool, boost::asio::ssl::verify_context&)> NodeInfoTools::newV
     };
 }
 
+bool NodeInfoTools::resumedSessionNodeId(SSL* _ssl, std::string& _nodeIDOut)
+{
+    if (!_ssl || !SSL_session_reused(_ssl))
+    {
+        return false;
+    }
+    // the certificate the peer sent in the full handshake, verified then
+    std::shared_ptr<X509> cert(SSL_get_peer_certificate(_ssl), [](X509* p) {
+        if (p != NULL)
+        {
+            X509_free(p);
+        }
+    });
+    if (!cert)
+    {
+        NODEINFO_LOG(WARNING) << LOG_DESC("Get the cert of the resumed session failed");
+        return false;
+    }
+    auto sslContextPubHexHandler = initSSLContextPubHexHandler();
+    return sslContextPubHexHandler(cert.get(), _nodeIDOut);
+}
+
 std::function<bool(const std::string& priKey, std::string& pubHex)>
 NodeInfoTools::initCert2PubHexHandler()
 {
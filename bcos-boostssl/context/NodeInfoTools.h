@@ -42,6 +42,9 @@ public:
 
     static std::function<bool(bool, boost::asio::ssl::verify_context&)> newVerifyCallback(
         std::shared_ptr<std::string> nodeIDOut);
+    // the verify callback is not called when the ssl session is resumed, take the node id from
+    // the peer certificate the session keeps instead, return false if the session is not resumed
+    static bool resumedSessionNodeId(SSL* _ssl, std::string& _nodeIDOut);
 
     static std::string moduleName() { return m_moduleName; }
     static void setModuleName(std::string _moduleName) { m_moduleName = _moduleName; }
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file SslSessionCache.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#include <bcos-boostssl/context/Common.h>
+#include <bcos-boostssl/context/SslSessionCache.h>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::context;
+
+namespace
+{
+// the cache and the endpoint a client connection keeps its new session for
+struct SessionBinding
+{
+    std::weak_ptr<SslSessionCache> cache;
+    std::string endpoint;
+};
+}  // namespace
+
+int SslSessionCache::exDataIndex()
+{
+    static const int s_index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr,
+        [](void*, void* _ptr, CRYPTO_EX_DATA*, int, long, void*) {
+            delete static_cast<SessionBinding*>(_ptr);
+        });
+    return s_index;
+}
+
+void SslSessionCache::initContext(bool _server, boost::asio::ssl::context& _sslContext)
+{
+    auto ctx = _sslContext.native_handle();
+    if (_server)
+    {
+        // the peers are verified, the server refuses to resume without a session id context
+        static const std::string sessionIdContext = "bcos-boostssl";
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_set_session_id_context(
+            ctx, (const unsigned char*)sessionIdContext.data(), sessionIdContext.size());
+    }
+    else
+    {
+        // the sessions are kept by the cache the connection is bound to, not by the context
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL);
+        SSL_CTX_sess_set_new_cb(ctx, &SslSessionCache::onNewSession);
+    }
+}
+
+int SslSessionCache::onNewSession(SSL* _ssl, SSL_SESSION* _session)
+{
+    auto binding = static_cast<SessionBinding*>(SSL_get_ex_data(_ssl, exDataIndex()));
+    auto cache = binding ? binding->cache.lock() : nullptr;
+    if (!cache)
+    {
+        return 0;
+    }
+    // a copy is kept, openssl marks the session of a connection closed without the ssl shutdown
+    // as not resumable, and the connections are mostly closed that way
+    auto session = SSL_SESSION_dup(_session);
+    if (!session)
+    {
+        return 0;
+    }
+    std::lock_guard<std::mutex> l(cache->x_sessions);
+    cache->m_sessions[binding->endpoint] = std::shared_ptr<SSL_SESSION>(session, SSL_SESSION_free);
+    return 0;
+}
+
+void SslSessionCache::offer(const std::string& _endpoint, SSL* _ssl)
+{
+    auto lastSession = session(_endpoint);
+    if (lastSession)
+    {
+        SSL_set_session(_ssl, lastSession.get());
+    }
+    auto binding = new SessionBinding{weak_from_this(), _endpoint};
+    if (!SSL_set_ex_data(_ssl, exDataIndex(), binding))
+    {
+        delete binding;
+    }
+}
+
+std::shared_ptr<SSL_SESSION> SslSessionCache::session(const std::string& _endpoint)
+{
+    std::lock_guard<std::mutex> l(x_sessions);
+    auto it = m_sessions.find(_endpoint);
+    return it == m_sessions.end() ? nullptr : it->second;
+}
+
+void SslSessionCache::eraseSession(const std::string& _endpoint)
+{
+    std::lock_guard<std::mutex> l(x_sessions);
+    m_sessions.erase(_endpoint);
+}
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the ssl session resumption, the client keeps the session of its last connection to each
+ * endpoint and offers it on reconnection, the server caches the sessions it hands out
+ * @file SslSessionCache.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+#include <openssl/ssl.h>
+#include <boost/asio/ssl.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace context
+{
+class SslSessionCache : public std::enable_shared_from_this<SslSessionCache>
+{
+public:
+    using Ptr = std::shared_ptr<SslSessionCache>;
+    using ConstPtr = std::shared_ptr<const SslSessionCache>;
+
+    // enable the session cache of the context, the client context hands every new session to the
+    // SslSessionCache the connection is bound to, tls 1.3 tickets arrive after the handshake
+    static void initContext(bool _server, boost::asio::ssl::context& _sslContext);
+
+public:
+    // Note: call before the client handshake, offer the last session to _endpoint and bind the
+    // connection to it so the new session is kept for the next one
+    void offer(const std::string& _endpoint, SSL* _ssl);
+
+    std::shared_ptr<SSL_SESSION> session(const std::string& _endpoint);
+    void eraseSession(const std::string& _endpoint);
+
+    std::string moduleName() { return m_moduleName; }
+    void setModuleName(std::string _moduleName) { m_moduleName = _moduleName; }
+
+private:
+    static int exDataIndex();
+    static int onNewSession(SSL* _ssl, SSL_SESSION* _session);
+
+private:
+    // the ssl session of the last connection to each endpoint
+    mutable std::mutex x_sessions;
+    std::unordered_map<std::string, std::shared_ptr<SSL_SESSION>> m_sessions;
+
+    std::string m_moduleName = "DEFAULT";
+};
+
+}  // namespace context
+}  // namespace boostssl
+}  // namespace bcos
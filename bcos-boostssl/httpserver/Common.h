@@ -19,6 +19,7 @@
  */
 #pragma once
 
+#include <bcos-boostssl/interfaces/Common.h>
 #include <bcos-utilities/BoostLog.h>
 #include <bcos-utilities/Common.h>
 #include <boost/beast/core.hpp>
@@ -26,10 +27,10 @@
 #include <boost/beast/http/vector_body.hpp>
 
 
-#define HTTP_LISTEN(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[HTTP][LISTEN]"
-#define HTTP_SESSION(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[HTTP][SESSION]"
-#define HTTP_SERVER(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[HTTP][SERVER]"
-#define HTTP_STREAM(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[HTTP][STREAM]"
+#define HTTP_LISTEN(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[HTTP][LISTEN]"
+#define HTTP_SESSION(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[HTTP][SESSION]"
+#define HTTP_SERVER(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[HTTP][SERVER]"
+#define HTTP_STREAM(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[HTTP][STREAM]"
 
 
 namespace bcos
@@ -47,6 +48,14 @@ using HttpReqHandler =
     std::function<void(const std::string_view req, std::function<void(bcos::bytes)>)>;
 using WsUpgradeHandler =
     std::function<void(std::shared_ptr<HttpStream>, HttpRequest&&, std::shared_ptr<std::string>)>;
+// called when the client selects the length-prefixed tcp frame transport
+using TcpFrameHandler =
+    std::function<void(std::shared_ptr<HttpStream>, std::shared_ptr<std::string>)>;
+// called when the client on the unix domain socket negotiates the shared memory rings
+using ShmRingHandler =
+    std::function<void(std::shared_ptr<HttpStream>, std::shared_ptr<std::string>)>;
+// renders the metrics page, called on the io thread so it must only read prepared data
+using MetricsHandler = std::function<std::string()>;
 
 static const int PARSER_BODY_LIMITATION = 100 * 1024 * 1024;
 }  // namespace http
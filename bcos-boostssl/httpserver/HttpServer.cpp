@@ -20,8 +20,12 @@
 
 #include <bcos-boostssl/context/NodeInfoTools.h>
 #include <bcos-boostssl/httpserver/HttpServer.h>
+#include <bcos-boostssl/websocket/WsTools.h>
 #include <bcos-utilities/ThreadPool.h>
+#include <boost/core/ignore_unused.hpp>
 #include <memory>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace bcos;
 using namespace bcos::boostssl;
@@ -38,13 +42,113 @@ void HttpServer::start()
     }
 
     HTTP_SERVER(INFO) << LOG_BADGE("startListen") << LOG_KV("listenIP", m_listenIP)
-                      << LOG_KV("listenPort", m_listenPort);
+                      << LOG_KV("listenPort", m_listenPort) << LOG_KV("reusePort", m_reusePort)
+                      << LOG_KV("reusePortAcceptorNum", m_reusePortAcceptorNum);
 
     auto address = boost::asio::ip::make_address(m_listenIP);
     auto endpoint = boost::asio::ip::tcp::endpoint{address, m_listenPort};
 
+    bool reusePort = m_reusePort;
+#ifndef SO_REUSEPORT
+    if (reusePort)
+    {
+        HTTP_SERVER(WARNING) << LOG_BADGE("startListen")
+                             << LOG_DESC("SO_REUSEPORT is not supported, use single acceptor");
+        reusePort = false;
+    }
+#endif
+    // doAccept keeps the connections on the io_context of the acceptor only if it is in effect
+    m_reusePort = reusePort;
+    auto acceptorIoc = [this](std::size_t _index) {
+        return m_ioServices.empty() ? m_ioservicePool->getIOService() :
+                                      m_ioServices[_index % m_ioServices.size()];
+    };
+    if (reusePort && !m_ioServices.empty())
+    {
+        m_acceptor = std::make_shared<boost::asio::ip::tcp::acceptor>(*acceptorIoc(0));
+    }
+
+    openAcceptor(m_acceptor, endpoint, reusePort);
+    // start accept
+    doAccept();
+
+    if (reusePort)
+    {
+        // the first acceptor has been opened, open the others on the other io_contexts, the
+        // kernel balances the incoming connections between the listening sockets
+        for (std::size_t i = 1; i < m_reusePortAcceptorNum; ++i)
+        {
+            auto acceptor = std::make_shared<boost::asio::ip::tcp::acceptor>(*acceptorIoc(i));
+            openAcceptor(acceptor, endpoint, reusePort);
+            m_reusePortAcceptors.push_back(acceptor);
+            doAccept(acceptor);
+        }
+    }
+
+    if (!m_unixSocketPath.empty())
+    {
+        openUnixAcceptor();
+        doUnixAccept();
+    }
+
+    HTTP_SERVER(INFO) << LOG_BADGE("startListen") << LOG_KV("ip", endpoint.address().to_string())
+                      << LOG_KV("port", endpoint.port())
+                      << LOG_KV("acceptors", m_reusePortAcceptors.size() + 1)
+                      << LOG_KV("unixSocketPath", m_unixSocketPath);
+}
+
+void HttpServer::openUnixAcceptor()
+{
+    // remove the socket file left by the last run, or bind fails, but never a file that is not a
+    // socket or the socket of a running server
+    if (!ws::WsTools::removeStaleUnixSocket(m_unixSocketPath))
+    {
+        BOOST_THROW_EXCEPTION(
+            std::runtime_error("unix domain socket path is in use: " + m_unixSocketPath));
+    }
+
+    boost::system::error_code ec;
+
+    m_unixAcceptor = std::make_shared<boost::asio::local::stream_protocol::acceptor>(
+        *(m_ioservicePool->getIOService()));
+    boost::asio::local::stream_protocol::endpoint endpoint(m_unixSocketPath);
+    m_unixAcceptor->open(endpoint.protocol(), ec);
+    if (!ec)
+    {
+        m_unixAcceptor->bind(endpoint, ec);
+    }
+    if (!ec)
+    {
+        // remember the file this acceptor owns, stop() leaves the file of another server alone
+        struct stat st;
+        if (::stat(m_unixSocketPath.c_str(), &st) == 0)
+        {
+            m_unixSocketDev = st.st_dev;
+            m_unixSocketIno = st.st_ino;
+        }
+        // set the permission bits before listen, no one connects in between
+        if (m_unixSocketMode != 0 && ::chmod(m_unixSocketPath.c_str(), m_unixSocketMode) != 0)
+        {
+            ec = boost::system::error_code(errno, boost::system::system_category());
+        }
+    }
+    if (!ec)
+    {
+        m_unixAcceptor->listen(boost::asio::socket_base::max_listen_connections, ec);
+    }
+    if (ec)
+    {
+        HTTP_SERVER(WARNING) << LOG_BADGE("openUnixAcceptor") << LOG_KV("path", m_unixSocketPath)
+                             << LOG_KV("error", ec) << LOG_KV("message", ec.message());
+        BOOST_THROW_EXCEPTION(std::runtime_error("unix domain socket acceptor open failed"));
+    }
+}
+
+void HttpServer::openAcceptor(std::shared_ptr<boost::asio::ip::tcp::acceptor> _acceptor,
+    const boost::asio::ip::tcp::endpoint& _endpoint, bool _reusePort)
+{
     boost::beast::error_code ec;
-    m_acceptor->open(endpoint.protocol(), ec);
+    _acceptor->open(_endpoint.protocol(), ec);
     if (ec)
     {
         HTTP_SERVER(WARNING) << LOG_BADGE("open") << LOG_KV("error", ec)
@@ -53,7 +157,7 @@ void HttpServer::start()
     }
 
     // allow address reuse
-    m_acceptor->set_option(boost::asio::socket_base::reuse_address(true), ec);
+    _acceptor->set_option(boost::asio::socket_base::reuse_address(true), ec);
     if (ec)
     {
         HTTP_SERVER(WARNING) << LOG_BADGE("set_option") << LOG_KV("error", ec)
@@ -62,7 +166,25 @@ void HttpServer::start()
         BOOST_THROW_EXCEPTION(std::runtime_error("acceptor set_option failed"));
     }
 
-    m_acceptor->bind(endpoint, ec);
+#ifdef SO_REUSEPORT
+    if (_reusePort)
+    {
+        // allow multiple acceptors to bind the same port
+        using reuse_port = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+        _acceptor->set_option(reuse_port(true), ec);
+        if (ec)
+        {
+            HTTP_SERVER(WARNING) << LOG_BADGE("set_option") << LOG_DESC("reuse port")
+                                 << LOG_KV("error", ec) << LOG_KV("message", ec.message());
+
+            BOOST_THROW_EXCEPTION(std::runtime_error("acceptor set_option reuse port failed"));
+        }
+    }
+#else
+    boost::ignore_unused(_reusePort);
+#endif
+
+    _acceptor->bind(_endpoint, ec);
     if (ec)
     {
         HTTP_SERVER(WARNING) << LOG_BADGE("bind") << LOG_KV("error", ec)
@@ -70,19 +192,13 @@ void HttpServer::start()
         BOOST_THROW_EXCEPTION(std::runtime_error("acceptor bind failed"));
     }
 
-    m_acceptor->listen(boost::asio::socket_base::max_listen_connections, ec);
+    _acceptor->listen(boost::asio::socket_base::max_listen_connections, ec);
     if (ec)
     {
         HTTP_SERVER(WARNING) << LOG_BADGE("listen") << LOG_KV("error", ec)
                              << LOG_KV("message", ec.message());
         BOOST_THROW_EXCEPTION(std::runtime_error("acceptor listen failed"));
     }
-
-    // start accept
-    doAccept();
-
-    HTTP_SERVER(INFO) << LOG_BADGE("startListen") << LOG_KV("ip", endpoint.address().to_string())
-                      << LOG_KV("port", endpoint.port());
 }
 
 void HttpServer::stop()
@@ -92,24 +208,61 @@ void HttpServer::stop()
         m_acceptor->close();
     }
 
+    for (auto& acceptor : m_reusePortAcceptors)
+    {
+        if (acceptor->is_open())
+        {
+            acceptor->close();
+        }
+    }
+    m_reusePortAcceptors.clear();
+
+    if (m_unixAcceptor && m_unixAcceptor->is_open())
+    {
+        m_unixAcceptor->close();
+        struct stat st;
+        if (::lstat(m_unixSocketPath.c_str(), &st) == 0 && S_ISSOCK(st.st_mode) &&
+            (uint64_t)st.st_dev == m_unixSocketDev && (uint64_t)st.st_ino == m_unixSocketIno)
+        {
+            ::unlink(m_unixSocketPath.c_str());
+        }
+    }
 
     HTTP_SERVER(INFO) << LOG_BADGE("stop") << LOG_DESC("http server");
 }
 
 void HttpServer::doAccept()
 {
+    doAccept(m_acceptor);
+}
+
+void HttpServer::doAccept(std::shared_ptr<boost::asio::ip::tcp::acceptor> _acceptor)
+{
+    if (m_reusePort)
+    {
+        // reuse port: the new connection stays on the io_context of the acceptor
+        _acceptor->async_accept(
+            boost::beast::bind_front_handler(&HttpServer::onAccept, shared_from_this(), _acceptor));
+        return;
+    }
+
     // The new connection gets its own strand
-    m_acceptor->async_accept(*(m_ioservicePool->getIOService()),
-        boost::beast::bind_front_handler(&HttpServer::onAccept, shared_from_this()));
+    _acceptor->async_accept(*(m_ioservicePool->getIOService()),
+        boost::beast::bind_front_handler(&HttpServer::onAccept, shared_from_this(), _acceptor));
 }
 
-void HttpServer::onAccept(boost::beast::error_code ec, boost::asio::ip::tcp::socket socket)
+void HttpServer::onAccept(std::shared_ptr<boost::asio::ip::tcp::acceptor> _acceptor,
+    boost::beast::error_code ec, boost::asio::ip::tcp::socket socket)
 {
     if (ec)
     {
         HTTP_SERVER(WARNING) << LOG_BADGE("accept") << LOG_KV("error", ec)
                              << LOG_KV("message", ec.message());
-        return doAccept();
+        if (!_acceptor->is_open())
+        {  // the acceptor has been closed
+            return;
+        }
+        return doAccept(_acceptor);
     }
 
     boost::system::error_code sec;
@@ -118,14 +271,14 @@ void HttpServer::onAccept(boost::beast::error_code ec, boost::asio::ip::tcp::soc
         HTTP_SERVER(WARNING) << LOG_BADGE("accept") << LOG_KV("local_endpoint error", sec)
                              << LOG_KV("message", sec.message());
         ws::WsTools::close(socket);
-        return doAccept();
+        return doAccept(_acceptor);
     }
     auto remoteEndpoint = socket.remote_endpoint(sec);
     if(sec) {
         HTTP_SERVER(WARNING) << LOG_BADGE("accept") << LOG_KV("remote_endpoint error", sec)
                              << LOG_KV("message", sec.message());
         ws::WsTools::close(socket);
-        return doAccept();
+        return doAccept(_acceptor);
     }
     socket.set_option(boost::asio::ip::tcp::no_delay(true));
 
@@ -139,7 +292,7 @@ void HttpServer::onAccept(boost::beast::error_code ec, boost::asio::ip::tcp::soc
             std::make_shared<boost::beast::tcp_stream>(std::move(socket)), m_moduleName);
         buildHttpSession(httpStream, nullptr)->run();
 
-        return doAccept();
+        return doAccept(_acceptor);
     }
 
     // ssl should be used,  start ssl handshake
@@ -163,6 +316,9 @@ void HttpServer::onAccept(boost::beast::error_code ec, boost::asio::ip::tcp::soc
                 return;
             }
 
+            // no verify callback for a resumed session, the node id comes from its certificate
+            NodeInfoTools::resumedSessionNodeId(ss->native_handle(), *nodeId);
+
             auto server = self.lock();
             if (server)
             {
@@ -171,9 +327,39 @@ void HttpServer::onAccept(boost::beast::error_code ec, boost::asio::ip::tcp::soc
             }
         });
 
-    return doAccept();
+    return doAccept(_acceptor);
 }
 
+void HttpServer::doUnixAccept()
+{
+    m_unixAcceptor->async_accept(*(m_ioservicePool->getIOService()),
+        boost::beast::bind_front_handler(&HttpServer::onUnixAccept, shared_from_this()));
+}
+
+void HttpServer::onUnixAccept(
+    boost::beast::error_code ec, boost::asio::local::stream_protocol::socket socket)
+{
+    if (ec)
+    {
+        HTTP_SERVER(WARNING) << LOG_BADGE("unixAccept") << LOG_KV("error", ec)
+                             << LOG_KV("message", ec.message());
+        if (!m_unixAcceptor->is_open())
+        {  // the acceptor has been closed
+            return;
+        }
+        return doUnixAccept();
+    }
+
+    HTTP_SERVER(INFO) << LOG_BADGE("unixAccept") << LOG_KV("path", m_unixSocketPath)
+                      << LOG_KV("fd", socket.native_handle());
+
+    // no ssl on the unix domain socket, the socket file permissions are the trust boundary
+    auto httpStream = m_httpStreamFactory->buildHttpStream(
+        std::make_shared<ws::UnixStream>(std::move(socket)), m_moduleName);
+    buildHttpSession(httpStream, nullptr)->run();
+
+    return doUnixAccept();
+}
 
 HttpSession::Ptr HttpServer::buildHttpSession(
     HttpStream::Ptr _httpStream, std::shared_ptr<std::string> _nodeId)
@@ -208,6 +394,9 @@ HttpSession::Ptr HttpServer::buildHttpSession(
     session->setHttpStream(_httpStream);
     session->setRequestHandler(m_httpReqHandler);
     session->setWsUpgradeHandler(m_wsUpgradeHandler);
+    session->setTcpFrameHandler(m_tcpFrameHandler);
+    session->setShmRingHandler(m_shmRingHandler);
+    session->setMetricsHandler(m_metricsPath, m_metricsHandler);
     session->setThreadPool(threadPool());
     session->setNodeId(_nodeId);
 
@@ -23,6 +23,7 @@
 #include <bcos-utilities/IOServicePool.h>
 #include <exception>
 #include <thread>
+#include <vector>
 namespace bcos
 {
 namespace boostssl
@@ -49,8 +50,15 @@ public:
 
     // accept connection
     void doAccept();
+    void doAccept(std::shared_ptr<boost::asio::ip::tcp::acceptor> _acceptor);
     // handle connection
-    void onAccept(boost::beast::error_code ec, boost::asio::ip::tcp::socket socket);
+    void onAccept(std::shared_ptr<boost::asio::ip::tcp::acceptor> _acceptor,
+        boost::beast::error_code ec, boost::asio::ip::tcp::socket socket);
+
+    // accept connection on the unix domain socket
+    void doUnixAccept();
+    void onUnixAccept(
+        boost::beast::error_code ec, boost::asio::local::stream_protocol::socket socket);
 
 public:
     HttpSession::Ptr buildHttpSession(
@@ -81,6 +89,23 @@ public:
         m_wsUpgradeHandler = _wsUpgradeHandler;
     }
 
+    TcpFrameHandler tcpFrameHandler() const { return m_tcpFrameHandler; }
+    void setTcpFrameHandler(TcpFrameHandler _tcpFrameHandler)
+    {
+        m_tcpFrameHandler = _tcpFrameHandler;
+    }
+
+    ShmRingHandler shmRingHandler() const { return m_shmRingHandler; }
+    void setShmRingHandler(ShmRingHandler _shmRingHandler) { m_shmRingHandler = _shmRingHandler; }
+
+    const std::string& metricsPath() const { return m_metricsPath; }
+    MetricsHandler metricsHandler() const { return m_metricsHandler; }
+    void setMetricsHandler(const std::string& _metricsPath, MetricsHandler _metricsHandler)
+    {
+        m_metricsPath = _metricsPath;
+        m_metricsHandler = _metricsHandler;
+    }
+
     HttpStreamFactory::Ptr httpStreamFactory() const { return m_httpStreamFactory; }
     void setHttpStreamFactory(HttpStreamFactory::Ptr _httpStreamFactory)
     {
@@ -90,28 +115,79 @@ public:
     bool disableSsl() const { return m_disableSsl; }
     void setDisableSsl(bool _disableSsl) { m_disableSsl = _disableSsl; }
 
+    bool reusePort() const { return m_reusePort; }
+    void setReusePort(bool _reusePort) { m_reusePort = _reusePort; }
+
+    std::size_t reusePortAcceptorNum() const { return m_reusePortAcceptorNum; }
+    void setReusePortAcceptorNum(std::size_t _reusePortAcceptorNum)
+    {
+        m_reusePortAcceptorNum = _reusePortAcceptorNum;
+    }
+
+    const std::string& unixSocketPath() const { return m_unixSocketPath; }
+    void setUnixSocketPath(const std::string& _unixSocketPath)
+    {
+        m_unixSocketPath = _unixSocketPath;
+    }
+
+    uint32_t unixSocketMode() const { return m_unixSocketMode; }
+    void setUnixSocketMode(uint32_t _unixSocketMode) { m_unixSocketMode = _unixSocketMode; }
+
     std::string moduleName() { return m_moduleName; }
 
     void setIOServicePool(bcos::IOServicePool::Ptr _ioservicePool)
     {
         m_ioservicePool = _ioservicePool;
     }
+    // the io_contexts of the pool in the order of its io threads, the reuse port acceptor i runs
+    // on the io_context i
+    void setIOServices(std::vector<std::shared_ptr<boost::asio::io_context>> _ioServices)
+    {
+        m_ioServices = std::move(_ioServices);
+    }
+
+private:
+    void openAcceptor(std::shared_ptr<boost::asio::ip::tcp::acceptor> _acceptor,
+        const boost::asio::ip::tcp::endpoint& _endpoint, bool _reusePort);
+    void openUnixAcceptor();
 
 private:
     std::string m_listenIP;
     uint16_t m_listenPort;
     bool m_disableSsl;
+    // open one SO_REUSEPORT acceptor per io_context, the accepted connection stays on
+    // the io_context that accepted it
+    bool m_reusePort{false};
+    std::size_t m_reusePortAcceptorNum{1};
+    // also listen on the unix domain socket if set, for the co-located processes
+    std::string m_unixSocketPath;
+    // the permission bits of the socket file, 0 leaves them to the umask
+    uint32_t m_unixSocketMode{0};
+    // the socket file bound by m_unixAcceptor
+    uint64_t m_unixSocketDev{0};
+    uint64_t m_unixSocketIno{0};
     std::string m_moduleName;
 
     HttpReqHandler m_httpReqHandler;
     WsUpgradeHandler m_wsUpgradeHandler;
+    // accept the length-prefixed tcp frame transport if set
+    TcpFrameHandler m_tcpFrameHandler;
+    // accept the shared memory rings on the unix domain socket if set
+    ShmRingHandler m_shmRingHandler;
+    // answer GET m_metricsPath with the page of m_metricsHandler if set
+    std::string m_metricsPath;
+    MetricsHandler m_metricsHandler;
 
     std::shared_ptr<boost::asio::ip::tcp::acceptor> m_acceptor;
+    // the extra acceptors when reuse port is enabled, each one runs on its own io_context
+    std::vector<std::shared_ptr<boost::asio::ip::tcp::acceptor>> m_reusePortAcceptors;
+    std::shared_ptr<boost::asio::local::stream_protocol::acceptor> m_unixAcceptor;
     std::shared_ptr<boost::asio::ssl::context> m_ctx;
 
     std::shared_ptr<bcos::ThreadPool> m_threadPool;
     std::shared_ptr<HttpStreamFactory> m_httpStreamFactory;
     bcos::IOServicePool::Ptr m_ioservicePool;
+    std::vector<std::shared_ptr<boost::asio::io_context>> m_ioServices;
 };
 
 // The http server factory
@@ -27,6 +27,7 @@
 #include <boost/asio/ssl/stream.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/websocket.hpp>
+#include <algorithm>
 #include <exception>
 #include <memory>
 #include <mutex>
@@ -59,10 +60,59 @@ public:
     // start the HttpSession
     void run()
     {
-        boost::asio::dispatch(m_httpStream->stream().get_executor(),
+        if (m_tcpFrameHandler || m_shmRingHandler)
+        {
+            boost::asio::dispatch(m_httpStream->executor(),
+                boost::beast::bind_front_handler(&HttpSession::doDetect, shared_from_this()));
+            return;
+        }
+        boost::asio::dispatch(m_httpStream->executor(),
             boost::beast::bind_front_handler(&HttpSession::doRead, shared_from_this()));
     }
 
+    // read the leading bytes to tell the tcp frame transport and the shared memory rings from
+    // http, any http request is longer than the preambles
+    void doDetect()
+    {
+        auto session = shared_from_this();
+        m_httpStream->asyncReadExactly(m_buffer, ws::TCP_FRAME_PREAMBLE.size(),
+            [session](boost::system::error_code _ec, std::size_t) { session->onDetect(_ec); });
+    }
+
+    void onDetect(boost::beast::error_code ec)
+    {
+        if (ec)
+        {
+            HTTP_SESSION(WARNING) << LOG_BADGE("onDetect") << LOG_DESC("close the connection")
+                                  << LOG_KV("error", ec);
+            return;
+        }
+
+        auto data = boost::asio::buffer_cast<const uint8_t*>(
+            boost::beast::buffers_front(m_buffer.data()));
+        if (m_tcpFrameHandler &&
+            std::equal(ws::TCP_FRAME_PREAMBLE.begin(), ws::TCP_FRAME_PREAMBLE.end(), data))
+        {
+            HTTP_SESSION(INFO) << LOG_BADGE("onDetect") << LOG_DESC("tcp frame transport");
+            m_buffer.consume(ws::TCP_FRAME_PREAMBLE.size());
+            m_tcpFrameHandler(m_httpStream, m_nodeId);
+            return;
+        }
+
+        static_assert(ws::SHM_RING_PREAMBLE.size() == ws::TCP_FRAME_PREAMBLE.size());
+        if (m_shmRingHandler &&
+            std::equal(ws::SHM_RING_PREAMBLE.begin(), ws::SHM_RING_PREAMBLE.end(), data))
+        {
+            HTTP_SESSION(INFO) << LOG_BADGE("onDetect") << LOG_DESC("shared memory rings");
+            m_buffer.consume(ws::SHM_RING_PREAMBLE.size());
+            m_shmRingHandler(m_httpStream, m_nodeId);
+            return;
+        }
+
+        // http request, the bytes read stay in the buffer for the parser
+        doRead();
+    }
+
     void doRead()
     {
         m_parser.emplace();
@@ -189,6 +239,18 @@ public:
 
         auto startT = utcTime();
         unsigned version = _httpRequest.version();
+        if (m_metricsHandler && _httpRequest.method() == boost::beast::http::verb::get &&
+            _httpRequest.target() == m_metricsPath)
+        {
+            // answered on the io thread, the page is rendered ahead by the metrics owner
+            auto page = m_metricsHandler();
+            auto resp = buildHttpResp(
+                boost::beast::http::status::ok, version, bcos::bytes(page.begin(), page.end()));
+            resp->set(boost::beast::http::field::content_type, "text/plain; version=0.0.4");
+            m_queue->enqueue(resp);
+            return;
+        }
+
         auto self = std::weak_ptr<HttpSession>(shared_from_this());
         if (m_httpReqHandler)
         {
@@ -203,12 +265,13 @@ public:
                     boost::beast::http::status::ok, version, std::move(_content));
                 // put the response into the queue and waiting to be send
                 session->queue()->enqueue(resp);
-                BCOS_LOG(TRACE) << LOG_BADGE(session->m_moduleName) << LOG_BADGE("handleRequest")
-                                << LOG_DESC("response")
-                                << LOG_KV("body", std::string_view((const char*)resp->body().data(),
-                                                      resp->body().size()))
-                                << LOG_KV("keep_alive", resp->keep_alive())
-                                << LOG_KV("timecost", (utcTime() - startT));
+                BOOSTSSL_LOG(TRACE)
+                    << LOG_BADGE(session->m_moduleName) << LOG_BADGE("handleRequest")
+                    << LOG_DESC("response")
+                    << LOG_KV("body", std::string_view((const char*)resp->body().data(),
+                                          resp->body().size()))
+                    << LOG_KV("keep_alive", resp->keep_alive())
+                    << LOG_KV("timecost", (utcTime() - startT));
             });
         }
         else
@@ -258,6 +321,21 @@ public:
     {
         m_wsUpgradeHandler = _wsUpgradeHandler;
     }
+    TcpFrameHandler tcpFrameHandler() const { return m_tcpFrameHandler; }
+    void setTcpFrameHandler(TcpFrameHandler _tcpFrameHandler)
+    {
+        m_tcpFrameHandler = _tcpFrameHandler;
+    }
+
+    ShmRingHandler shmRingHandler() const { return m_shmRingHandler; }
+    void setShmRingHandler(ShmRingHandler _shmRingHandler) { m_shmRingHandler = _shmRingHandler; }
+
+    void setMetricsHandler(const std::string& _metricsPath, MetricsHandler _metricsHandler)
+    {
+        m_metricsPath = _metricsPath;
+        m_metricsHandler = _metricsHandler;
+    }
+
     std::shared_ptr<Queue> queue() { return m_queue; }
     void setQueue(std::shared_ptr<Queue> _queue) { m_queue = _queue; }
 
@@ -287,6 +365,10 @@ private:
 
     HttpReqHandler m_httpReqHandler;
     WsUpgradeHandler m_wsUpgradeHandler;
+    TcpFrameHandler m_tcpFrameHandler;
+    ShmRingHandler m_shmRingHandler;
+    std::string m_metricsPath;
+    MetricsHandler m_metricsHandler;
     // the parser is stored in an optional container so we can
     // construct it from scratch it at the beginning of each new message.
     boost::optional<boost::beast::http::request_parser<boost::beast::http::string_body>> m_parser;
@@ -45,8 +45,14 @@ public:
 
 public:
     virtual boost::beast::tcp_stream& stream() = 0;
+    virtual boost::beast::tcp_stream::executor_type executor() { return stream().get_executor(); }
 
     virtual ws::WsStreamDelegate::Ptr wsStream() = 0;
+    virtual ws::WsStreamDelegate::Ptr tcpFrameStream() = 0;
+    // only on the unix domain socket
+    virtual ws::WsStreamDelegate::Ptr shmRingStream() { return nullptr; }
+    // only on tcp without ssl
+    virtual ws::WsStreamDelegate::Ptr uringFrameStream() { return nullptr; }
 
     virtual bool open() = 0;
     virtual void close() = 0;
@@ -58,6 +64,10 @@ public:
 
     virtual void asyncWrite(const HttpResponse& _httpResp, HttpStreamRWHandler _handler) = 0;
 
+    // read exactly _size bytes into _buffer
+    virtual void asyncReadExactly(
+        boost::beast::flat_buffer& _buffer, std::size_t _size, HttpStreamRWHandler _handler) = 0;
+
     virtual std::string localEndpoint()
     {
         try
@@ -130,6 +140,20 @@ public:
         return builder->build(m_stream, m_moduleName);
     }
 
+    virtual ws::WsStreamDelegate::Ptr tcpFrameStream() override
+    {
+        m_closed.store(true);
+        auto builder = std::make_shared<ws::WsStreamDelegateBuilder>();
+        return builder->buildTcpFrame(m_stream, m_moduleName);
+    }
+
+    virtual ws::WsStreamDelegate::Ptr uringFrameStream() override
+    {
+        m_closed.store(true);
+        auto builder = std::make_shared<ws::WsStreamDelegateBuilder>();
+        return builder->buildUringFrame(m_stream, m_moduleName);
+    }
+
     virtual bool open() override
     {
         if (!m_closed.load() && m_stream)
@@ -167,6 +191,17 @@ public:
         boost::beast::http::async_write(*m_stream, _httpResp, _handler);
     }
 
+    virtual void asyncReadExactly(boost::beast::flat_buffer& _buffer, std::size_t _size,
+        HttpStreamRWHandler _handler) override
+    {
+        // read into the prepared area, the dynamic buffer overload would read into a copy
+        boost::asio::async_read(*m_stream, _buffer.prepare(_size),
+            [&_buffer, _handler](boost::system::error_code _ec, std::size_t _bytesTransferred) {
+                _buffer.commit(_bytesTransferred);
+                _handler(_ec, _bytesTransferred);
+            });
+    }
+
 
 private:
     std::shared_ptr<boost::beast::tcp_stream> m_stream;
@@ -203,6 +238,13 @@ public:
         return builder->build(m_stream, m_moduleName);
     }
 
+    virtual ws::WsStreamDelegate::Ptr tcpFrameStream() override
+    {
+        m_closed.store(true);
+        auto builder = std::make_shared<ws::WsStreamDelegateBuilder>();
+        return builder->buildTcpFrame(m_stream, m_moduleName);
+    }
+
     virtual bool open() override
     {
         if (!m_closed.load() && m_stream)
@@ -242,10 +284,150 @@ public:
         boost::beast::http::async_write(*m_stream, _httpResp, _handler);
     }
 
+    virtual void asyncReadExactly(boost::beast::flat_buffer& _buffer, std::size_t _size,
+        HttpStreamRWHandler _handler) override
+    {
+        // read into the prepared area, the dynamic buffer overload would read into a copy
+        boost::asio::async_read(*m_stream, _buffer.prepare(_size),
+            [&_buffer, _handler](boost::system::error_code _ec, std::size_t _bytesTransferred) {
+                _buffer.commit(_bytesTransferred);
+                _handler(_ec, _bytesTransferred);
+            });
+    }
+
 private:
     std::shared_ptr<boost::beast::ssl_stream<boost::beast::tcp_stream>> m_stream;
 };
 
+// The http stream over the unix domain socket, the socket file permissions are the trust
+// boundary, so there is no ssl on it
+class HttpStreamUnixImpl : public HttpStream,
+                           public std::enable_shared_from_this<HttpStreamUnixImpl>
+{
+public:
+    using Ptr = std::shared_ptr<HttpStreamUnixImpl>;
+
+public:
+    HttpStreamUnixImpl(std::shared_ptr<ws::UnixStream> _stream, std::string _moduleName)
+      : m_stream(_stream)
+    {
+        setModuleName(_moduleName);
+        HTTP_STREAM(DEBUG) << LOG_KV("[NEWOBJ][HttpStreamUnixImpl]", this);
+    }
+    virtual ~HttpStreamUnixImpl()
+    {
+        HTTP_STREAM(DEBUG) << LOG_KV("[DELOBJ][HttpStreamUnixImpl]", this);
+        close();
+    }
+
+public:
+    virtual boost::beast::tcp_stream& stream() override
+    {
+        BOOST_THROW_EXCEPTION(std::logic_error("no tcp stream on the unix domain socket"));
+    }
+    virtual boost::beast::tcp_stream::executor_type executor() override
+    {
+        return m_stream->get_executor();
+    }
+
+    virtual ws::WsStreamDelegate::Ptr wsStream() override
+    {
+        m_closed.store(true);
+        auto builder = std::make_shared<ws::WsStreamDelegateBuilder>();
+        return builder->build(m_stream, m_moduleName);
+    }
+
+    virtual ws::WsStreamDelegate::Ptr tcpFrameStream() override
+    {
+        m_closed.store(true);
+        auto builder = std::make_shared<ws::WsStreamDelegateBuilder>();
+        return builder->buildTcpFrame(m_stream, m_moduleName);
+    }
+
+    virtual ws::WsStreamDelegate::Ptr shmRingStream() override
+    {
+        m_closed.store(true);
+        auto builder = std::make_shared<ws::WsStreamDelegateBuilder>();
+        return builder->buildShmRing(m_stream, 0, m_moduleName);
+    }
+
+    virtual bool open() override
+    {
+        if (!m_closed.load() && m_stream)
+        {
+            return m_stream->socket().is_open();
+        }
+        return false;
+    }
+    virtual void close() override
+    {
+        if (m_closed.load())
+        {
+            return;
+        }
+
+        bool trueValue = true;
+        bool falseValue = false;
+        if (m_closed.compare_exchange_strong(falseValue, trueValue))
+        {
+            HTTP_STREAM(INFO) << LOG_DESC("close the unix stream") << LOG_KV("this", this);
+            ws::WsTools::close(m_stream->socket());
+        }
+    }
+
+    virtual void asyncRead(boost::beast::flat_buffer& _buffer,
+        boost::optional<boost::beast::http::request_parser<boost::beast::http::string_body>>&
+            _parser,
+        HttpStreamRWHandler _handler) override
+    {
+        boost::beast::http::async_read(*m_stream, _buffer, *_parser, _handler);
+    }
+
+    virtual void asyncWrite(const HttpResponse& _httpResp, HttpStreamRWHandler _handler) override
+    {
+        boost::beast::http::async_write(*m_stream, _httpResp, _handler);
+    }
+
+    virtual void asyncReadExactly(boost::beast::flat_buffer& _buffer, std::size_t _size,
+        HttpStreamRWHandler _handler) override
+    {
+        boost::asio::async_read(*m_stream, _buffer.prepare(_size),
+            [&_buffer, _handler](boost::system::error_code _ec, std::size_t _bytesTransferred) {
+                _buffer.commit(_bytesTransferred);
+                _handler(_ec, _bytesTransferred);
+            });
+    }
+
+    virtual std::string localEndpoint() override
+    {
+        try
+        {
+            return ws::WsTools::localEndPoint(m_stream->socket());
+        }
+        catch (...)
+        {
+        }
+
+        return std::string("");
+    }
+
+    virtual std::string remoteEndpoint() override
+    {
+        try
+        {
+            return ws::WsTools::remoteEndPoint(m_stream->socket());
+        }
+        catch (...)
+        {
+        }
+
+        return std::string("");
+    }
+
+private:
+    std::shared_ptr<ws::UnixStream> m_stream;
+};
+
 class HttpStreamFactory
 {
 public:
@@ -264,6 +446,12 @@ public:
     {
         return std::make_shared<HttpStreamSslImpl>(_stream, _moduleName);
     }
+
+    HttpStream::Ptr buildHttpStream(
+        std::shared_ptr<ws::UnixStream> _stream, std::string _moduleName)
+    {
+        return std::make_shared<HttpStreamUnixImpl>(_stream, _moduleName);
+    }
 };
 }  // namespace http
 }  // namespace boostssl
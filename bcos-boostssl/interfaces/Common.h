@@ -19,6 +19,28 @@
  */
 #pragma once
 
+#include <bcos-utilities/BoostLog.h>
+
+#define BOOSTSSL_LOG_LEVEL_TRACE 0
+#define BOOSTSSL_LOG_LEVEL_DEBUG 1
+#define BOOSTSSL_LOG_LEVEL_INFO 2
+#define BOOSTSSL_LOG_LEVEL_WARNING 3
+#define BOOSTSSL_LOG_LEVEL_ERROR 4
+#define BOOSTSSL_LOG_LEVEL_FATAL 5
+
+// the logs below the level are compiled out, set by the BOOSTSSL_MIN_LOG_LEVEL cmake option
+#ifndef BOOSTSSL_MIN_LOG_LEVEL
+#define BOOSTSSL_MIN_LOG_LEVEL BOOSTSSL_LOG_LEVEL_TRACE
+#endif
+
+// the compiler drops the statement below the minimum level, above it BCOS_LOG checks the
+// runtime level before any argument of the stream is evaluated, the loop runs at most once and
+// unlike an if/else keeps an unbraced if in front of the macro unambiguous
+#define BOOSTSSL_LOG(LEVEL)                                                         \
+    for (bool boostsslLogOn = BOOSTSSL_LOG_LEVEL_##LEVEL >= BOOSTSSL_MIN_LOG_LEVEL; \
+         boostsslLogOn; boostsslLogOn = false)                                      \
+    BCOS_LOG(LEVEL)
+
 namespace bcos
 {
 namespace boostssl
@@ -27,6 +49,22 @@ namespace boostssl
 enum MessageExtFieldFlag
 {
     Response = 0x0001,
+    // the payload is compressed by the WsCompressor
+    Compressed = 0x0010,
+    // the sender accepts the compressed payloads
+    CompressSupported = 0x0020,
+    // the payload packs the encoded messages of a batch
+    Batch = 0x0040,
+    // the sender accepts the batch frames
+    BatchSupported = 0x0080,
+    // the payload is a chunk of the stream of the seq, led by the WsChunkFlag byte
+    Chunk = 0x0100,
+    // the payload grants the sender of the stream of the seq more bytes to send
+    ChunkCredit = 0x0200,
+    // the payload is the flag byte and the next slice of a large encoded message
+    Fragment = 0x0400,
+    // the sender reassembles the fragment frames
+    FragmentSupported = 0x0800,
 };
 
 }  // namespace boostssl
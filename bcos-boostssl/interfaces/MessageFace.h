@@ -48,6 +48,12 @@ public:
     virtual void setExt(uint16_t) = 0;
     virtual std::shared_ptr<bytes> payload() const = 0;
     virtual void setPayload(std::shared_ptr<bcos::bytes>) = 0;
+    // a view of the payload, valid while the message lives and the payload is not replaced
+    virtual bytesConstRef payloadRef() const
+    {
+        auto payload = this->payload();
+        return payload ? bytesConstRef(payload->data(), payload->size()) : bytesConstRef();
+    }
 
     virtual bool encode(bcos::bytes& _buffer) = 0;
     virtual int64_t decode(bytesConstRef _buffer) = 0;
@@ -65,6 +71,8 @@ public:
 public:
     virtual ~MessageFaceFactory() {}
     virtual MessageFace::Ptr buildMessage() = 0;
+    // the buffer the messages are encoded into
+    virtual std::shared_ptr<bytes> buildBuffer() { return std::make_shared<bytes>(); }
     virtual std::string newSeq() = 0;
 };
 
@@ -29,6 +29,8 @@ namespace bcos
 namespace boostssl
 {
 
+static const std::string UNIX_SOCKET_PREFIX = "unix:";
+
 /**
  * @brief client end endpoint. Node will connect to NodeIPEndpoint.
  */
@@ -73,6 +75,13 @@ struct NodeIPEndpoint
     std::string address() const { return m_host; };
     bool isIPv6() const { return m_ipv6; }
 
+    // the unix domain socket endpoint: host "unix:<path>", port 0
+    bool isUnixSocket() const
+    {
+        return m_host.compare(0, UNIX_SOCKET_PREFIX.size(), UNIX_SOCKET_PREFIX) == 0;
+    }
+    std::string unixSocketPath() const { return m_host.substr(UNIX_SOCKET_PREFIX.size()); }
+
     std::string m_host;
     uint16_t m_port;
     bool m_ipv6 = false;
@@ -25,18 +25,26 @@
 #include <boost/asio/ssl.hpp>
 #include <boost/beast/websocket.hpp>
 
-#define BOOST_SSL_LOG(LEVEL) BCOS_LOG(LEVEL) << "[BOOSTSSL]"
-#define WEBSOCKET_TOOL(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][TOOL]"
-#define WEBSOCKET_CONNECTOR(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][CONNECTOR]"
-#define WEBSOCKET_VERSION(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][VERSION]"
-#define WEBSOCKET_SESSION(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][SESSION]"
-#define WEBSOCKET_MESSAGE(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][MESSAGE]"
-#define WEBSOCKET_SERVICE(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][SERVICE]"
-#define WEBSOCKET_STREAM(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][STREAM]"
+#define BOOST_SSL_LOG(LEVEL) BOOSTSSL_LOG(LEVEL) << "[BOOSTSSL]"
+#define WEBSOCKET_TOOL(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][TOOL]"
+#define WEBSOCKET_CONNECTOR(LEVEL) \
+    BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][CONNECTOR]"
+#define WEBSOCKET_VERSION(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][VERSION]"
+#define WEBSOCKET_SESSION(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][SESSION]"
+#define WEBSOCKET_MESSAGE(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][MESSAGE]"
+#define WEBSOCKET_SERVICE(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][SERVICE]"
+#define WEBSOCKET_STREAM(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][STREAM]"
 #define WEBSOCKET_SSL_STREAM(LEVEL) \
-    BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][SSL][STREAM]"
+    BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][SSL][STREAM]"
+#define WEBSOCKET_TCP_FRAME_STREAM(LEVEL) \
+    BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][TCPFRAME][STREAM]"
+#define WEBSOCKET_SHM_RING_STREAM(LEVEL) \
+    BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][SHMRING][STREAM]"
+#define WEBSOCKET_URING_STREAM(LEVEL) \
+    BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][URING][STREAM]"
+#define WEBSOCKET_IO_URING(LEVEL) BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][IOURING]"
 #define WEBSOCKET_INITIALIZER(LEVEL) \
-    BCOS_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][INITIALIZER]"
+    BOOSTSSL_LOG(LEVEL) << LOG_BADGE(m_moduleName) << "[WS][INITIALIZER]"
 
 namespace bcos
 {
@@ -0,0 +1,696 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file ShmRingStream.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#include <bcos-boostssl/websocket/ShmRingStream.h>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <algorithm>
+#include <cstring>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+    "the shared memory ring needs lock-free atomics to work across processes");
+
+bool ShmRingView::used(uint64_t _head, uint64_t _tail, std::size_t& _used)
+{
+    // the indexes only grow, the unsigned difference is out of range if the peer moved either
+    // one backwards or too far
+    auto used = _head - _tail;
+    if (m_corrupted || used > m_capacity)
+    {
+        m_corrupted = true;
+        return false;
+    }
+    _used = used;
+    return true;
+}
+
+std::size_t ShmRingView::readable()
+{
+    std::size_t n = 0;
+    used(m_ring->head.load(std::memory_order_acquire),
+        m_ring->tail.load(std::memory_order_relaxed), n);
+    return n;
+}
+
+std::size_t ShmRingView::write(const uint8_t* _data, std::size_t _size)
+{
+    auto h = m_ring->head.load(std::memory_order_relaxed);
+    auto t = m_ring->tail.load(std::memory_order_acquire);
+    std::size_t usedSize = 0;
+    if (!used(h, t, usedSize))
+    {
+        return 0;
+    }
+    auto n = std::min<std::size_t>(_size, m_capacity - usedSize);
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    // the capacity is a power of two, the copy wraps around at most once
+    auto offset = h & (m_capacity - 1);
+    auto first = std::min<std::size_t>(n, m_capacity - offset);
+    std::memcpy(data() + offset, _data, first);
+    std::memcpy(data(), _data + first, n - first);
+    m_ring->head.store(h + n, std::memory_order_release);
+    return n;
+}
+
+std::size_t ShmRingView::read(uint8_t* _data, std::size_t _size)
+{
+    auto t = m_ring->tail.load(std::memory_order_relaxed);
+    auto h = m_ring->head.load(std::memory_order_acquire);
+    std::size_t usedSize = 0;
+    if (!used(h, t, usedSize))
+    {
+        return 0;
+    }
+    auto n = std::min<std::size_t>(_size, usedSize);
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    auto offset = t & (m_capacity - 1);
+    auto first = std::min<std::size_t>(n, m_capacity - offset);
+    std::memcpy(_data, data() + offset, first);
+    std::memcpy(_data + first, data(), n - first);
+    m_ring->tail.store(t + n, std::memory_order_release);
+    return n;
+}
+
+ShmRingStream::ShmRingStream(
+    std::shared_ptr<UnixStream> _stream, uint32_t _ringSize, std::string _moduleName)
+  : m_stream(_stream), m_doorbell(_stream->get_executor()), m_moduleName(_moduleName)
+{
+    // round up to a power of two for the index masking
+    uint32_t ringSize = SHM_RING_MIN_SIZE;
+    while (ringSize < _ringSize && ringSize < SHM_RING_MAX_SIZE)
+    {
+        ringSize <<= 1;
+    }
+    m_ringSize = ringSize;
+    WEBSOCKET_SHM_RING_STREAM(INFO) << LOG_KV("[NEWOBJ][ShmRingStream]", this)
+                                    << LOG_KV("ringSize", m_ringSize);
+}
+
+ShmRingStream::~ShmRingStream()
+{
+    WEBSOCKET_SHM_RING_STREAM(INFO) << LOG_KV("[DELOBJ][ShmRingStream]", this);
+    close();
+#ifdef __linux__
+    if (m_region)
+    {
+        ::munmap(m_region, m_regionSize);
+    }
+    if (m_peerDoorbell >= 0)
+    {
+        ::close(m_peerDoorbell);
+    }
+#endif
+}
+
+void ShmRingStream::close()
+{
+    bool trueValue = true;
+    bool falseValue = false;
+    if (!m_closed.compare_exchange_strong(falseValue, trueValue))
+    {
+        return;
+    }
+
+    // the peer sees the socket closed and stops too
+    WsTools::close(m_stream->socket());
+
+    // the doorbell and the pending handlers belong to the io thread of the stream
+    auto self = weak_from_this();
+    boost::asio::post(m_stream->get_executor(), [self]() {
+        auto stream = self.lock();
+        if (!stream)
+        {
+            return;
+        }
+        boost::system::error_code ec;
+        stream->m_doorbell.close(ec);
+        stream->failPending(boost::asio::error::operation_aborted);
+    });
+
+    WEBSOCKET_SHM_RING_STREAM(INFO)
+        << LOG_DESC("the real action to close the stream") << LOG_KV("this", this);
+}
+
+void ShmRingStream::failPending(boost::system::error_code _ec)
+{
+    if (m_writeHandler)
+    {
+        auto handler = std::move(m_writeHandler);
+        m_writeHandler = nullptr;
+        boost::asio::post(m_stream->get_executor(), [handler, _ec]() { handler(_ec, 0); });
+    }
+    if (m_readHandler)
+    {
+        auto handler = std::move(m_readHandler);
+        m_readHandler = nullptr;
+        boost::asio::post(m_stream->get_executor(), [handler, _ec]() { handler(_ec, 0); });
+    }
+}
+
+bool ShmRingStream::mapRings(int _memfd, bool _asClient)
+{
+#ifdef __linux__
+    if (!ShmRing::validSize(m_ringSize))
+    {
+        WEBSOCKET_SHM_RING_STREAM(WARNING) << LOG_BADGE("mapRings") << LOG_DESC("invalid size")
+                                           << LOG_KV("ringSize", m_ringSize);
+        return false;
+    }
+    m_regionSize = 2 * (sizeof(ShmRing) + m_ringSize);
+    m_region = ::mmap(nullptr, m_regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, _memfd, 0);
+    if (m_region == MAP_FAILED)
+    {
+        m_region = nullptr;
+        WEBSOCKET_SHM_RING_STREAM(WARNING)
+            << LOG_BADGE("mapRings") << LOG_DESC("mmap failed") << LOG_KV("errno", errno);
+        return false;
+    }
+
+    auto base = reinterpret_cast<uint8_t*>(m_region);
+    auto clientRing = reinterpret_cast<ShmRing*>(base);
+    auto serverRing = reinterpret_cast<ShmRing*>(base + sizeof(ShmRing) + m_ringSize);
+    if (_asClient)
+    {
+        // the memfd is zero filled, the client sets the capacity before handing it over
+        clientRing->capacity = m_ringSize;
+        serverRing->capacity = m_ringSize;
+    }
+    else if (clientRing->capacity != m_ringSize || serverRing->capacity != m_ringSize)
+    {
+        WEBSOCKET_SHM_RING_STREAM(WARNING) << LOG_BADGE("mapRings") << LOG_DESC("invalid rings");
+        return false;
+    }
+    // the checked size is kept on this side, the capacity in the shared memory is not read again
+    m_txRing = ShmRingView(_asClient ? clientRing : serverRing, m_ringSize);
+    m_rxRing = ShmRingView(_asClient ? serverRing : clientRing, m_ringSize);
+    return true;
+#else
+    boost::ignore_unused(_memfd, _asClient);
+    return false;
+#endif
+}
+
+void ShmRingStream::asyncHandshake(
+    const std::string&, const std::string&, HandshakeHandler _handler)
+{
+#ifdef __linux__
+    int memfd = ::memfd_create("bcos-shm-ring", MFD_CLOEXEC);
+    int doorbell = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    m_peerDoorbell = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    bool ok = memfd >= 0 && doorbell >= 0 && m_peerDoorbell >= 0 &&
+              ::ftruncate(memfd, 2 * (sizeof(ShmRing) + m_ringSize)) == 0 &&
+              mapRings(memfd, true);
+    if (ok)
+    {
+        boost::system::error_code ec;
+        m_doorbell.assign(doorbell, ec);
+        ok = !ec;
+    }
+    if (!ok)
+    {
+        WEBSOCKET_SHM_RING_STREAM(WARNING)
+            << LOG_BADGE("asyncHandshake") << LOG_DESC("create the rings failed")
+            << LOG_KV("errno", errno);
+        if (memfd >= 0)
+        {
+            ::close(memfd);
+        }
+        if (doorbell >= 0 && !m_doorbell.is_open())
+        {
+            ::close(doorbell);
+        }
+        boost::asio::post(m_stream->get_executor(),
+            [_handler]() { _handler(boost::asio::error::no_memory); });
+        return;
+    }
+
+    auto self = weak_from_this();
+    boost::asio::async_write(*m_stream, boost::asio::buffer(SHM_RING_PREAMBLE),
+        [self, memfd, _handler](boost::system::error_code _ec, std::size_t) {
+            auto stream = self.lock();
+            if (!stream || _ec)
+            {
+                ::close(memfd);
+                return _handler(_ec ? _ec : boost::asio::error::operation_aborted);
+            }
+
+            // the ring size goes with the fds: the memfd, the doorbell of the server, and the
+            // doorbell of the client, they are sent apart from the preamble, so the http
+            // session of the server that reads the preamble does not drop them
+            uint32_t ringSize =
+                boost::asio::detail::socket_ops::host_to_network_long(stream->m_ringSize);
+            int fds[3] = {memfd, stream->m_peerDoorbell, stream->m_doorbell.native_handle()};
+            char control[CMSG_SPACE(sizeof(fds))];
+            std::memset(control, 0, sizeof(control));
+            struct iovec iov = {&ringSize, sizeof(ringSize)};
+            struct msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            auto cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_RIGHTS;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+            std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+            auto r = ::sendmsg(stream->m_stream->socket().native_handle(), &msg, MSG_NOSIGNAL);
+            ::close(memfd);
+            if (r != (ssize_t)sizeof(ringSize))
+            {
+                std::string m_moduleName = stream->m_moduleName;
+                WEBSOCKET_SHM_RING_STREAM(WARNING) << LOG_BADGE("asyncHandshake")
+                                                   << LOG_DESC("sendmsg failed")
+                                                   << LOG_KV("errno", errno);
+                return _handler(boost::asio::error::broken_pipe);
+            }
+
+            // wait for the server to map the rings
+            auto ack = std::make_shared<uint8_t>(0);
+            boost::asio::async_read(*stream->m_stream, boost::asio::buffer(ack.get(), 1),
+                [self, ack, _handler](boost::system::error_code _ec, std::size_t) {
+                    auto stream = self.lock();
+                    if (!stream || _ec)
+                    {
+                        return _handler(_ec ? _ec : boost::asio::error::operation_aborted);
+                    }
+                    stream->onReady(_handler);
+                });
+        });
+#else
+    boost::asio::post(m_stream->get_executor(),
+        [_handler]() { _handler(boost::asio::error::operation_not_supported); });
+#endif
+}
+
+void ShmRingStream::asyncAccept(bcos::boostssl::http::HttpRequest, HandshakeHandler _handler)
+{
+#ifdef __linux__
+    auto self = weak_from_this();
+    m_stream->socket().async_wait(boost::asio::socket_base::wait_read,
+        [self, _handler](boost::system::error_code _ec) {
+            auto stream = self.lock();
+            if (!stream || _ec)
+            {
+                return _handler(_ec ? _ec : boost::asio::error::operation_aborted);
+            }
+            std::string m_moduleName = stream->m_moduleName;
+
+            uint32_t ringSize = 0;
+            int fds[3] = {-1, -1, -1};
+            char control[CMSG_SPACE(sizeof(fds))];
+            struct iovec iov = {&ringSize, sizeof(ringSize)};
+            struct msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+
+            auto r = ::recvmsg(stream->m_stream->socket().native_handle(), &msg, MSG_CMSG_CLOEXEC);
+            auto cmsg = CMSG_FIRSTHDR(&msg);
+            if (r == (ssize_t)sizeof(ringSize) && cmsg && cmsg->cmsg_level == SOL_SOCKET &&
+                cmsg->cmsg_type == SCM_RIGHTS && cmsg->cmsg_len == CMSG_LEN(sizeof(fds)))
+            {
+                std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+            }
+
+            // the size comes from the peer, it must be a valid ring size that matches the memfd
+            // before anything is mapped
+            struct stat st;
+            stream->m_ringSize = boost::asio::detail::socket_ops::network_to_host_long(ringSize);
+            bool ok = ShmRing::validSize(stream->m_ringSize) && fds[0] >= 0 &&
+                      ::fstat(fds[0], &st) == 0 &&
+                      (std::size_t)st.st_size == 2 * (sizeof(ShmRing) + stream->m_ringSize) &&
+                      stream->mapRings(fds[0], false);
+            if (fds[0] >= 0)
+            {
+                ::close(fds[0]);
+            }
+            boost::system::error_code ec;
+            if (ok)
+            {
+                stream->m_doorbell.assign(fds[1], ec);
+                stream->m_peerDoorbell = fds[2];
+            }
+            if (!ok || ec)
+            {
+                WEBSOCKET_SHM_RING_STREAM(WARNING)
+                    << LOG_BADGE("asyncAccept") << LOG_DESC("invalid shared memory rings")
+                    << LOG_KV("recv", r) << LOG_KV("ringSize", stream->m_ringSize);
+                for (auto fd : {fds[1], fds[2]})
+                {
+                    if (fd >= 0 && fd != stream->m_peerDoorbell)
+                    {
+                        ::close(fd);
+                    }
+                }
+                return _handler(boost::asio::error::invalid_argument);
+            }
+
+            auto ack = std::make_shared<uint8_t>(1);
+            boost::asio::async_write(*stream->m_stream, boost::asio::buffer(ack.get(), 1),
+                [self, ack, _handler](boost::system::error_code _ec, std::size_t) {
+                    auto stream = self.lock();
+                    if (!stream || _ec)
+                    {
+                        return _handler(_ec ? _ec : boost::asio::error::operation_aborted);
+                    }
+                    stream->onReady(_handler);
+                });
+        });
+#else
+    boost::asio::post(m_stream->get_executor(),
+        [_handler]() { _handler(boost::asio::error::operation_not_supported); });
+#endif
+}
+
+void ShmRingStream::onReady(HandshakeHandler _handler)
+{
+    WEBSOCKET_SHM_RING_STREAM(INFO) << LOG_BADGE("onReady") << LOG_DESC("the rings are mapped")
+                                    << LOG_KV("ringSize", m_ringSize) << LOG_KV("this", this);
+    watchPeer();
+    _handler(make_error_code(boost::system::errc::success));
+}
+
+void ShmRingStream::watchPeer()
+{
+    // nothing is sent on the socket anymore, it turns readable when the peer closes it
+    auto self = weak_from_this();
+    m_stream->socket().async_wait(
+        boost::asio::socket_base::wait_read, [self](boost::system::error_code _ec) {
+            auto stream = self.lock();
+            if (!stream || _ec == boost::asio::error::operation_aborted)
+            {
+                return;
+            }
+            std::string m_moduleName = stream->m_moduleName;
+            WEBSOCKET_SHM_RING_STREAM(INFO)
+                << LOG_BADGE("watchPeer") << LOG_DESC("the peer is gone") << LOG_KV("error", _ec);
+            stream->failPending(boost::asio::error::eof);
+            stream->close();
+        });
+}
+
+void ShmRingStream::waitDoorbell()
+{
+    if (m_waitingDoorbell || !m_doorbell.is_open())
+    {
+        return;
+    }
+    m_waitingDoorbell = true;
+
+    auto self = weak_from_this();
+    m_doorbell.async_wait(boost::asio::posix::stream_descriptor::wait_read,
+        [self](boost::system::error_code _ec) {
+            auto stream = self.lock();
+            if (!stream)
+            {
+                return;
+            }
+            stream->m_waitingDoorbell = false;
+            if (_ec)
+            {
+                return;
+            }
+#ifdef __linux__
+            eventfd_t value;
+            ::eventfd_read(stream->m_doorbell.native_handle(), &value);
+#endif
+            if (stream->m_readHandler)
+            {
+                stream->pumpRead();
+            }
+            if (stream->m_writeHandler)
+            {
+                stream->pumpWrite();
+            }
+        });
+}
+
+void ShmRingStream::ringPeer()
+{
+#ifdef __linux__
+    ::eventfd_write(m_peerDoorbell, 1);
+#endif
+}
+
+void ShmRingStream::asyncWrite(const bcos::bytes& _buffer, RWHandler _handler)
+{
+    if (m_closed.load() || !m_txRing)
+    {
+        boost::asio::post(m_stream->get_executor(),
+            [_handler]() { _handler(boost::asio::error::operation_aborted, 0); });
+        return;
+    }
+
+    uint32_t length = boost::asio::detail::socket_ops::host_to_network_long(_buffer.size());
+    std::memcpy(m_writeHeader.data(), &length, m_writeHeader.size());
+    m_writeData = _buffer.data();
+    m_writeSize = _buffer.size();
+    m_writeOffset = 0;
+    m_writeHandler = std::move(_handler);
+    pumpWrite();
+}
+
+void ShmRingStream::pumpWrite()
+{
+    auto headerSize = m_writeHeader.size();
+    auto total = headerSize + m_writeSize;
+    while (true)
+    {
+        bool progress = false;
+        while (m_writeOffset < total)
+        {
+            std::size_t n = 0;
+            if (m_writeOffset < headerSize)
+            {
+                n = m_txRing.write(
+                    m_writeHeader.data() + m_writeOffset, headerSize - m_writeOffset);
+            }
+            else
+            {
+                n = m_txRing.write(
+                    m_writeData + m_writeOffset - headerSize, total - m_writeOffset);
+            }
+            if (n == 0)
+            {
+                break;
+            }
+            m_writeOffset += n;
+            progress = true;
+        }
+        if (m_txRing.corrupted())
+        {
+            return onRingCorrupted(m_txRing);
+        }
+
+        if (progress)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_txRing->consumerWaiting.exchange(0))
+            {
+                ringPeer();
+            }
+        }
+
+        if (m_writeOffset == total)
+        {
+            auto handler = std::move(m_writeHandler);
+            m_writeHandler = nullptr;
+            auto size = m_writeSize;
+            boost::asio::post(
+                m_stream->get_executor(), [handler, size]() { handler({}, size); });
+            return;
+        }
+
+        // the ring is full, ask the consumer to ring after it frees some space, check again in
+        // case it did so before seeing the flag
+        m_txRing->producerWaiting.store(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_txRing.readable() < m_txRing.capacity() || m_txRing.corrupted())
+        {
+            continue;
+        }
+        return waitDoorbell();
+    }
+}
+
+void ShmRingStream::asyncRead(boost::beast::flat_buffer& _buffer, RWHandler _handler)
+{
+    if (m_closed.load() || !m_rxRing)
+    {
+        boost::asio::post(m_stream->get_executor(),
+            [_handler]() { _handler(boost::asio::error::operation_aborted, 0); });
+        return;
+    }
+
+    m_readBuffer = &_buffer;
+    m_readHeaderSize = 0;
+    m_readData = nullptr;
+    m_readSize = 0;
+    m_readOffset = 0;
+    m_readHandler = std::move(_handler);
+    pumpRead();
+}
+
+void ShmRingStream::pumpRead()
+{
+    auto headerSize = m_readHeader.size();
+    while (true)
+    {
+        bool progress = false;
+        if (m_readHeaderSize < headerSize)
+        {
+            auto n = m_rxRing.read(
+                m_readHeader.data() + m_readHeaderSize, headerSize - m_readHeaderSize);
+            m_readHeaderSize += n;
+            progress = n > 0;
+
+            if (m_readHeaderSize == headerSize)
+            {
+                uint32_t length = 0;
+                std::memcpy(&length, m_readHeader.data(), headerSize);
+                m_readSize = boost::asio::detail::socket_ops::network_to_host_long(length);
+                if (m_readSize > m_maxReadMsgSize)
+                {
+                    WEBSOCKET_SHM_RING_STREAM(WARNING)
+                        << LOG_BADGE("asyncRead") << LOG_DESC("frame size overflow")
+                        << LOG_KV("length", m_readSize)
+                        << LOG_KV("maxReadMsgSize", m_maxReadMsgSize);
+                    auto handler = std::move(m_readHandler);
+                    m_readHandler = nullptr;
+                    boost::asio::post(m_stream->get_executor(),
+                        [handler]() { handler(boost::asio::error::message_size, 0); });
+                    return;
+                }
+                m_readData = reinterpret_cast<uint8_t*>(m_readBuffer->prepare(m_readSize).data());
+            }
+        }
+
+        if (m_readHeaderSize == headerSize && m_readOffset < m_readSize)
+        {
+            auto n = m_rxRing.read(m_readData + m_readOffset, m_readSize - m_readOffset);
+            m_readOffset += n;
+            progress = progress || n > 0;
+        }
+        if (m_rxRing.corrupted())
+        {
+            return onRingCorrupted(m_rxRing);
+        }
+
+        if (progress)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_rxRing->producerWaiting.exchange(0))
+            {
+                ringPeer();
+            }
+        }
+
+        if (m_readHeaderSize == headerSize && m_readOffset == m_readSize)
+        {
+            m_readBuffer->commit(m_readSize);
+            auto handler = std::move(m_readHandler);
+            m_readHandler = nullptr;
+            auto size = m_readSize;
+            boost::asio::post(
+                m_stream->get_executor(), [handler, size]() { handler({}, size); });
+            return;
+        }
+
+        if (progress)
+        {
+            continue;
+        }
+
+        // the ring is empty, ask the producer to ring after it writes, check again in case it
+        // did so before seeing the flag
+        m_rxRing->consumerWaiting.store(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_rxRing.readable() > 0 || m_rxRing.corrupted())
+        {
+            continue;
+        }
+        return waitDoorbell();
+    }
+}
+
+void ShmRingStream::onRingCorrupted(const ShmRingView& _ring)
+{
+    WEBSOCKET_SHM_RING_STREAM(WARNING)
+        << LOG_BADGE("onRingCorrupted") << LOG_DESC("the peer corrupted the ring indexes")
+        << LOG_KV("head", _ring->head.load()) << LOG_KV("tail", _ring->tail.load())
+        << LOG_KV("capacity", _ring.capacity()) << LOG_KV("this", this);
+    // the session sees the error and drops the connection
+    failPending(boost::asio::error::invalid_argument);
+    close();
+}
+
+std::string ShmRingStream::localEndpoint()
+{
+    try
+    {
+        return WsTools::localEndPoint(m_stream->socket());
+    }
+    catch (const std::exception& e)
+    {
+        WEBSOCKET_SHM_RING_STREAM(WARNING) << LOG_BADGE("localEndpoint") << LOG_KV("e", e.what());
+    }
+
+    return std::string("");
+}
+
+std::string ShmRingStream::remoteEndpoint()
+{
+    try
+    {
+        return WsTools::remoteEndPoint(m_stream->socket());
+    }
+    catch (const std::exception& e)
+    {
+        WEBSOCKET_SHM_RING_STREAM(WARNING)
+            << LOG_BADGE("remoteEndpoint") << LOG_KV("e", e.what());
+    }
+
+    return std::string("");
+}
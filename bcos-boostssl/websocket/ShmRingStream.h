@@ -0,0 +1,196 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file ShmRingStream.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <bcos-boostssl/httpserver/Common.h>
+#include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/WsTools.h>
+#include <bcos-utilities/Common.h>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/beast/core.hpp>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+// the preamble the client sends on the unix domain socket to negotiate the shared memory rings
+static const std::array<uint8_t, 8> SHM_RING_PREAMBLE = {
+    0x00, 'B', 'C', 'O', 'S', 'S', 'M', 0x01};
+
+// the default size of each ring, one for each direction
+static const uint32_t SHM_RING_DEFAULT_SIZE = 4 * 1024 * 1024;
+// the bounds of the ring size, it is a power of two between them
+static const uint32_t SHM_RING_MIN_SIZE = 4096;
+static const uint32_t SHM_RING_MAX_SIZE = 1U << 31;
+
+/**
+ * @brief: the single producer single consumer byte ring in the shared memory, the data follows
+ * the header, the producer only moves head and the consumer only moves tail
+ */
+struct ShmRing
+{
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+    // set by the side going to sleep on its eventfd, the other side rings it after progress
+    alignas(64) std::atomic<uint32_t> consumerWaiting;
+    alignas(64) std::atomic<uint32_t> producerWaiting;
+    // set by the client and checked by the server once, never used to index the data
+    uint64_t capacity;
+
+    static bool validSize(uint64_t _size)
+    {
+        return _size >= SHM_RING_MIN_SIZE && _size <= SHM_RING_MAX_SIZE &&
+               (_size & (_size - 1)) == 0;
+    }
+};
+
+/**
+ * @brief: the view of a ring in the shared memory, the capacity is copied when the ring is
+ * mapped and head - tail is checked against it on every access, the peer can write anything there
+ */
+class ShmRingView
+{
+public:
+    ShmRingView() = default;
+    ShmRingView(ShmRing* _ring, uint64_t _capacity) : m_ring(_ring), m_capacity(_capacity) {}
+
+    explicit operator bool() const { return m_ring != nullptr; }
+    ShmRing* operator->() const { return m_ring; }
+    uint64_t capacity() const { return m_capacity; }
+    // head and tail have been out of range once, nothing is copied anymore
+    bool corrupted() const { return m_corrupted; }
+
+    std::size_t readable();
+    // copy up to _size bytes in, return the bytes copied
+    std::size_t write(const uint8_t* _data, std::size_t _size);
+    // copy up to _size bytes out, return the bytes copied
+    std::size_t read(uint8_t* _data, std::size_t _size);
+
+private:
+    uint8_t* data() const { return reinterpret_cast<uint8_t*>(m_ring) + sizeof(ShmRing); }
+    // the bytes in the ring, false if head - tail is not in [0, capacity]
+    bool used(uint64_t _head, uint64_t _tail, std::size_t& _used);
+
+    ShmRing* m_ring = nullptr;
+    uint64_t m_capacity = 0;
+    bool m_corrupted = false;
+};
+
+/**
+ * @brief: the message stream over a pair of shared memory rings for the peers on the same host,
+ * negotiated on a unix domain socket that is kept open to detect the peer going away, every
+ * message is framed as length(4, big endian) + message(N) like the tcp frame transport
+ */
+class ShmRingStream : public std::enable_shared_from_this<ShmRingStream>
+{
+public:
+    using Ptr = std::shared_ptr<ShmRingStream>;
+    using ConstPtr = std::shared_ptr<const ShmRingStream>;
+    using RWHandler = std::function<void(boost::system::error_code, std::size_t)>;
+    using HandshakeHandler = std::function<void(boost::system::error_code)>;
+
+    ShmRingStream(std::shared_ptr<UnixStream> _stream, uint32_t _ringSize, std::string _moduleName);
+    virtual ~ShmRingStream();
+
+public:
+    void setMaxReadMsgSize(uint32_t _maxValue) { m_maxReadMsgSize = _maxValue; }
+
+    std::string moduleName() { return m_moduleName; }
+    void setModuleName(std::string _moduleName) { m_moduleName = _moduleName; }
+
+    uint32_t ringSize() const { return m_ringSize; }
+
+public:
+    bool open() { return !m_closed.load() && m_stream->socket().is_open(); }
+    void close();
+
+    // the unix domain socket the rings are negotiated on
+    UnixStream& lowestLayer() { return *m_stream; }
+
+public:
+    // Note: only one write and one read are in flight at a time, the session serializes them
+    void asyncWrite(const bcos::bytes& _buffer, RWHandler _handler);
+    // read one whole frame into _buffer
+    void asyncRead(boost::beast::flat_buffer& _buffer, RWHandler _handler);
+
+    // client side: create the rings and hand them to the server
+    void asyncHandshake(const std::string&, const std::string&, HandshakeHandler _handler);
+    // server side: map the rings created by the client, the preamble has been consumed
+    void asyncAccept(bcos::boostssl::http::HttpRequest, HandshakeHandler _handler);
+
+    virtual std::string localEndpoint();
+    virtual std::string remoteEndpoint();
+
+private:
+    bool mapRings(int _memfd, bool _asClient);
+    void onReady(HandshakeHandler _handler);
+    void watchPeer();
+    void waitDoorbell();
+    void ringPeer();
+    void pumpWrite();
+    void pumpRead();
+    void onRingCorrupted(const ShmRingView& _ring);
+    void failPending(boost::system::error_code _ec);
+
+private:
+    std::atomic<bool> m_closed{false};
+    std::shared_ptr<UnixStream> m_stream;
+    uint32_t m_ringSize;
+    uint32_t m_maxReadMsgSize{UINT32_MAX};
+
+    // the mapped rings, the first one from client to server, the second one back
+    void* m_region = nullptr;
+    std::size_t m_regionSize = 0;
+    ShmRingView m_txRing;
+    ShmRingView m_rxRing;
+
+    // the eventfd the peer rings to wake this side up, and the one to wake the peer up
+    boost::asio::posix::stream_descriptor m_doorbell;
+    int m_peerDoorbell = -1;
+    bool m_waitingDoorbell = false;
+
+    // the write in progress
+    RWHandler m_writeHandler;
+    std::array<uint8_t, 4> m_writeHeader;
+    const uint8_t* m_writeData = nullptr;
+    std::size_t m_writeSize = 0;
+    std::size_t m_writeOffset = 0;
+
+    // the read in progress
+    RWHandler m_readHandler;
+    boost::beast::flat_buffer* m_readBuffer = nullptr;
+    std::array<uint8_t, 4> m_readHeader;
+    std::size_t m_readHeaderSize = 0;
+    uint8_t* m_readData = nullptr;
+    std::size_t m_readSize = 0;
+    std::size_t m_readOffset = 0;
+
+    std::string m_moduleName = "DEFAULT";
+};
+
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
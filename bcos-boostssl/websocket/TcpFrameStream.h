@@ -0,0 +1,391 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file TcpFrameStream.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <bcos-boostssl/httpserver/Common.h>
+#include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/WsTools.h>
+#include <bcos-utilities/BoostLog.h>
+#include <bcos-utilities/Common.h>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/ssl.hpp>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+// the preamble the client sends after the connection is established to select the tcp frame
+// transport, the leading zero byte never starts a http request
+static const std::array<uint8_t, 8> TCP_FRAME_PREAMBLE = {
+    0x00, 'B', 'C', 'O', 'S', 'T', 'F', 0x01};
+
+// the length-prefixed frame: length(4, big endian) + message(N)
+static const std::size_t TCP_FRAME_HEADER_SIZE = 4;
+
+// the length of the keepalive frame, a header without a message that the reader skips
+static const uint32_t TCP_FRAME_KEEPALIVE_LENGTH = UINT32_MAX;
+static const std::array<uint8_t, TCP_FRAME_HEADER_SIZE> TCP_FRAME_KEEPALIVE = {
+    0xff, 0xff, 0xff, 0xff};
+
+// the link is closed when nothing is read for the idle timeout, the same as the websocket stream
+static const uint32_t TCP_FRAME_IDLE_TIMEOUT_MS = 10000;
+
+/**
+ * @brief: the message stream for trusted links, every message is framed with a length prefix
+ * over raw tcp or tls, without the http upgrade round-trip and the websocket framing and masking
+ */
+template <typename STREAM>
+class TcpFrameStream : public std::enable_shared_from_this<TcpFrameStream<STREAM>>
+{
+public:
+    using Ptr = std::shared_ptr<TcpFrameStream>;
+    using ConstPtr = std::shared_ptr<const TcpFrameStream>;
+    using RWHandler = std::function<void(boost::system::error_code, std::size_t)>;
+    using HandshakeHandler = std::function<void(boost::system::error_code)>;
+
+    TcpFrameStream(std::shared_ptr<STREAM> _stream, std::string _moduleName)
+      : m_stream(_stream), m_moduleName(_moduleName)
+    {
+        // no websocket ping/pong on this transport, the keepalive frames and the idle timeout
+        // detect the dead peer, the kernel keepalive is left as a backstop
+        boost::system::error_code ec;
+        lowestLayer().socket().set_option(boost::asio::socket_base::keep_alive(true), ec);
+        WEBSOCKET_TCP_FRAME_STREAM(INFO) << LOG_KV("[NEWOBJ][TcpFrameStream]", this);
+    }
+
+    virtual ~TcpFrameStream()
+    {
+        WEBSOCKET_TCP_FRAME_STREAM(INFO) << LOG_KV("[DELOBJ][TcpFrameStream]", this);
+        close();
+    }
+
+public:
+    void setMaxReadMsgSize(uint32_t _maxValue)
+    {
+        m_maxReadMsgSize = std::min(_maxValue, TCP_FRAME_KEEPALIVE_LENGTH - 1);
+    }
+
+    // Note: set it before the first read, 0 disables the keepalive frames and the idle timeout
+    void setIdleTimeout(uint32_t _idleTimeout) { m_idleTimeout = _idleTimeout; }
+    uint32_t idleTimeout() const { return m_idleTimeout; }
+
+    std::string moduleName() { return m_moduleName; }
+    void setModuleName(std::string _moduleName) { m_moduleName = _moduleName; }
+
+public:
+    bool open() { return !m_closed.load() && lowestLayer().socket().is_open(); }
+
+    void close()
+    {
+        bool trueValue = true;
+        bool falseValue = false;
+        if (m_closed.compare_exchange_strong(falseValue, trueValue))
+        {
+            ws::WsTools::close(lowestLayer().socket());
+            if (m_idleTimer)
+            {
+                // the timer is only touched on the io thread of the stream
+                auto timer = m_idleTimer;
+                boost::asio::post(m_stream->get_executor(), [timer]() { timer->cancel(); });
+            }
+            WEBSOCKET_TCP_FRAME_STREAM(INFO)
+                << LOG_DESC("the real action to close the stream") << LOG_KV("this", this);
+        }
+    }
+
+    boost::beast::tcp_stream& tcpStream() { return boost::beast::get_lowest_layer(*m_stream); }
+    // the tcp_stream, or the UnixStream on the unix domain socket transport
+    auto& lowestLayer() { return boost::beast::get_lowest_layer(*m_stream); }
+
+    std::shared_ptr<STREAM> stream() const { return m_stream; }
+
+public:
+    // Note: only one write is in flight at a time, the session serializes the writes
+    void asyncWrite(const bcos::bytes& _buffer, RWHandler _handler)
+    {
+        if (m_keepaliveWriting)
+        {
+            auto self = this->shared_from_this();
+            m_pendingWrite = [self, &_buffer, _handler]() { self->asyncWrite(_buffer, _handler); };
+            return;
+        }
+
+        uint32_t length = boost::asio::detail::socket_ops::host_to_network_long(_buffer.size());
+        std::memcpy(m_writeHeader.data(), &length, TCP_FRAME_HEADER_SIZE);
+
+        std::array<boost::asio::const_buffer, 2> buffers = {
+            boost::asio::buffer(m_writeHeader), boost::asio::buffer(_buffer)};
+        m_writing = true;
+        // the session may release the stream after a drop, the aborted handler still runs
+        auto self = this->shared_from_this();
+        boost::asio::async_write(*m_stream, buffers,
+            [self, _handler](boost::system::error_code _ec, std::size_t _bytesTransferred) {
+                self->onWriteFinished();
+                _handler(_ec, _ec ? 0 : _bytesTransferred - TCP_FRAME_HEADER_SIZE);
+            });
+    }
+
+    // Note: without ssl only, the frame is the header followed by _size bytes of the file from
+    // _offset, the file goes to the socket with sendfile, the fd stays open until the handler
+    void asyncWriteFile(const bcos::bytes& _header, int _fd, uint64_t _offset, std::size_t _size,
+        RWHandler _handler)
+    {
+        if (m_keepaliveWriting)
+        {
+            auto self = this->shared_from_this();
+            m_pendingWrite = [self, &_header, _fd, _offset, _size, _handler]() {
+                self->asyncWriteFile(_header, _fd, _offset, _size, _handler);
+            };
+            return;
+        }
+
+        uint32_t length =
+            boost::asio::detail::socket_ops::host_to_network_long(_header.size() + _size);
+        std::memcpy(m_writeHeader.data(), &length, TCP_FRAME_HEADER_SIZE);
+
+        std::array<boost::asio::const_buffer, 2> buffers = {
+            boost::asio::buffer(m_writeHeader), boost::asio::buffer(_header)};
+        auto headerSize = _header.size();
+        m_writing = true;
+        auto self = this->shared_from_this();
+        boost::asio::async_write(*m_stream, buffers,
+            [self, _fd, _offset, _size, headerSize, _handler](
+                boost::system::error_code _ec, std::size_t) {
+                if (_ec)
+                {
+                    self->onWriteFinished();
+                    return _handler(_ec, 0);
+                }
+                WsTools::asyncSendFile(self->lowestLayer().socket(), _fd, _offset, _size,
+                    [self, headerSize, _handler](boost::system::error_code _ec, std::size_t _sent) {
+                        self->onWriteFinished();
+                        _handler(_ec, _ec ? 0 : headerSize + _sent);
+                    });
+            });
+    }
+
+    // read one whole frame into _buffer, the keepalive frames are skipped
+    void asyncRead(boost::beast::flat_buffer& _buffer, RWHandler _handler)
+    {
+        if (!m_idleTimer && m_idleTimeout > 0)
+        {
+            startIdleTimer();
+        }
+
+        auto self = this->shared_from_this();
+        boost::asio::async_read(*m_stream, boost::asio::buffer(m_readHeader),
+            [self, &_buffer, _handler](boost::system::error_code _ec, std::size_t) {
+                if (_ec)
+                {
+                    return _handler(_ec, 0);
+                }
+                self->onReadHeader(_buffer, _handler);
+            });
+    }
+
+    // client side: select the tcp frame transport on the server
+    void asyncHandshake(const std::string&, const std::string&, HandshakeHandler _handler)
+    {
+        boost::asio::async_write(*m_stream, boost::asio::buffer(TCP_FRAME_PREAMBLE),
+            [_handler](boost::system::error_code _ec, std::size_t) { _handler(_ec); });
+    }
+
+    // server side: the preamble has been consumed by the http session, nothing to negotiate
+    void asyncAccept(bcos::boostssl::http::HttpRequest, HandshakeHandler _handler)
+    {
+        boost::asio::post(m_stream->get_executor(),
+            [_handler]() { _handler(make_error_code(boost::system::errc::success)); });
+    }
+
+    virtual std::string localEndpoint()
+    {
+        try
+        {
+            return WsTools::localEndPoint(lowestLayer().socket());
+        }
+        catch (const std::exception& e)
+        {
+            WEBSOCKET_TCP_FRAME_STREAM(WARNING)
+                << LOG_BADGE("localEndpoint") << LOG_KV("e", e.what());
+        }
+
+        return std::string("");
+    }
+
+    virtual std::string remoteEndpoint()
+    {
+        try
+        {
+            return WsTools::remoteEndPoint(lowestLayer().socket());
+        }
+        catch (const std::exception& e)
+        {
+            WEBSOCKET_TCP_FRAME_STREAM(WARNING)
+                << LOG_BADGE("remoteEndpoint") << LOG_KV("e", e.what());
+        }
+
+        return std::string("");
+    }
+
+private:
+    // the header of a frame has been read, read its body or skip the keepalive
+    void onReadHeader(boost::beast::flat_buffer& _buffer, RWHandler _handler)
+    {
+        m_lastRead = std::chrono::steady_clock::now();
+        uint32_t length = 0;
+        std::memcpy(&length, m_readHeader.data(), TCP_FRAME_HEADER_SIZE);
+        length = boost::asio::detail::socket_ops::network_to_host_long(length);
+        if (length == TCP_FRAME_KEEPALIVE_LENGTH)
+        {
+            return asyncRead(_buffer, _handler);
+        }
+        if (length > m_maxReadMsgSize)
+        {
+            WEBSOCKET_TCP_FRAME_STREAM(WARNING)
+                << LOG_BADGE("asyncRead") << LOG_DESC("frame size overflow")
+                << LOG_KV("length", length) << LOG_KV("maxReadMsgSize", m_maxReadMsgSize);
+            return _handler(boost::asio::error::message_size, 0);
+        }
+
+        // every part of a large frame counts as read activity, the completion condition only
+        // runs while the read below holds self
+        auto transferAll = [this](boost::system::error_code _ec, std::size_t _size) {
+            m_lastRead = std::chrono::steady_clock::now();
+            return boost::asio::transfer_all()(_ec, _size);
+        };
+        auto self = this->shared_from_this();
+        boost::asio::async_read(*m_stream, _buffer.prepare(length), transferAll,
+            [self, &_buffer, _handler](boost::system::error_code _ec, std::size_t _size) {
+                if (!_ec)
+                {
+                    _buffer.commit(_size);
+                }
+                _handler(_ec, _size);
+            });
+    }
+
+    void onWriteFinished()
+    {
+        m_writing = false;
+        m_lastWrite = std::chrono::steady_clock::now();
+    }
+
+    // Note: on the io thread of the stream, the same as the reads and the writes
+    void startIdleTimer()
+    {
+        auto now = std::chrono::steady_clock::now();
+        m_lastRead = now;
+        m_lastWrite = now;
+        m_idleTimer = std::make_shared<boost::asio::steady_timer>(m_stream->get_executor());
+        waitIdleTimer();
+    }
+
+    void waitIdleTimer()
+    {
+        // a third of the idle timeout, the keepalive reaches the peer before it times out
+        m_idleTimer->expires_after(std::chrono::milliseconds(m_idleTimeout / 3 + 1));
+        auto self = std::weak_ptr<TcpFrameStream>(this->shared_from_this());
+        m_idleTimer->async_wait([self](boost::system::error_code _ec) {
+            auto stream = self.lock();
+            if (_ec || !stream || stream->m_closed.load())
+            {
+                return;
+            }
+            stream->onIdleTimer();
+        });
+    }
+
+    void onIdleTimer()
+    {
+        auto now = std::chrono::steady_clock::now();
+        auto idle = std::chrono::milliseconds(m_idleTimeout);
+        if (now - m_lastRead >= idle)
+        {
+            WEBSOCKET_TCP_FRAME_STREAM(WARNING)
+                << LOG_BADGE("onIdleTimer") << LOG_DESC("nothing read in the idle timeout")
+                << LOG_KV("idleTimeout", m_idleTimeout) << LOG_KV("this", this);
+            return close();
+        }
+
+        if (!m_writing && now - m_lastWrite >= idle / 3)
+        {
+            writeKeepalive();
+        }
+        waitIdleTimer();
+    }
+
+    // the write of the session that comes meanwhile waits for the keepalive
+    void writeKeepalive()
+    {
+        m_writing = true;
+        m_keepaliveWriting = true;
+        auto self = this->shared_from_this();
+        boost::asio::async_write(*m_stream, boost::asio::buffer(TCP_FRAME_KEEPALIVE),
+            [self](boost::system::error_code, std::size_t) {
+                self->onWriteFinished();
+                self->m_keepaliveWriting = false;
+                if (self->m_pendingWrite)
+                {
+                    auto pendingWrite = std::move(self->m_pendingWrite);
+                    self->m_pendingWrite = nullptr;
+                    pendingWrite();
+                }
+            });
+    }
+
+private:
+    std::atomic<bool> m_closed{false};
+    std::shared_ptr<STREAM> m_stream;
+    uint32_t m_maxReadMsgSize{TCP_FRAME_KEEPALIVE_LENGTH - 1};
+    uint32_t m_idleTimeout{TCP_FRAME_IDLE_TIMEOUT_MS};
+    std::shared_ptr<boost::asio::steady_timer> m_idleTimer;
+    std::chrono::steady_clock::time_point m_lastRead;
+    std::chrono::steady_clock::time_point m_lastWrite;
+    // a session write or a keepalive is in flight
+    bool m_writing{false};
+    bool m_keepaliveWriting{false};
+    std::function<void()> m_pendingWrite;
+    std::array<uint8_t, TCP_FRAME_HEADER_SIZE> m_readHeader;
+    std::array<uint8_t, TCP_FRAME_HEADER_SIZE> m_writeHeader;
+    std::string m_moduleName = "DEFAULT";
+};
+
+using RawTcpFrameStream = TcpFrameStream<boost::beast::tcp_stream>;
+using SslTcpFrameStream = TcpFrameStream<boost::beast::ssl_stream<boost::beast::tcp_stream>>;
+using UnixTcpFrameStream = TcpFrameStream<UnixStream>;
+
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
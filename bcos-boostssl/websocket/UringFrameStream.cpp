@@ -0,0 +1,1079 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file UringFrameStream.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#include <bcos-boostssl/websocket/UringFrameStream.h>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/execution/context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/query.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#ifdef BOOSTSSL_HAS_IO_URING
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+boost::asio::io_context::id IoUringService::id;
+
+#ifdef BOOSTSSL_HAS_IO_URING
+namespace
+{
+// there is no liburing in the dependencies, the three syscalls are all it wraps for us
+int ioUringSetup(unsigned _entries, io_uring_params* _params)
+{
+    return (int)::syscall(__NR_io_uring_setup, _entries, _params);
+}
+
+int ioUringEnter(int _fd, unsigned _toSubmit)
+{
+    return (int)::syscall(__NR_io_uring_enter, _fd, _toSubmit, 0, 0, nullptr, 0);
+}
+
+int ioUringRegister(int _fd, unsigned _opcode, const void* _arg, unsigned _nrArgs)
+{
+    return (int)::syscall(__NR_io_uring_register, _fd, _opcode, _arg, _nrArgs);
+}
+}  // namespace
+#endif
+
+int UringFixedBuffers::acquire()
+{
+    std::lock_guard<std::mutex> l(x_buffers);
+    if (m_free.empty())
+    {
+        return -1;
+    }
+    auto index = m_free.back();
+    m_free.pop_back();
+    return index;
+}
+
+void UringFixedBuffers::release(int _index)
+{
+    std::lock_guard<std::mutex> l(x_buffers);
+    if (m_shutdown)
+    {
+        return;
+    }
+    m_free.push_back(_index);
+}
+
+void UringFixedBuffers::init(std::size_t _count)
+{
+    std::vector<uint8_t>(URING_FIXED_BUFFER_SIZE * _count).swap(m_buffers);
+}
+
+void UringFixedBuffers::setRegistered(std::size_t _count)
+{
+    std::lock_guard<std::mutex> l(x_buffers);
+    for (int i = (int)_count - 1; i >= 0; --i)
+    {
+        m_free.push_back(i);
+    }
+}
+
+void UringFixedBuffers::shutdown()
+{
+    std::lock_guard<std::mutex> l(x_buffers);
+    m_shutdown = true;
+    m_free.clear();
+}
+
+IoUringService::IoUringService(boost::asio::io_context& _ioc)
+  : boost::asio::io_context::service(_ioc),
+    m_ioc(_ioc),
+    m_eventfd(_ioc),
+    m_fixedBuffers(std::make_shared<UringFixedBuffers>())
+{
+    if (!setup())
+    {
+        release();
+    }
+}
+
+IoUringService::~IoUringService()
+{
+    release();
+}
+
+bool IoUringService::supported()
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    static const bool s_supported = []() {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        int fd = ioUringSetup(4, &params);
+        if (fd < 0)
+        {
+            WEBSOCKET_IO_URING(INFO) << LOG_BADGE("supported")
+                                     << LOG_DESC("io_uring_setup failed") << LOG_KV("errno", errno);
+            return false;
+        }
+
+        // the probe of the supported operations is there since linux 5.6
+        std::vector<uint8_t> buffer(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op), 0);
+        auto probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+        bool ok = ioUringRegister(fd, IORING_REGISTER_PROBE, probe, 256) == 0;
+        for (auto op : {IORING_OP_READ_FIXED, IORING_OP_RECV, IORING_OP_SENDMSG,
+                 IORING_OP_POLL_ADD, IORING_OP_ASYNC_CANCEL})
+        {
+            ok = ok && op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+        }
+        ::close(fd);
+
+        WEBSOCKET_IO_URING(INFO) << LOG_BADGE("supported") << LOG_KV("supported", ok);
+        return ok;
+    }();
+    return s_supported;
+#else
+    return false;
+#endif
+}
+
+bool IoUringService::setup()
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    m_ringFd = ioUringSetup(URING_ENTRIES, &params);
+    if (m_ringFd < 0)
+    {
+        WEBSOCKET_IO_URING(WARNING) << LOG_BADGE("setup") << LOG_DESC("io_uring_setup failed")
+                                    << LOG_KV("errno", errno);
+        return false;
+    }
+
+    m_sqEntries = params.sq_entries;
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap)
+    {
+        m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+    }
+
+    auto sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        m_ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED)
+    {
+        WEBSOCKET_IO_URING(WARNING) << LOG_BADGE("setup") << LOG_DESC("mmap sq ring failed")
+                                    << LOG_KV("errno", errno);
+        return false;
+    }
+    m_sqRing = sqRing;
+
+    auto cqRing = singleMmap ? sqRing :
+                               ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_CQ_RING);
+    if (cqRing == MAP_FAILED)
+    {
+        WEBSOCKET_IO_URING(WARNING) << LOG_BADGE("setup") << LOG_DESC("mmap cq ring failed")
+                                    << LOG_KV("errno", errno);
+        return false;
+    }
+    m_cqRing = cqRing;
+
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    auto sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        m_ringFd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        WEBSOCKET_IO_URING(WARNING) << LOG_BADGE("setup") << LOG_DESC("mmap sqes failed")
+                                    << LOG_KV("errno", errno);
+        return false;
+    }
+    m_sqes = reinterpret_cast<io_uring_sqe*>(sqes);
+
+    auto sq = reinterpret_cast<uint8_t*>(m_sqRing);
+    m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    m_sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    m_sqLocalTail = m_sqSubmitted = *m_sqTail;
+
+    auto cq = reinterpret_cast<uint8_t*>(m_cqRing);
+    m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    m_cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    m_cqes = cq + params.cq_off.cqes;
+
+    int eventfd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventfd < 0 || ioUringRegister(m_ringFd, IORING_REGISTER_EVENTFD, &eventfd, 1) != 0)
+    {
+        WEBSOCKET_IO_URING(WARNING) << LOG_BADGE("setup") << LOG_DESC("register eventfd failed")
+                                    << LOG_KV("errno", errno);
+        if (eventfd >= 0)
+        {
+            ::close(eventfd);
+        }
+        return false;
+    }
+    boost::system::error_code ec;
+    m_eventfd.assign(eventfd, ec);
+    if (ec)
+    {
+        ::close(eventfd);
+        return false;
+    }
+
+    // the registered buffers are pinned and count against RLIMIT_MEMLOCK on older kernels, read
+    // into the buffers of the streams instead if they can not be registered
+    std::vector<struct iovec> iovs(URING_FIXED_BUFFER_COUNT);
+    m_fixedBuffers->init(URING_FIXED_BUFFER_COUNT);
+    for (std::size_t i = 0; i < URING_FIXED_BUFFER_COUNT; ++i)
+    {
+        iovs[i].iov_base = m_fixedBuffers->data(i);
+        iovs[i].iov_len = URING_FIXED_BUFFER_SIZE;
+    }
+    bool registered =
+        ioUringRegister(m_ringFd, IORING_REGISTER_BUFFERS, iovs.data(), iovs.size()) == 0;
+    if (registered)
+    {
+        m_fixedBuffers->setRegistered(URING_FIXED_BUFFER_COUNT);
+    }
+    else
+    {
+        WEBSOCKET_IO_URING(WARNING) << LOG_BADGE("setup") << LOG_DESC("register buffers failed")
+                                    << LOG_KV("errno", errno);
+        m_fixedBuffers->init(0);
+    }
+
+    WEBSOCKET_IO_URING(INFO) << LOG_BADGE("setup") << LOG_KV("sqEntries", params.sq_entries)
+                             << LOG_KV("cqEntries", params.cq_entries)
+                             << LOG_KV("fixedBuffers", registered ? URING_FIXED_BUFFER_COUNT : 0);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void IoUringService::release()
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    boost::system::error_code ec;
+    m_eventfd.close(ec);
+    // closing the ring cancels the operations still in the kernel
+    if (m_sqes)
+    {
+        ::munmap(m_sqes, m_sqesSize);
+    }
+    if (m_cqRing && m_cqRing != m_sqRing)
+    {
+        ::munmap(m_cqRing, m_cqRingSize);
+    }
+    if (m_sqRing)
+    {
+        ::munmap(m_sqRing, m_sqRingSize);
+    }
+    if (m_ringFd >= 0)
+    {
+        ::close(m_ringFd);
+    }
+#endif
+    m_sqes = nullptr;
+    m_cqRing = nullptr;
+    m_sqRing = nullptr;
+    m_ringFd = -1;
+}
+
+void IoUringService::shutdown()
+{
+    // the ring goes first, no completion can land in the buffers of the handlers released below
+    release();
+    m_fixedBuffers->shutdown();
+    std::unordered_map<uint64_t, CompletionHandler> handlers;
+    handlers.swap(m_handlers);
+    m_backlog.clear();
+}
+
+io_uring_sqe* IoUringService::getSqe()
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    auto head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    if (m_sqLocalTail - head >= m_sqEntries)
+    {
+        return nullptr;
+    }
+    auto index = m_sqLocalTail & *m_sqMask;
+    m_sqArray[index] = index;
+    ++m_sqLocalTail;
+    auto sqe = &m_sqes[index];
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    return sqe;
+#else
+    return nullptr;
+#endif
+}
+
+uint64_t IoUringService::submit(PrepareHandler _prepare, CompletionHandler _handler)
+{
+    auto id = m_nextId.fetch_add(1);
+    // the ring belongs to the io thread, the streams are driven from it except for the rare call
+    // from another thread
+    if (!m_ioc.get_executor().running_in_this_thread())
+    {
+        boost::asio::post(m_ioc,
+            [this, id, _prepare, _handler]() { doSubmit(id, _prepare, _handler); });
+        return id;
+    }
+    doSubmit(id, std::move(_prepare), std::move(_handler));
+    return id;
+}
+
+void IoUringService::cancel(uint64_t _id)
+{
+    if (!m_ioc.get_executor().running_in_this_thread())
+    {
+        boost::asio::post(m_ioc, [this, _id]() { cancel(_id); });
+        return;
+    }
+
+    // not in the kernel yet, it never will be
+    auto it = std::find_if(m_backlog.begin(), m_backlog.end(),
+        [_id](const PendingOp& _op) { return _op.id == _id; });
+    if (it != m_backlog.end())
+    {
+        auto handler = std::move(it->handler);
+        m_backlog.erase(it);
+        boost::asio::post(m_ioc, [handler]() { handler(-ECANCELED); });
+        return;
+    }
+    if (m_handlers.count(_id) == 0)
+    {
+        return;
+    }
+
+#ifdef BOOSTSSL_HAS_IO_URING
+    // the cancel itself completes with its own result, the operation with -ECANCELED if it was
+    // still waiting, or with whatever it got if it was done first
+    doSubmit(
+        m_nextId.fetch_add(1),
+        [_id](io_uring_sqe& _sqe) {
+            _sqe.opcode = IORING_OP_ASYNC_CANCEL;
+            _sqe.fd = -1;
+            _sqe.addr = _id;
+        },
+        [](int) {});
+#endif
+}
+
+void IoUringService::doSubmit(uint64_t _id, PrepareHandler _prepare, CompletionHandler _handler)
+{
+    if (!ready())
+    {
+        boost::asio::post(m_ioc, [_handler]() { _handler(-ECANCELED); });
+        return;
+    }
+
+    auto sqe = getSqe();
+    if (!sqe)
+    {
+        flush();
+        sqe = getSqe();
+    }
+    if (!sqe)
+    {
+        m_backlog.push_back(PendingOp{_id, std::move(_prepare), std::move(_handler)});
+        return;
+    }
+
+#ifdef BOOSTSSL_HAS_IO_URING
+    _prepare(*sqe);
+    sqe->user_data = _id;
+    m_handlers.emplace(_id, std::move(_handler));
+#endif
+    scheduleFlush();
+}
+
+void IoUringService::scheduleFlush()
+{
+    if (m_flushScheduled)
+    {
+        return;
+    }
+    m_flushScheduled = true;
+    // queued behind the handlers ready in this turn, their sqes go in with the same syscall
+    boost::asio::post(m_ioc, [this]() {
+        m_flushScheduled = false;
+        flush();
+    });
+}
+
+void IoUringService::flush()
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    if (!ready())
+    {
+        return;
+    }
+
+    auto toSubmit = m_sqLocalTail - m_sqSubmitted;
+    if (toSubmit > 0)
+    {
+        __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+        auto r = ioUringEnter(m_ringFd, toSubmit);
+        if (r >= 0)
+        {
+            m_sqSubmitted += r;
+        }
+        else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        {
+            WEBSOCKET_IO_URING(WARNING) << LOG_BADGE("flush") << LOG_DESC("io_uring_enter failed")
+                                        << LOG_KV("toSubmit", toSubmit) << LOG_KV("errno", errno);
+        }
+        if (m_sqSubmitted != m_sqLocalTail)
+        {
+            scheduleFlush();
+        }
+    }
+
+    // the room freed in the submission queue goes to the backlog first
+    while (!m_backlog.empty())
+    {
+        auto sqe = getSqe();
+        if (!sqe)
+        {
+            break;
+        }
+        auto op = std::move(m_backlog.front());
+        m_backlog.pop_front();
+        op.prepare(*sqe);
+        sqe->user_data = op.id;
+        m_handlers.emplace(op.id, std::move(op.handler));
+        scheduleFlush();
+    }
+
+    // the completions already there cost no syscall to reap, flush runs inside doSubmit too so
+    // their handlers are posted instead of re-entering the stream that submits
+    reap(true);
+    if (!m_handlers.empty())
+    {
+        waitCompletion();
+    }
+#endif
+}
+
+void IoUringService::reap(bool _defer)
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    if (!ready())
+    {
+        return;
+    }
+
+    std::vector<std::pair<CompletionHandler, int>> completions;
+    auto head = *m_cqHead;
+    auto tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+    auto cqes = reinterpret_cast<io_uring_cqe*>(m_cqes);
+    while (head != tail)
+    {
+        auto& cqe = cqes[head & *m_cqMask];
+        auto it = m_handlers.find(cqe.user_data);
+        if (it != m_handlers.end())
+        {
+            completions.emplace_back(std::move(it->second), cqe.res);
+            m_handlers.erase(it);
+        }
+        ++head;
+    }
+    __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+
+    if (_defer && !completions.empty())
+    {
+        boost::asio::post(m_ioc, [completions = std::move(completions)]() {
+            for (auto& completion : completions)
+            {
+                completion.first(completion.second);
+            }
+        });
+        return;
+    }
+    for (auto& completion : completions)
+    {
+        completion.first(completion.second);
+    }
+#endif
+}
+
+void IoUringService::waitCompletion()
+{
+    if (m_waiting || !m_eventfd.is_open())
+    {
+        return;
+    }
+    m_waiting = true;
+
+    // nothing is waited for without operations in the kernel, the io_context may run out of work
+    m_eventfd.async_wait(
+        boost::asio::posix::stream_descriptor::wait_read, [this](boost::system::error_code _ec) {
+            m_waiting = false;
+            if (_ec)
+            {
+                return;
+            }
+#ifdef BOOSTSSL_HAS_IO_URING
+            eventfd_t value;
+            ::eventfd_read(m_eventfd.native_handle(), &value);
+#endif
+            reap(false);
+            if (!m_handlers.empty())
+            {
+                waitCompletion();
+            }
+        });
+}
+
+static boost::asio::io_context& ioContextOf(boost::beast::tcp_stream& _stream)
+{
+    return static_cast<boost::asio::io_context&>(
+        boost::asio::query(_stream.get_executor(), boost::asio::execution::context));
+}
+
+UringFrameStream::UringFrameStream(
+    std::shared_ptr<boost::beast::tcp_stream> _stream, std::string _moduleName)
+  : m_stream(_stream),
+    m_service(boost::asio::use_service<IoUringService>(ioContextOf(*_stream))),
+    m_fixedBuffers(m_service.fixedBuffers()),
+    m_fd(_stream->socket().native_handle()),
+    m_moduleName(_moduleName)
+{
+    // no websocket ping/pong on this transport, the keepalive frames and the idle timeout
+    // detect the dead peer, the kernel keepalive is left as a backstop
+    boost::system::error_code ec;
+    m_stream->socket().set_option(boost::asio::socket_base::keep_alive(true), ec);
+    WEBSOCKET_URING_STREAM(INFO) << LOG_KV("[NEWOBJ][UringFrameStream]", this);
+}
+
+UringFrameStream::~UringFrameStream()
+{
+    WEBSOCKET_URING_STREAM(INFO) << LOG_KV("[DELOBJ][UringFrameStream]", this);
+    close();
+    if (m_fixedIndex >= 0)
+    {
+        // the io_context and its service may be gone already, the pool is not
+        m_fixedBuffers->release(m_fixedIndex);
+    }
+}
+
+void UringFrameStream::close()
+{
+    bool trueValue = true;
+    bool falseValue = false;
+    if (!m_closed.compare_exchange_strong(falseValue, trueValue))
+    {
+        return;
+    }
+    WEBSOCKET_URING_STREAM(INFO) << LOG_DESC("the real action to close the stream")
+                                 << LOG_KV("this", this);
+
+    // the shutdown completes the recv and the send in the kernel, the fd itself stays open until
+    // their completions are reaped
+    boost::system::error_code ec;
+    m_stream->socket().shutdown(boost::asio::socket_base::shutdown_both, ec);
+    auto self = weak_from_this().lock();
+    if (!self)
+    {
+        // called by the destructor, every sqe holds the stream so none is left
+        ws::WsTools::close(m_stream->socket());
+        return;
+    }
+    boost::asio::dispatch(m_stream->get_executor(), [self]() {
+        if (self->m_idleTimer)
+        {
+            self->m_idleTimer->cancel();
+        }
+        for (auto op : {self->m_readOp, self->m_writeOp})
+        {
+            if (op != 0)
+            {
+                self->m_service.cancel(op);
+            }
+        }
+        self->closeIfIdle();
+    });
+}
+
+void UringFrameStream::closeIfIdle()
+{
+    if (m_closed.load() && m_readOp == 0 && m_writeOp == 0 && m_stream->socket().is_open())
+    {
+        ws::WsTools::close(m_stream->socket());
+    }
+}
+
+void UringFrameStream::prepareSocket()
+{
+    if (m_prepared)
+    {
+        return;
+    }
+    m_prepared = true;
+    // the socket stays non-blocking, an operation that would block hands back EAGAIN and waits
+    // for the readiness with a poll sqe instead of sleeping in a kernel worker
+    boost::system::error_code ec;
+    m_stream->socket().native_non_blocking(true, ec);
+    if (ec)
+    {
+        WEBSOCKET_URING_STREAM(WARNING)
+            << LOG_BADGE("prepareSocket") << LOG_DESC("set non-blocking failed")
+            << LOG_KV("error", ec.message());
+    }
+}
+
+void UringFrameStream::asyncWrite(const bcos::bytes& _buffer, RWHandler _handler)
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    if (m_closed.load())
+    {
+        boost::asio::post(m_stream->get_executor(),
+            [_handler]() { _handler(boost::asio::error::operation_aborted, 0); });
+        return;
+    }
+    if (m_keepaliveWriting)
+    {
+        m_pendingWrite = [this, &_buffer, _handler]() { asyncWrite(_buffer, _handler); };
+        return;
+    }
+    prepareSocket();
+    writeFrame(_buffer.size(), _buffer.data(), _buffer.size(), std::move(_handler));
+#else
+    boost::ignore_unused(_buffer);
+    boost::asio::post(m_stream->get_executor(),
+        [_handler]() { _handler(boost::asio::error::operation_not_supported, 0); });
+#endif
+}
+
+void UringFrameStream::writeFrame(
+    uint32_t _length, const uint8_t* _data, std::size_t _size, RWHandler _handler)
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    uint32_t length = boost::asio::detail::socket_ops::host_to_network_long(_length);
+    std::memcpy(m_writeHeader.data(), &length, TCP_FRAME_HEADER_SIZE);
+    m_writeIov[0].iov_base = m_writeHeader.data();
+    m_writeIov[0].iov_len = TCP_FRAME_HEADER_SIZE;
+    m_writeIov[1].iov_base = const_cast<uint8_t*>(_data);
+    m_writeIov[1].iov_len = _size;
+    std::memset(&m_writeMsg, 0, sizeof(m_writeMsg));
+    m_writeMsg.msg_iov = m_writeIov.data();
+    m_writeMsg.msg_iovlen = m_writeIov.size();
+    m_writeSize = _size;
+    m_writeHandler = std::move(_handler);
+    submitSend();
+#else
+    boost::ignore_unused(_length, _data, _size, _handler);
+#endif
+}
+
+void UringFrameStream::completeWrite(boost::system::error_code _ec, std::size_t _size)
+{
+    m_lastWrite = std::chrono::steady_clock::now();
+    auto handler = std::move(m_writeHandler);
+    m_writeHandler = nullptr;
+    handler(_ec, _size);
+}
+
+void UringFrameStream::startIdleTimer()
+{
+    auto now = std::chrono::steady_clock::now();
+    m_lastRead = now;
+    m_lastWrite = now;
+    m_idleTimer = std::make_shared<boost::asio::steady_timer>(m_stream->get_executor());
+    waitIdleTimer();
+}
+
+void UringFrameStream::waitIdleTimer()
+{
+    // a third of the idle timeout, the keepalive reaches the peer before it times out
+    m_idleTimer->expires_after(std::chrono::milliseconds(m_idleTimeout / 3 + 1));
+    auto self = std::weak_ptr<UringFrameStream>(shared_from_this());
+    m_idleTimer->async_wait([self](boost::system::error_code _ec) {
+        auto stream = self.lock();
+        if (_ec || !stream || stream->m_closed.load())
+        {
+            return;
+        }
+        stream->onIdleTimer();
+    });
+}
+
+void UringFrameStream::onIdleTimer()
+{
+    auto now = std::chrono::steady_clock::now();
+    auto idle = std::chrono::milliseconds(m_idleTimeout);
+    if (now - m_lastRead >= idle)
+    {
+        WEBSOCKET_URING_STREAM(WARNING)
+            << LOG_BADGE("onIdleTimer") << LOG_DESC("nothing read in the idle timeout")
+            << LOG_KV("idleTimeout", m_idleTimeout) << LOG_KV("this", this);
+        return close();
+    }
+
+    if (!m_writeHandler && now - m_lastWrite >= idle / 3)
+    {
+        writeKeepalive();
+    }
+    waitIdleTimer();
+}
+
+void UringFrameStream::writeKeepalive()
+{
+    // the write of the session that comes meanwhile waits for the keepalive
+    m_keepaliveWriting = true;
+    auto self = shared_from_this();
+    prepareSocket();
+    writeFrame(
+        TCP_FRAME_KEEPALIVE_LENGTH, nullptr, 0, [self](boost::system::error_code, std::size_t) {
+            self->m_keepaliveWriting = false;
+            if (self->m_pendingWrite)
+            {
+                auto pendingWrite = std::move(self->m_pendingWrite);
+                self->m_pendingWrite = nullptr;
+                pendingWrite();
+            }
+        });
+}
+
+void UringFrameStream::submitSend()
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    if (m_closed.load())
+    {
+        return completeWrite(boost::asio::error::operation_aborted, 0);
+    }
+
+    auto self = shared_from_this();
+    auto fd = m_fd;
+    auto msg = &m_writeMsg;
+    m_writeOp = m_service.submit(
+        [fd, msg](io_uring_sqe& _sqe) {
+            _sqe.opcode = IORING_OP_SENDMSG;
+            _sqe.fd = fd;
+            _sqe.addr = reinterpret_cast<uint64_t>(msg);
+            _sqe.len = 1;
+            _sqe.msg_flags = MSG_NOSIGNAL;
+        },
+        [self](int _result) {
+            self->m_writeOp = 0;
+            self->onSend(_result);
+            self->closeIfIdle();
+        });
+#endif
+}
+
+void UringFrameStream::submitPoll(bool _read)
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    auto self = shared_from_this();
+    auto fd = m_fd;
+    auto& op = _read ? m_readOp : m_writeOp;
+    op = m_service.submit(
+        [fd, _read](io_uring_sqe& _sqe) {
+            _sqe.opcode = IORING_OP_POLL_ADD;
+            _sqe.fd = fd;
+            _sqe.poll_events = _read ? POLLIN : POLLOUT;
+        },
+        [self, _read](int _result) {
+            (_read ? self->m_readOp : self->m_writeOp) = 0;
+            self->onPoll(_read, _result);
+            self->closeIfIdle();
+        });
+#else
+    boost::ignore_unused(_read);
+#endif
+}
+
+void UringFrameStream::onPoll(bool _read, int _result)
+{
+    // the poll reports the error and the hang up as ready too, the op that follows gets them
+    if (_result < 0 && _result != -EINTR)
+    {
+        auto ec = boost::system::error_code(-_result, boost::system::system_category());
+        if (_read)
+        {
+            return completeRead(ec, 0);
+        }
+        return completeWrite(ec, 0);
+    }
+    if (_read)
+    {
+        return submitRecv();
+    }
+    submitSend();
+}
+
+void UringFrameStream::onSend(int _result)
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    if ((_result == -EINTR || _result == -EAGAIN) && !m_closed.load())
+    {
+        return submitPoll(false);
+    }
+    if (_result < 0)
+    {
+        return completeWrite(
+            boost::system::error_code(-_result, boost::system::system_category()), 0);
+    }
+
+    // skip what has been sent, a partial send goes on with the rest
+    std::size_t sent = _result;
+    while (m_writeMsg.msg_iovlen > 0 && sent >= m_writeMsg.msg_iov[0].iov_len)
+    {
+        sent -= m_writeMsg.msg_iov[0].iov_len;
+        ++m_writeMsg.msg_iov;
+        --m_writeMsg.msg_iovlen;
+    }
+    if (m_writeMsg.msg_iovlen > 0)
+    {
+        auto& iov = m_writeMsg.msg_iov[0];
+        iov.iov_base = reinterpret_cast<uint8_t*>(iov.iov_base) + sent;
+        iov.iov_len -= sent;
+        return submitSend();
+    }
+
+    completeWrite({}, m_writeSize);
+#else
+    boost::ignore_unused(_result);
+#endif
+}
+
+void UringFrameStream::asyncRead(boost::beast::flat_buffer& _buffer, RWHandler _handler)
+{
+    if (m_closed.load())
+    {
+        boost::asio::post(m_stream->get_executor(),
+            [_handler]() { _handler(boost::asio::error::operation_aborted, 0); });
+        return;
+    }
+    prepareSocket();
+    if (!m_idleTimer && m_idleTimeout > 0)
+    {
+        startIdleTimer();
+    }
+
+    m_readBuffer = &_buffer;
+    m_readHeaderSize = 0;
+    m_readData = nullptr;
+    m_readSize = 0;
+    m_readOffset = 0;
+    m_readHandler = std::move(_handler);
+    pumpRead();
+}
+
+void UringFrameStream::pumpRead()
+{
+    // take the frame out of the bytes received ahead first
+    auto available = m_recvEnd - m_recvBegin;
+    if (m_readHeaderSize < TCP_FRAME_HEADER_SIZE)
+    {
+        auto n = std::min(available, TCP_FRAME_HEADER_SIZE - m_readHeaderSize);
+        if (n > 0)
+        {
+            std::memcpy(m_readHeader.data() + m_readHeaderSize, m_recvData + m_recvBegin, n);
+            m_readHeaderSize += n;
+            m_recvBegin += n;
+            available -= n;
+        }
+        if (m_readHeaderSize < TCP_FRAME_HEADER_SIZE)
+        {
+            return submitRecv();
+        }
+
+        uint32_t length = 0;
+        std::memcpy(&length, m_readHeader.data(), TCP_FRAME_HEADER_SIZE);
+        m_readSize = boost::asio::detail::socket_ops::network_to_host_long(length);
+        if (m_readSize == TCP_FRAME_KEEPALIVE_LENGTH)
+        {
+            // skipped, the frame that follows is read in its place
+            m_readHeaderSize = 0;
+            m_readSize = 0;
+            return pumpRead();
+        }
+        if (m_readSize > m_maxReadMsgSize)
+        {
+            WEBSOCKET_URING_STREAM(WARNING)
+                << LOG_BADGE("asyncRead") << LOG_DESC("frame size overflow")
+                << LOG_KV("length", m_readSize) << LOG_KV("maxReadMsgSize", m_maxReadMsgSize);
+            return completeRead(boost::asio::error::message_size, 0);
+        }
+        m_readData = reinterpret_cast<uint8_t*>(m_readBuffer->prepare(m_readSize).data());
+    }
+
+    auto n = std::min(available, m_readSize - m_readOffset);
+    if (n > 0)
+    {
+        std::memcpy(m_readData + m_readOffset, m_recvData + m_recvBegin, n);
+        m_readOffset += n;
+        m_recvBegin += n;
+    }
+    if (m_readOffset == m_readSize)
+    {
+        m_readBuffer->commit(m_readSize);
+        return completeRead({}, m_readSize);
+    }
+    submitRecv();
+}
+
+void UringFrameStream::submitRecv()
+{
+#ifdef BOOSTSSL_HAS_IO_URING
+    if (m_closed.load())
+    {
+        return completeRead(boost::asio::error::operation_aborted, 0);
+    }
+
+    // the bytes received ahead are all taken whenever more are needed
+    m_recvBegin = m_recvEnd = 0;
+    if (!m_recvData)
+    {
+        m_fixedIndex = m_fixedBuffers->acquire();
+        if (m_fixedIndex >= 0)
+        {
+            m_recvData = m_fixedBuffers->data(m_fixedIndex);
+        }
+        else
+        {
+            m_recvBuffer.resize(URING_FIXED_BUFFER_SIZE);
+            m_recvData = m_recvBuffer.data();
+        }
+    }
+
+    auto remaining = m_readSize - m_readOffset;
+    m_directRecv =
+        m_readHeaderSize == TCP_FRAME_HEADER_SIZE && remaining >= URING_FIXED_BUFFER_SIZE;
+    auto data = m_directRecv ? m_readData + m_readOffset : m_recvData;
+    auto size = m_directRecv ? std::min<std::size_t>(remaining, INT_MAX) : URING_FIXED_BUFFER_SIZE;
+    auto fixedIndex = m_directRecv ? -1 : m_fixedIndex;
+    auto fd = m_fd;
+
+    auto self = shared_from_this();
+    m_readOp = m_service.submit(
+        [fd, data, size, fixedIndex](io_uring_sqe& _sqe) {
+            _sqe.fd = fd;
+            _sqe.addr = reinterpret_cast<uint64_t>(data);
+            _sqe.len = size;
+            if (fixedIndex >= 0)
+            {
+                // the offset stays zero, sockets refuse any other
+                _sqe.opcode = IORING_OP_READ_FIXED;
+                _sqe.buf_index = fixedIndex;
+            }
+            else
+            {
+                _sqe.opcode = IORING_OP_RECV;
+            }
+        },
+        [self](int _result) {
+            self->m_readOp = 0;
+            self->onRecv(_result);
+            self->closeIfIdle();
+        });
+#endif
+}
+
+void UringFrameStream::onRecv(int _result)
+{
+    if ((_result == -EINTR || _result == -EAGAIN) && !m_closed.load())
+    {
+        return submitPoll(true);
+    }
+    if (_result <= 0)
+    {
+        auto ec = _result == 0 ?
+                      boost::system::error_code(boost::asio::error::eof) :
+                      boost::system::error_code(-_result, boost::system::system_category());
+        return completeRead(ec, 0);
+    }
+
+    m_lastRead = std::chrono::steady_clock::now();
+    if (m_directRecv)
+    {
+        m_readOffset += _result;
+    }
+    else
+    {
+        m_recvEnd = _result;
+    }
+    pumpRead();
+}
+
+void UringFrameStream::completeRead(boost::system::error_code _ec, std::size_t _size)
+{
+    auto handler = std::move(m_readHandler);
+    m_readHandler = nullptr;
+    if (!handler)
+    {
+        return;
+    }
+    // the next read is issued by the handler, keep the stack flat when the frame was buffered
+    boost::asio::post(m_stream->get_executor(), [handler, _ec, _size]() { handler(_ec, _size); });
+}
+
+void UringFrameStream::asyncHandshake(
+    const std::string&, const std::string&, HandshakeHandler _handler)
+{
+    boost::asio::async_write(*m_stream, boost::asio::buffer(TCP_FRAME_PREAMBLE),
+        [_handler](boost::system::error_code _ec, std::size_t) { _handler(_ec); });
+}
+
+void UringFrameStream::asyncAccept(bcos::boostssl::http::HttpRequest, HandshakeHandler _handler)
+{
+    boost::asio::post(m_stream->get_executor(),
+        [_handler]() { _handler(make_error_code(boost::system::errc::success)); });
+}
+
+std::string UringFrameStream::localEndpoint()
+{
+    try
+    {
+        return WsTools::localEndPoint(m_stream->socket());
+    }
+    catch (const std::exception& e)
+    {
+        WEBSOCKET_URING_STREAM(WARNING) << LOG_BADGE("localEndpoint") << LOG_KV("e", e.what());
+    }
+
+    return std::string("");
+}
+
+std::string UringFrameStream::remoteEndpoint()
+{
+    try
+    {
+        return WsTools::remoteEndPoint(m_stream->socket());
+    }
+    catch (const std::exception& e)
+    {
+        WEBSOCKET_URING_STREAM(WARNING) << LOG_BADGE("remoteEndpoint") << LOG_KV("e", e.what());
+    }
+
+    return std::string("");
+}
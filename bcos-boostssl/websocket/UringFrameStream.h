@@ -0,0 +1,304 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file UringFrameStream.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <bcos-boostssl/httpserver/Common.h>
+#include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/TcpFrameStream.h>
+#include <bcos-boostssl/websocket/WsTools.h>
+#include <bcos-utilities/Common.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define BOOSTSSL_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+#endif
+#endif
+
+#ifndef BOOSTSSL_HAS_IO_URING
+struct io_uring_sqe;
+#endif
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+// the registered buffers of each ring, one for each stream reading small frames
+static const std::size_t URING_FIXED_BUFFER_SIZE = 32 * 1024;
+static const std::size_t URING_FIXED_BUFFER_COUNT = 64;
+static const uint32_t URING_ENTRIES = 1024;
+
+/**
+ * @brief: the registered buffers of a ring, shared with the streams so that a stream destroyed
+ * after its io_context gives its buffer back to the pool instead of to a freed service
+ */
+class UringFixedBuffers
+{
+public:
+    using Ptr = std::shared_ptr<UringFixedBuffers>;
+
+    // the index of a free registered buffer, -1 if none left or the ring is gone
+    int acquire();
+    // Note: a no-op after shutdown(), nothing is registered any more
+    void release(int _index);
+    uint8_t* data(int _index) { return m_buffers.data() + _index * URING_FIXED_BUFFER_SIZE; }
+
+    // Note: called once by the service before the buffers are registered
+    void init(std::size_t _count);
+    void setRegistered(std::size_t _count);
+    // the ring is closed, the memory stays until the last stream holding a buffer is gone
+    void shutdown();
+
+private:
+    // the streams may give their buffers back from any thread when they are destroyed
+    std::mutex x_buffers;
+    std::vector<uint8_t> m_buffers;
+    std::vector<int> m_free;
+    bool m_shutdown = false;
+};
+
+/**
+ * @brief: the io_uring proactor of one io_context, the sqes queued by the handlers running in the
+ * same turn of the io_context are submitted with one io_uring_enter, and the completions are
+ * reaped when the eventfd registered with the ring turns readable
+ */
+class IoUringService : public boost::asio::io_context::service
+{
+public:
+    using CompletionHandler = std::function<void(int)>;
+    using PrepareHandler = std::function<void(io_uring_sqe&)>;
+
+    static boost::asio::io_context::id id;
+
+    explicit IoUringService(boost::asio::io_context& _ioc);
+    ~IoUringService() override;
+
+    // whether the kernel supports the ring and the operations the streams use, checked once
+    static bool supported();
+
+    bool ready() const { return m_ringFd >= 0; }
+
+    // _prepare fills the sqe, _handler gets the result of the cqe on the io thread, return the id
+    // of the operation to cancel it with
+    uint64_t submit(PrepareHandler _prepare, CompletionHandler _handler);
+    // the operation completes with -ECANCELED unless it is done already, its handler still runs
+    void cancel(uint64_t _id);
+
+    UringFixedBuffers::Ptr fixedBuffers() const { return m_fixedBuffers; }
+
+private:
+    void shutdown() override;
+
+    bool setup();
+    void release();
+    void doSubmit(uint64_t _id, PrepareHandler _prepare, CompletionHandler _handler);
+    void scheduleFlush();
+    void flush();
+    // _defer posts the completion handlers, for the callers that may be inside a handler
+    void reap(bool _defer);
+    void waitCompletion();
+    io_uring_sqe* getSqe();
+
+private:
+    boost::asio::io_context& m_ioc;
+
+    int m_ringFd = -1;
+    void* m_sqRing = nullptr;
+    std::size_t m_sqRingSize = 0;
+    void* m_cqRing = nullptr;
+    std::size_t m_cqRingSize = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    std::size_t m_sqesSize = 0;
+
+    unsigned* m_sqHead = nullptr;
+    unsigned* m_sqTail = nullptr;
+    unsigned* m_sqMask = nullptr;
+    unsigned* m_sqArray = nullptr;
+    unsigned m_sqEntries = 0;
+    // the local tail, published to the kernel on flush
+    unsigned m_sqLocalTail = 0;
+    unsigned m_sqSubmitted = 0;
+
+    unsigned* m_cqHead = nullptr;
+    unsigned* m_cqTail = nullptr;
+    unsigned* m_cqMask = nullptr;
+    void* m_cqes = nullptr;
+
+    // the eventfd the kernel signals on completions
+    boost::asio::posix::stream_descriptor m_eventfd;
+    bool m_waiting = false;
+    bool m_flushScheduled = false;
+
+    std::atomic<uint64_t> m_nextId{1};
+    std::unordered_map<uint64_t, CompletionHandler> m_handlers;
+    // the sqes that did not fit into the full submission queue
+    struct PendingOp
+    {
+        uint64_t id;
+        PrepareHandler prepare;
+        CompletionHandler handler;
+    };
+    std::deque<PendingOp> m_backlog;
+
+    UringFixedBuffers::Ptr m_fixedBuffers;
+};
+
+/**
+ * @brief: the length-prefixed tcp frame transport without ssl driven by io_uring instead of the
+ * epoll reactor, small frames are read through a registered buffer so one completion can carry
+ * many of them, and a frame is written with one sendmsg of the header and the payload
+ */
+class UringFrameStream : public std::enable_shared_from_this<UringFrameStream>
+{
+public:
+    using Ptr = std::shared_ptr<UringFrameStream>;
+    using ConstPtr = std::shared_ptr<const UringFrameStream>;
+    using RWHandler = std::function<void(boost::system::error_code, std::size_t)>;
+    using HandshakeHandler = std::function<void(boost::system::error_code)>;
+
+    UringFrameStream(std::shared_ptr<boost::beast::tcp_stream> _stream, std::string _moduleName);
+    virtual ~UringFrameStream();
+
+public:
+    void setMaxReadMsgSize(uint32_t _maxValue)
+    {
+        m_maxReadMsgSize = std::min(_maxValue, TCP_FRAME_KEEPALIVE_LENGTH - 1);
+    }
+
+    // Note: set it before the first read, 0 disables the keepalive frames and the idle timeout
+    void setIdleTimeout(uint32_t _idleTimeout) { m_idleTimeout = _idleTimeout; }
+    uint32_t idleTimeout() const { return m_idleTimeout; }
+
+    std::string moduleName() { return m_moduleName; }
+    void setModuleName(std::string _moduleName) { m_moduleName = _moduleName; }
+
+public:
+    bool open() { return !m_closed.load() && m_stream->socket().is_open(); }
+    void close();
+
+    boost::beast::tcp_stream& tcpStream() { return *m_stream; }
+    boost::beast::tcp_stream& lowestLayer() { return *m_stream; }
+
+public:
+    // Note: only one write and one read are in flight at a time, the session serializes them
+    void asyncWrite(const bcos::bytes& _buffer, RWHandler _handler);
+    // read one whole frame into _buffer
+    void asyncRead(boost::beast::flat_buffer& _buffer, RWHandler _handler);
+
+    // client side: select the tcp frame transport on the server
+    void asyncHandshake(const std::string&, const std::string&, HandshakeHandler _handler);
+    // server side: the preamble has been consumed by the http session, nothing to negotiate
+    void asyncAccept(bcos::boostssl::http::HttpRequest, HandshakeHandler _handler);
+
+    virtual std::string localEndpoint();
+    virtual std::string remoteEndpoint();
+
+private:
+    void prepareSocket();
+    void writeFrame(
+        uint32_t _length, const uint8_t* _data, std::size_t _size, RWHandler _handler);
+    void completeWrite(boost::system::error_code _ec, std::size_t _size);
+    void startIdleTimer();
+    void waitIdleTimer();
+    void onIdleTimer();
+    void writeKeepalive();
+    void pumpRead();
+    void submitRecv();
+    void onRecv(int _result);
+    void submitSend();
+    void onSend(int _result);
+    // wait for the socket to turn readable or writable after EAGAIN, then submit the op again
+    void submitPoll(bool _read);
+    void onPoll(bool _read, int _result);
+    // close the fd once no sqe refers to it, the number may be reused by another socket
+    void closeIfIdle();
+    void completeRead(boost::system::error_code _ec, std::size_t _size);
+
+private:
+    std::atomic<bool> m_closed{false};
+    std::shared_ptr<boost::beast::tcp_stream> m_stream;
+    // Note: only used on the io thread, while the io_context and so the service are alive
+    IoUringService& m_service;
+    UringFixedBuffers::Ptr m_fixedBuffers;
+    int m_fd = -1;
+    bool m_prepared = false;
+    uint32_t m_maxReadMsgSize{TCP_FRAME_KEEPALIVE_LENGTH - 1};
+
+    // the keepalive frames and the idle timeout, the same as the tcp frame stream
+    uint32_t m_idleTimeout{TCP_FRAME_IDLE_TIMEOUT_MS};
+    std::shared_ptr<boost::asio::steady_timer> m_idleTimer;
+    std::chrono::steady_clock::time_point m_lastRead;
+    std::chrono::steady_clock::time_point m_lastWrite;
+    bool m_keepaliveWriting = false;
+    std::function<void()> m_pendingWrite;
+    // the ids of the read and the write operations in the ring, 0 if none
+    uint64_t m_readOp = 0;
+    uint64_t m_writeOp = 0;
+
+    // the bytes received ahead of the frame being read, in the registered buffer if any
+    int m_fixedIndex = -1;
+    std::vector<uint8_t> m_recvBuffer;
+    uint8_t* m_recvData = nullptr;
+    std::size_t m_recvBegin = 0;
+    std::size_t m_recvEnd = 0;
+    // the payload too large for the buffer is received into the frame directly
+    bool m_directRecv = false;
+
+    // the read in progress
+    RWHandler m_readHandler;
+    boost::beast::flat_buffer* m_readBuffer = nullptr;
+    std::array<uint8_t, TCP_FRAME_HEADER_SIZE> m_readHeader;
+    std::size_t m_readHeaderSize = 0;
+    uint8_t* m_readData = nullptr;
+    std::size_t m_readSize = 0;
+    std::size_t m_readOffset = 0;
+
+    // the write in progress, while its handler is held
+    RWHandler m_writeHandler;
+    std::array<uint8_t, TCP_FRAME_HEADER_SIZE> m_writeHeader;
+    std::size_t m_writeSize = 0;
+#ifdef BOOSTSSL_HAS_IO_URING
+    std::array<struct iovec, 2> m_writeIov;
+    struct msghdr m_writeMsg;
+#endif
+
+    std::string m_moduleName = "DEFAULT";
+};
+
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the payloads sent as a stream of chunks with a window of unacknowledged bytes granted
+ * by the receiver, neither side holds more than the window of a stream in memory
+ * @file WsChunkStream.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <bcos-boostssl/interfaces/MessageFace.h>
+#include <bcos-utilities/Common.h>
+#include <bcos-utilities/Error.h>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+class WsSession;
+
+// the first byte of the payload of a MessageExtFieldFlag::Chunk message, the data follows it
+enum WsChunkFlag : uint8_t
+{
+    // opens the stream, the receiver replies with the window as the first credit or aborts
+    ChunkOpen = 0x01,
+    // the last chunk of the stream, in the final credit the end was consumed
+    ChunkEnd = 0x02,
+    // either side gives up the stream
+    ChunkAbort = 0x04,
+};
+
+// reads up to _size bytes of the payload to _data, returns the bytes read, 0 at the end of the
+// payload, negative to abort the stream
+using WsStreamSource = std::function<int64_t(bcos::byte* _data, std::size_t _size)>;
+// the receiver consumed the whole stream, or the error the stream failed with
+using WsStreamSendCallback = std::function<void(bcos::Error::Ptr)>;
+// consumes the chunks of a stream in order, _end on the last one, called with the error and
+// without the chunk if the stream fails
+using WsStreamChunkHandler =
+    std::function<void(bcos::Error::Ptr _error, bytesConstRef _chunk, bool _end)>;
+// called on the io thread with the open message of a stream, returns the consumer of its chunks,
+// nullptr rejects the stream
+using WsStreamHandler = std::function<WsStreamChunkHandler(
+    std::shared_ptr<boostssl::MessageFace>, std::shared_ptr<WsSession>)>;
+
+class WsChunkStream
+{
+public:
+    // the grant in 4 bytes big endian and the WsChunkFlag byte
+    static constexpr std::size_t CREDIT_LENGTH = 5;
+
+    static std::shared_ptr<bcos::bytes> encodeCredit(
+        std::shared_ptr<bcos::bytes> _buffer, uint32_t _grant, uint8_t _flags)
+    {
+        _buffer->resize(CREDIT_LENGTH);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            (*_buffer)[i] = (bcos::byte)(_grant >> (8 * (3 - i)));
+        }
+        (*_buffer)[4] = _flags;
+        return _buffer;
+    }
+
+    static bool decodeCredit(bytesConstRef _payload, uint32_t& _grant, uint8_t& _flags)
+    {
+        if (_payload.size() != CREDIT_LENGTH)
+        {
+            return false;
+        }
+        _grant = 0;
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            _grant = (_grant << 8) | _payload.data()[i];
+        }
+        _flags = _payload.data()[4];
+        return true;
+    }
+};
+
+struct WsStreamSender
+{
+    using Ptr = std::shared_ptr<WsStreamSender>;
+
+    std::string seq;
+    uint16_t type = 0;
+    WsStreamSource source;
+    WsStreamSendCallback callback;
+
+    std::mutex mutex;
+    // granted by the first credit, 0 until the receiver accepts the stream
+    uint64_t window = 0;
+    // the data bytes sent and not granted back
+    uint64_t outstanding = 0;
+    // a thread pool task is reading the source
+    bool pumping = false;
+    // the end chunk was sent
+    bool ended = false;
+    bool finished = false;
+};
+
+struct WsStreamReceiver
+{
+    using Ptr = std::shared_ptr<WsStreamReceiver>;
+
+    std::string seq;
+    uint16_t type = 0;
+    WsStreamChunkHandler handler;
+
+    std::mutex mutex;
+    // the chunks waiting for the handler
+    std::deque<std::shared_ptr<boostssl::MessageFace>> chunks;
+    uint64_t queuedBytes = 0;
+    // the data bytes consumed and not granted back yet
+    uint64_t consumed = 0;
+    // a thread pool task is running the handler
+    bool draining = false;
+    // the stream failed locally, the handler is called with it instead of the next chunk
+    bcos::Error::Ptr error;
+    bool finished = false;
+};
+
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file WsCompressor.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/WsCompressor.h>
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/beast/zlib/inflate_stream.hpp>
+#include <chrono>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+// the window and the memory level of zlib's defaults
+constexpr int WINDOW_BITS = 15;
+constexpr int MEM_LEVEL = 8;
+
+uint64_t elapsedUs(std::chrono::steady_clock::time_point _start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _start)
+        .count();
+}
+}  // namespace
+
+bool WsCompressor::compress(bytesConstRef _payload, bcos::bytes& _out)
+{
+    if (_payload.size() < m_threshold)
+    {
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    // the streams hold some hundred KB of state, allocated once per thread
+    static thread_local boost::beast::zlib::deflate_stream deflater;
+    deflater.reset(m_level, WINDOW_BITS, MEM_LEVEL, boost::beast::zlib::Strategy::normal);
+
+    _out.resize(SIZE_PREFIX_LENGTH + deflater.upper_bound(_payload.size()));
+    auto size = (uint32_t)_payload.size();
+    for (std::size_t i = 0; i < SIZE_PREFIX_LENGTH; ++i)
+    {
+        _out[i] = (byte)(size >> (8 * (SIZE_PREFIX_LENGTH - 1 - i)));
+    }
+
+    boost::beast::zlib::z_params zs;
+    zs.next_in = _payload.data();
+    zs.avail_in = _payload.size();
+    zs.next_out = _out.data() + SIZE_PREFIX_LENGTH;
+    zs.avail_out = _out.size() - SIZE_PREFIX_LENGTH;
+    boost::beast::error_code ec;
+    deflater.write(zs, boost::beast::zlib::Flush::finish, ec);
+    _out.resize(SIZE_PREFIX_LENGTH + zs.total_out);
+
+    m_compressTime.record(elapsedUs(start));
+    if ((ec && ec != boost::beast::zlib::error::end_of_stream) || _out.size() >= _payload.size())
+    {
+        m_incompressible.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_compressed.fetch_add(1, std::memory_order_relaxed);
+    m_rawBytes.fetch_add(_payload.size(), std::memory_order_relaxed);
+    m_compressedBytes.fetch_add(_out.size(), std::memory_order_relaxed);
+    return true;
+}
+
+bool WsCompressor::decompress(bytesConstRef _payload, bcos::bytes& _out, uint32_t _maxSize)
+{
+    if (_payload.size() < SIZE_PREFIX_LENGTH)
+    {
+        m_decompressErrors.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    uint32_t size = 0;
+    for (std::size_t i = 0; i < SIZE_PREFIX_LENGTH; ++i)
+    {
+        size = (size << 8) | _payload.data()[i];
+    }
+    if (size > _maxSize)
+    {
+        m_decompressErrors.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    static thread_local boost::beast::zlib::inflate_stream inflater;
+    inflater.reset(WINDOW_BITS);
+
+    _out.resize(size);
+    boost::beast::zlib::z_params zs;
+    zs.next_in = _payload.data() + SIZE_PREFIX_LENGTH;
+    zs.avail_in = _payload.size() - SIZE_PREFIX_LENGTH;
+    zs.next_out = _out.data();
+    zs.avail_out = _out.size();
+    boost::beast::error_code ec;
+    inflater.write(zs, boost::beast::zlib::Flush::finish, ec);
+
+    m_decompressTime.record(elapsedUs(start));
+    // the whole stream inflated to exactly the size of the prefix
+    if ((ec && ec != boost::beast::zlib::error::end_of_stream) || zs.total_out != size ||
+        zs.avail_in != 0)
+    {
+        m_decompressErrors.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_decompressed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+WsCompressionSnapshot WsCompressor::metrics() const
+{
+    WsCompressionSnapshot snapshot;
+    snapshot.compressed = m_compressed.load(std::memory_order_relaxed);
+    snapshot.incompressible = m_incompressible.load(std::memory_order_relaxed);
+    snapshot.rawBytes = m_rawBytes.load(std::memory_order_relaxed);
+    snapshot.compressedBytes = m_compressedBytes.load(std::memory_order_relaxed);
+    snapshot.decompressed = m_decompressed.load(std::memory_order_relaxed);
+    snapshot.decompressErrors = m_decompressErrors.load(std::memory_order_relaxed);
+    snapshot.compressTime = m_compressTime.snapshot();
+    snapshot.decompressTime = m_decompressTime.snapshot();
+    return snapshot;
+}
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief per message compression of the payloads, flagged by MessageExtFieldFlag::Compressed
+ * and sent only to the peers that set MessageExtFieldFlag::CompressSupported on their messages
+ * @file WsCompressor.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <bcos-boostssl/websocket/WsMetrics.h>
+#include <bcos-utilities/Common.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+// raw deflate of the payload prefixed with the size of the payload in 4 bytes big endian, the
+// streams are kept per thread and reused
+class WsCompressor
+{
+public:
+    using Ptr = std::shared_ptr<WsCompressor>;
+
+    // the size prefix of the compressed payload
+    static constexpr std::size_t SIZE_PREFIX_LENGTH = 4;
+
+    // compress the payloads of at least _threshold bytes, _level in [1, 9]
+    WsCompressor(uint32_t _threshold, int _level)
+      : m_threshold(_threshold), m_level(_level < 1 ? 1 : (_level > 9 ? 9 : _level))
+    {}
+
+    uint32_t threshold() const { return m_threshold; }
+    int level() const { return m_level; }
+
+    /**
+     * @brief: compress the payload
+     * @param _payload: the payload
+     * @param _out: the compressed payload
+     * @return bool: false if the payload is below the threshold or does not get smaller
+     */
+    bool compress(bytesConstRef _payload, bcos::bytes& _out);
+
+    /**
+     * @brief: decompress the payload
+     * @param _payload: the compressed payload
+     * @param _out: the payload
+     * @param _maxSize: the largest payload accepted
+     * @return bool: false if the payload is corrupted or larger than _maxSize
+     */
+    bool decompress(bytesConstRef _payload, bcos::bytes& _out, uint32_t _maxSize);
+
+    WsCompressionSnapshot metrics() const;
+
+private:
+    uint32_t m_threshold;
+    int m_level;
+
+    std::atomic<uint64_t> m_compressed{0};
+    std::atomic<uint64_t> m_incompressible{0};
+    std::atomic<uint64_t> m_rawBytes{0};
+    std::atomic<uint64_t> m_compressedBytes{0};
+    std::atomic<uint64_t> m_decompressed{0};
+    std::atomic<uint64_t> m_decompressErrors{0};
+    WsLatencyMetrics m_compressTime;
+    WsLatencyMetrics m_decompressTime;
+};
+
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
@@ -23,8 +23,10 @@
 #include <bcos-boostssl/interfaces/NodeInfoDef.h>
 #include <bcos-utilities/BoostLog.h>
 #include <boost/asio/ip/tcp.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #define MIN_HEART_BEAT_PERIOD_MS (10000)
@@ -51,6 +53,14 @@ enum WsModel : uint16_t
     Mixed = Client | Server
 };
 
+// the io backend of the io threads
+enum IOBackend : uint16_t
+{
+    Epoll = 0,
+    // io_uring for the tcp frame transport without ssl, the other transports stay on epoll
+    IoUring = 1
+};
+
 class WsConfig
 {
 public:
@@ -65,6 +75,11 @@ private:
     std::string m_listenIP;
     // the listen port when ws work as server
     uint16_t m_listenPort;
+    // also listen on the unix domain socket when ws work as server, without ssl, the
+    // permissions of the socket file decide who can connect
+    std::string m_unixSocketPath;
+    // the permission bits of the socket file, 0 leaves them to the umask
+    uint32_t m_unixSocketMode = 0;
 
     // whether smSSL or not, default not
     bool m_smSSL = false;
@@ -72,9 +87,46 @@ private:
     // list of connected server nodes when ws work as client
     EndPointsPtr m_connectPeers;
 
+    // the server nodes connected with the length-prefixed tcp frame transport instead of
+    // websocket, only for trusted links
+    EndPointsPtr m_tcpFramePeers;
+    // accept the tcp frame transport when ws work as server
+    bool m_acceptTcpFrame{false};
+
+    // the unix domain socket peers to exchange the messages with through shared memory rings
+    EndPointsPtr m_shmRingPeers;
+    // accept the shared memory rings on the unix domain socket when ws work as server
+    bool m_acceptShmRing{false};
+    // the size of each ring, one for each direction, default 4M
+    uint32_t m_shmRingSize{4 * 1024 * 1024};
+
     // thread pool size
     uint32_t m_threadPoolSize{4};
 
+    // io thread pool size, default hardware_concurrency
+    uint32_t m_ioThreadPoolSize{0};
+
+    // open one SO_REUSEPORT acceptor per io thread when ws work as server
+    bool m_reusePort{false};
+
+    // falls back to epoll if the kernel does not support io_uring
+    IOBackend m_ioBackend{IOBackend::Epoll};
+
+    // cpus the io threads are pinned to, io thread i is pinned to m_ioThreadCpus[i % size]
+    std::vector<uint32_t> m_ioThreadCpus;
+    // cpus the worker threads are pinned to, the workers are grouped by numa node and the
+    // handler work of a session runs on the group of its io thread's numa node
+    std::vector<uint32_t> m_threadPoolCpus;
+
+    // the first m_busyPollThreads io threads spin on their io_context instead of blocking in
+    // epoll, 0 disables the busy poll
+    uint32_t m_busyPollThreads{0};
+    // how long an idle io thread spins before it blocks, also the SO_BUSY_POLL of the sockets
+    uint32_t m_busyPollUs{50};
+    // the share of its cpu an idle spinning io thread may burn, the thread blocks between two
+    // spins long enough to stay within it, 100 spins without blocking
+    uint32_t m_busyPollCpuPercent{50};
+
     // time out for send message
     int32_t m_sendMsgTimeout{DEFAULT_MESSAGE_TIMEOUT_MS};
 
@@ -84,6 +136,47 @@ private:
     // time interval for heartbeat
     uint32_t m_heartbeatPeriod{MIN_HEART_BEAT_PERIOD_MS};
 
+    // serve the metrics in the prometheus text format on GET m_metricsPath when ws work as
+    // server, empty disables it
+    std::string m_metricsPath;
+    // time interval for rendering the metrics page
+    uint32_t m_metricsPeriod{1000};
+    // a message that took longer than this from the write queue to the socket is a slow send,
+    // counted and reported with a warning once in a while
+    uint32_t m_slowSendThreshold{5000};
+
+    // trace the lifecycle of one message in m_traceSampleRate, 0 disables the tracing
+    uint32_t m_traceSampleRate{0};
+    // the trace events kept in memory for the dump
+    uint32_t m_traceBufferSize{8192};
+
+    // recycle the messages and the buffers through the WsPooledMessageFactory when no message
+    // factory is set
+    bool m_messagePool{false};
+
+    // compress the payloads of at least m_compressThreshold bytes sent to the peers that support
+    // it, 0 disables the compression
+    uint32_t m_compressThreshold{0};
+    // the deflate level in [1, 9]
+    int32_t m_compressLevel{1};
+
+    // pack the queued messages into batch frames of up to m_batchMaxBytes for the peers that
+    // support it, 0 disables the batching
+    uint32_t m_batchMaxBytes{0};
+    // how long a message sent to an idle session waits for the next ones, 0 never waits
+    uint32_t m_batchLingerUs{0};
+
+    // split the messages larger than m_fragmentSize into fragment frames for the peers that
+    // support it so the smaller ones are not blocked behind them, 0 disables the fragmentation
+    uint32_t m_fragmentSize{0};
+
+    // the unacknowledged bytes of a stream received, bounds the memory of a stream on both sides,
+    // 0 disables the streams, the peer is not asked so both sides must turn them on, 4MB is a
+    // good start
+    uint32_t m_streamWindow{0};
+    // the data bytes of a chunk of a stream sent, capped by m_maxMsgSize
+    uint32_t m_streamChunkSize{256 * 1024};
+
     bool m_disableSsl{false};
 
     // cert config for boostssl
@@ -107,6 +200,15 @@ public:
     void setListenPort(uint16_t _listenPort) { m_listenPort = _listenPort; }
     uint16_t listenPort() const { return m_listenPort; }
 
+    void setUnixSocketPath(const std::string& _unixSocketPath)
+    {
+        m_unixSocketPath = _unixSocketPath;
+    }
+    const std::string& unixSocketPath() const { return m_unixSocketPath; }
+
+    void setUnixSocketMode(uint32_t _unixSocketMode) { m_unixSocketMode = _unixSocketMode & 0777; }
+    uint32_t unixSocketMode() const { return m_unixSocketMode; }
+
     void setSmSSL(bool _isSmSSL) { m_smSSL = _isSmSSL; }
     bool smSSL() { return m_smSSL; }
 
@@ -136,8 +238,118 @@ public:
     }
     void setThreadPoolSize(uint32_t _threadPoolSize) { m_threadPoolSize = _threadPoolSize; }
 
+    uint32_t ioThreadPoolSize() const
+    {
+        if (m_ioThreadPoolSize)
+        {
+            return m_ioThreadPoolSize;
+        }
+        auto hardwareConcurrency = std::thread::hardware_concurrency();
+        return hardwareConcurrency ? hardwareConcurrency : MIN_THREAD_POOL_SIZE;
+    }
+    void setIOThreadPoolSize(uint32_t _ioThreadPoolSize) { m_ioThreadPoolSize = _ioThreadPoolSize; }
+
+    bool reusePort() const { return m_reusePort; }
+    void setReusePort(bool _reusePort) { m_reusePort = _reusePort; }
+
+    IOBackend ioBackend() const { return m_ioBackend; }
+    void setIOBackend(IOBackend _ioBackend) { m_ioBackend = _ioBackend; }
+
+    const std::vector<uint32_t>& ioThreadCpus() const { return m_ioThreadCpus; }
+    void setIOThreadCpus(std::vector<uint32_t> _ioThreadCpus)
+    {
+        m_ioThreadCpus = std::move(_ioThreadCpus);
+    }
+
+    const std::vector<uint32_t>& threadPoolCpus() const { return m_threadPoolCpus; }
+    void setThreadPoolCpus(std::vector<uint32_t> _threadPoolCpus)
+    {
+        m_threadPoolCpus = std::move(_threadPoolCpus);
+    }
+
+    uint32_t busyPollThreads() const { return m_busyPollThreads; }
+    void setBusyPollThreads(uint32_t _busyPollThreads) { m_busyPollThreads = _busyPollThreads; }
+
+    uint32_t busyPollUs() const { return m_busyPollUs; }
+    void setBusyPollUs(uint32_t _busyPollUs) { m_busyPollUs = _busyPollUs; }
+
+    uint32_t busyPollCpuPercent() const { return m_busyPollCpuPercent; }
+    void setBusyPollCpuPercent(uint32_t _busyPollCpuPercent)
+    {
+        m_busyPollCpuPercent = std::min<uint32_t>(std::max<uint32_t>(_busyPollCpuPercent, 1), 100);
+    }
+
+    const std::string& metricsPath() const { return m_metricsPath; }
+    void setMetricsPath(const std::string& _metricsPath) { m_metricsPath = _metricsPath; }
+
+    uint32_t metricsPeriod() const { return m_metricsPeriod; }
+    void setMetricsPeriod(uint32_t _metricsPeriod) { m_metricsPeriod = _metricsPeriod; }
+
+    uint32_t slowSendThreshold() const { return m_slowSendThreshold; }
+    void setSlowSendThreshold(uint32_t _slowSendThreshold)
+    {
+        m_slowSendThreshold = _slowSendThreshold;
+    }
+
+    uint32_t traceSampleRate() const { return m_traceSampleRate; }
+    void setTraceSampleRate(uint32_t _traceSampleRate) { m_traceSampleRate = _traceSampleRate; }
+
+    uint32_t traceBufferSize() const { return m_traceBufferSize; }
+    void setTraceBufferSize(uint32_t _traceBufferSize) { m_traceBufferSize = _traceBufferSize; }
+
+    bool messagePool() const { return m_messagePool; }
+    void setMessagePool(bool _messagePool) { m_messagePool = _messagePool; }
+
+    uint32_t compressThreshold() const { return m_compressThreshold; }
+    void setCompressThreshold(uint32_t _compressThreshold)
+    {
+        m_compressThreshold = _compressThreshold;
+    }
+
+    int32_t compressLevel() const { return m_compressLevel; }
+    void setCompressLevel(int32_t _compressLevel) { m_compressLevel = _compressLevel; }
+
+    uint32_t batchMaxBytes() const { return m_batchMaxBytes; }
+    void setBatchMaxBytes(uint32_t _batchMaxBytes) { m_batchMaxBytes = _batchMaxBytes; }
+
+    uint32_t batchLingerUs() const { return m_batchLingerUs; }
+    void setBatchLingerUs(uint32_t _batchLingerUs) { m_batchLingerUs = _batchLingerUs; }
+
+    uint32_t fragmentSize() const { return m_fragmentSize; }
+    void setFragmentSize(uint32_t _fragmentSize) { m_fragmentSize = _fragmentSize; }
+
+    uint32_t streamWindow() const { return m_streamWindow; }
+    void setStreamWindow(uint32_t _streamWindow) { m_streamWindow = _streamWindow; }
+
+    uint32_t streamChunkSize() const { return m_streamChunkSize; }
+    void setStreamChunkSize(uint32_t _streamChunkSize) { m_streamChunkSize = _streamChunkSize; }
+
     EndPointsPtr connectPeers() const { return m_connectPeers; }
     void setConnectPeers(EndPointsPtr _connectPeers) { m_connectPeers = _connectPeers; }
+
+    EndPointsPtr tcpFramePeers() const { return m_tcpFramePeers; }
+    void setTcpFramePeers(EndPointsPtr _tcpFramePeers) { m_tcpFramePeers = _tcpFramePeers; }
+    bool isTcpFramePeer(const NodeIPEndpoint& _peer) const
+    {
+        return m_tcpFramePeers && m_tcpFramePeers->count(_peer);
+    }
+
+    bool acceptTcpFrame() const { return m_acceptTcpFrame; }
+    void setAcceptTcpFrame(bool _acceptTcpFrame) { m_acceptTcpFrame = _acceptTcpFrame; }
+
+    EndPointsPtr shmRingPeers() const { return m_shmRingPeers; }
+    void setShmRingPeers(EndPointsPtr _shmRingPeers) { m_shmRingPeers = _shmRingPeers; }
+    bool isShmRingPeer(const NodeIPEndpoint& _peer) const
+    {
+        return _peer.isUnixSocket() && m_shmRingPeers && m_shmRingPeers->count(_peer);
+    }
+
+    bool acceptShmRing() const { return m_acceptShmRing; }
+    void setAcceptShmRing(bool _acceptShmRing) { m_acceptShmRing = _acceptShmRing; }
+
+    uint32_t shmRingSize() const { return m_shmRingSize; }
+    void setShmRingSize(uint32_t _shmRingSize) { m_shmRingSize = _shmRingSize; }
+
     bool disableSsl() const { return m_disableSsl; }
     void setDisableSsl(bool _disableSsl) { m_disableSsl = _disableSsl; }
 
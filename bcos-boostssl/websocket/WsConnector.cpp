@@ -26,6 +26,7 @@
 #include <boost/asio/strand.hpp>
 #include <boost/beast/websocket/stream_base.hpp>
 #include <boost/thread/thread.hpp>
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <utility>
@@ -35,8 +36,27 @@ using namespace bcos::boostssl;
 using namespace bcos::boostssl::ws;
 using namespace bcos::boostssl::context;
 
+namespace
+{
+// the phases of one connection, lap() is the time since the last phase ended
+struct ConnectTrace
+{
+    ConnectTimings timings;
+    std::chrono::steady_clock::time_point phaseStart = std::chrono::steady_clock::now();
+
+    int64_t lap()
+    {
+        auto now = std::chrono::steady_clock::now();
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(now - phaseStart).count();
+        phaseStart = now;
+        return us;
+    }
+};
+}  // namespace
+
 // TODO: how to set timeout for connect to wsServer ???
 void WsConnector::connectToWsServer(const std::string& _host, uint16_t _port, bool _disableSsl,
+    bool _tcpFrame,
     std::function<void(boost::beast::error_code, const std::string& _extErrorMsg,
         std::shared_ptr<WsStreamDelegate>, std::shared_ptr<std::string>)>
         _callback)
@@ -58,11 +78,14 @@ void WsConnector::connectToWsServer(const std::string& _host, uint16_t _port, bo
     auto resolver = m_resolver;
     auto builder = m_builder;
     auto connector = shared_from_this();
+    auto trace = std::make_shared<ConnectTrace>();
 
     // resolve host
     resolver->async_resolve(_host.c_str(), std::to_string(_port).c_str(),
-        [this, _host, _port, _disableSsl, endpoint, ioc, ctx, connector, builder, _callback](
+        [this, _host, _port, _disableSsl, _tcpFrame, endpoint, ioc, ctx, connector, builder,
+            trace, _callback](
             boost::beast::error_code _ec, boost::asio::ip::tcp::resolver::results_type _results) {
+            trace->timings.resolveUs = trace->lap();
             if (_ec)
             {
                 WEBSOCKET_CONNECTOR(WARNING)
@@ -84,9 +107,10 @@ void WsConnector::connectToWsServer(const std::string& _host, uint16_t _port, bo
 
             // async connect
             rawStream->async_connect(_results,
-                [this, _host, _port, _disableSsl, endpoint, ctx, connector, builder, rawStream,
-                    _callback](boost::beast::error_code _ec,
+                [this, _host, _port, _disableSsl, _tcpFrame, endpoint, ctx, connector, builder,
+                    rawStream, trace, _callback](boost::beast::error_code _ec,
                     boost::asio::ip::tcp::resolver::results_type::endpoint_type _ep) mutable {
+                    trace->timings.connectUs = trace->lap();
                     if (_ec)
                     {
                         WEBSOCKET_CONNECTOR(WARNING)
@@ -102,16 +126,26 @@ void WsConnector::connectToWsServer(const std::string& _host, uint16_t _port, bo
                         << LOG_KV("endpoint", endpoint);
 
                     auto wsStreamDelegate =
-                        builder->build(_disableSsl, ctx, rawStream, m_moduleName);
+                        _tcpFrame ?
+                            builder->buildTcpFrame(_disableSsl, ctx, rawStream, m_moduleName) :
+                            builder->build(_disableSsl, ctx, rawStream, m_moduleName);
 
                     std::shared_ptr<std::string> nodeId = std::make_shared<std::string>();
                     wsStreamDelegate->setVerifyCallback(
                         _disableSsl, NodeInfoTools::newVerifyCallback(nodeId));
 
+                    // offer the session of the last connection to the endpoint
+                    auto ssl = wsStreamDelegate->nativeSslHandle();
+                    if (ssl && m_sslSessionCache)
+                    {
+                        m_sslSessionCache->offer(endpoint, ssl);
+                    }
+
                     // start ssl handshake
                     wsStreamDelegate->asyncHandshake([this, wsStreamDelegate, connector, _host,
-                                                         _port, endpoint, _ep, _callback,
+                                                         _port, endpoint, _ep, trace, _callback,
                                                          nodeId](boost::beast::error_code _ec) {
+                        trace->timings.sslHandshakeUs = trace->lap();
                         if (_ec)
                         {
                             WEBSOCKET_CONNECTOR(WARNING)
@@ -123,20 +157,30 @@ void WsConnector::connectToWsServer(const std::string& _host, uint16_t _port, bo
                             return;
                         }
 
-                        WEBSOCKET_CONNECTOR(INFO) << LOG_BADGE("connectToWsServer")
-                                                  << LOG_DESC("ssl async_handshake success")
-                                                  << LOG_KV("host", _host) << LOG_KV("port", _port);
+                        auto ssl = wsStreamDelegate->nativeSslHandle();
+                        if (ssl)
+                        {
+                            trace->timings.sslSessionReused = SSL_session_reused(ssl);
+                            NodeInfoTools::resumedSessionNodeId(ssl, *nodeId);
+                        }
+
+                        WEBSOCKET_CONNECTOR(INFO)
+                            << LOG_BADGE("connectToWsServer")
+                            << LOG_DESC("ssl async_handshake success") << LOG_KV("host", _host)
+                            << LOG_KV("port", _port)
+                            << LOG_KV("sessionReused", trace->timings.sslSessionReused);
 
                         // turn off the timeout on the tcp_stream, because
                         // the websocket stream has its own timeout system.
-                        wsStreamDelegate->tcpStream().expires_never();
+                        wsStreamDelegate->expiresNever();
 
                         std::string tmpHost = _host + ':' + std::to_string(_ep.port());
 
                         // websocket async handshake
                         wsStreamDelegate->asyncWsHandshake(tmpHost, "/",
                             [this, connector, _host, _port, endpoint, _callback, wsStreamDelegate,
-                                nodeId](boost::beast::error_code _ec) mutable {
+                                trace, nodeId](boost::beast::error_code _ec) mutable {
+                                trace->timings.wsHandshakeUs = trace->lap();
                                 if (_ec)
                                 {
                                     WEBSOCKET_CONNECTOR(WARNING)
@@ -153,6 +197,10 @@ void WsConnector::connectToWsServer(const std::string& _host, uint16_t _port, bo
                                     << LOG_BADGE("connectToWsServer")
                                     << LOG_DESC("websocket handshake successfully")
                                     << LOG_KV("host", _host) << LOG_KV("port", _port);
+                                if (m_connectObserver)
+                                {
+                                    m_connectObserver(endpoint, trace->timings);
+                                }
                                 _callback(_ec, "", wsStreamDelegate, nodeId);
                                 connector->erasePendingConns(endpoint);
                             });
@@ -160,3 +208,102 @@ void WsConnector::connectToWsServer(const std::string& _host, uint16_t _port, bo
                 });
         });
 }
+
+void WsConnector::connectToUnixSocket(const std::string& _path, bool _tcpFrame,
+    std::function<void(boost::beast::error_code, const std::string& _extErrorMsg,
+        std::shared_ptr<WsStreamDelegate>, std::shared_ptr<std::string>)>
+        _callback)
+{
+    auto builder = m_builder;
+    std::string moduleName = m_moduleName;
+    connectToUnixSocket(
+        _path,
+        [builder, _tcpFrame, moduleName](std::shared_ptr<UnixStream> _unixStream) {
+            return _tcpFrame ? builder->buildTcpFrame(_unixStream, moduleName) :
+                               builder->build(_unixStream, moduleName);
+        },
+        _callback);
+}
+
+void WsConnector::connectToShmRing(const std::string& _path, uint32_t _ringSize,
+    std::function<void(boost::beast::error_code, const std::string& _extErrorMsg,
+        std::shared_ptr<WsStreamDelegate>, std::shared_ptr<std::string>)>
+        _callback)
+{
+    auto builder = m_builder;
+    std::string moduleName = m_moduleName;
+    connectToUnixSocket(
+        _path,
+        [builder, _ringSize, moduleName](std::shared_ptr<UnixStream> _unixStream) {
+            return builder->buildShmRing(_unixStream, _ringSize, moduleName);
+        },
+        _callback);
+}
+
+void WsConnector::connectToUnixSocket(const std::string& _path,
+    std::function<WsStreamDelegate::Ptr(std::shared_ptr<UnixStream>)> _build,
+    std::function<void(boost::beast::error_code, const std::string& _extErrorMsg,
+        std::shared_ptr<WsStreamDelegate>, std::shared_ptr<std::string>)>
+        _callback)
+{
+    auto ioc = m_ioservicePool->getIOService();
+
+    std::string endpoint = UNIX_SOCKET_PREFIX + _path;
+    // check if last connect opr done
+    if (!insertPendingConns(endpoint))
+    {
+        WEBSOCKET_CONNECTOR(WARNING)
+            << LOG_BADGE("connectToUnixSocket") << LOG_DESC("insertPendingConns")
+            << LOG_KV("endpoint", endpoint);
+        _callback(boost::beast::error_code(boost::asio::error::would_block), "", nullptr, nullptr);
+        return;
+    }
+
+    auto connector = shared_from_this();
+
+    auto unixStream = std::make_shared<UnixStream>(*ioc);
+    unixStream->async_connect(boost::asio::local::stream_protocol::endpoint(_path),
+        [this, _build, endpoint, connector, unixStream, _callback](
+            boost::beast::error_code _ec) mutable {
+            if (_ec)
+            {
+                WEBSOCKET_CONNECTOR(WARNING)
+                    << LOG_BADGE("connectToUnixSocket") << LOG_DESC("async_connect failed")
+                    << LOG_KV("error", _ec.message()) << LOG_KV("endpoint", endpoint);
+                _callback(_ec, "", nullptr, nullptr);
+                connector->erasePendingConns(endpoint);
+                return;
+            }
+
+            WEBSOCKET_CONNECTOR(INFO) << LOG_BADGE("connectToUnixSocket")
+                                      << LOG_DESC("async_connect success")
+                                      << LOG_KV("endpoint", endpoint);
+
+            // the websocket stream has its own timeout system
+            unixStream->expires_never();
+            auto wsStreamDelegate = _build(unixStream);
+
+            // websocket async handshake
+            wsStreamDelegate->asyncWsHandshake("localhost", "/",
+                [this, connector, endpoint, _callback, wsStreamDelegate](
+                    boost::beast::error_code _ec) mutable {
+                    if (_ec)
+                    {
+                        WEBSOCKET_CONNECTOR(WARNING)
+                            << LOG_BADGE("connectToUnixSocket")
+                            << LOG_DESC("websocket async_handshake failed")
+                            << LOG_KV("error", _ec.message()) << LOG_KV("endpoint", endpoint);
+                        _callback(_ec, "", nullptr, nullptr);
+                        connector->erasePendingConns(endpoint);
+                        return;
+                    }
+
+                    WEBSOCKET_CONNECTOR(INFO)
+                        << LOG_BADGE("connectToUnixSocket")
+                        << LOG_DESC("websocket handshake successfully")
+                        << LOG_KV("endpoint", endpoint);
+                    _callback(_ec, "", wsStreamDelegate, std::make_shared<std::string>());
+                    connector->erasePendingConns(endpoint);
+                });
+        });
+}
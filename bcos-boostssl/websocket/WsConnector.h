@@ -18,6 +18,7 @@
  * @date 2021-08-23
  */
 #pragma once
+#include <bcos-boostssl/context/SslSessionCache.h>
 #include <bcos-boostssl/websocket/WsStream.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <bcos-utilities/IOServicePool.h>
@@ -37,6 +38,20 @@ namespace boostssl
 {
 namespace ws
 {
+// the time each phase of a connection to the server took, in microseconds
+struct ConnectTimings
+{
+    int64_t resolveUs = 0;
+    int64_t connectUs = 0;
+    int64_t sslHandshakeUs = 0;
+    // the websocket upgrade, or the preamble of the tcp frame transport
+    int64_t wsHandshakeUs = 0;
+    // the ssl session of the last connection was resumed, no full handshake
+    bool sslSessionReused = false;
+};
+using ConnectObserver =
+    std::function<void(const std::string& _endpoint, const ConnectTimings& _timings)>;
+
 class WsConnector : public std::enable_shared_from_this<WsConnector>
 {
 public:
@@ -52,10 +67,52 @@ public:
      * @param _host: the remote server host, support ipv4, ipv6, domain name
      * @param _port: the remote server port
      * @param _disableSsl: disable ssl
+     * @param _tcpFrame: use the length-prefixed tcp frame transport instead of websocket
      * @param _callback:
      * @return void:
      */
     void connectToWsServer(const std::string& _host, uint16_t _port, bool _disableSsl,
+        bool _tcpFrame,
+        std::function<void(boost::beast::error_code, const std::string& extErrorMsg,
+            std::shared_ptr<WsStreamDelegate>, std::shared_ptr<std::string>)>
+            _callback);
+
+    void connectToWsServer(const std::string& _host, uint16_t _port, bool _disableSsl,
+        std::function<void(boost::beast::error_code, const std::string& extErrorMsg,
+            std::shared_ptr<WsStreamDelegate>, std::shared_ptr<std::string>)>
+            _callback)
+    {
+        connectToWsServer(_host, _port, _disableSsl, false, _callback);
+    }
+
+    /**
+     * @brief: connect to the server on the same host through the unix domain socket, no ssl
+     * @param _path: the unix domain socket path of the server
+     * @param _tcpFrame: use the length-prefixed tcp frame transport instead of websocket
+     * @param _callback:
+     * @return void:
+     */
+    void connectToUnixSocket(const std::string& _path, bool _tcpFrame,
+        std::function<void(boost::beast::error_code, const std::string& extErrorMsg,
+            std::shared_ptr<WsStreamDelegate>, std::shared_ptr<std::string>)>
+            _callback);
+
+    /**
+     * @brief: connect to the server on the same host through the unix domain socket, and
+     *          exchange the messages through the shared memory rings negotiated on it
+     * @param _path: the unix domain socket path of the server
+     * @param _ringSize: the size of each ring
+     * @param _callback:
+     * @return void:
+     */
+    void connectToShmRing(const std::string& _path, uint32_t _ringSize,
+        std::function<void(boost::beast::error_code, const std::string& extErrorMsg,
+            std::shared_ptr<WsStreamDelegate>, std::shared_ptr<std::string>)>
+            _callback);
+
+private:
+    void connectToUnixSocket(const std::string& _path,
+        std::function<WsStreamDelegate::Ptr(std::shared_ptr<UnixStream>)> _build,
         std::function<void(boost::beast::error_code, const std::string& extErrorMsg,
             std::shared_ptr<WsStreamDelegate>, std::shared_ptr<std::string>)>
             _callback);
@@ -92,6 +149,19 @@ public:
     std::string moduleName() { return m_moduleName; }
     void setModuleName(std::string _moduleName) { m_moduleName = _moduleName; }
 
+    // the ssl sessions offered on reconnection, nullptr to always do the full handshake
+    context::SslSessionCache::Ptr sslSessionCache() const { return m_sslSessionCache; }
+    void setSslSessionCache(context::SslSessionCache::Ptr _sslSessionCache)
+    {
+        m_sslSessionCache = std::move(_sslSessionCache);
+    }
+
+    // Note: called on the io thread after every successful connection to the server
+    void setConnectObserver(ConnectObserver _connectObserver)
+    {
+        m_connectObserver = std::move(_connectObserver);
+    }
+
 private:
     std::shared_ptr<WsStreamDelegateBuilder> m_builder;
     std::shared_ptr<boost::asio::ip::tcp::resolver> m_resolver;
@@ -100,6 +170,10 @@ private:
     mutable std::mutex x_pendingConns;
     std::set<std::string> m_pendingConns;
 
+    context::SslSessionCache::Ptr m_sslSessionCache;
+
+    ConnectObserver m_connectObserver;
+
     std::string m_moduleName = "DEFAULT";
     IOServicePool::Ptr m_ioservicePool;
 };
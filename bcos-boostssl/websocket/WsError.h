@@ -40,7 +40,11 @@ enum WsError
     EndPointNotExist = -4010,
     MessageOverflow = -4011,
     UndefinedException = -4012,
-    MessageEncodeError = -4013
+    MessageEncodeError = -4013,
+    StreamAborted = -4014,
+    FileReadError = -4015,
+    RequestCancelled = -4016,
+    RequestDropped = -4017
 };
 
 inline bool notRetryAgain(int _wsError)
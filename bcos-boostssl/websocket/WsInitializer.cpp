@@ -21,10 +21,12 @@
 #include <bcos-boostssl/context/NodeInfoTools.h>
 #include <bcos-boostssl/httpserver/Common.h>
 #include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/UringFrameStream.h>
 #include <bcos-boostssl/websocket/WsConfig.h>
 #include <bcos-boostssl/websocket/WsConnector.h>
 #include <bcos-boostssl/websocket/WsInitializer.h>
 #include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-boostssl/websocket/WsMessagePool.h>
 #include <bcos-boostssl/websocket/WsService.h>
 #include <bcos-boostssl/websocket/WsSession.h>
 #include <bcos-boostssl/websocket/WsTools.h>
@@ -32,8 +34,12 @@
 #include <bcos-utilities/IOServicePool.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <boost/system/detail/error_code.hpp>
+#include <algorithm>
+#include <condition_variable>
 #include <cstddef>
+#include <map>
 #include <memory>
+#include <mutex>
 
 using namespace bcos;
 using namespace bcos::boostssl;
@@ -44,9 +50,13 @@ using namespace bcos::boostssl::http;
 void WsInitializer::initWsService(WsService::Ptr _wsService)
 {
     std::shared_ptr<WsConfig> _config = m_config;
-    std::string m_moduleName = _config->moduleName();
+    m_moduleName = _config->moduleName();
     auto messageFactory = m_messageFactory;
-    if (!messageFactory)
+    if (!messageFactory && _config->messagePool())
+    {
+        messageFactory = std::make_shared<WsPooledMessageFactory>();
+    }
+    else if (!messageFactory)
     {
         messageFactory = std::make_shared<WsMessageFactory>();
     }
@@ -64,7 +74,14 @@ void WsInitializer::initWsService(WsService::Ptr _wsService)
         threadPoolSize = 16;
     }
     auto wsServiceWeakPtr = std::weak_ptr<WsService>(_wsService);
-    auto ioServicePool = std::make_shared<IOServicePool>();
+    auto ioServicePool = std::make_shared<IOServicePool>(_config->ioThreadPoolSize());
+    // the io_contexts are handed out round-robin, take each of them once before anyone else so
+    // that ioServices[i] is the io_context of the io thread i
+    std::vector<std::shared_ptr<boost::asio::io_context>> ioServices;
+    for (uint32_t i = 0; i < _config->ioThreadPoolSize(); ++i)
+    {
+        ioServices.push_back(ioServicePool->getIOService());
+    }
     _wsService->setIOServicePool(ioServicePool);
 
     auto resolver =
@@ -73,7 +90,28 @@ void WsInitializer::initWsService(WsService::Ptr _wsService)
     connector->setIOServicePool(ioServicePool);
 
     auto builder = std::make_shared<WsStreamDelegateBuilder>();
-    auto threadPool = std::make_shared<ThreadPool>("t_ws_pool", threadPoolSize);
+    bool ioUring = false;
+    if (_config->ioBackend() == IOBackend::IoUring)
+    {
+        ioUring = IoUringService::supported();
+        if (!ioUring)
+        {
+            WEBSOCKET_INITIALIZER(WARNING)
+                << LOG_BADGE("initWsService") << LOG_DESC("io_uring not supported, use epoll");
+        }
+    }
+    builder->setIoUring(ioUring);
+    std::shared_ptr<ThreadPool> threadPool = nullptr;
+    if (_config->threadPoolCpus().empty())
+    {
+        threadPool = std::make_shared<ThreadPool>("t_ws_pool", threadPoolSize);
+    }
+    else
+    {
+        threadPool = initThreadPoolAffinity(_wsService, ioServices, threadPoolSize);
+    }
+    initIOThreadAffinity(ioServices);
+    initIOBusyPoll(ioServices);
 
     // init module_name for log
     WsTools::setModuleName(m_moduleName);
@@ -92,6 +130,12 @@ void WsInitializer::initWsService(WsService::Ptr _wsService)
 
         srvCtx = contextBuilder->buildSslContext(true, *_config->contextConfig());
         clientCtx = contextBuilder->buildSslContext(false, *_config->contextConfig());
+        if (_config->contextConfig()->sessionResumption())
+        {
+            auto sslSessionCache = std::make_shared<SslSessionCache>();
+            sslSessionCache->setModuleName(m_moduleName);
+            connector->setSslSessionCache(sslSessionCache);
+        }
     }
 
     if (_config->asServer())
@@ -117,6 +161,11 @@ void WsInitializer::initWsService(WsService::Ptr _wsService)
             _config->listenPort(), ioServicePool->getIOService(), srvCtx, m_moduleName);
         httpServer->setIOServicePool(ioServicePool);
         httpServer->setDisableSsl(_config->disableSsl());
+        httpServer->setReusePort(_config->reusePort());
+        httpServer->setReusePortAcceptorNum(_config->ioThreadPoolSize());
+        httpServer->setIOServices(ioServices);
+        httpServer->setUnixSocketPath(_config->unixSocketPath());
+        httpServer->setUnixSocketMode(_config->unixSocketMode());
         httpServer->setThreadPool(threadPool);
         httpServer->setWsUpgradeHandler(
             [wsServiceWeakPtr](std::shared_ptr<HttpStream> _httpStream, HttpRequest&& _httpRequest,
@@ -129,6 +178,49 @@ void WsInitializer::initWsService(WsService::Ptr _wsService)
                     session->startAsServer(_httpRequest);
                 }
             });
+        if (_config->acceptTcpFrame())
+        {
+            httpServer->setTcpFrameHandler([wsServiceWeakPtr, ioUring](
+                                               std::shared_ptr<HttpStream> _httpStream,
+                                               std::shared_ptr<std::string> _nodeId) {
+                auto service = wsServiceWeakPtr.lock();
+                if (service)
+                {
+                    std::string nodeIdString = _nodeId == nullptr ? "" : *_nodeId.get();
+                    // the ssl and the unix domain socket streams stay on epoll
+                    auto frameStream = ioUring ? _httpStream->uringFrameStream() : nullptr;
+                    if (!frameStream)
+                    {
+                        frameStream = _httpStream->tcpFrameStream();
+                    }
+                    auto session = service->newSession(frameStream, nodeIdString);
+                    session->startAsServer(HttpRequest());
+                }
+            });
+        }
+        if (_config->acceptShmRing())
+        {
+            httpServer->setShmRingHandler([wsServiceWeakPtr](
+                                              std::shared_ptr<HttpStream> _httpStream,
+                                              std::shared_ptr<std::string> _nodeId) {
+                auto service = wsServiceWeakPtr.lock();
+                auto shmRingStream = _httpStream->shmRingStream();
+                if (service && shmRingStream)
+                {
+                    std::string nodeIdString = _nodeId == nullptr ? "" : *_nodeId.get();
+                    auto session = service->newSession(shmRingStream, nodeIdString);
+                    session->startAsServer(HttpRequest());
+                }
+            });
+        }
+
+        if (!_config->metricsPath().empty())
+        {
+            httpServer->setMetricsHandler(_config->metricsPath(), [wsServiceWeakPtr]() {
+                auto service = wsServiceWeakPtr.lock();
+                return service ? service->metricsText() : std::string();
+            });
+        }
 
         _wsService->setHttpServer(httpServer);
         _wsService->setHostPort(_config->listenIP(), _config->listenPort());
@@ -145,6 +237,16 @@ void WsInitializer::initWsService(WsService::Ptr _wsService)
         {
             for (auto& peer : *connectPeers)
             {
+                if (peer.isUnixSocket())
+                {
+                    if (peer.unixSocketPath().empty())
+                    {
+                        BOOST_THROW_EXCEPTION(InvalidParameter() << errinfo_comment(
+                                                  "empty unix domain socket path"));
+                    }
+                    continue;
+                }
+
                 if (!WsTools::validIP(peer.address()))
                 {
                     boost::system::error_code err;
@@ -188,6 +290,17 @@ void WsInitializer::initWsService(WsService::Ptr _wsService)
     connector->setCtx(clientCtx);
     connector->setBuilder(builder);
 
+    if (_config->traceSampleRate() > 0)
+    {
+        _wsService->setTracer(std::make_shared<WsTracer>(_config->traceSampleRate(),
+            std::make_shared<WsRingTraceSink>(_config->traceBufferSize())));
+    }
+    if (_config->compressThreshold() > 0)
+    {
+        _wsService->setCompressor(std::make_shared<WsCompressor>(
+            _config->compressThreshold(), _config->compressLevel()));
+    }
+
     _wsService->setConfig(_config);
     _wsService->setConnector(connector);
     _wsService->setThreadPool(threadPool);
@@ -200,7 +313,139 @@ void WsInitializer::initWsService(WsService::Ptr _wsService)
         << LOG_KV("disableSsl", _config->disableSsl()) << LOG_KV("server", _config->asServer())
         << LOG_KV("client", _config->asClient())
         << LOG_KV("threadPoolSize", _config->threadPoolSize())
+        << LOG_KV("ioThreadPoolSize", _config->ioThreadPoolSize())
+        << LOG_KV("reusePort", _config->reusePort())
+        << LOG_KV("ioBackend", _config->ioBackend()) << LOG_KV("ioUring", builder->ioUring())
+        << LOG_KV("unixSocketPath", _config->unixSocketPath())
+        << LOG_KV("acceptTcpFrame", _config->acceptTcpFrame())
+        << LOG_KV("tcpFramePeers", _config->tcpFramePeers() ? _config->tcpFramePeers()->size() : 0)
+        << LOG_KV("acceptShmRing", _config->acceptShmRing())
+        << LOG_KV("shmRingPeers", _config->shmRingPeers() ? _config->shmRingPeers()->size() : 0)
+        << LOG_KV("shmRingSize", _config->shmRingSize())
+        << LOG_KV("ioThreadCpus", _config->ioThreadCpus().size())
+        << LOG_KV("threadPoolCpus", _config->threadPoolCpus().size())
+        << LOG_KV("busyPollThreads", _config->busyPollThreads())
+        << LOG_KV("busyPollUs", _config->busyPollUs())
+        << LOG_KV("busyPollCpuPercent", _config->busyPollCpuPercent())
+        << LOG_KV("metricsPath", _config->metricsPath())
+        << LOG_KV("metricsPeriod", _config->metricsPeriod())
+        << LOG_KV("slowSendThreshold", _config->slowSendThreshold())
+        << LOG_KV("traceSampleRate", _config->traceSampleRate())
+        << LOG_KV("traceBufferSize", _config->traceBufferSize())
+        << LOG_KV("messagePool", _config->messagePool())
+        << LOG_KV("compressThreshold", _config->compressThreshold())
+        << LOG_KV("compressLevel", _config->compressLevel())
+        << LOG_KV("batchMaxBytes", _config->batchMaxBytes())
+        << LOG_KV("batchLingerUs", _config->batchLingerUs())
+        << LOG_KV("fragmentSize", _config->fragmentSize())
+        << LOG_KV("streamWindow", _config->streamWindow())
+        << LOG_KV("streamChunkSize", _config->streamChunkSize())
         << LOG_KV("maxMsgSize", _config->maxMsgSize())
         << LOG_KV("msgTimeOut", _config->sendMsgTimeout())
         << LOG_KV("connected peers", _config->connectPeers() ? _config->connectPeers()->size() : 0);
-}
\ No newline at end of file
+}
+void WsInitializer::initIOThreadAffinity(
+    const std::vector<std::shared_ptr<boost::asio::io_context>>& _ioServices)
+{
+    auto& cpus = m_config->ioThreadCpus();
+    if (cpus.empty())
+    {
+        return;
+    }
+
+    // every io_context is run by a single thread, the posted task pins that thread
+    for (std::size_t i = 0; i < _ioServices.size(); ++i)
+    {
+        auto cpu = cpus[i % cpus.size()];
+        boost::asio::post(*_ioServices[i], [cpu]() { WsTools::setThreadAffinity({cpu}); });
+    }
+}
+
+void WsInitializer::initIOBusyPoll(
+    const std::vector<std::shared_ptr<boost::asio::io_context>>& _ioServices)
+{
+    auto threads = std::min<std::size_t>(m_config->busyPollThreads(), _ioServices.size());
+    // the spinning io threads are the first ones, they are pinned to the first ioThreadCpus
+    for (std::size_t i = 0; i < threads; ++i)
+    {
+        WsTools::busyPoll(_ioServices[i], m_config->busyPollUs(), m_config->busyPollCpuPercent());
+    }
+}
+
+void WsInitializer::pinThreadPool(
+    std::shared_ptr<ThreadPool> _threadPool, std::size_t _threadNum, std::vector<uint32_t> _cpus)
+{
+    struct Barrier
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t count = 0;
+    };
+    auto barrier = std::make_shared<Barrier>();
+
+    // every worker blocks until all of them have taken a task, so each thread pins itself once
+    for (std::size_t i = 0; i < _threadNum; ++i)
+    {
+        _threadPool->enqueue([barrier, _threadNum, _cpus]() {
+            WsTools::setThreadAffinity(_cpus);
+            std::unique_lock<std::mutex> l(barrier->mutex);
+            if (++barrier->count == _threadNum)
+            {
+                barrier->cv.notify_all();
+                return;
+            }
+            barrier->cv.wait(l, [barrier, _threadNum]() { return barrier->count >= _threadNum; });
+        });
+    }
+}
+
+std::shared_ptr<ThreadPool> WsInitializer::initThreadPoolAffinity(WsService::Ptr _wsService,
+    const std::vector<std::shared_ptr<boost::asio::io_context>>& _ioServices,
+    std::size_t _threadPoolSize)
+{
+    auto& cpus = m_config->threadPoolCpus();
+    auto& ioThreadCpus = m_config->ioThreadCpus();
+
+    // group the worker cpus by numa node
+    std::map<uint32_t, std::vector<uint32_t>> node2Cpus;
+    for (auto cpu : cpus)
+    {
+        node2Cpus[WsTools::numaNodeOfCpu(cpu)].push_back(cpu);
+    }
+
+    // one thread pool per numa node, the threads are shared out by the number of cpus
+    std::map<uint32_t, std::shared_ptr<ThreadPool>> node2ThreadPool;
+    for (auto& [node, nodeCpus] : node2Cpus)
+    {
+        std::size_t threadNum =
+            std::max<std::size_t>(1, _threadPoolSize * nodeCpus.size() / cpus.size());
+        auto threadPool =
+            std::make_shared<ThreadPool>("t_ws_pool_" + std::to_string(node), threadNum);
+        pinThreadPool(threadPool, threadNum, nodeCpus);
+        node2ThreadPool[node] = threadPool;
+
+        WEBSOCKET_INITIALIZER(INFO)
+            << LOG_BADGE("initThreadPoolAffinity") << LOG_KV("numaNode", node)
+            << LOG_KV("cpus", nodeCpus.size()) << LOG_KV("threadNum", threadNum);
+    }
+
+    // the handler work of a session runs on the numa node of its io thread, the first group is
+    // used for the io threads that are not pinned or have no worker on their numa node
+    auto defaultThreadPool = node2ThreadPool.begin()->second;
+    for (std::size_t i = 0; i < _ioServices.size(); ++i)
+    {
+        auto threadPool = defaultThreadPool;
+        if (!ioThreadCpus.empty())
+        {
+            auto node = WsTools::numaNodeOfCpu(ioThreadCpus[i % ioThreadCpus.size()]);
+            auto it = node2ThreadPool.find(node);
+            if (it != node2ThreadPool.end())
+            {
+                threadPool = it->second;
+            }
+        }
+        _wsService->setAffinityThreadPool(_ioServices[i].get(), threadPool);
+    }
+
+    return defaultThreadPool;
+}
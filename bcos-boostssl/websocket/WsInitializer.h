@@ -51,13 +51,30 @@ public:
         m_sessionFactory = _sessionFactory;
     }
 
+    std::string moduleName() { return m_moduleName; }
+
 public:
     void initWsService(WsService::Ptr _wsService);
 
+    // pin the thread of every io_context to the ioThreadCpus of the config
+    void initIOThreadAffinity(
+        const std::vector<std::shared_ptr<boost::asio::io_context>>& _ioServices);
+    // one pinned thread pool per numa node of the threadPoolCpus, returns the default one
+    std::shared_ptr<bcos::ThreadPool> initThreadPoolAffinity(WsService::Ptr _wsService,
+        const std::vector<std::shared_ptr<boost::asio::io_context>>& _ioServices,
+        std::size_t _threadPoolSize);
+
+private:
+    void initIOBusyPoll(const std::vector<std::shared_ptr<boost::asio::io_context>>& _ioServices);
+    void pinThreadPool(std::shared_ptr<bcos::ThreadPool> _threadPool, std::size_t _threadNum,
+        std::vector<uint32_t> _cpus);
+
 private:
     std::shared_ptr<MessageFaceFactory> m_messageFactory;
     std::shared_ptr<WsConfig> m_config;
     WsSessionFactory::Ptr m_sessionFactory;
+    // the module name of the config, set by initWsService
+    std::string m_moduleName = "DEFAULT";
 };
 }  // namespace ws
 }  // namespace boostssl
@@ -20,6 +20,7 @@
 #include <bcos-boostssl/websocket/Common.h>
 #include <bcos-boostssl/websocket/WsMessage.h>
 #include <boost/asio/detail/socket_ops.hpp>
+#include <algorithm>
 #include <iterator>
 
 using namespace bcos;
@@ -30,14 +31,20 @@ using namespace bcos::boostssl::ws;
 constexpr size_t WsMessage::MESSAGE_MIN_LENGTH = 10;
 
 bool WsMessage::encode(bytes& _buffer)
+{
+    return encode(_buffer, payloadRef(), m_ext);
+}
+
+bool WsMessage::encode(bytes& _buffer, bytesConstRef _payload, uint16_t _ext)
 {
     _buffer.clear();
+    _buffer.reserve(MESSAGE_MIN_LENGTH + m_seq.size() + _payload.size());
 
     uint16_t version = boost::asio::detail::socket_ops::host_to_network_short(m_version);
     uint16_t type = boost::asio::detail::socket_ops::host_to_network_short(m_packetType);
     int16_t status = boost::asio::detail::socket_ops::host_to_network_short(m_status);
     uint16_t seqLength = boost::asio::detail::socket_ops::host_to_network_short(m_seq.size());
-    uint16_t ext = boost::asio::detail::socket_ops::host_to_network_short(m_ext);
+    uint16_t ext = boost::asio::detail::socket_ops::host_to_network_short(_ext);
 
     _buffer.insert(_buffer.end(), (byte*)&version, (byte*)&version + 2);
     _buffer.insert(_buffer.end(), (byte*)&type, (byte*)&type + 2);
@@ -45,7 +52,7 @@ bool WsMessage::encode(bytes& _buffer)
     _buffer.insert(_buffer.end(), (byte*)&seqLength, (byte*)&seqLength + 2);
     _buffer.insert(_buffer.end(), m_seq.begin(), m_seq.end());
     _buffer.insert(_buffer.end(), (byte*)&ext, (byte*)&ext + 2);
-    _buffer.insert(_buffer.end(), m_payload->begin(), m_payload->end());
+    _buffer.insert(_buffer.end(), _payload.data(), _payload.data() + _payload.size());
 
     m_length = _buffer.size();
     return true;
@@ -60,7 +67,12 @@ int64_t WsMessage::decode(bytesConstRef _buffer)
     }
 
     m_seq.clear();
-    m_payload->clear();
+    // null after reset() or before the first payload()
+    if (m_payload)
+    {
+        m_payload->clear();
+    }
+    m_inline.store(false, std::memory_order_relaxed);
 
     auto dataBuffer = _buffer.data();
     auto p = _buffer.data();
@@ -88,7 +100,7 @@ int64_t WsMessage::decode(bytesConstRef _buffer)
 
     CHECK_OFFSET(offset + seqLength, length);
     // seq field
-    m_seq.insert(m_seq.begin(), p, p + seqLength);
+    m_seq.assign((const char*)p, seqLength);
     p += seqLength;
     offset += seqLength;
 
@@ -98,11 +110,146 @@ int64_t WsMessage::decode(bytesConstRef _buffer)
     p += 2;
     offset += 2;
 
-    // data field
-    if (p)
+    // data field, the short payloads are kept inline
+    auto payloadSize = length - offset;
+    if (payloadSize <= INLINE_PAYLOAD_SIZE)
+    {
+        std::copy(p, p + payloadSize, m_inlinePayload.begin());
+        m_inlineSize = payloadSize;
+        m_inline.store(true, std::memory_order_release);
+    }
+    else
     {
-        m_payload->insert(m_payload->begin(), p, dataBuffer + length);
+        if (!m_payload)
+        {
+            m_payload = std::make_shared<bytes>(p, dataBuffer + length);
+        }
+        else
+        {
+            m_payload->insert(m_payload->begin(), p, dataBuffer + length);
+        }
     }
     m_length = length;
     return length;
+}
+
+bool WsMessage::peekHeader(bytesConstRef _frame, WsMessageHeader& _header)
+{
+    if (_frame.size() < MESSAGE_MIN_LENGTH)
+    {
+        return false;
+    }
+    auto p = _frame.data();
+    // version(2) + type(2) + status(2) + seqLength(2) + seq + ext(2)
+    uint16_t seqLength =
+        boost::asio::detail::socket_ops::network_to_host_short(*((uint16_t*)(p + 6)));
+    size_t offset = 8 + seqLength;
+    if (offset + 2 > _frame.size())
+    {
+        return false;
+    }
+    _header.version = boost::asio::detail::socket_ops::network_to_host_short(*((uint16_t*)p));
+    _header.packetType =
+        boost::asio::detail::socket_ops::network_to_host_short(*((uint16_t*)(p + 2)));
+    _header.status = boost::asio::detail::socket_ops::network_to_host_short(*((uint16_t*)(p + 4)));
+    _header.seq = bytesConstRef(p + 8, seqLength);
+    _header.ext = boost::asio::detail::socket_ops::network_to_host_short(
+        *((uint16_t*)(p + offset)));
+    _header.payload = bytesConstRef(p + offset + 2, _frame.size() - offset - 2);
+    return true;
+}
+
+bool WsMessage::setFrameExt(bytes& _frame, uint16_t _ext)
+{
+    WsMessageHeader header;
+    if (!peekHeader(bytesConstRef(_frame.data(), _frame.size()), header))
+    {
+        return false;
+    }
+    uint16_t ext = boost::asio::detail::socket_ops::host_to_network_short(_ext);
+    auto offset = header.payload.data() - _frame.data() - 2;
+    std::copy((byte*)&ext, (byte*)&ext + 2, _frame.begin() + offset);
+    return true;
+}
+
+namespace
+{
+// the payload of the frame if its ext has the flag
+bool flaggedPayload(bytesConstRef _frame, uint16_t _flag, bytesConstRef& _payload)
+{
+    WsMessageHeader header;
+    if (!WsMessage::peekHeader(_frame, header) || (header.ext & _flag) == 0)
+    {
+        return false;
+    }
+    _payload = header.payload;
+    return true;
+}
+
+void beginFlaggedFrame(bytes& _buffer, uint16_t _flag)
+{
+    _buffer.assign(WsMessage::MESSAGE_MIN_LENGTH, 0);
+    uint16_t ext = boost::asio::detail::socket_ops::host_to_network_short(_flag);
+    std::copy((byte*)&ext, (byte*)&ext + 2, _buffer.begin() + WsMessage::MESSAGE_MIN_LENGTH - 2);
+}
+}  // namespace
+
+void WsMessage::beginBatch(bytes& _buffer)
+{
+    beginFlaggedFrame(_buffer, MessageExtFieldFlag::Batch);
+}
+
+void WsMessage::appendToBatch(bytes& _buffer, bytesConstRef _frame)
+{
+    auto length = (uint32_t)_frame.size();
+    for (size_t i = 0; i < BATCH_LENGTH_PREFIX; ++i)
+    {
+        _buffer.push_back((byte)(length >> (8 * (BATCH_LENGTH_PREFIX - 1 - i))));
+    }
+    _buffer.insert(_buffer.end(), _frame.data(), _frame.data() + _frame.size());
+}
+
+bool WsMessage::batchPayload(bytesConstRef _frame, bytesConstRef& _payload)
+{
+    return flaggedPayload(_frame, MessageExtFieldFlag::Batch, _payload);
+}
+
+void WsMessage::encodeFragment(bytes& _buffer, bytesConstRef _slice, bool _last)
+{
+    _buffer.reserve(MESSAGE_MIN_LENGTH + 1 + _slice.size());
+    beginFlaggedFrame(_buffer, MessageExtFieldFlag::Fragment);
+    _buffer.push_back(_last ? FRAGMENT_LAST : 0);
+    _buffer.insert(_buffer.end(), _slice.data(), _slice.data() + _slice.size());
+}
+
+bool WsMessage::fragmentPayload(bytesConstRef _frame, bytesConstRef& _slice, bool& _last)
+{
+    bytesConstRef payload;
+    if (!flaggedPayload(_frame, MessageExtFieldFlag::Fragment, payload) || payload.size() == 0)
+    {
+        return false;
+    }
+    _last = (payload.data()[0] & FRAGMENT_LAST) != 0;
+    _slice = bytesConstRef(payload.data() + 1, payload.size() - 1);
+    return true;
+}
+
+std::shared_ptr<bytes> WsMessage::materializePayload() const
+{
+    // the handlers may share the message between threads, only one of them copies
+    std::lock_guard<std::mutex> lock(x_payload);
+    if (m_inline.load(std::memory_order_relaxed))
+    {
+        if (!m_payload)
+        {
+            m_payload = std::make_shared<bytes>(
+                m_inlinePayload.begin(), m_inlinePayload.begin() + m_inlineSize);
+        }
+        else
+        {
+            m_payload->assign(m_inlinePayload.begin(), m_inlinePayload.begin() + m_inlineSize);
+        }
+        m_inline.store(false, std::memory_order_release);
+    }
+    return m_payload;
 }
\ No newline at end of file
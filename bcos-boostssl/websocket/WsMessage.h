@@ -24,8 +24,11 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <array>
+#include <atomic>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -46,6 +49,17 @@ namespace boostssl
 {
 namespace ws
 {
+// the fields of an encoded message read in place, the seq and the payload point into the frame
+struct WsMessageHeader
+{
+    uint16_t version = 0;
+    uint16_t packetType = 0;
+    int16_t status = 0;
+    uint16_t ext = 0;
+    bytesConstRef seq;
+    bytesConstRef payload;
+};
+
 // the message format for ws protocol
 class WsMessage : public boostssl::MessageFace
 {
@@ -53,9 +67,38 @@ public:
 
     // version(2) + type(2) + status(2) + seqLength(2) + ext(2) + payload(N)
     const static size_t MESSAGE_MIN_LENGTH;
+    // the decoded payloads up to the size are kept in the message instead of the payload buffer
+    static constexpr size_t INLINE_PAYLOAD_SIZE = 128;
+    // the length prefix of a message in the payload of a batch frame
+    static constexpr size_t BATCH_LENGTH_PREFIX = 4;
+
+    // a batch frame is a message without seq flagged MessageExtFieldFlag::Batch, its payload
+    // packs the encoded messages each prefixed with its length in 4 bytes big endian
+    static void beginBatch(bcos::bytes& _buffer);
+    static void appendToBatch(bcos::bytes& _buffer, bytesConstRef _frame);
+    // the payload of the frame if it is a batch frame, without decoding it
+    static bool batchPayload(bytesConstRef _frame, bytesConstRef& _payload);
+
+    // the header of the frame without copying the seq and the payload, false if it is truncated
+    static bool peekHeader(bytesConstRef _frame, WsMessageHeader& _header);
+    // overwrite the ext of the encoded message in place
+    static bool setFrameExt(bcos::bytes& _frame, uint16_t _ext);
+
+    // the flag of the last fragment of a message, in the first byte of the payload
+    static constexpr bcos::byte FRAGMENT_LAST = 0x01;
+    // a fragment frame is a message without seq flagged MessageExtFieldFlag::Fragment, its
+    // payload is the flag byte and the next slice of an encoded message
+    static void encodeFragment(bcos::bytes& _buffer, bytesConstRef _slice, bool _last);
+    // the slice of the frame if it is a fragment frame, without decoding it
+    static bool fragmentPayload(bytesConstRef _frame, bytesConstRef& _slice, bool& _last);
 
     using Ptr = std::shared_ptr<WsMessage>;
-    WsMessage() { m_payload = std::make_shared<bcos::bytes>(); }
+    // the payload buffer is allocated on the first call of payload(), until then the message
+    // holds an empty inline payload
+    WsMessage() = default;
+    explicit WsMessage(std::shared_ptr<bcos::bytes> _payload)
+      : m_payload(std::move(_payload)), m_inline(!m_payload)
+    {}
     virtual ~WsMessage() {}
 
 
@@ -66,17 +109,40 @@ public:
     virtual int16_t status() { return m_status; }
     virtual void setStatus(int16_t _status) { m_status = _status; }
     virtual std::string const& seq() const override { return m_seq; }
-    virtual void setSeq(std::string _seq) override { m_seq = _seq; }
-    virtual std::shared_ptr<bcos::bytes> payload() const override { return m_payload; }
+    virtual void setSeq(std::string _seq) override { m_seq = std::move(_seq); }
+    // an inline payload is copied to the payload buffer on the first call, payloadRef reads it
+    // in place, a message without a payload buffer returns a new empty one
+    virtual std::shared_ptr<bcos::bytes> payload() const override
+    {
+        if (!m_inline.load(std::memory_order_acquire))
+        {
+            return m_payload;
+        }
+        return materializePayload();
+    }
     virtual void setPayload(std::shared_ptr<bcos::bytes> _payload) override
     {
         m_payload = _payload;
+        // a null payload reads as empty
+        m_inlineSize = 0;
+        m_inline.store(!m_payload, std::memory_order_relaxed);
     }
+    virtual bytesConstRef payloadRef() const override
+    {
+        if (m_inline.load(std::memory_order_acquire))
+        {
+            return bytesConstRef(m_inlinePayload.data(), m_inlineSize);
+        }
+        return bytesConstRef(m_payload->data(), m_payload->size());
+    }
+    bool inlinePayload() const { return m_inline.load(std::memory_order_acquire); }
     virtual uint16_t ext() const override { return m_ext; }
     virtual void setExt(uint16_t _ext) override { m_ext = _ext; }
 
 
     virtual bool encode(bcos::bytes& _buffer) override;
+    // encode with _payload and _ext in place of the fields of the message, which is unchanged
+    bool encode(bcos::bytes& _buffer, bytesConstRef _payload, uint16_t _ext);
     virtual int64_t decode(bytesConstRef _buffer) override;
 
     bool isRespPacket() const override { return (m_ext & MessageExtFieldFlag::Response) != 0; }
@@ -84,12 +150,38 @@ public:
 
     virtual uint32_t length() const override { return m_length; }
 
+    // clear the fields for the reuse of the message, the seq keeps its capacity and the payload
+    // is released, payload() allocates a new one unless setPayload sets it first
+    void reset()
+    {
+        m_version = 0;
+        m_packetType = 0;
+        m_seq.clear();
+        m_ext = 0;
+        m_payload.reset();
+        m_inline.store(true, std::memory_order_relaxed);
+        m_inlineSize = 0;
+        m_status = 0;
+        m_length = 0;
+    }
+
 private:
+    std::shared_ptr<bcos::bytes> materializePayload() const;
+
     uint16_t m_version = 0;
     uint16_t m_packetType = 0;
     std::string m_seq;
     uint16_t m_ext = 0;
-    std::shared_ptr<bcos::bytes> m_payload;
+    // allocated by the first payload() if no buffer was set or decoded
+    mutable std::shared_ptr<bcos::bytes> m_payload;
+
+    // set by decode for the short payloads and while there is no m_payload, cleared once the
+    // payload is copied to m_payload
+    mutable std::atomic_bool m_inline{true};
+    // taken by the first payload() of an inline payload, the handlers may share the message
+    mutable std::mutex x_payload;
+    uint8_t m_inlineSize = 0;
+    std::array<byte, INLINE_PAYLOAD_SIZE> m_inlinePayload;
 
     int16_t m_status{0};
     uint32_t m_length;
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file WsMessagePool.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/WsMessagePool.h>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+// the buffers are capped at MAX_POOLED_BUFFER each, fewer of them are kept than of the messages
+using WsBufferFreeList = WsFreeList<bcos::bytes, 64, 1024>;
+using WsMessageFreeList = WsFreeList<WsMessage>;
+}  // namespace
+
+std::shared_ptr<bcos::bytes> WsMessagePool::newBuffer()
+{
+    auto buffer = WsBufferFreeList::acquire();
+    if (!buffer)
+    {
+        buffer = new bcos::bytes();
+    }
+    return std::shared_ptr<bcos::bytes>(
+        buffer, &WsMessagePool::releaseBuffer, WsPoolAllocator<bcos::bytes>());
+}
+
+WsMessage::Ptr WsMessagePool::newMessage()
+{
+    auto message = WsMessageFreeList::acquire();
+    if (!message)
+    {
+        message = new WsMessage(newBuffer());
+    }
+    else
+    {
+        message->setPayload(newBuffer());
+    }
+    return WsMessage::Ptr(message, &WsMessagePool::releaseMessage, WsPoolAllocator<WsMessage>());
+}
+
+void WsMessagePool::releaseBuffer(bcos::bytes* _buffer)
+{
+    if (_buffer->capacity() > MAX_POOLED_BUFFER)
+    {
+        delete _buffer;
+        return;
+    }
+    _buffer->clear();
+    WsBufferFreeList::release(_buffer);
+}
+
+void WsMessagePool::releaseMessage(WsMessage* _message)
+{
+    _message->reset();
+    WsMessageFreeList::release(_message);
+}
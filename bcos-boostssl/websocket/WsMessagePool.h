@@ -0,0 +1,272 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief recycles the messages, the payload buffers and the shared_ptr control blocks through
+ * per thread free lists, a thread spills its list to a global list when it is full and refills
+ * from it when it is empty, so the messages built on the io threads and released on the worker
+ * threads still come back
+ * @file WsMessagePool.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-utilities/Common.h>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+// the objects released past the capacity of both lists are deleted
+template <typename T, std::size_t LocalCapacity = 256, std::size_t GlobalCapacity = 4096>
+class WsFreeList
+{
+public:
+    // nullptr if the lists are empty
+    static T* acquire()
+    {
+        if (t_exited)
+        {
+            return globalList().pop();
+        }
+        auto& cache = localCache();
+        if (cache.objects.empty())
+        {
+            globalList().take(cache.objects, LocalCapacity / 2);
+            if (cache.objects.empty())
+            {
+                return nullptr;
+            }
+        }
+        auto object = cache.objects.back();
+        cache.objects.pop_back();
+        return object;
+    }
+
+    static void release(T* _object)
+    {
+        if (t_exited)
+        {
+            globalList().push(_object);
+            return;
+        }
+        auto& cache = localCache();
+        if (cache.objects.size() >= LocalCapacity)
+        {
+            globalList().put(cache.objects, LocalCapacity / 2);
+        }
+        cache.objects.push_back(_object);
+    }
+
+private:
+    struct GlobalList
+    {
+        GlobalList() { objects.reserve(GlobalCapacity); }
+
+        T* pop()
+        {
+            std::lock_guard<std::mutex> l(mutex);
+            if (objects.empty())
+            {
+                return nullptr;
+            }
+            auto object = objects.back();
+            objects.pop_back();
+            return object;
+        }
+
+        void push(T* _object)
+        {
+            {
+                std::lock_guard<std::mutex> l(mutex);
+                if (objects.size() < GlobalCapacity)
+                {
+                    objects.push_back(_object);
+                    return;
+                }
+            }
+            delete _object;
+        }
+
+        // moves up to _count objects to _out
+        void take(std::vector<T*>& _out, std::size_t _count)
+        {
+            std::lock_guard<std::mutex> l(mutex);
+            auto count = std::min(_count, objects.size());
+            _out.insert(_out.end(), objects.end() - count, objects.end());
+            objects.resize(objects.size() - count);
+        }
+
+        // moves the objects of _in past the first _keep here, deletes the ones that do not fit
+        void put(std::vector<T*>& _in, std::size_t _keep)
+        {
+            {
+                std::lock_guard<std::mutex> l(mutex);
+                auto room = GlobalCapacity - objects.size();
+                auto count = std::min(room, _in.size() - _keep);
+                objects.insert(objects.end(), _in.end() - count, _in.end());
+                _in.resize(_in.size() - count);
+            }
+            while (_in.size() > _keep)
+            {
+                delete _in.back();
+                _in.pop_back();
+            }
+        }
+
+        std::mutex mutex;
+        std::vector<T*> objects;
+    };
+
+    struct LocalCache
+    {
+        LocalCache() { objects.reserve(LocalCapacity); }
+        // the objects released later in the exiting thread go to the global list directly
+        ~LocalCache()
+        {
+            t_exited = true;
+            globalList().put(objects, 0);
+        }
+
+        std::vector<T*> objects;
+    };
+
+    // never destroyed, the caches of the threads are flushed to it when the threads exit
+    static GlobalList& globalList()
+    {
+        static auto* list = new GlobalList();
+        return *list;
+    }
+
+    static LocalCache& localCache()
+    {
+        static thread_local LocalCache cache;
+        return cache;
+    }
+
+    static inline thread_local bool t_exited = false;
+};
+
+template <std::size_t Size, std::size_t Align>
+struct WsBlock
+{
+    alignas(Align) unsigned char data[Size];
+};
+
+// allocates the single objects from the free list of their size, used for the control blocks
+// of allocate_shared and of the shared_ptrs with a deleter
+template <typename T>
+class WsPoolAllocator
+{
+public:
+    using value_type = T;
+    using Block = WsBlock<sizeof(T), alignof(T)>;
+
+    WsPoolAllocator() = default;
+    template <typename U>
+    WsPoolAllocator(const WsPoolAllocator<U>&)
+    {}
+
+    T* allocate(std::size_t _n)
+    {
+        if (_n != 1)
+        {
+            return std::allocator<T>().allocate(_n);
+        }
+        auto block = WsFreeList<Block>::acquire();
+        return reinterpret_cast<T*>(block ? block : new Block);
+    }
+
+    void deallocate(T* _p, std::size_t _n)
+    {
+        if (_n != 1)
+        {
+            std::allocator<T>().deallocate(_p, _n);
+            return;
+        }
+        WsFreeList<Block>::release(reinterpret_cast<Block*>(_p));
+    }
+
+    template <typename U>
+    bool operator==(const WsPoolAllocator<U>&) const
+    {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const WsPoolAllocator<U>&) const
+    {
+        return false;
+    }
+};
+
+class WsMessagePool
+{
+public:
+    // the buffers grown past it are freed, copying such a payload costs more than allocating it
+    // and keeping them would pin the memory of the largest messages
+    static constexpr std::size_t MAX_POOLED_BUFFER = 16 * 1024;
+
+    // an empty buffer, back to the pool when the last reference is released
+    static std::shared_ptr<bcos::bytes> newBuffer();
+    // a message with an empty payload from newBuffer, back to the pool when the last reference
+    // is released, the payload is released with it and may outlive it
+    static WsMessage::Ptr newMessage();
+
+private:
+    static void releaseBuffer(bcos::bytes* _buffer);
+    static void releaseMessage(WsMessage* _message);
+};
+
+class WsPooledMessageFactory : public WsMessageFactory
+{
+public:
+    using Ptr = std::shared_ptr<WsPooledMessageFactory>;
+    WsPooledMessageFactory() = default;
+    virtual ~WsPooledMessageFactory() {}
+
+public:
+    virtual boostssl::MessageFace::Ptr buildMessage() override
+    {
+        return WsMessagePool::newMessage();
+    }
+
+    virtual std::shared_ptr<WsMessage> buildMessage(
+        uint16_t _type, std::shared_ptr<bcos::bytes> _data) override
+    {
+        auto msg = WsMessagePool::newMessage();
+
+        msg->setPacketType(_type);
+        msg->setPayload(_data);
+
+        return msg;
+    }
+
+    virtual std::shared_ptr<bcos::bytes> buildBuffer() override
+    {
+        return WsMessagePool::newBuffer();
+    }
+};
+
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
@@ -0,0 +1,183 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file WsMetrics.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/WsError.h>
+#include <bcos-boostssl/websocket/WsMetrics.h>
+#include <sstream>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+const char* wsErrorName(int32_t _error)
+{
+    switch (_error)
+    {
+    case WsError::AcceptError:
+        return "AcceptError";
+    case WsError::ReadError:
+        return "ReadError";
+    case WsError::WriteError:
+        return "WriteError";
+    case WsError::PingError:
+        return "PingError";
+    case WsError::PongError:
+        return "PongError";
+    case WsError::PacketError:
+        return "PacketError";
+    case WsError::SessionDisconnect:
+        return "SessionDisconnect";
+    case WsError::UserDisconnect:
+        return "UserDisconnect";
+    case WsError::TimeOut:
+        return "TimeOut";
+    case WsError::NoActiveCons:
+        return "NoActiveCons";
+    case WsError::EndPointNotExist:
+        return "EndPointNotExist";
+    case WsError::MessageOverflow:
+        return "MessageOverflow";
+    case WsError::UndefinedException:
+        return "UndefinedException";
+    case WsError::MessageEncodeError:
+        return "MessageEncodeError";
+    case WsError::StreamAborted:
+        return "StreamAborted";
+    case WsError::FileReadError:
+        return "FileReadError";
+    case WsError::RequestCancelled:
+        return "RequestCancelled";
+    case WsError::RequestDropped:
+        return "RequestDropped";
+    default:
+        return "Unknown";
+    }
+}
+
+void writeHeader(
+    std::ostream& _out, const std::string& _name, const char* _type, const char* _help)
+{
+    _out << "# HELP " << _name << " " << _help << "\n# TYPE " << _name << " " << _type << "\n";
+}
+
+void writeHistogram(std::ostream& _out, const std::string& _name, const std::string& _labels,
+    const WsLatencySnapshot& _latency)
+{
+    // the bucket bounds are fixed so that the series stay the same between the scrapes
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i + 1 < WS_LATENCY_BUCKETS; ++i)
+    {
+        cumulative += _latency.buckets[i];
+        auto upper = i == 0 ? 0 : (1ULL << i) - 1;
+        _out << _name << "_bucket{" << _labels << ",le=\"" << upper << "\"} " << cumulative
+             << "\n";
+    }
+    // the count from the buckets, the counters are read one by one and may be apart
+    cumulative += _latency.buckets[WS_LATENCY_BUCKETS - 1];
+    _out << _name << "_bucket{" << _labels << ",le=\"+Inf\"} " << cumulative << "\n";
+    _out << _name << "_sum{" << _labels << "} " << _latency.sumUs << "\n";
+    _out << _name << "_count{" << _labels << "} " << cumulative << "\n";
+}
+}  // namespace
+
+std::string bcos::boostssl::ws::renderPrometheus(
+    const WsServiceSnapshot& _snapshot, const std::string& _moduleName)
+{
+    std::ostringstream out;
+    std::string module = "module=\"" + _moduleName + "\"";
+    auto sample = [&out, &module](const std::string& _name, const char* _type, const char* _help,
+                      uint64_t _value) {
+        writeHeader(out, _name, _type, _help);
+        out << _name << "{" << module << "} " << _value << "\n";
+    };
+
+    sample("boostssl_sessions", "gauge", "The sessions of the service.",
+        _snapshot.sessions.size());
+    sample("boostssl_received_bytes_total", "counter", "The bytes of the received messages.",
+        _snapshot.traffic.bytesIn);
+    sample("boostssl_sent_bytes_total", "counter", "The bytes of the sent messages.",
+        _snapshot.traffic.bytesOut);
+    sample("boostssl_received_messages_total", "counter", "The received messages.",
+        _snapshot.traffic.msgsIn);
+    sample("boostssl_sent_messages_total", "counter", "The sent messages.",
+        _snapshot.traffic.msgsOut);
+    sample("boostssl_response_timeouts_total", "counter",
+        "The requests that timed out waiting for the response.", _snapshot.traffic.timeouts);
+    sample("boostssl_slow_sends_total", "counter",
+        "The messages that took longer than the slow send threshold to be written.",
+        _snapshot.traffic.slowSends);
+    sample("boostssl_write_queue_messages", "gauge",
+        "The messages waiting in the write queues of the sessions.", _snapshot.writeQueueSize);
+    sample("boostssl_pending_callbacks", "gauge", "The requests waiting for the response.",
+        _snapshot.callbacks);
+    sample("boostssl_handler_backlog_messages", "gauge",
+        "The received messages waiting in the thread pool for the handler.",
+        _snapshot.handlerBacklog > 0 ? _snapshot.handlerBacklog : 0);
+
+    writeHeader(out, "boostssl_session_drops_total", "counter",
+        "The sessions dropped, by the reason.");
+    for (const auto& drop : _snapshot.drops)
+    {
+        out << "boostssl_session_drops_total{" << module << ",reason=\""
+            << wsErrorName(drop.first) << "\"} " << drop.second << "\n";
+    }
+
+    std::string histogram = "boostssl_handler_duration_microseconds";
+    writeHeader(out, histogram, "histogram", "The execution time of the message handlers.");
+    for (const auto& handler : _snapshot.handlers)
+    {
+        auto labels = module + ",type=\"" + std::to_string(handler.first) + "\"";
+        writeHistogram(out, histogram, labels, handler.second);
+    }
+
+    histogram = "boostssl_send_latency_microseconds";
+    writeHeader(out, histogram, "histogram",
+        "The time from the write queue to the end of the socket write.");
+    writeHistogram(out, histogram, module, _snapshot.sendLatency);
+
+    const auto& compression = _snapshot.compression;
+    sample("boostssl_compressed_messages_total", "counter", "The sent messages compressed.",
+        compression.compressed);
+    sample("boostssl_incompressible_messages_total", "counter",
+        "The sent messages above the threshold not smaller after the compression.",
+        compression.incompressible);
+    sample("boostssl_compression_input_bytes_total", "counter",
+        "The payload bytes of the compressed messages before the compression.",
+        compression.rawBytes);
+    sample("boostssl_compression_output_bytes_total", "counter",
+        "The payload bytes of the compressed messages after the compression.",
+        compression.compressedBytes);
+    sample("boostssl_decompressed_messages_total", "counter", "The received messages decompressed.",
+        compression.decompressed);
+    sample("boostssl_decompress_errors_total", "counter",
+        "The received messages failed to be decompressed.", compression.decompressErrors);
+
+    histogram = "boostssl_compress_duration_microseconds";
+    writeHeader(out, histogram, "histogram", "The cpu time of the compression of a payload.");
+    writeHistogram(out, histogram, module, compression.compressTime);
+
+    histogram = "boostssl_decompress_duration_microseconds";
+    writeHeader(out, histogram, "histogram", "The cpu time of the decompression of a payload.");
+    writeHistogram(out, histogram, module, compression.decompressTime);
+
+    return out.str();
+}
@@ -0,0 +1,242 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief runtime metrics of the sessions and the service, the counters are updated with relaxed
+ * atomics on the hot path and read through the snapshots
+ * @file WsMetrics.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+// the traffic of one session or, summed up, of the service
+struct WsTrafficSnapshot
+{
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+    uint64_t msgsIn = 0;
+    uint64_t msgsOut = 0;
+    uint64_t timeouts = 0;
+    uint64_t slowSends = 0;
+
+    WsTrafficSnapshot& operator+=(const WsTrafficSnapshot& _other)
+    {
+        bytesIn += _other.bytesIn;
+        bytesOut += _other.bytesOut;
+        msgsIn += _other.msgsIn;
+        msgsOut += _other.msgsOut;
+        timeouts += _other.timeouts;
+        slowSends += _other.slowSends;
+        return *this;
+    }
+};
+
+class WsTrafficMetrics
+{
+public:
+    void onRead(uint64_t _bytes)
+    {
+        m_bytesIn.fetch_add(_bytes, std::memory_order_relaxed);
+        m_msgsIn.fetch_add(1, std::memory_order_relaxed);
+    }
+    // _msgs: the messages of a batch frame
+    void onWrite(uint64_t _bytes, uint64_t _msgs = 1)
+    {
+        m_bytesOut.fetch_add(_bytes, std::memory_order_relaxed);
+        m_msgsOut.fetch_add(_msgs, std::memory_order_relaxed);
+    }
+    void onTimeout() { m_timeouts.fetch_add(1, std::memory_order_relaxed); }
+    void onSlowSend() { m_slowSends.fetch_add(1, std::memory_order_relaxed); }
+
+    WsTrafficSnapshot snapshot() const
+    {
+        WsTrafficSnapshot snapshot;
+        snapshot.bytesIn = m_bytesIn.load(std::memory_order_relaxed);
+        snapshot.bytesOut = m_bytesOut.load(std::memory_order_relaxed);
+        snapshot.msgsIn = m_msgsIn.load(std::memory_order_relaxed);
+        snapshot.msgsOut = m_msgsOut.load(std::memory_order_relaxed);
+        snapshot.timeouts = m_timeouts.load(std::memory_order_relaxed);
+        snapshot.slowSends = m_slowSends.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+private:
+    std::atomic<uint64_t> m_bytesIn{0};
+    std::atomic<uint64_t> m_bytesOut{0};
+    std::atomic<uint64_t> m_msgsIn{0};
+    std::atomic<uint64_t> m_msgsOut{0};
+    std::atomic<uint64_t> m_timeouts{0};
+    std::atomic<uint64_t> m_slowSends{0};
+};
+
+// bucket i counts the values in [2^(i-1), 2^i), bucket 0 counts 0
+static constexpr std::size_t WS_LATENCY_BUCKETS = 40;
+
+struct WsLatencySnapshot
+{
+    uint64_t count = 0;
+    uint64_t sumUs = 0;
+    uint64_t maxUs = 0;
+    std::array<uint64_t, WS_LATENCY_BUCKETS> buckets{};
+
+    WsLatencySnapshot& operator+=(const WsLatencySnapshot& _other)
+    {
+        count += _other.count;
+        sumUs += _other.sumUs;
+        maxUs = maxUs > _other.maxUs ? maxUs : _other.maxUs;
+        for (std::size_t i = 0; i < WS_LATENCY_BUCKETS; ++i)
+        {
+            buckets[i] += _other.buckets[i];
+        }
+        return *this;
+    }
+
+    // the upper bound of the bucket of the percentile, _percentile in [0, 100]
+    uint64_t percentileUs(double _percentile) const
+    {
+        if (count == 0)
+        {
+            return 0;
+        }
+        auto target = (uint64_t)(_percentile / 100 * (double)count + 0.5);
+        target = target > 0 ? target : 1;
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < buckets.size(); ++i)
+        {
+            seen += buckets[i];
+            if (seen >= target)
+            {
+                auto upper = i == 0 ? 0 : (1ULL << i) - 1;
+                return upper < maxUs ? upper : maxUs;
+            }
+        }
+        return maxUs;
+    }
+};
+
+// log2 histogram of microseconds, cheap enough to be recorded for every message
+class WsLatencyMetrics
+{
+public:
+    using Ptr = std::shared_ptr<WsLatencyMetrics>;
+
+    void record(uint64_t _us)
+    {
+        std::size_t bucket = _us == 0 ? 0 : 64 - __builtin_clzll(_us);
+        bucket = bucket < WS_LATENCY_BUCKETS ? bucket : WS_LATENCY_BUCKETS - 1;
+        m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sumUs.fetch_add(_us, std::memory_order_relaxed);
+        auto max = m_maxUs.load(std::memory_order_relaxed);
+        while (_us > max && !m_maxUs.compare_exchange_weak(max, _us, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    WsLatencySnapshot snapshot() const
+    {
+        WsLatencySnapshot snapshot;
+        snapshot.count = m_count.load(std::memory_order_relaxed);
+        snapshot.sumUs = m_sumUs.load(std::memory_order_relaxed);
+        snapshot.maxUs = m_maxUs.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < WS_LATENCY_BUCKETS; ++i)
+        {
+            snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, WS_LATENCY_BUCKETS> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sumUs{0};
+    std::atomic<uint64_t> m_maxUs{0};
+};
+
+struct WsCompressionSnapshot
+{
+    // the sent messages compressed and their payload bytes before and after
+    uint64_t compressed = 0;
+    uint64_t rawBytes = 0;
+    uint64_t compressedBytes = 0;
+    // the sent messages above the threshold left as they are, not smaller after the compression
+    uint64_t incompressible = 0;
+    // the received messages decompressed, and those failed
+    uint64_t decompressed = 0;
+    uint64_t decompressErrors = 0;
+    WsLatencySnapshot compressTime;
+    WsLatencySnapshot decompressTime;
+};
+
+struct WsSessionSnapshot
+{
+    std::string endPoint;
+    std::string connectedEndPoint;
+    WsTrafficSnapshot traffic;
+    // from the write queue to the end of the socket write
+    WsLatencySnapshot sendLatency;
+    // the messages waiting in the write queue
+    std::size_t writeQueueSize = 0;
+    // the requests waiting for the response
+    std::size_t callbacks = 0;
+    // the messages received and waiting in the thread pool for the handler
+    int64_t handlerBacklog = 0;
+    // the WsError the session was dropped for, 0 if the session is alive
+    int32_t dropReason = 0;
+};
+
+struct WsServiceSnapshot
+{
+    // all the sessions of the service, the closed ones included
+    WsTrafficSnapshot traffic;
+    WsLatencySnapshot sendLatency;
+    // the sum of the alive sessions
+    std::size_t writeQueueSize = 0;
+    std::size_t callbacks = 0;
+    int64_t handlerBacklog = 0;
+    // the alive sessions
+    std::vector<WsSessionSnapshot> sessions;
+    // WsError => the sessions dropped for it
+    std::map<int32_t, uint64_t> drops;
+    // packet type => the execution time of its handler
+    std::map<uint16_t, WsLatencySnapshot> handlers;
+    WsCompressionSnapshot compression;
+};
+
+/**
+ * @brief: render the snapshot in the prometheus text exposition format
+ * @param _snapshot: the snapshot of the service
+ * @param _moduleName: the value of the module label
+ * @return std::string:
+ */
+std::string renderPrometheus(const WsServiceSnapshot& _snapshot, const std::string& _moduleName);
+
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the completion handlers of the requests sent with WsSession::asyncRequest, kept
+ * without std::function and resumed on their own executors
+ * @file WsResponseWaiter.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <bcos-boostssl/interfaces/MessageFace.h>
+#include <bcos-boostssl/websocket/WsError.h>
+#include <bcos-utilities/Error.h>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <memory>
+#include <utility>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+// the signature the requests complete with, the error or the response
+using WsResponseSignature = void(bcos::Error::Ptr, std::shared_ptr<boostssl::MessageFace>);
+
+class WsResponseWaiter
+{
+public:
+    using UniquePtr = std::unique_ptr<WsResponseWaiter>;
+
+    virtual ~WsResponseWaiter() = default;
+
+    // called once on any thread, the handler runs on its executor, a waiter destroyed before
+    // it completes the handler with WsError::RequestDropped
+    virtual void complete(
+        bcos::Error::Ptr _error, std::shared_ptr<boostssl::MessageFace> _response) = 0;
+};
+
+// the handler of a completion token, the executor of the session when it has none
+template <typename Handler, typename Executor>
+class WsResponseWaiterImpl : public WsResponseWaiter
+{
+public:
+    WsResponseWaiterImpl(Handler _handler, const Executor& _executor)
+      : m_handler(std::move(_handler)),
+        m_work(boost::asio::make_work_guard(boost::asio::get_associated_executor(m_handler,
+            _executor)))
+    {}
+
+    ~WsResponseWaiterImpl() override
+    {
+        // the callback went away without a response, e.g. the session is destroyed
+        if (m_work.owns_work())
+        {
+            complete(std::make_shared<bcos::Error>(
+                         WsError::RequestDropped, "the request is dropped without a response"),
+                nullptr);
+        }
+    }
+
+    void complete(
+        bcos::Error::Ptr _error, std::shared_ptr<boostssl::MessageFace> _response) override
+    {
+        if (!m_work.owns_work())
+        {
+            return;
+        }
+        auto executor = m_work.get_executor();
+        boost::asio::post(executor, [handler = std::move(m_handler), _error = std::move(_error),
+                                        _response = std::move(_response)]() mutable {
+            handler(std::move(_error), std::move(_response));
+        });
+        m_work.reset();
+    }
+
+private:
+    Handler m_handler;
+    boost::asio::executor_work_guard<
+        typename boost::asio::associated_executor<Handler, Executor>::type>
+        m_work;
+};
+
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
@@ -90,6 +90,11 @@ void WsService::start()
 
     reportConnectedNodes();
 
+    if (!m_config->metricsPath().empty())
+    {
+        refreshMetrics();
+    }
+
     WEBSOCKET_SERVICE(INFO) << LOG_BADGE("start")
                             << LOG_DESC("start websocket service successfully")
                             << LOG_KV("model", m_config->model())
@@ -124,6 +129,12 @@ void WsService::stop()
         m_heartbeat->cancel();
     }
 
+    // cancel metrics task
+    if (m_metricsTimer)
+    {
+        m_metricsTimer->cancel();
+    }
+
 
     WEBSOCKET_SERVICE(INFO) << LOG_BADGE("stop") << LOG_DESC("stop websocket service successfully");
 }
@@ -159,6 +170,42 @@ void WsService::reportConnectedNodes()
     });
 }
 
+std::string WsService::metricsText() const
+{
+    auto text = std::atomic_load(&m_metricsText);
+    return text ? *text : std::string();
+}
+
+void WsService::refreshMetrics()
+{
+    auto text = std::make_shared<const std::string>(renderPrometheus(metrics(), m_moduleName));
+    std::atomic_store(&m_metricsText, text);
+
+    m_metricsTimer = std::make_shared<boost::asio::deadline_timer>(
+        *(m_timerIoc), boost::posix_time::milliseconds(m_config->metricsPeriod()));
+    auto self = std::weak_ptr<WsService>(shared_from_this());
+    m_metricsTimer->async_wait([self](const boost::system::error_code& _error) {
+        if (_error == boost::asio::error::operation_aborted)
+        {
+            return;
+        }
+        try
+        {
+            auto service = self.lock();
+            if (!service)
+            {
+                return;
+            }
+            service->refreshMetrics();
+        }
+        catch (std::exception const& e)
+        {
+            BOOST_SSL_LOG(WARNING) << LOG_DESC("refreshMetrics exception")
+                                   << LOG_KV("error", boost::diagnostic_information(e));
+        }
+    });
+}
+
 std::string WsService::genConnectError(
     const std::string& _error, const std::string& endpoint, bool end)
 {
@@ -250,29 +297,43 @@ WsService::asyncConnectToEndpoints(EndPointsPtr _peers)
         uint16_t port = peer.port();
 
         auto self = std::weak_ptr<WsService>(shared_from_this());
-        m_connector->connectToWsServer(host, port, m_config->disableSsl(),
-            [p, self, connectedEndPoint](boost::beast::error_code _ec,
-                const std::string& _extErrorMsg,
-                std::shared_ptr<WsStreamDelegate> _wsStreamDelegate,
-                std::shared_ptr<std::string> _nodeId) {
-                auto service = self.lock();
-                if (!service)
-                {
-                    return;
-                }
+        auto callback = [p, self, connectedEndPoint](boost::beast::error_code _ec,
+                            const std::string& _extErrorMsg,
+                            std::shared_ptr<WsStreamDelegate> _wsStreamDelegate,
+                            std::shared_ptr<std::string> _nodeId) {
+            auto service = self.lock();
+            if (!service)
+            {
+                return;
+            }
 
-                auto futResult = std::make_tuple(_ec, _extErrorMsg, connectedEndPoint);
-                p->set_value(futResult);
+            auto futResult = std::make_tuple(_ec, _extErrorMsg, connectedEndPoint);
+            p->set_value(futResult);
 
-                if (_ec)
-                {
-                    return;
-                }
+            if (_ec)
+            {
+                return;
+            }
 
-                auto session = service->newSession(_wsStreamDelegate, *_nodeId.get());
-                session->setConnectedEndPoint(connectedEndPoint);
-                session->startAsClient();
-            });
+            auto session = service->newSession(_wsStreamDelegate, *_nodeId.get());
+            session->setConnectedEndPoint(connectedEndPoint);
+            session->startAsClient();
+        };
+
+        if (m_config->isShmRingPeer(peer))
+        {
+            m_connector->connectToShmRing(
+                peer.unixSocketPath(), m_config->shmRingSize(), callback);
+            continue;
+        }
+        if (peer.isUnixSocket())
+        {
+            m_connector->connectToUnixSocket(
+                peer.unixSocketPath(), m_config->isTcpFramePeer(peer), callback);
+            continue;
+        }
+        m_connector->connectToWsServer(
+            host, port, m_config->disableSsl(), m_config->isTcpFramePeer(peer), callback);
     }
 
     return vPromise;
@@ -345,6 +406,10 @@ bool WsService::registerMsgHandler(uint16_t _msgType, MsgHandler _msgHandler)
     }
     UpgradeGuard ul(l);
     m_msgType2Method[_msgType] = _msgHandler;
+    if (!m_msgType2Latency.count(_msgType))
+    {
+        m_msgType2Latency[_msgType] = std::make_shared<WsLatencyMetrics>();
+    }
     return true;
 }
 
@@ -370,23 +435,86 @@ bool WsService::eraseMsgHandler(uint16_t _type)
     return true;
 }
 
+bool WsService::registerStreamHandler(uint16_t _msgType, WsStreamHandler _streamHandler)
+{
+    UpgradableGuard l(x_msgTypeHandlers);
+    if (m_streamType2Handler.count(_msgType) || !_streamHandler)
+    {
+        return false;
+    }
+    UpgradeGuard ul(l);
+    m_streamType2Handler[_msgType] = _streamHandler;
+    return true;
+}
+
+bool WsService::eraseStreamHandler(uint16_t _msgType)
+{
+    UpgradableGuard l(x_msgTypeHandlers);
+    if (!m_streamType2Handler.count(_msgType))
+    {
+        return false;
+    }
+    UpgradeGuard ul(l);
+    m_streamType2Handler.erase(_msgType);
+    return true;
+}
+
+bool WsService::registerRawFrameHandler(uint16_t _msgType, WsRawFrameHandler _rawFrameHandler)
+{
+    UpgradableGuard l(x_msgTypeHandlers);
+    if (m_rawType2Handler.count(_msgType) || !_rawFrameHandler)
+    {
+        return false;
+    }
+    UpgradeGuard ul(l);
+    m_rawType2Handler[_msgType] = _rawFrameHandler;
+    m_hasRawHandler->store(true, std::memory_order_relaxed);
+    return true;
+}
+
+bool WsService::eraseRawFrameHandler(uint16_t _msgType)
+{
+    UpgradableGuard l(x_msgTypeHandlers);
+    if (!m_rawType2Handler.count(_msgType))
+    {
+        return false;
+    }
+    UpgradeGuard ul(l);
+    m_rawType2Handler.erase(_msgType);
+    m_hasRawHandler->store(!m_rawType2Handler.empty(), std::memory_order_relaxed);
+    return true;
+}
+
 std::shared_ptr<WsSession> WsService::newSession(
     std::shared_ptr<WsStreamDelegate> _wsStreamDelegate, std::string const& _nodeId)
 {
     _wsStreamDelegate->setMaxReadMsgSize(m_config->maxMsgSize());
+    if (m_config->busyPollThreads() > 0)
+    {
+        _wsStreamDelegate->setBusyPoll(m_config->busyPollUs());
+    }
 
     std::string endPoint = _wsStreamDelegate->remoteEndpoint();
     auto session = m_sessionFactory->createSession(m_moduleName);
 
     session->setWsStreamDelegate(_wsStreamDelegate);
     session->setIoc(m_ioservicePool->getIOService());
-    session->setThreadPool(threadPool());
+    session->setThreadPool(affinityThreadPool(_wsStreamDelegate));
     session->setMessageFactory(messageFactory());
     session->setEndPoint(endPoint);
     session->setConnectedEndPoint(endPoint);
     session->setMaxWriteMsgSize(m_config->maxMsgSize());
     session->setSendMsgTimeout(m_config->sendMsgTimeout());
+    session->setSlowSendThreshold(m_config->slowSendThreshold());
+    session->setMessagePool(m_config->messagePool());
     session->setNodeId(_nodeId);
+    session->setTracer(m_tracer);
+    session->setCompressor(m_compressor);
+    session->setBatchMaxBytes(m_config->batchMaxBytes());
+    session->setBatchLingerUs(m_config->batchLingerUs());
+    session->setFragmentSize(m_config->fragmentSize());
+    session->setStreamWindow(m_config->streamWindow());
+    session->setStreamChunkSize(m_config->streamChunkSize());
 
     auto self = std::weak_ptr<WsService>(shared_from_this());
     session->setConnectHandler([self](Error::Ptr _error, std::shared_ptr<WsSession> _session) {
@@ -412,12 +540,76 @@ std::shared_ptr<WsSession> WsService::newSession(
                 wsService->onRecvMessage(_msg, _session);
             }
         });
+    session->setStreamHandler(
+        [self](std::shared_ptr<boostssl::MessageFace> _msg,
+            std::shared_ptr<WsSession> _session) -> WsStreamChunkHandler {
+            auto wsService = self.lock();
+            if (!wsService)
+            {
+                return nullptr;
+            }
+            WsStreamHandler streamHandler;
+            {
+                ReadGuard l(wsService->x_msgTypeHandlers);
+                auto it = wsService->m_streamType2Handler.find(_msg->packetType());
+                if (it != wsService->m_streamType2Handler.end())
+                {
+                    streamHandler = it->second;
+                }
+            }
+            return streamHandler ? streamHandler(_msg, _session) : nullptr;
+        });
+    // the session checks m_hasRawHandler before it peeks at a frame
+    session->setRawFrameHandler(
+        [self](const WsMessageHeader& _header, bytesConstRef _frame,
+            std::shared_ptr<WsSession> _session) {
+            auto wsService = self.lock();
+            if (!wsService)
+            {
+                return false;
+            }
+            WsRawFrameHandler rawFrameHandler;
+            {
+                ReadGuard l(wsService->x_msgTypeHandlers);
+                auto it = wsService->m_rawType2Handler.find(_header.packetType);
+                if (it != wsService->m_rawType2Handler.end())
+                {
+                    rawFrameHandler = it->second;
+                }
+            }
+            return rawFrameHandler && rawFrameHandler(_header, _frame, _session);
+        },
+        m_hasRawHandler);
 
     WEBSOCKET_SERVICE(INFO) << LOG_BADGE("newSession") << LOG_DESC("start the session")
                             << LOG_KV("endPoint", endPoint);
     return session;
 }
 
+std::shared_ptr<bcos::ThreadPool> WsService::affinityThreadPool(
+    boost::asio::execution_context* _ioc)
+{
+    auto it = m_affinityThreadPools.find(_ioc);
+    if (it != m_affinityThreadPools.end())
+    {
+        return it->second;
+    }
+    return threadPool();
+}
+
+std::shared_ptr<bcos::ThreadPool> WsService::affinityThreadPool(
+    std::shared_ptr<WsStreamDelegate> _wsStreamDelegate)
+{
+    if (m_affinityThreadPools.empty())
+    {
+        return threadPool();
+    }
+
+    // the session is driven by the io_context of its stream
+    auto& ioc = boost::asio::query(_wsStreamDelegate->executor(), boost::asio::execution::context);
+    return affinityThreadPool(&ioc);
+}
+
 void WsService::addSession(std::shared_ptr<WsSession> _session)
 {
     auto connectedEndPoint = _session->connectedEndPoint();
@@ -523,8 +715,23 @@ void WsService::onDisconnect(Error::Ptr _error, std::shared_ptr<WsSession> _sess
         connectedEndPoint = _session->connectedEndPoint();
     }
 
-    // clear the session
-    removeSession(connectedEndPoint);
+    // the closed session keeps counting in the totals of the service, its totals move there
+    // and the session is cleared under x_closedMetrics, metrics() sees either of them but never
+    // none or both
+    {
+        std::lock_guard<std::mutex> l(x_closedMetrics);
+        if (_session)
+        {
+            m_closedTraffic += _session->traffic();
+            m_closedSendLatency += _session->sendLatency();
+            auto reason = _session->dropReason();
+            if (reason != 0)
+            {
+                m_drops[reason]++;
+            }
+        }
+        removeSession(connectedEndPoint);
+    }
 
     for (auto& disHandler : m_disconnectHandlers)
     {
@@ -545,20 +752,33 @@ void WsService::onRecvMessage(
                              << LOG_DESC("receive message from server")
                              << LOG_KV("type", _msg->packetType()) << LOG_KV("seq", seq)
                              << LOG_KV("endpoint", _session->endPoint())
-                             << LOG_KV("data size", _msg->payload()->size())
+                             << LOG_KV("data size", _msg->payloadRef().size())
                              << LOG_KV("use_count", _session.use_count());
 
-    auto typeHandler = getMsgHandler(_msg->packetType());
+    MsgHandler typeHandler;
+    WsLatencyMetrics::Ptr latency;
+    {
+        ReadGuard l(x_msgTypeHandlers);
+        auto it = m_msgType2Method.find(_msg->packetType());
+        if (it != m_msgType2Method.end())
+        {
+            typeHandler = it->second;
+            latency = m_msgType2Latency.at(_msg->packetType());
+        }
+    }
     if (typeHandler)
     {
+        auto startPoint = std::chrono::steady_clock::now();
         typeHandler(_msg, _session);
+        auto elapsed = std::chrono::steady_clock::now() - startPoint;
+        latency->record(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
     }
     else
     {
         WEBSOCKET_SERVICE(WARNING)
             << LOG_BADGE("onRecvMessage") << LOG_DESC("unrecognized message type")
             << LOG_KV("type", _msg->packetType()) << LOG_KV("endpoint", _session->endPoint())
-            << LOG_KV("seq", seq) << LOG_KV("data size", _msg->payload()->size())
+            << LOG_KV("seq", seq) << LOG_KV("data size", _msg->payloadRef().size())
             << LOG_KV("use_count", _session.use_count());
     }
 }
@@ -728,4 +948,45 @@ void WsService::broadcastMessage(
     }
 
     WEBSOCKET_SERVICE(DEBUG) << LOG_BADGE("broadcastMessage");
-}
\ No newline at end of file
+}
+
+WsServiceSnapshot WsService::metrics()
+{
+    WsServiceSnapshot snapshot;
+    std::vector<std::shared_ptr<WsSession>> ss;
+    {
+        // the same order as onDisconnect, a closing session is counted once
+        std::lock_guard<std::mutex> l(x_closedMetrics);
+        snapshot.traffic = m_closedTraffic;
+        snapshot.sendLatency = m_closedSendLatency;
+        snapshot.drops = m_drops;
+        boost::shared_lock<boost::shared_mutex> lock(x_mutex);
+        for (const auto& session : m_sessions)
+        {
+            ss.push_back(session.second);
+        }
+    }
+    for (auto& session : ss)
+    {
+        auto sessionSnapshot = session->metrics();
+        snapshot.traffic += sessionSnapshot.traffic;
+        snapshot.sendLatency += sessionSnapshot.sendLatency;
+        snapshot.writeQueueSize += sessionSnapshot.writeQueueSize;
+        snapshot.callbacks += sessionSnapshot.callbacks;
+        snapshot.handlerBacklog += sessionSnapshot.handlerBacklog;
+        snapshot.sessions.push_back(std::move(sessionSnapshot));
+    }
+
+    {
+        ReadGuard l(x_msgTypeHandlers);
+        for (const auto& latency : m_msgType2Latency)
+        {
+            snapshot.handlers[latency.first] = latency.second->snapshot();
+        }
+    }
+    if (m_compressor)
+    {
+        snapshot.compression = m_compressor->metrics();
+    }
+    return snapshot;
+}
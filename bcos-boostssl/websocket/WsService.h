@@ -22,11 +22,14 @@
 #include <bcos-boostssl/httpserver/HttpServer.h>
 #include <bcos-boostssl/interfaces/MessageFace.h>
 #include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/WsCompressor.h>
 #include <bcos-boostssl/websocket/WsConfig.h>
 #include <bcos-boostssl/websocket/WsConnector.h>
 #include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-boostssl/websocket/WsMetrics.h>
 #include <bcos-boostssl/websocket/WsSession.h>
 #include <bcos-boostssl/websocket/WsStream.h>
+#include <bcos-boostssl/websocket/WsTracer.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/IOServicePool.h>
 #include <bcos-utilities/ThreadPool.h>
@@ -36,7 +39,9 @@
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/thread/thread.hpp>
+#include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -133,12 +138,30 @@ public:
         m_threadPool = _threadPool;
     }
 
+    // the thread pool to run the handler work of the sessions driven by the io_context
+    void setAffinityThreadPool(
+        boost::asio::execution_context* _ioc, std::shared_ptr<bcos::ThreadPool> _threadPool)
+    {
+        m_affinityThreadPools[_ioc] = _threadPool;
+    }
+    std::shared_ptr<bcos::ThreadPool> affinityThreadPool(boost::asio::execution_context* _ioc);
+    std::shared_ptr<bcos::ThreadPool> affinityThreadPool(
+        std::shared_ptr<WsStreamDelegate> _wsStreamDelegate);
+
     void setIOServicePool(IOServicePool::Ptr _ioservicePool)
     {
         m_ioservicePool = _ioservicePool;
         m_timerIoc = m_ioservicePool->getIOService();
     }
 
+    // the tracer of the sessions created after it is set
+    WsTracer::Ptr tracer() const { return m_tracer; }
+    void setTracer(WsTracer::Ptr _tracer) { m_tracer = _tracer; }
+
+    // the payload compression of the sessions created after it is set
+    WsCompressor::Ptr compressor() const { return m_compressor; }
+    void setCompressor(WsCompressor::Ptr _compressor) { m_compressor = _compressor; }
+
     std::shared_ptr<WsConnector> connector() const { return m_connector; }
     void setConnector(std::shared_ptr<WsConnector> _connector) { m_connector = _connector; }
 
@@ -165,6 +188,21 @@ public:
 
     bool eraseMsgHandler(uint16_t _msgType);
 
+    // accept the streams of the type from the peers, see WsSession::asyncSendStream
+    bool registerStreamHandler(uint16_t _msgType, WsStreamHandler _streamHandler);
+    bool eraseStreamHandler(uint16_t _msgType);
+
+    // take the messages of the type before they are decoded, to forward them with
+    // WsSession::asyncSendFrame
+    bool registerRawFrameHandler(uint16_t _msgType, WsRawFrameHandler _rawFrameHandler);
+    bool eraseRawFrameHandler(uint16_t _msgType);
+
+    // the traffic, the queues, the drops and the handler time of the service and its sessions
+    WsServiceSnapshot metrics();
+    // the metrics page in the prometheus text format, rendered every metricsPeriod
+    std::string metricsText() const;
+    void refreshMetrics();
+
     void registerConnectHandler(ConnectHandler _connectHandler)
     {
         m_connectHandlers.push_back(_connectHandler);
@@ -201,6 +239,10 @@ private:
     std::shared_ptr<MessageFaceFactory> m_messageFactory;
     // ThreadPool
     std::shared_ptr<bcos::ThreadPool> m_threadPool;
+    // io_context => ThreadPool on the same cpus or numa node, set only when cpu affinity is
+    // configured, it is not modified after the service started
+    std::unordered_map<boost::asio::execution_context*, std::shared_ptr<bcos::ThreadPool>>
+        m_affinityThreadPools;
     // listen host port
     std::string m_listenHost = "";
     uint16_t m_listenPort = 0;
@@ -215,10 +257,18 @@ private:
 
     // ws connector
     std::shared_ptr<WsConnector> m_connector;
+    // message lifecycle tracer, nullptr if disabled
+    WsTracer::Ptr m_tracer;
+    // payload compression, nullptr if disabled
+    WsCompressor::Ptr m_compressor;
     // reconnect timer
     std::shared_ptr<boost::asio::deadline_timer> m_reconnect;
     // heartbeat timer
     std::shared_ptr<boost::asio::deadline_timer> m_heartbeat;
+    // metrics timer
+    std::shared_ptr<boost::asio::deadline_timer> m_metricsTimer;
+    // the last rendered metrics page, swapped atomically
+    std::shared_ptr<const std::string> m_metricsText;
     // http server
     std::shared_ptr<bcos::boostssl::http::HttpServer> m_httpServer;
 
@@ -229,7 +279,21 @@ private:
     std::unordered_map<std::string, std::shared_ptr<WsSession>> m_sessions;
     // type => handler
     std::unordered_map<uint16_t, MsgHandler> m_msgType2Method;
+    // type => handler execution time, kept after the handler is erased
+    std::unordered_map<uint16_t, WsLatencyMetrics::Ptr> m_msgType2Latency;
+    // type => stream handler
+    std::unordered_map<uint16_t, WsStreamHandler> m_streamType2Handler;
+    // type => raw frame handler
+    std::unordered_map<uint16_t, WsRawFrameHandler> m_rawType2Handler;
+    // m_rawType2Handler is not empty, shared with the sessions that check it for each message
+    // without the lock
+    std::shared_ptr<std::atomic_bool> m_hasRawHandler = std::make_shared<std::atomic_bool>(false);
     mutable SharedMutex x_msgTypeHandlers;
+    // the traffic and the drop reasons of the closed sessions
+    mutable std::mutex x_closedMetrics;
+    WsTrafficSnapshot m_closedTraffic;
+    WsLatencySnapshot m_closedSendLatency;
+    std::map<int32_t, uint64_t> m_drops;
     // connected handlers, the handers will be called after ws protocol handshake
     // is complete
     std::vector<ConnectHandler> m_connectHandlers;
@@ -19,6 +19,7 @@
  */
 
 #include <bcos-boostssl/websocket/WsError.h>
+#include <bcos-boostssl/websocket/WsMessagePool.h>
 #include <bcos-boostssl/websocket/WsSession.h>
 #include <bcos-utilities/BoostLog.h>
 #include <bcos-utilities/Common.h>
@@ -26,14 +27,15 @@
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream.hpp>
 #include <boost/core/ignore_unused.hpp>
+#include <cerrno>
 #include <exception>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unistd.h>
 #include <utility>
 
 #define MESSAGE_SEND_DELAY_REPORT_MS (5000)
-#define MAX_MESSAGE_SEND_DELAY_MS (5000)
 
 using namespace bcos;
 using namespace bcos::boostssl;
@@ -55,22 +57,28 @@ void WsSession::drop(uint32_t _reason)
     }
 
     m_isDrop = true;
+    m_dropReason.store((int32_t)_reason, std::memory_order_relaxed);
 
     WEBSOCKET_SESSION(INFO) << LOG_BADGE("drop") << LOG_KV("reason", _reason)
                             << LOG_KV("endpoint", m_endPoint) << LOG_KV("session", this);
 
     auto self = std::weak_ptr<WsSession>(shared_from_this());
-    // call callbacks
+    // call callbacks, taken out first so that a response or a timeout does not call them again
     {
         auto error = std::make_shared<Error>(
             WsError::SessionDisconnect, "the session has been disconnected");
 
-        ReadGuard l(x_callback);
-        WEBSOCKET_SESSION(INFO) << LOG_BADGE("drop") << LOG_KV("reason", _reason)
+        std::unordered_map<std::string, CallBack::Ptr> callbacks;
+        {
+            WriteGuard lock(x_callback);
+            callbacks.swap(m_callbacks);
+            m_waiters.store(0, std::memory_order_relaxed);
+        }
+        WEBSOCKET_SESSION(DEBUG) << LOG_BADGE("drop") << LOG_KV("reason", _reason)
                                 << LOG_KV("endpoint", m_endPoint)
-                                << LOG_KV("cb size", m_callbacks.size()) << LOG_KV("session", this);
+                                << LOG_KV("cb size", callbacks.size()) << LOG_KV("session", this);
 
-        for (auto& cbEntry : m_callbacks)
+        for (auto& cbEntry : callbacks)
         {
             auto callback = cbEntry.second;
             if (callback->timer)
@@ -81,15 +89,29 @@ void WsSession::drop(uint32_t _reason)
             WEBSOCKET_SESSION(TRACE)
                 << LOG_DESC("the session has been disconnected") << LOG_KV("seq", cbEntry.first);
 
-            m_threadPool->enqueue(
-                [callback, error]() { callback->respCallBack(error, nullptr, nullptr); });
+            respondError(callback, error);
         }
     }
 
-    // clear callbacks
+    // fail the streams
     {
-        WriteGuard lock(x_callback);
-        m_callbacks.clear();
+        std::unordered_map<std::string, WsStreamSender::Ptr> senders;
+        std::unordered_map<std::string, WsStreamReceiver::Ptr> receivers;
+        {
+            std::lock_guard<std::mutex> l(x_streams);
+            senders.swap(m_streamSenders);
+            receivers.swap(m_streamReceivers);
+        }
+        auto error = std::make_shared<Error>(
+            WsError::SessionDisconnect, "the session has been disconnected");
+        for (auto& sender : senders)
+        {
+            finishStreamSender(sender.second, error);
+        }
+        for (auto& receiver : receivers)
+        {
+            failStreamReceiver(receiver.second, error);
+        }
     }
 
     if (m_wsStreamDelegate)
@@ -155,20 +177,23 @@ void WsSession::onReadPacket(boost::beast::flat_buffer& _buffer)
 {
     try
     {
+        auto receivedAt = m_tracer ? WsTracer::now() : 0;
         auto data = boost::asio::buffer_cast<byte*>(boost::beast::buffers_front(_buffer.data()));
         auto size = boost::asio::buffer_size(m_buffer.data());
 
-        auto message = m_messageFactory->buildMessage();
-        if (message->decode(bytesConstRef(data, size)) < 0)
-        {  // invalid packet, stop this session ?
-            WEBSOCKET_SESSION(WARNING)
-                << LOG_BADGE("onReadPacket") << LOG_DESC("decode packet error")
-                << LOG_KV("endpoint", endPoint()) << LOG_KV("session", this);
-            return drop(WsError::PacketError);
+        // the fragment frames only come from the peers the fragmentation was advertised to
+        bytesConstRef slice;
+        bool last = false;
+        if (m_fragmentSize > 0 &&
+            WsMessage::fragmentPayload(bytesConstRef(data, size), slice, last))
+        {
+            onReadFragment(slice, last, receivedAt);
+        }
+        else
+        {
+            onReadFrame(bytesConstRef(data, size), receivedAt);
         }
-
         m_buffer.consume(_buffer.size());
-        onMessage(message);
     }
     catch (std::exception const& e)
     {
@@ -177,16 +202,216 @@ void WsSession::onReadPacket(boost::beast::flat_buffer& _buffer)
     }
 }
 
+void WsSession::onReadFrame(bytesConstRef _frame, int64_t _receivedAt)
+{
+    // the batch frames only come from the peers the batching was advertised to
+    bytesConstRef batch;
+    if (m_batchMaxBytes > 0 && WsMessage::batchPayload(_frame, batch))
+    {
+        return onReadBatch(batch, _receivedAt);
+    }
+
+    if (rawFrameEnabled() && onRawFrame(_frame))
+    {
+        return;
+    }
+    auto message = m_messageFactory->buildMessage();
+    if (message->decode(_frame) < 0)
+    {  // invalid packet, stop this session ?
+        WEBSOCKET_SESSION(WARNING) << LOG_BADGE("onReadFrame") << LOG_DESC("decode packet error")
+                                   << LOG_KV("endpoint", endPoint()) << LOG_KV("session", this);
+        return drop(WsError::PacketError);
+    }
+    onDecodedMessage(message, _frame.size(), _receivedAt);
+}
+
+void WsSession::onReadFragment(bytesConstRef _slice, bool _last, int64_t _receivedAt)
+{
+    // the largest frame of a message is the header, the longest seq and the largest payload
+    auto maxSize = m_maxWriteMsgSize > 0 ?
+                       (std::size_t)m_maxWriteMsgSize + WsMessage::MESSAGE_MIN_LENGTH + UINT16_MAX :
+                       SIZE_MAX;
+    if (m_fragmentBuffer.size() + _slice.size() > maxSize)
+    {
+        WEBSOCKET_SESSION(WARNING)
+            << LOG_BADGE("onReadFragment") << LOG_DESC("the fragments exceed the message size")
+            << LOG_KV("size", m_fragmentBuffer.size() + _slice.size())
+            << LOG_KV("endpoint", endPoint()) << LOG_KV("session", this);
+        bcos::bytes().swap(m_fragmentBuffer);
+        return drop(WsError::PacketError);
+    }
+    m_fragmentBuffer.insert(m_fragmentBuffer.end(), _slice.data(), _slice.data() + _slice.size());
+    if (!_last)
+    {
+        return;
+    }
+    // the reassembled message is released after the decoding
+    bcos::bytes frame;
+    frame.swap(m_fragmentBuffer);
+    onReadFrame(bytesConstRef(frame.data(), frame.size()), _receivedAt);
+}
+
+void WsSession::onReadBatch(bytesConstRef _payload, int64_t _receivedAt)
+{
+    std::size_t offset = 0;
+    while (offset < _payload.size())
+    {
+        auto p = _payload.data() + offset;
+        uint32_t length = 0;
+        if (offset + WsMessage::BATCH_LENGTH_PREFIX <= _payload.size())
+        {
+            for (std::size_t i = 0; i < WsMessage::BATCH_LENGTH_PREFIX; ++i)
+            {
+                length = (length << 8) | p[i];
+            }
+            offset += WsMessage::BATCH_LENGTH_PREFIX;
+        }
+        if (length > 0 && offset + length <= _payload.size() && rawFrameEnabled() &&
+            onRawFrame(bytesConstRef(_payload.data() + offset, length)))
+        {
+            offset += length;
+            continue;
+        }
+        auto message = m_messageFactory->buildMessage();
+        if (length == 0 || offset + length > _payload.size() ||
+            message->decode(bytesConstRef(_payload.data() + offset, length)) < 0)
+        {
+            WEBSOCKET_SESSION(WARNING)
+                << LOG_BADGE("onReadBatch") << LOG_DESC("decode batch frame error")
+                << LOG_KV("endpoint", endPoint()) << LOG_KV("offset", offset)
+                << LOG_KV("size", _payload.size()) << LOG_KV("session", this);
+            return drop(WsError::PacketError);
+        }
+        offset += length;
+        onDecodedMessage(message, length, _receivedAt);
+    }
+}
+
+void WsSession::onDecodedMessage(
+    std::shared_ptr<MessageFace> _message, std::size_t _size, int64_t _receivedAt)
+{
+    m_traffic.onRead(_size);
+    auto ext = _message->ext();
+    auto accepted = acceptAdvertisements(ext);
+    if (accepted != ext)
+    {
+        _message->setExt(accepted);
+    }
+    if (streamEnabled() &&
+        (_message->ext() & (MessageExtFieldFlag::Chunk | MessageExtFieldFlag::ChunkCredit)))
+    {
+        return onStreamMessage(_message);
+    }
+    if (m_tracer)
+    {
+        auto trace = m_tracer->newTrace(_message->seq(), _message->packetType(), _size);
+        if (trace)
+        {
+            m_tracer->trace(this, *trace, WsTraceEvent::Received, _receivedAt);
+            m_tracer->trace(this, *trace, WsTraceEvent::Decoded);
+        }
+    }
+    // the responses of asyncRequest skip the thread pool, the compressed ones are decompressed
+    // there
+    if (m_waiters.load(std::memory_order_relaxed) > 0 && !compressedPayload(_message->ext()))
+    {
+        auto callback = takeResponseWaiter(_message);
+        if (callback)
+        {
+            if (callback->timer)
+            {
+                callback->timer->cancel();
+            }
+            return callback->respond(nullptr, _message, nullptr);
+        }
+    }
+    onMessage(_message);
+}
+
+bool WsSession::onRawFrame(bytesConstRef _frame)
+{
+    WsMessageHeader header;
+    // the chunks of the streams belong to the session, the broken frames fail the decoding
+    if (!WsMessage::peekHeader(_frame, header) ||
+        (streamEnabled() &&
+            (header.ext & (MessageExtFieldFlag::Chunk | MessageExtFieldFlag::ChunkCredit))))
+    {
+        return false;
+    }
+    // the responses to the requests of this session go to their callbacks
+    if ((header.ext & MessageExtFieldFlag::Response) &&
+        getAndRemoveRespCallback(
+            std::string((const char*)header.seq.data(), header.seq.size()), false))
+    {
+        return false;
+    }
+    auto ext = header.ext;
+    header.ext = acceptAdvertisements(ext);
+    if (!m_rawFrameHandler(header, _frame, shared_from_this()))
+    {
+        // the advertisements are seen again by the decoding
+        return false;
+    }
+    m_traffic.onRead(_frame.size());
+    return true;
+}
+
+uint16_t WsSession::acceptAdvertisements(uint16_t _ext)
+{
+    auto supported = _ext & advertisements();
+    if (!supported)
+    {
+        return _ext;
+    }
+    if (supported & MessageExtFieldFlag::FragmentSupported)
+    {
+        m_peerFragment.store(true, std::memory_order_relaxed);
+    }
+    if (supported & MessageExtFieldFlag::CompressSupported)
+    {
+        m_peerCompress.store(true, std::memory_order_relaxed);
+    }
+    if (supported & MessageExtFieldFlag::BatchSupported)
+    {
+        m_peerBatch.store(true, std::memory_order_relaxed);
+    }
+    return _ext & ~supported;
+}
+
+uint16_t WsSession::advertisements() const
+{
+    return (m_compressor ? MessageExtFieldFlag::CompressSupported : 0) |
+           (m_batchMaxBytes > 0 ? MessageExtFieldFlag::BatchSupported : 0) |
+           (m_fragmentSize > 0 ? MessageExtFieldFlag::FragmentSupported : 0);
+}
+
 void WsSession::onMessage(bcos::boostssl::MessageFace::Ptr _message)
 {
     auto self = std::weak_ptr<WsSession>(shared_from_this());
+    m_handlerBacklog.fetch_add(1, std::memory_order_relaxed);
+    WsTraceContext::Ptr trace;
+    if (m_tracer)
+    {
+        trace = m_tracer->newTrace(
+            _message->seq(), _message->packetType(), _message->payloadRef().size());
+    }
     // task enqueue
-    m_threadPool->enqueue([_message, self]() {
+    m_threadPool->enqueue([_message, self, trace]() {
         auto session = self.lock();
         if (!session)
         {
             return;
         }
+        session->m_handlerBacklog.fetch_sub(1, std::memory_order_relaxed);
+        if (trace)
+        {
+            session->m_tracer->trace(session.get(), *trace, WsTraceEvent::Dispatched);
+        }
+        // on the thread pool, off the io thread
+        if (session->compressedPayload(_message->ext()) && !session->decompressMessage(_message))
+        {
+            return;
+        }
         auto callback = session->getAndRemoveRespCallback(_message->seq(), true, _message);
         if (callback)
         {
@@ -195,12 +420,16 @@ void WsSession::onMessage(bcos::boostssl::MessageFace::Ptr _message)
                 callback->timer->cancel();
             }
 
-            callback->respCallBack(nullptr, _message, session);
+            callback->respond(nullptr, _message, session);
         }
         else
         {
             session->recvMessageHandler()(_message, session);
         }
+        if (trace)
+        {
+            session->m_tracer->trace(session.get(), *trace, WsTraceEvent::Handled);
+        }
     });
 }
 
@@ -241,7 +470,7 @@ void WsSession::onRead(boost::system::error_code _ec, std::size_t)
     asyncRead();
 }
 
-void WsSession::onWritePacket()
+void WsSession::onWritePacket(bool _mayLinger)
 {
     if (m_writing)
     {
@@ -252,18 +481,112 @@ void WsSession::onWritePacket()
     {
         return;
     }
-    if (m_writeQueue.empty())
+    if (m_writeQueue.empty() && m_largeQueue.empty())
     {
         m_writing = false;
         return;
     }
+    auto batching = m_batchMaxBytes > 0 && m_peerBatch.load(std::memory_order_relaxed);
+    // a message to an idle session waits for the ones behind it, until the window ends or a
+    // batch is filled, the messages queued during a write go without waiting
+    if (_mayLinger && batching && m_batchLingerUs > 0 && m_largeQueue.empty() &&
+        m_writeQueueBytes < m_batchMaxBytes)
+    {
+        if (!m_lingering.exchange(true))
+        {
+            if (!m_lingerTimer)
+            {
+                // on the io thread of the stream, the handler writes to it
+                m_lingerTimer =
+                    std::make_shared<boost::asio::steady_timer>(m_wsStreamDelegate->executor());
+            }
+            auto self = std::weak_ptr<WsSession>(shared_from_this());
+            m_lingerTimer->expires_after(std::chrono::microseconds(m_batchLingerUs));
+            m_lingerTimer->async_wait([self](const boost::system::error_code& _error) {
+                auto session = self.lock();
+                if (!session || _error)
+                {
+                    return;
+                }
+                session->m_lingering = false;
+                session->onWritePacket();
+            });
+        }
+        return;
+    }
+
     m_writing = true;
-    auto msg = m_writeQueue.top();
+    m_writingMsgs.clear();
+    // the next fragment of the large message when no other message waits, so a message sent
+    // meanwhile waits for one fragment at most
+    if (m_writeQueue.empty())
+    {
+        auto msg = m_largeQueue.front();
+        if (m_fragmentOffset == 0 && msg->trace)
+        {
+            m_tracer->trace(this, *msg->trace, WsTraceEvent::WriteStart);
+        }
+        auto size = std::min<std::size_t>(m_fragmentSize, msg->buffer->size() - m_fragmentOffset);
+        auto last = m_fragmentOffset + size == msg->buffer->size();
+        auto buffer = m_messageFactory->buildBuffer();
+        WsMessage::encodeFragment(
+            *buffer, bytesConstRef(msg->buffer->data() + m_fragmentOffset, size), last);
+        m_fragmentOffset += size;
+        if (last)
+        {
+            m_largeQueue.pop();
+            m_fragmentOffset = 0;
+            m_writingMsgs.push_back(msg);
+        }
+        return asyncWrite(buffer);
+    }
+    auto msg = m_writeQueue.front();
     m_writeQueue.pop();
-    asyncWrite(msg->buffer);
+    m_writingMsgs.push_back(msg);
+    if (msg->file)
+    {
+        // the file follows its header in the kernel, nothing is packed with it
+        m_writeQueueBytes -= msg->size();
+        if (msg->trace)
+        {
+            m_tracer->trace(this, *msg->trace, WsTraceEvent::WriteStart);
+        }
+        return asyncWrite(msg->buffer, msg->file);
+    }
+    auto buffer = msg->buffer;
+    auto frameBytes =
+        WsMessage::MESSAGE_MIN_LENGTH + WsMessage::BATCH_LENGTH_PREFIX + buffer->size();
+    while (batching && !m_writeQueue.empty() && !m_writeQueue.front()->file &&
+           frameBytes + WsMessage::BATCH_LENGTH_PREFIX + m_writeQueue.front()->buffer->size() <=
+               m_batchMaxBytes)
+    {
+        frameBytes += WsMessage::BATCH_LENGTH_PREFIX + m_writeQueue.front()->buffer->size();
+        m_writingMsgs.push_back(m_writeQueue.front());
+        m_writeQueue.pop();
+    }
+    if (m_writingMsgs.size() > 1)
+    {
+        buffer = m_messageFactory->buildBuffer();
+        buffer->reserve(frameBytes);
+        WsMessage::beginBatch(*buffer);
+    }
+    for (const auto& writingMsg : m_writingMsgs)
+    {
+        m_writeQueueBytes -= writingMsg->buffer->size();
+        if (m_writingMsgs.size() > 1)
+        {
+            WsMessage::appendToBatch(*buffer,
+                bytesConstRef(writingMsg->buffer->data(), writingMsg->buffer->size()));
+        }
+        if (writingMsg->trace)
+        {
+            m_tracer->trace(this, *writingMsg->trace, WsTraceEvent::WriteStart);
+        }
+    }
+    asyncWrite(buffer);
 }
 
-void WsSession::asyncWrite(std::shared_ptr<bcos::bytes> _buffer)
+void WsSession::asyncWrite(std::shared_ptr<bcos::bytes> _buffer, FileRange::Ptr _file)
 {
     if (!isConnected())
     {
@@ -276,28 +599,39 @@ void WsSession::asyncWrite(std::shared_ptr<bcos::bytes> _buffer)
     try
     {
         auto self = std::weak_ptr<WsSession>(shared_from_this());
-        // Note: add one simple way to monitor message sending latency
+        // Note: the send latency of the message is recorded in onWriteFinished
         // Note: the lamda[] should not include session directly, this will cause memory leak
-        m_wsStreamDelegate->asyncWrite(
-            *_buffer, [self, _buffer](boost::beast::error_code _ec, std::size_t) {
-                auto session = self.lock();
-                if (!session)
-                {
-                    return;
-                }
-                if (_ec)
-                {
-                    BCOS_LOG(WARNING) << LOG_BADGE(session->moduleName()) << LOG_BADGE("Session")
-                                      << LOG_BADGE("asyncWrite") << LOG_KV("message", _ec.message())
-                                      << LOG_KV("endpoint", session->endPoint());
-                    return session->drop(WsError::WriteError);
-                }
-                if (session->m_writing)
-                {
-                    session->m_writing = false;
-                }
-                session->onWritePacket();
-            });
+        auto handler = [self, _buffer, _file](boost::beast::error_code _ec, std::size_t _size) {
+            auto session = self.lock();
+            if (!session)
+            {
+                return;
+            }
+            if (_ec)
+            {
+                BOOSTSSL_LOG(WARNING)
+                    << LOG_BADGE(session->moduleName()) << LOG_BADGE("Session")
+                    << LOG_BADGE("asyncWrite") << LOG_KV("message", _ec.message())
+                    << LOG_KV("endpoint", session->endPoint());
+                return session->drop(WsError::WriteError);
+            }
+            session->m_traffic.onWrite(_size, session->m_writingMsgs.size());
+            session->onWriteFinished();
+            if (session->m_writing)
+            {
+                session->m_writing = false;
+            }
+            session->onWritePacket();
+        };
+        if (_file)
+        {
+            m_wsStreamDelegate->asyncWriteFile(
+                *_buffer, _file->fd, _file->offset, _file->size, std::move(handler));
+        }
+        else
+        {
+            m_wsStreamDelegate->asyncWrite(*_buffer, std::move(handler));
+        }
     }
     catch (const std::exception& _e)
     {
@@ -309,16 +643,159 @@ void WsSession::asyncWrite(std::shared_ptr<bcos::bytes> _buffer)
     }
 }
 
-void WsSession::send(std::shared_ptr<bytes> _buffer)
+void WsSession::onWriteFinished()
+{
+    if (m_writingMsgs.empty())
+    {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& writingMsg : m_writingMsgs)
+    {
+        if (writingMsg->trace)
+        {
+            m_tracer->trace(this, *writingMsg->trace, WsTraceEvent::Written);
+        }
+        m_sendLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(
+            now - writingMsg->enqueueTime)
+                                 .count());
+    }
+    // the first one of a batch has waited the longest
+    auto msg = m_writingMsgs.front();
+    m_writingMsgs.clear();
+    auto delayMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - msg->enqueueTime).count();
+
+    // a slow peer or a large message ahead in the queue, reported once in a while
+    if (delayMs <= m_slowSendThreshold)
+    {
+        return;
+    }
+    m_traffic.onSlowSend();
+    if (now - m_sendDelayReportTime > std::chrono::milliseconds(MESSAGE_SEND_DELAY_REPORT_MS))
+    {
+        m_sendDelayReportTime = now;
+        WEBSOCKET_SESSION(WARNING)
+            << LOG_BADGE("onWriteFinished") << LOG_DESC("message send delay too long")
+            << LOG_KV("endpoint", endPoint()) << LOG_KV("delay(ms)", delayMs)
+            << LOG_KV("msgSize", msg->buffer->size()) << LOG_KV("queueSize", msgQueueSize());
+    }
+}
+
+void WsSession::send(
+    std::shared_ptr<bytes> _buffer, WsTraceContext::Ptr _trace, FileRange::Ptr _file)
 {
-    auto msg = std::make_shared<Message>();
+    auto msg = m_messagePool ? std::allocate_shared<Message>(WsPoolAllocator<Message>()) :
+                               std::make_shared<Message>();
     msg->buffer = _buffer;
+    msg->file = std::move(_file);
+    msg->enqueueTime = std::chrono::steady_clock::now();
+    msg->trace = _trace;
     {
         WriteGuard l(x_writeQueue);
         // data to be sent is always enqueue first
-        m_writeQueue.push(msg);
+        if (m_fragmentSize > 0 && !msg->file && _buffer->size() > m_fragmentSize &&
+            m_peerFragment.load(std::memory_order_relaxed))
+        {
+            m_largeQueue.push(msg);
+        }
+        else
+        {
+            m_writeQueue.push(msg);
+            m_writeQueueBytes += msg->size();
+        }
+    }
+    if (_trace)
+    {
+        m_tracer->trace(this, *_trace, WsTraceEvent::Enqueued);
+    }
+    onWritePacket(true);
+}
+
+bool WsSession::encodeMessage(std::shared_ptr<MessageFace> _msg, bytes& _buffer)
+{
+    // the compression and the advertisements work on the fields of WsMessage
+    auto supported = advertisements();
+    auto wsMessage = supported ? std::dynamic_pointer_cast<WsMessage>(_msg) : nullptr;
+    if (!wsMessage)
+    {
+        return _msg->encode(_buffer);
+    }
+    // the message may be broadcast to the sessions, the flags and the compressed payload only go
+    // to the buffer and the message is left as it is
+    auto ext = (uint16_t)(wsMessage->ext() | supported);
+    auto payload = wsMessage->payloadRef();
+    if (m_compressor && m_peerCompress.load(std::memory_order_relaxed) &&
+        payload.size() >= m_compressor->threshold())
+    {
+        auto compressed = m_messageFactory->buildBuffer();
+        if (m_compressor->compress(payload, *compressed))
+        {
+            return wsMessage->encode(_buffer,
+                bytesConstRef(compressed->data(), compressed->size()),
+                (uint16_t)(ext | MessageExtFieldFlag::Compressed));
+        }
     }
-    onWritePacket();
+    return wsMessage->encode(_buffer, payload, ext);
+}
+
+bool WsSession::decompressMessage(std::shared_ptr<MessageFace> _msg)
+{
+    auto maxSize = m_maxWriteMsgSize > 0 ? (uint32_t)m_maxWriteMsgSize : UINT32_MAX;
+    auto payload = m_messageFactory->buildBuffer();
+    if (!m_compressor || !m_compressor->decompress(_msg->payloadRef(), *payload, maxSize))
+    {
+        WEBSOCKET_SESSION(WARNING)
+            << LOG_BADGE("decompressMessage") << LOG_DESC("drop the message")
+            << LOG_KV("compression", m_compressor != nullptr) << LOG_KV("endpoint", endPoint())
+            << LOG_KV("seq", _msg->seq()) << LOG_KV("size", _msg->payloadRef().size());
+        return false;
+    }
+    _msg->setPayload(payload);
+    _msg->setExt(_msg->ext() & ~MessageExtFieldFlag::Compressed);
+    return true;
+}
+
+bool WsSession::asyncSendFrame(bytesConstRef _frame)
+{
+    WsMessageHeader header;
+    if (!isConnected() || !WsMessage::peekHeader(_frame, header))
+    {
+        return false;
+    }
+    // the frames of the link itself are not messages to forward
+    if (header.ext & (MessageExtFieldFlag::Batch | MessageExtFieldFlag::Fragment |
+                         MessageExtFieldFlag::Chunk | MessageExtFieldFlag::ChunkCredit))
+    {
+        return false;
+    }
+    if ((header.ext & MessageExtFieldFlag::Compressed) && !compressedPayload(header.ext))
+    {
+        return false;
+    }
+    if ((int64_t)header.payload.size() > (int64_t)maxWriteMsgSize())
+    {
+        WEBSOCKET_SESSION(WARNING)
+            << LOG_BADGE("asyncSendFrame") << LOG_DESC("send message size overflow")
+            << LOG_KV("endpoint", endPoint()) << LOG_KV("msgSize", header.payload.size())
+            << LOG_KV("maxWriteMsgSize", maxWriteMsgSize());
+        return false;
+    }
+
+    auto buffer = m_messageFactory->buildBuffer();
+    buffer->assign(_frame.data(), _frame.data() + _frame.size());
+    auto ext = (uint16_t)((header.ext & ~(MessageExtFieldFlag::CompressSupported |
+                                             MessageExtFieldFlag::BatchSupported |
+                                             MessageExtFieldFlag::FragmentSupported)) |
+                          advertisements());
+    if (ext != header.ext)
+    {
+        WsMessage::setFrameExt(*buffer, ext);
+    }
+    boost::asio::post(m_wsStreamDelegate->executor(),
+        boost::beast::bind_front_handler(
+            &WsSession::send, shared_from_this(), buffer, nullptr, nullptr));
+    return true;
 }
 
 /**
@@ -330,8 +807,99 @@ void WsSession::send(std::shared_ptr<bytes> _buffer)
  */
 void WsSession::asyncSendMessage(
     std::shared_ptr<MessageFace> _msg, Options _options, RespCallBack _respFunc)
+{
+    sendMessage(_msg, _options, newCallBack(_respFunc), nullptr);
+}
+
+void WsSession::asyncSendFile(std::shared_ptr<MessageFace> _msg, int _fd, uint64_t _offset,
+    std::size_t _size, Options _options, RespCallBack _respFunc)
+{
+    // the payload of WsMessage is the tail of the frame, the file follows the header as it is
+    if (std::dynamic_pointer_cast<WsMessage>(_msg) && m_wsStreamDelegate &&
+        m_wsStreamDelegate->canSendFile())
+    {
+        auto file = std::make_shared<FileRange>();
+        file->fd = ::dup(_fd);
+        file->offset = _offset;
+        file->size = _size;
+        if (file->fd >= 0)
+        {
+            _msg->setPayload(m_messageFactory->buildBuffer());
+            return sendMessage(_msg, _options, newCallBack(_respFunc), file);
+        }
+    }
+
+    // the fallback for ssl, websocket and the other transports, it reads the range into memory
+    // and the ranges sendMessage would reject are not read at all
+    if ((int64_t)_size > (int64_t)maxWriteMsgSize())
+    {
+        WEBSOCKET_SESSION(WARNING)
+            << LOG_BADGE("asyncSendFile") << LOG_DESC("send message size overflow")
+            << LOG_KV("endpoint", endPoint()) << LOG_KV("seq", _msg->seq())
+            << LOG_KV("size", _size) << LOG_KV("maxWriteMsgSize", maxWriteMsgSize());
+        if (_respFunc)
+        {
+            _respFunc(std::make_shared<Error>(WsError::MessageOverflow, "Message size overflow"),
+                nullptr, nullptr);
+        }
+        return;
+    }
+    auto payload = m_messageFactory->buildBuffer();
+    payload->resize(_size);
+    std::size_t read = 0;
+    while (read < _size)
+    {
+        auto n = ::pread(_fd, payload->data() + read, _size - read, _offset + read);
+        if (n > 0)
+        {
+            read += n;
+        }
+        else if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else
+        {
+            // 0 if the file ends before the range
+            auto error = n < 0 ? errno : 0;
+            WEBSOCKET_SESSION(WARNING)
+                << LOG_BADGE("asyncSendFile") << LOG_DESC("read the file failed")
+                << LOG_KV("seq", _msg->seq()) << LOG_KV("offset", _offset)
+                << LOG_KV("size", _size) << LOG_KV("read", read) << LOG_KV("errno", error);
+            if (_respFunc)
+            {
+                _respFunc(std::make_shared<Error>(WsError::FileReadError, "read the file failed"),
+                    nullptr, nullptr);
+            }
+            return;
+        }
+    }
+    _msg->setPayload(payload);
+    sendMessage(_msg, _options, newCallBack(_respFunc), nullptr);
+}
+
+WsSession::FileRange::~FileRange()
+{
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+}
+
+void WsSession::sendMessage(std::shared_ptr<MessageFace> _msg, Options _options,
+    CallBack::Ptr _callback, FileRange::Ptr _file)
 {
     auto seq = _msg->seq();
+    auto payloadSize = _msg->payloadRef().size() + (_file ? _file->size : 0);
+    WsTraceContext::Ptr trace;
+    if (m_tracer)
+    {
+        trace = m_tracer->newTrace(seq, _msg->packetType(), payloadSize);
+        if (trace)
+        {
+            m_tracer->trace(this, *trace, WsTraceEvent::SendStart);
+        }
+    }
 
     if (!isConnected())
     {
@@ -339,56 +907,58 @@ void WsSession::asyncSendMessage(
             << LOG_BADGE("asyncSendMessage") << LOG_DESC("the session has been disconnected")
             << LOG_KV("seq", seq) << LOG_KV("endpoint", endPoint());
 
-        if (_respFunc)
+        if (_callback)
         {
             auto error = std::make_shared<Error>(
                 WsError::SessionDisconnect, "the session has been disconnected");
-            _respFunc(error, nullptr, nullptr);
+            _callback->respond(error, nullptr, nullptr);
         }
 
         return;
     }
 
     // check if message size overflow
-    if ((int64_t)_msg->payload()->size() > (int64_t)maxWriteMsgSize())
+    if ((int64_t)payloadSize > (int64_t)maxWriteMsgSize())
     {
-        if (_respFunc)
+        if (_callback)
         {
             auto error = std::make_shared<Error>(WsError::MessageOverflow, "Message size overflow");
-            _respFunc(error, nullptr, nullptr);
+            _callback->respond(error, nullptr, nullptr);
         }
 
         WEBSOCKET_SESSION(WARNING)
             << LOG_BADGE("asyncSendMessage") << LOG_DESC("send message size overflow")
             << LOG_KV("endpoint", endPoint()) << LOG_KV("seq", seq)
-            << LOG_KV("msgSize", _msg->payload()->size())
-            << LOG_KV("maxWriteMsgSize", maxWriteMsgSize());
+            << LOG_KV("msgSize", payloadSize) << LOG_KV("maxWriteMsgSize", maxWriteMsgSize());
         return;
     }
 
-    auto buffer = std::make_shared<bytes>();
-    auto r = _msg->encode(*buffer);
+    auto buffer = m_messageFactory->buildBuffer();
+    auto r = encodeMessage(_msg, *buffer);
     if (!r)
     {
-        if (_respFunc)
+        if (_callback)
         {
             auto error =
                 std::make_shared<Error>(WsError::MessageEncodeError, "Message encode failed");
-            _respFunc(error, nullptr, nullptr);
+            _callback->respond(error, nullptr, nullptr);
         }
 
         WEBSOCKET_SESSION(WARNING)
             << LOG_BADGE("asyncSendMessage") << LOG_DESC("message encode failed")
             << LOG_KV("endpoint", endPoint()) << LOG_KV("seq", seq)
-            << LOG_KV("msgSize", _msg->payload()->size())
+            << LOG_KV("msgSize", _msg->payloadRef().size())
             << LOG_KV("maxWriteMsgSize", maxWriteMsgSize());
         return;
     }
+    if (trace)
+    {
+        m_tracer->trace(this, *trace, WsTraceEvent::Encoded);
+    }
 
-    if (_respFunc)
+    if (_callback)
     {  // callback
-        auto callback = std::make_shared<CallBack>();
-        callback->respCallBack = _respFunc;
+        auto callback = _callback;
         auto timeout = _options.timeout > 0 ? _options.timeout : m_sendMsgTimeout;
         if (timeout > 0)
         {
@@ -411,14 +981,442 @@ void WsSession::asyncSendMessage(
     }
 
     {
-        boost::asio::post(m_wsStreamDelegate->tcpStream().get_executor(),
-            boost::beast::bind_front_handler(&WsSession::send, shared_from_this(), buffer));
+        boost::asio::post(m_wsStreamDelegate->executor(),
+            boost::beast::bind_front_handler(
+                &WsSession::send, shared_from_this(), buffer, trace, _file));
+    }
+}
+
+std::string WsSession::asyncSendStream(
+    uint16_t _type, WsStreamSource _source, WsStreamSendCallback _callback)
+{
+    auto sender = std::make_shared<WsStreamSender>();
+    sender->seq = m_messageFactory->newSeq();
+    sender->type = _type;
+    sender->source = std::move(_source);
+    sender->callback = std::move(_callback);
+    if (!isConnected())
+    {
+        finishStreamSender(sender, std::make_shared<Error>(WsError::SessionDisconnect,
+                                       "the session has been disconnected"));
+        return sender->seq;
+    }
+    if (!streamEnabled())
+    {
+        finishStreamSender(sender,
+            std::make_shared<Error>(WsError::StreamAborted, "the streams are disabled"));
+        return sender->seq;
+    }
+    {
+        std::lock_guard<std::mutex> l(x_streams);
+        m_streamSenders[sender->seq] = sender;
+    }
+    auto payload = m_messageFactory->buildBuffer();
+    payload->assign(1, (byte)WsChunkFlag::ChunkOpen);
+    sendStreamFrame(sender->seq, _type, MessageExtFieldFlag::Chunk, payload);
+
+    WEBSOCKET_SESSION(DEBUG) << LOG_BADGE("asyncSendStream") << LOG_DESC("open the stream")
+                             << LOG_KV("seq", sender->seq) << LOG_KV("type", _type)
+                             << LOG_KV("endpoint", endPoint());
+    return sender->seq;
+}
+
+void WsSession::sendStreamFrame(
+    const std::string& _seq, uint16_t _type, uint16_t _ext, std::shared_ptr<bytes> _payload)
+{
+    auto message = m_messageFactory->buildMessage();
+    message->setPacketType(_type);
+    message->setSeq(_seq);
+    message->setExt(_ext);
+    message->setPayload(std::move(_payload));
+    asyncSendMessage(message);
+}
+
+void WsSession::onStreamMessage(std::shared_ptr<MessageFace> _message)
+{
+    auto ext = _message->ext();
+    if (ext & MessageExtFieldFlag::ChunkCredit)
+    {
+        return onStreamCredit(_message);
+    }
+    auto payload = _message->payloadRef();
+    if (payload.size() == 0)
+    {
+        WEBSOCKET_SESSION(WARNING) << LOG_BADGE("onStreamMessage") << LOG_DESC("empty chunk")
+                                   << LOG_KV("seq", _message->seq())
+                                   << LOG_KV("endpoint", endPoint());
+        return;
+    }
+    // the flags of a compressed chunk are read after the decompression, the open and the abort
+    // chunks are too small to be compressed
+    auto flags = compressedPayload(ext) ? 0 : payload.data()[0];
+    if (flags & WsChunkFlag::ChunkOpen)
+    {
+        return onStreamOpen(_message);
+    }
+
+    WsStreamReceiver::Ptr receiver;
+    WsStreamSender::Ptr sender;
+    {
+        std::lock_guard<std::mutex> l(x_streams);
+        auto it = m_streamReceivers.find(_message->seq());
+        if (it != m_streamReceivers.end())
+        {
+            receiver = it->second;
+        }
+        else if (flags & WsChunkFlag::ChunkAbort)
+        {
+            auto senderIt = m_streamSenders.find(_message->seq());
+            if (senderIt != m_streamSenders.end())
+            {
+                sender = senderIt->second;
+            }
+        }
+    }
+    if (sender)
+    {
+        return finishStreamSender(
+            sender, std::make_shared<Error>(WsError::StreamAborted, "aborted by the receiver"));
+    }
+    if (!receiver)
+    {
+        // the stream was finished or failed here
+        return;
+    }
+
+    bool drain = false;
+    {
+        std::lock_guard<std::mutex> l(receiver->mutex);
+        // the sender never has more than the window unacknowledged, the compressed chunks are
+        // smaller than their data and the flag byte
+        if (receiver->queuedBytes + receiver->consumed + payload.size() - 1 > m_streamWindow &&
+            !receiver->error)
+        {
+            receiver->error =
+                std::make_shared<Error>(WsError::StreamAborted, "the window was exceeded");
+            auto abort = m_messageFactory->buildBuffer();
+            abort->assign(1, (byte)WsChunkFlag::ChunkAbort);
+            sendStreamFrame(receiver->seq, receiver->type, MessageExtFieldFlag::Chunk, abort);
+        }
+        else if (!receiver->error)
+        {
+            receiver->queuedBytes += payload.size() - 1;
+            receiver->chunks.push_back(_message);
+        }
+        if (!receiver->draining)
+        {
+            receiver->draining = true;
+            drain = true;
+        }
+    }
+    if (drain)
+    {
+        auto self = std::weak_ptr<WsSession>(shared_from_this());
+        m_threadPool->enqueue([self, receiver]() {
+            auto session = self.lock();
+            if (session)
+            {
+                session->drainStream(receiver);
+            }
+        });
+    }
+}
+
+void WsSession::onStreamOpen(std::shared_ptr<MessageFace> _message)
+{
+    auto handler =
+        m_streamHandler ? m_streamHandler(_message, shared_from_this()) : WsStreamChunkHandler();
+    if (!handler)
+    {
+        WEBSOCKET_SESSION(INFO) << LOG_BADGE("onStreamOpen") << LOG_DESC("reject the stream")
+                                << LOG_KV("seq", _message->seq())
+                                << LOG_KV("type", _message->packetType())
+                                << LOG_KV("endpoint", endPoint());
+        auto abort = m_messageFactory->buildBuffer();
+        abort->assign(1, (byte)WsChunkFlag::ChunkAbort);
+        return sendStreamFrame(
+            _message->seq(), _message->packetType(), MessageExtFieldFlag::Chunk, abort);
+    }
+
+    auto receiver = std::make_shared<WsStreamReceiver>();
+    receiver->seq = _message->seq();
+    receiver->type = _message->packetType();
+    receiver->handler = std::move(handler);
+    {
+        std::lock_guard<std::mutex> l(x_streams);
+        m_streamReceivers[receiver->seq] = receiver;
+    }
+    sendStreamFrame(receiver->seq, receiver->type, MessageExtFieldFlag::ChunkCredit,
+        WsChunkStream::encodeCredit(m_messageFactory->buildBuffer(), m_streamWindow, 0));
+}
+
+void WsSession::onStreamCredit(std::shared_ptr<MessageFace> _message)
+{
+    uint32_t grant = 0;
+    uint8_t flags = 0;
+    if (!WsChunkStream::decodeCredit(_message->payloadRef(), grant, flags))
+    {
+        WEBSOCKET_SESSION(WARNING) << LOG_BADGE("onStreamCredit") << LOG_DESC("invalid credit")
+                                   << LOG_KV("seq", _message->seq())
+                                   << LOG_KV("endpoint", endPoint());
+        return;
+    }
+    WsStreamSender::Ptr sender;
+    {
+        std::lock_guard<std::mutex> l(x_streams);
+        auto it = m_streamSenders.find(_message->seq());
+        if (it == m_streamSenders.end())
+        {
+            return;
+        }
+        sender = it->second;
+    }
+
+    bool pump = false;
+    {
+        std::lock_guard<std::mutex> l(sender->mutex);
+        if (sender->window == 0)
+        {
+            sender->window = std::max(grant, 1u);
+        }
+        else
+        {
+            sender->outstanding -= std::min<uint64_t>(grant, sender->outstanding);
+        }
+        if (!(flags & WsChunkFlag::ChunkEnd) && !sender->pumping && !sender->ended)
+        {
+            sender->pumping = true;
+            pump = true;
+        }
+    }
+    if (flags & WsChunkFlag::ChunkEnd)
+    {
+        return finishStreamSender(sender, nullptr);
+    }
+    if (pump)
+    {
+        auto self = std::weak_ptr<WsSession>(shared_from_this());
+        m_threadPool->enqueue([self, sender]() {
+            auto session = self.lock();
+            if (session)
+            {
+                session->pumpStream(sender);
+            }
+        });
+    }
+}
+
+void WsSession::pumpStream(WsStreamSender::Ptr _sender)
+{
+    auto maxChunk = std::min<uint64_t>(m_streamChunkSize,
+        m_maxWriteMsgSize > 1 ? (uint64_t)m_maxWriteMsgSize - 1 : m_streamChunkSize);
+    // the fragmented messages may be overtaken by the smaller ones, the chunks of a stream fit in
+    // a fragment to stay in order
+    if (m_fragmentSize > 0)
+    {
+        maxChunk = std::min<uint64_t>(
+            maxChunk, m_fragmentSize - WsMessage::MESSAGE_MIN_LENGTH - _sender->seq.size() - 1);
+    }
+    while (true)
+    {
+        uint64_t size = 0;
+        {
+            std::lock_guard<std::mutex> l(_sender->mutex);
+            if (_sender->finished || _sender->ended || _sender->outstanding >= _sender->window)
+            {
+                _sender->pumping = false;
+                return;
+            }
+            size = std::min(_sender->window - _sender->outstanding, maxChunk);
+        }
+
+        auto payload = m_messageFactory->buildBuffer();
+        payload->resize(1 + size);
+        int64_t read = -1;
+        try
+        {
+            read = _sender->source(payload->data() + 1, size);
+        }
+        catch (std::exception const& e)
+        {
+            WEBSOCKET_SESSION(WARNING) << LOG_BADGE("pumpStream") << LOG_DESC("source exception")
+                                       << LOG_KV("seq", _sender->seq)
+                                       << LOG_KV("error", boost::diagnostic_information(e));
+        }
+        if (read < 0 || (uint64_t)read > size)
+        {
+            payload->assign(1, (byte)WsChunkFlag::ChunkAbort);
+            sendStreamFrame(_sender->seq, _sender->type, MessageExtFieldFlag::Chunk, payload);
+            return finishStreamSender(_sender,
+                std::make_shared<Error>(WsError::StreamAborted, "aborted by the source"));
+        }
+
+        payload->resize(1 + read);
+        (*payload)[0] = read == 0 ? (byte)WsChunkFlag::ChunkEnd : 0;
+        {
+            std::lock_guard<std::mutex> l(_sender->mutex);
+            _sender->outstanding += read;
+            _sender->ended = read == 0;
+        }
+        sendStreamFrame(_sender->seq, _sender->type, MessageExtFieldFlag::Chunk, payload);
+    }
+}
+
+void WsSession::drainStream(WsStreamReceiver::Ptr _receiver)
+{
+    while (true)
+    {
+        std::shared_ptr<MessageFace> chunk;
+        bcos::Error::Ptr error;
+        {
+            std::lock_guard<std::mutex> l(_receiver->mutex);
+            if (_receiver->finished)
+            {
+                _receiver->draining = false;
+                return;
+            }
+            if (_receiver->error)
+            {
+                error = _receiver->error;
+                _receiver->chunks.clear();
+            }
+            else if (_receiver->chunks.empty())
+            {
+                _receiver->draining = false;
+                return;
+            }
+            else
+            {
+                chunk = _receiver->chunks.front();
+                _receiver->chunks.pop_front();
+                _receiver->queuedBytes -= std::min<uint64_t>(
+                    _receiver->queuedBytes, chunk->payloadRef().size() - 1);
+            }
+        }
+        if (chunk && compressedPayload(chunk->ext()) && !decompressMessage(chunk))
+        {
+            error = std::make_shared<Error>(WsError::StreamAborted, "invalid compressed chunk");
+        }
+        auto payload = chunk ? chunk->payloadRef() : bytesConstRef();
+        if (!error && (payload.size() == 0 || (payload.data()[0] & WsChunkFlag::ChunkAbort)))
+        {
+            error = std::make_shared<Error>(WsError::StreamAborted, "aborted by the sender");
+        }
+        if (error)
+        {
+            {
+                std::lock_guard<std::mutex> l(x_streams);
+                m_streamReceivers.erase(_receiver->seq);
+            }
+            {
+                std::lock_guard<std::mutex> l(_receiver->mutex);
+                _receiver->finished = true;
+                _receiver->draining = false;
+            }
+            _receiver->handler(error, bytesConstRef(), false);
+            return;
+        }
+
+        auto end = (payload.data()[0] & WsChunkFlag::ChunkEnd) != 0;
+        auto data = bytesConstRef(payload.data() + 1, payload.size() - 1);
+        _receiver->handler(nullptr, data, end);
+
+        uint64_t grant = 0;
+        {
+            std::lock_guard<std::mutex> l(_receiver->mutex);
+            _receiver->consumed += data.size();
+            // grant back a quarter of the window at a time, and the rest at the end
+            if (end || _receiver->consumed >= m_streamWindow / 4)
+            {
+                grant = _receiver->consumed;
+                _receiver->consumed = 0;
+            }
+            if (end)
+            {
+                _receiver->finished = true;
+                _receiver->draining = false;
+            }
+        }
+        if (end)
+        {
+            std::lock_guard<std::mutex> l(x_streams);
+            m_streamReceivers.erase(_receiver->seq);
+        }
+        if (grant > 0 || end)
+        {
+            sendStreamFrame(_receiver->seq, _receiver->type, MessageExtFieldFlag::ChunkCredit,
+                WsChunkStream::encodeCredit(m_messageFactory->buildBuffer(), grant,
+                    end ? (uint8_t)WsChunkFlag::ChunkEnd : 0));
+        }
+        if (end)
+        {
+            return;
+        }
+    }
+}
+
+void WsSession::finishStreamSender(WsStreamSender::Ptr _sender, bcos::Error::Ptr _error)
+{
+    {
+        std::lock_guard<std::mutex> l(x_streams);
+        m_streamSenders.erase(_sender->seq);
+    }
+    {
+        std::lock_guard<std::mutex> l(_sender->mutex);
+        if (_sender->finished)
+        {
+            return;
+        }
+        _sender->finished = true;
+    }
+    WEBSOCKET_SESSION(DEBUG) << LOG_BADGE("finishStreamSender") << LOG_KV("seq", _sender->seq)
+                             << LOG_KV("error", _error ? _error->errorMessage() : "")
+                             << LOG_KV("endpoint", endPoint());
+    if (_sender->callback)
+    {
+        auto callback = std::move(_sender->callback);
+        m_threadPool->enqueue([callback, _error]() { callback(_error); });
+    }
+}
+
+void WsSession::failStreamReceiver(WsStreamReceiver::Ptr _receiver, bcos::Error::Ptr _error)
+{
+    bool drain = false;
+    {
+        std::lock_guard<std::mutex> l(_receiver->mutex);
+        if (_receiver->finished || _receiver->error)
+        {
+            return;
+        }
+        _receiver->error = _error;
+        if (!_receiver->draining)
+        {
+            _receiver->draining = true;
+            drain = true;
+        }
+    }
+    if (drain)
+    {
+        // the session may be gone, the receiver is drained without it
+        m_threadPool->enqueue([_receiver, _error]() {
+            {
+                std::lock_guard<std::mutex> l(_receiver->mutex);
+                _receiver->finished = true;
+                _receiver->draining = false;
+                _receiver->chunks.clear();
+            }
+            _receiver->handler(_error, bytesConstRef(), false);
+        });
     }
 }
 
 void WsSession::addRespCallback(const std::string& _seq, CallBack::Ptr _callback)
 {
     WriteGuard lock(x_callback);
+    if (_callback->waiter)
+    {
+        m_waiters.fetch_add(1, std::memory_order_relaxed);
+    }
     m_callbacks[_seq] = _callback;
 }
 
@@ -443,6 +1441,10 @@ WsSession::CallBack::Ptr WsSession::getAndRemoveRespCallback(
             {
                 UpgradeGuard ul(l);
                 m_callbacks.erase(it);
+                if (callback->waiter)
+                {
+                    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+                }
             }
         }
     }
@@ -450,6 +1452,25 @@ WsSession::CallBack::Ptr WsSession::getAndRemoveRespCallback(
     return callback;
 }
 
+WsSession::CallBack::Ptr WsSession::takeResponseWaiter(std::shared_ptr<MessageFace> _message)
+{
+    if (needCheckRspPacket() && !_message->isRespPacket())
+    {
+        return nullptr;
+    }
+    UpgradableGuard l(x_callback);
+    auto it = m_callbacks.find(_message->seq());
+    if (it == m_callbacks.end() || !it->second->waiter)
+    {
+        return nullptr;
+    }
+    auto callback = it->second;
+    UpgradeGuard ul(l);
+    m_callbacks.erase(it);
+    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    return callback;
+}
+
 void WsSession::onRespTimeout(const boost::system::error_code& _error, const std::string& _seq)
 {
     if (_error)
@@ -463,9 +1484,74 @@ void WsSession::onRespTimeout(const boost::system::error_code& _error, const std
         return;
     }
 
+    m_traffic.onTimeout();
+    if (m_tracer)
+    {
+        auto trace = m_tracer->newTrace(_seq, 0, 0);
+        if (trace)
+        {
+            m_tracer->trace(this, *trace, WsTraceEvent::TimedOut);
+        }
+    }
     WEBSOCKET_SESSION(WARNING) << LOG_BADGE("onRespTimeout") << LOG_KV("seq", _seq);
 
     auto error =
         std::make_shared<Error>(WsError::TimeOut, "waiting for message response timed out");
-    m_threadPool->enqueue([callback, error]() { callback->respCallBack(error, nullptr, nullptr); });
+    respondError(callback, error);
+}
+
+bool WsSession::cancelRequest(const std::string& _seq)
+{
+    auto callback = getAndRemoveRespCallback(_seq);
+    if (!callback)
+    {
+        return false;
+    }
+    if (callback->timer)
+    {
+        callback->timer->cancel();
+    }
+    WEBSOCKET_SESSION(DEBUG) << LOG_BADGE("cancelRequest") << LOG_KV("seq", _seq)
+                             << LOG_KV("endpoint", endPoint());
+    respondError(
+        callback, std::make_shared<Error>(WsError::RequestCancelled, "the request is cancelled"));
+    return true;
+}
+
+WsSession::CallBack::Ptr WsSession::newCallBack(RespCallBack _respFunc)
+{
+    if (!_respFunc)
+    {
+        return nullptr;
+    }
+    auto callback = std::make_shared<CallBack>();
+    callback->respCallBack = std::move(_respFunc);
+    return callback;
+}
+
+void WsSession::respondError(CallBack::Ptr _callback, bcos::Error::Ptr _error)
+{
+    // the waiters go to their own executors, the callbacks to the thread pool
+    if (_callback->waiter)
+    {
+        return _callback->waiter->complete(_error, nullptr);
+    }
+    m_threadPool->enqueue([_callback, _error]() { _callback->respond(_error, nullptr, nullptr); });
+}
+
+WsSessionSnapshot WsSession::metrics()
+{
+    WsSessionSnapshot snapshot;
+    snapshot.endPoint = m_endPoint;
+    snapshot.connectedEndPoint = m_connectedEndPoint;
+    snapshot.traffic = m_traffic.snapshot();
+    snapshot.sendLatency = m_sendLatency.snapshot();
+    snapshot.writeQueueSize = msgQueueSize();
+    {
+        ReadGuard l(x_callback);
+        snapshot.callbacks = m_callbacks.size();
+    }
+    snapshot.handlerBacklog = m_handlerBacklog.load(std::memory_order_relaxed);
+    snapshot.dropReason = dropReason();
+    return snapshot;
 }
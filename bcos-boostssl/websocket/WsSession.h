@@ -20,21 +20,34 @@
 #pragma once
 #include <bcos-boostssl/httpserver/Common.h>
 #include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/WsChunkStream.h>
+#include <bcos-boostssl/websocket/WsCompressor.h>
 #include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-boostssl/websocket/WsMetrics.h>
+#include <bcos-boostssl/websocket/WsResponseWaiter.h>
 #include <bcos-boostssl/websocket/WsStream.h>
+#include <bcos-boostssl/websocket/WsTracer.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <bcos-utilities/Timer.h>
+#include <boost/asio/async_result.hpp>
 #include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/thread/thread.hpp>
 #include <atomic>
+#include <tuple>
+#include <chrono>
 #include <mutex>
 #include <queue>
 #include <shared_mutex>
 #include <unordered_map>
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#endif
 
 namespace bcos
 {
@@ -43,6 +56,11 @@ namespace boostssl
 namespace ws
 {
 class WsService;
+// called on the io thread with each message received before it is decoded, the frame is valid
+// only during the call, returns true if it took the frame, false to decode and dispatch it
+using WsRawFrameHandler = std::function<bool(
+    const WsMessageHeader& _header, bytesConstRef _frame, std::shared_ptr<WsSession> _session)>;
+
 // The websocket session for connection
 class WsSession : public std::enable_shared_from_this<WsSession>
 {
@@ -50,6 +68,9 @@ public:
     using Ptr = std::shared_ptr<WsSession>;
     using Ptrs = std::vector<std::shared_ptr<WsSession>>;
 
+    // leaves room for the data of a chunk of a stream in a frame not fragmented
+    static constexpr uint32_t MIN_FRAGMENT_SIZE = 1024;
+
 public:
     WsSession(std::string _moduleName = "DEFAULT");
 
@@ -80,6 +101,81 @@ public:
     virtual void asyncSendMessage(std::shared_ptr<boostssl::MessageFace> _msg,
         Options _options = Options(), RespCallBack _respCallback = RespCallBack());
 
+    /**
+     * @brief: async send a request and complete the token with the response, the handler of the
+     * token is kept as it is and runs on its own executor, the response is handed to it from the
+     * io thread unless the payload is compressed
+     * @param _msg: the request, cancelRequest with its seq
+     * @param _options: options, the timeout is the deadline of the response
+     * @param _token: the completion token of void(bcos::Error::Ptr, MessageFace::Ptr)
+     */
+    template <typename CompletionToken>
+    auto asyncRequest(
+        std::shared_ptr<boostssl::MessageFace> _msg, Options _options, CompletionToken&& _token)
+    {
+        return boost::asio::async_initiate<CompletionToken, WsResponseSignature>(
+            [self = shared_from_this(), _msg, _options](auto&& _handler) {
+                using Handler = std::decay_t<decltype(_handler)>;
+                using Waiter =
+                    WsResponseWaiterImpl<Handler, boost::asio::io_context::executor_type>;
+                auto callback = std::make_shared<CallBack>();
+                callback->waiter = std::make_unique<Waiter>(
+                    std::forward<decltype(_handler)>(_handler), self->m_ioc->get_executor());
+                self->sendMessage(_msg, _options, callback, nullptr);
+            },
+            _token);
+    }
+
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+    // auto [error, response] = co_await session->request(msg, options);
+    boost::asio::awaitable<std::tuple<bcos::Error::Ptr, std::shared_ptr<boostssl::MessageFace>>>
+    request(std::shared_ptr<boostssl::MessageFace> _msg, Options _options = Options())
+    {
+        return asyncRequest(_msg, _options, boost::asio::use_awaitable);
+    }
+#endif
+
+    // complete the request waiting for the response with WsError::RequestCancelled, false if it
+    // is not waiting
+    bool cancelRequest(const std::string& _seq);
+
+    /**
+     * @brief: async send a payload of any size as a stream of chunks, the chunks are read from
+     * the source on the thread pool as the receiver grants the window
+     * @param _type: the packet type the stream handler of the receiver is chosen by
+     * @param _source: the source of the payload
+     * @param _callback: called when the receiver consumed the whole stream or it failed, fails
+     * with StreamAborted if the streams are disabled here, see setStreamWindow
+     * @return std::string: the seq of the stream
+     */
+    std::string asyncSendStream(
+        uint16_t _type, WsStreamSource _source, WsStreamSendCallback _callback);
+
+    /**
+     * @brief: async send the encoded message received by a session as it is, without decoding
+     * and encoding it again, the advertisements in its ext are replaced by those of this session
+     * @param _frame: the frame passed to the WsRawFrameHandler, copied once
+     * @return bool: false if the session is disconnected, the frame is not a message or its
+     * payload is compressed and the peer does not decompress, decode and send it instead
+     */
+    bool asyncSendFrame(bytesConstRef _frame);
+
+    /**
+     * @brief: async send a message with the payload from a range of a file, the file is sent
+     * with sendfile after the header on the tcp frame transport without ssl, otherwise the range
+     * is read into the payload on the calling thread and the message is sent as usual
+     * @param _msg: the message, its payload is replaced
+     * @param _fd: the file, duplicated and may be closed after the call
+     * @param _offset: the offset of the range
+     * @param _size: the size of the range
+     * @param _options: options
+     * @param _respCallback: callback
+     * @return void:
+     */
+    void asyncSendFile(std::shared_ptr<boostssl::MessageFace> _msg, int _fd, uint64_t _offset,
+        std::size_t _size, Options _options = Options(),
+        RespCallBack _respCallback = RespCallBack());
+
 
     std::string endPoint() const { return m_endPoint; }
     void setEndPoint(const std::string& _endPoint) { m_endPoint = _endPoint; }
@@ -105,6 +201,20 @@ public:
     }
     WsRecvMessageHandler recvMessageHandler() { return m_recvMessageHandler; }
 
+    // accepts the streams of the peer, the streams are rejected without it
+    void setStreamHandler(WsStreamHandler _streamHandler) { m_streamHandler = _streamHandler; }
+    WsStreamHandler streamHandler() { return m_streamHandler; }
+
+    // takes the messages received before they are decoded, see asyncSendFrame, only while
+    // _rawFrameEnabled is set if given, the frames skip the header peek otherwise
+    void setRawFrameHandler(WsRawFrameHandler _rawFrameHandler,
+        std::shared_ptr<const std::atomic_bool> _rawFrameEnabled = nullptr)
+    {
+        m_rawFrameHandler = _rawFrameHandler;
+        m_rawFrameEnabled = _rawFrameEnabled;
+    }
+    WsRawFrameHandler rawFrameHandler() { return m_rawFrameHandler; }
+
     std::shared_ptr<MessageFaceFactory> messageFactory() { return m_messageFactory; }
     void setMessageFactory(std::shared_ptr<MessageFaceFactory> _messageFactory)
     {
@@ -135,13 +245,24 @@ public:
     int32_t sendMsgTimeout() const { return m_sendMsgTimeout; }
     void setSendMsgTimeout(int32_t _sendMsgTimeout) { m_sendMsgTimeout = _sendMsgTimeout; }
 
+    // the ms from the write queue to the socket over which a send is slow
+    uint32_t slowSendThreshold() const { return m_slowSendThreshold; }
+    void setSlowSendThreshold(uint32_t _slowSendThreshold)
+    {
+        m_slowSendThreshold = _slowSendThreshold;
+    }
+
+    // the queued messages come from the WsMessagePool free lists
+    bool messagePool() const { return m_messagePool; }
+    void setMessagePool(bool _messagePool) { m_messagePool = _messagePool; }
+
     int32_t maxWriteMsgSize() const { return m_maxWriteMsgSize; }
     void setMaxWriteMsgSize(int32_t _maxWriteMsgSize) { m_maxWriteMsgSize = _maxWriteMsgSize; }
 
     std::size_t msgQueueSize()
     {
         bcos::ReadGuard l(x_writeQueue);
-        return m_writeQueue.size();
+        return m_writeQueue.size() + m_largeQueue.size();
     }
 
     std::string nodeId() { return m_nodeId; }
@@ -156,16 +277,93 @@ public:
         m_needCheckRspPacket = _needCheckRespPacket;
     }
 
+    // the WsError the session was dropped for, 0 if the session is alive
+    int32_t dropReason() const { return m_dropReason.load(std::memory_order_relaxed); }
+
+    WsTrafficSnapshot traffic() const { return m_traffic.snapshot(); }
+    WsLatencySnapshot sendLatency() const { return m_sendLatency.snapshot(); }
+    WsSessionSnapshot metrics();
+
+    // trace the lifecycle of the sampled messages, nullptr disables the tracing
+    WsTracer::Ptr tracer() const { return m_tracer; }
+    void setTracer(WsTracer::Ptr _tracer) { m_tracer = _tracer; }
+
+    // compress the payloads sent to the peer once it advertised the support, nullptr disables
+    // the compression and the advertisement
+    WsCompressor::Ptr compressor() const { return m_compressor; }
+    void setCompressor(WsCompressor::Ptr _compressor) { m_compressor = _compressor; }
+    bool peerCompress() const { return m_peerCompress.load(std::memory_order_relaxed); }
+
+    // pack the queued messages into batch frames of up to _batchMaxBytes for the peers that
+    // support it, 0 disables the batching and the advertisement
+    uint32_t batchMaxBytes() const { return m_batchMaxBytes; }
+    void setBatchMaxBytes(uint32_t _batchMaxBytes) { m_batchMaxBytes = _batchMaxBytes; }
+    // how long a message sent to an idle session waits for the next ones to share its frame
+    uint32_t batchLingerUs() const { return m_batchLingerUs; }
+    void setBatchLingerUs(uint32_t _batchLingerUs) { m_batchLingerUs = _batchLingerUs; }
+    bool peerBatch() const { return m_peerBatch.load(std::memory_order_relaxed); }
+
+    // split the messages larger than _fragmentSize into fragment frames for the peers that
+    // support it, the smaller messages are written between the fragments, 0 disables the
+    // fragmentation and the advertisement
+    uint32_t fragmentSize() const { return m_fragmentSize; }
+    void setFragmentSize(uint32_t _fragmentSize)
+    {
+        m_fragmentSize = _fragmentSize > 0 ? std::max(_fragmentSize, MIN_FRAGMENT_SIZE) : 0;
+    }
+    bool peerFragment() const { return m_peerFragment.load(std::memory_order_relaxed); }
+
+    // the unacknowledged bytes of a stream received, granted to the sender of the stream, 0
+    // disables the streams as by default, the chunk flags of the messages are then the user's
+    uint32_t streamWindow() const { return m_streamWindow; }
+    void setStreamWindow(uint32_t _streamWindow) { m_streamWindow = _streamWindow; }
+    bool streamEnabled() const { return m_streamWindow > 0; }
+    // the data bytes of a chunk sent
+    uint32_t streamChunkSize() const { return m_streamChunkSize; }
+    void setStreamChunkSize(uint32_t _streamChunkSize)
+    {
+        m_streamChunkSize = std::max(_streamChunkSize, 1u);
+    }
+
 protected:
     struct CallBack
     {
         using Ptr = std::shared_ptr<CallBack>;
         RespCallBack respCallBack;
+        // the handler of asyncRequest, in place of respCallBack
+        WsResponseWaiter::UniquePtr waiter;
         std::shared_ptr<boost::asio::deadline_timer> timer;
+
+        void respond(bcos::Error::Ptr _error, std::shared_ptr<boostssl::MessageFace> _message,
+            std::shared_ptr<WsSession> _session)
+        {
+            if (waiter)
+            {
+                return waiter->complete(std::move(_error), std::move(_message));
+            }
+            respCallBack(std::move(_error), std::move(_message), std::move(_session));
+        }
     };
+    // a range of a file written after the header of a message, the fd is closed with it
+    struct FileRange
+    {
+        using Ptr = std::shared_ptr<FileRange>;
+        ~FileRange();
+        int fd = -1;
+        uint64_t offset = 0;
+        std::size_t size = 0;
+    };
+    void sendMessage(std::shared_ptr<boostssl::MessageFace> _msg, Options _options,
+        CallBack::Ptr _callback, FileRange::Ptr _file);
+
     virtual void addRespCallback(const std::string& _seq, CallBack::Ptr _callback);
     CallBack::Ptr getAndRemoveRespCallback(const std::string& _seq, bool _remove = true,
         std::shared_ptr<MessageFace> _message = nullptr);
+    // remove the callback of the response if it is an asyncRequest, on the io thread
+    CallBack::Ptr takeResponseWaiter(std::shared_ptr<MessageFace> _message);
+    static CallBack::Ptr newCallBack(RespCallBack _respFunc);
+    // complete the callback with the error off the calling thread
+    void respondError(CallBack::Ptr _callback, bcos::Error::Ptr _error);
     virtual void onRespTimeout(const boost::system::error_code& _error, const std::string& _seq);
 
     virtual void onWsAccept(boost::beast::error_code _ec);
@@ -173,18 +371,106 @@ protected:
     virtual void asyncRead();
     virtual void onRead(boost::system::error_code ec, std::size_t bytes_transferred);
 
-    virtual void asyncWrite(std::shared_ptr<bcos::bytes> _buffer);
-    virtual void send(std::shared_ptr<bcos::bytes> _buffer);
+    virtual void asyncWrite(std::shared_ptr<bcos::bytes> _buffer, FileRange::Ptr _file = nullptr);
+    virtual void send(std::shared_ptr<bcos::bytes> _buffer, WsTraceContext::Ptr _trace = nullptr,
+        FileRange::Ptr _file = nullptr);
 
     // async read
     virtual void onReadPacket(boost::beast::flat_buffer& _buffer);
-    void onWritePacket();
+    // a whole frame, read or reassembled from the fragments
+    void onReadFrame(bytesConstRef _frame, int64_t _receivedAt);
+    void onReadFragment(bytesConstRef _slice, bool _last, int64_t _receivedAt);
+    // unpack the messages of a batch frame and dispatch them in order
+    void onReadBatch(bytesConstRef _payload, int64_t _receivedAt);
+    void onDecodedMessage(std::shared_ptr<MessageFace> _message, std::size_t _size,
+        int64_t _receivedAt);
+    // offer the message to the raw frame handler, true if it took the message
+    bool rawFrameEnabled() const
+    {
+        return m_rawFrameHandler &&
+               (!m_rawFrameEnabled || m_rawFrameEnabled->load(std::memory_order_relaxed));
+    }
+    bool onRawFrame(bytesConstRef _frame);
+    // record the features the peer advertised in the ext, returns the ext without them, only the
+    // advertisements of the features on in this session are taken, the others stay in the ext
+    uint16_t acceptAdvertisements(uint16_t _ext);
+    // the features this session advertises in the ext of its messages
+    uint16_t advertisements() const;
+    // _mayLinger: called for a new message, which may wait for the linger window
+    void onWritePacket(bool _mayLinger = false);
+    // record the send latency of the message just written
+    void onWriteFinished();
+
+    // the MessageExtFieldFlag::Chunk and ChunkCredit messages, on the io thread
+    void onStreamMessage(std::shared_ptr<MessageFace> _message);
+    void onStreamOpen(std::shared_ptr<MessageFace> _message);
+    void onStreamCredit(std::shared_ptr<MessageFace> _message);
+    // read the chunks from the source while the window allows, on the thread pool
+    void pumpStream(WsStreamSender::Ptr _sender);
+    // run the handler on the queued chunks in order, on the thread pool
+    void drainStream(WsStreamReceiver::Ptr _receiver);
+    void finishStreamSender(WsStreamSender::Ptr _sender, bcos::Error::Ptr _error);
+    void failStreamReceiver(WsStreamReceiver::Ptr _receiver, bcos::Error::Ptr _error);
+    void sendStreamFrame(const std::string& _seq, uint16_t _type, uint16_t _ext,
+        std::shared_ptr<bcos::bytes> _payload);
+
+    // encode the message, with the payload compressed when the compression applies
+    bool encodeMessage(std::shared_ptr<MessageFace> _msg, bcos::bytes& _buffer);
+    // replace the compressed payload of the received message with the original one
+    bool decompressMessage(std::shared_ptr<MessageFace> _msg);
+    // the payload was compressed by the peer, only if the compression is on here and the peer
+    // advertised it, otherwise the flag belongs to the user and the message is passed on as it is
+    bool compressedPayload(uint16_t _ext) const
+    {
+        return (_ext & MessageExtFieldFlag::Compressed) && m_compressor &&
+               m_peerCompress.load(std::memory_order_relaxed);
+    }
 
 protected:
     // flag for message that need to check respond packet like p2pmessage
     bool m_needCheckRspPacket = false;
     //
     std::atomic_bool m_isDrop = false;
+    std::atomic<int32_t> m_dropReason = 0;
+    // the received messages waiting in the thread pool
+    std::atomic<int64_t> m_handlerBacklog = 0;
+    // bytes and messages in and out, timeouts and slow sends
+    WsTrafficMetrics m_traffic;
+    // the time from the write queue to the end of the socket write
+    WsLatencyMetrics m_sendLatency;
+    // the last time a slow send was reported
+    std::chrono::steady_clock::time_point m_sendDelayReportTime;
+    uint32_t m_slowSendThreshold = 5000;
+    bool m_messagePool = false;
+    // the lifecycle tracer, nullptr if disabled
+    WsTracer::Ptr m_tracer;
+    // the payload compression, nullptr if disabled
+    WsCompressor::Ptr m_compressor;
+    // the peer set MessageExtFieldFlag::CompressSupported on a message
+    std::atomic_bool m_peerCompress = false;
+    // batch frames, m_batchMaxBytes 0 if disabled
+    uint32_t m_batchMaxBytes = 0;
+    uint32_t m_batchLingerUs = 0;
+    // the peer set MessageExtFieldFlag::BatchSupported on a message
+    std::atomic_bool m_peerBatch = false;
+    // the linger timer is armed
+    std::atomic_bool m_lingering = false;
+    std::shared_ptr<boost::asio::steady_timer> m_lingerTimer;
+    // fragmentation, m_fragmentSize 0 if disabled
+    uint32_t m_fragmentSize = 0;
+    // the peer set MessageExtFieldFlag::FragmentSupported on a message
+    std::atomic_bool m_peerFragment = false;
+    // the fragments of the message being received, on the io thread
+    bcos::bytes m_fragmentBuffer;
+    // streams
+    uint32_t m_streamWindow = 0;
+    uint32_t m_streamChunkSize = 256 * 1024;
+    WsStreamHandler m_streamHandler;
+    WsRawFrameHandler m_rawFrameHandler;
+    std::shared_ptr<const std::atomic_bool> m_rawFrameEnabled;
+    mutable std::mutex x_streams;
+    std::unordered_map<std::string, WsStreamSender::Ptr> m_streamSenders;
+    std::unordered_map<std::string, WsStreamReceiver::Ptr> m_streamReceivers;
     // websocket protocol version
     std::atomic<uint16_t> m_version = 0;
     std::string m_moduleName;
@@ -206,6 +492,9 @@ protected:
     // callbacks
     mutable bcos::SharedMutex x_callback;
     std::unordered_map<std::string, CallBack::Ptr> m_callbacks;
+    // the callbacks of m_callbacks with a waiter, the responses are looked up on the io thread
+    // only when there are any
+    std::atomic<uint32_t> m_waiters = 0;
 
     // callback handler
     WsConnectHandler m_connectHandler;
@@ -222,12 +511,26 @@ protected:
     struct Message
     {
         std::shared_ptr<bcos::bytes> buffer;
+        std::chrono::steady_clock::time_point enqueueTime;
+        WsTraceContext::Ptr trace;
+        // the body after the buffer, written alone
+        FileRange::Ptr file;
+
+        std::size_t size() const { return buffer->size() + (file ? file->size : 0); }
     };
 
-    // send message queue
+    // send message queue, in the order sent, the chunks of a stream rely on it
     mutable bcos::SharedMutex x_writeQueue;
-    std::priority_queue<std::shared_ptr<Message>> m_writeQueue;
+    std::queue<std::shared_ptr<Message>> m_writeQueue;
+    // the bytes of the messages in the write queue
+    std::size_t m_writeQueueBytes = 0;
+    // the messages sent in fragments, written when the write queue is empty
+    std::queue<std::shared_ptr<Message>> m_largeQueue;
+    // the bytes of the front of m_largeQueue written
+    std::size_t m_fragmentOffset = 0;
     std::atomic_bool m_writing = {false};
+    // the messages being written, in one frame or in one batch frame, only one write is in flight
+    std::vector<std::shared_ptr<Message>> m_writingMsgs;
 };
 
 class WsSessionFactory
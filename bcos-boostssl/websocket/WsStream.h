@@ -21,6 +21,9 @@
 
 #include <bcos-boostssl/httpserver/Common.h>
 #include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/ShmRingStream.h>
+#include <bcos-boostssl/websocket/TcpFrameStream.h>
+#include <bcos-boostssl/websocket/UringFrameStream.h>
 #include <bcos-boostssl/websocket/WsTools.h>
 #include <bcos-utilities/BoostLog.h>
 #include <bcos-utilities/Common.h>
@@ -39,6 +42,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <utility>
 
 namespace bcos
@@ -135,6 +139,8 @@ public:
     }
 
     boost::beast::tcp_stream& tcpStream() { return boost::beast::get_lowest_layer(*m_stream); }
+    // the tcp_stream, or the UnixStream on the unix domain socket transport
+    auto& lowestLayer() { return boost::beast::get_lowest_layer(*m_stream); }
 
     std::shared_ptr<boost::beast::websocket::stream<STREAM>> stream() const { return m_stream; }
 
@@ -166,11 +172,7 @@ public:
     {
         try
         {
-            auto& s = tcpStream();
-            auto localEndPoint = s.socket().local_endpoint();
-            auto endPoint =
-                localEndPoint.address().to_string() + ":" + std::to_string(localEndPoint.port());
-            return endPoint;
+            return WsTools::localEndPoint(lowestLayer().socket());
         }
         catch (const std::exception& e)
         {
@@ -184,11 +186,7 @@ public:
     {
         try
         {
-            auto& s = tcpStream();
-            auto remoteEndpoint = s.socket().remote_endpoint();
-            auto endPoint =
-                remoteEndpoint.address().to_string() + ":" + std::to_string(remoteEndpoint.port());
-            return endPoint;
+            return WsTools::remoteEndPoint(lowestLayer().socket());
         }
         catch (const std::exception& e)
         {
@@ -206,6 +204,7 @@ private:
 
 using RawWsStream = WsStream<boost::beast::tcp_stream>;
 using SslWsStream = WsStream<boost::beast::ssl_stream<boost::beast::tcp_stream>>;
+using UnixWsStream = WsStream<UnixStream>;
 
 class WsStreamDelegate
 {
@@ -216,81 +215,222 @@ public:
 public:
     WsStreamDelegate(RawWsStream::Ptr _rawStream) : m_isSsl(false), m_rawStream(_rawStream) {}
     WsStreamDelegate(SslWsStream::Ptr _sslStream) : m_isSsl(true), m_sslStream(_sslStream) {}
+    WsStreamDelegate(RawTcpFrameStream::Ptr _rawFrameStream)
+      : m_isSsl(false), m_isTcpFrame(true), m_rawFrameStream(_rawFrameStream)
+    {}
+    WsStreamDelegate(SslTcpFrameStream::Ptr _sslFrameStream)
+      : m_isSsl(true), m_isTcpFrame(true), m_sslFrameStream(_sslFrameStream)
+    {}
+    WsStreamDelegate(UnixWsStream::Ptr _unixStream)
+      : m_isSsl(false), m_isUnix(true), m_unixStream(_unixStream)
+    {}
+    WsStreamDelegate(UnixTcpFrameStream::Ptr _unixFrameStream)
+      : m_isSsl(false), m_isTcpFrame(true), m_isUnix(true), m_unixFrameStream(_unixFrameStream)
+    {}
+    WsStreamDelegate(ShmRingStream::Ptr _shmRingStream)
+      : m_isSsl(false), m_isUnix(true), m_isShmRing(true), m_shmRingStream(_shmRingStream)
+    {}
+    WsStreamDelegate(UringFrameStream::Ptr _uringFrameStream)
+      : m_isSsl(false), m_isTcpFrame(true), m_isUring(true), m_uringFrameStream(_uringFrameStream)
+    {}
+
+private:
+    // call _f with the underlying stream, defined ahead of the callers for return type deduction
+    template <typename F>
+    decltype(auto) visit(F&& _f)
+    {
+        if (m_isShmRing)
+        {
+            return _f(*m_shmRingStream);
+        }
+        if (m_isUring)
+        {
+            return _f(*m_uringFrameStream);
+        }
+        if (m_isUnix)
+        {
+            return m_isTcpFrame ? _f(*m_unixFrameStream) : _f(*m_unixStream);
+        }
+        if (m_isTcpFrame)
+        {
+            return m_isSsl ? _f(*m_sslFrameStream) : _f(*m_rawFrameStream);
+        }
+        return m_isSsl ? _f(*m_sslStream) : _f(*m_rawStream);
+    }
 
 public:
+    bool isSsl() const { return m_isSsl; }
+    bool isTcpFrame() const { return m_isTcpFrame; }
+    bool isUnix() const { return m_isUnix; }
+    bool isShmRing() const { return m_isShmRing; }
+    bool isUring() const { return m_isUring; }
+
     void setMaxReadMsgSize(uint32_t _maxValue)
     {
-        m_isSsl ? m_sslStream->setMaxReadMsgSize(_maxValue) :
-                  m_rawStream->setMaxReadMsgSize(_maxValue);
+        visit([_maxValue](auto& _stream) { _stream.setMaxReadMsgSize(_maxValue); });
+    }
+    bool open()
+    {
+        return visit([](auto& _stream) { return _stream.open(); });
+    }
+    void close()
+    {
+        visit([](auto& _stream) { _stream.close(); });
     }
-    bool open() { return m_isSsl ? m_sslStream->open() : m_rawStream->open(); }
-    void close() { return m_isSsl ? m_sslStream->close() : m_rawStream->close(); }
     std::string localEndpoint()
     {
-        return m_isSsl ? m_sslStream->localEndpoint() : m_rawStream->localEndpoint();
+        return visit([](auto& _stream) { return _stream.localEndpoint(); });
     }
     std::string remoteEndpoint()
     {
-        return m_isSsl ? m_sslStream->remoteEndpoint() : m_rawStream->remoteEndpoint();
+        return visit([](auto& _stream) { return _stream.remoteEndpoint(); });
     }
 
     void asyncWrite(const bcos::bytes& _buffer, WsStreamRWHandler _handler)
     {
-        return m_isSsl ? m_sslStream->asyncWrite(_buffer, _handler) :
-                         m_rawStream->asyncWrite(_buffer, _handler);
+        visit([&_buffer, &_handler](auto& _stream) { _stream.asyncWrite(_buffer, _handler); });
+    }
+
+    // the body of asyncWriteFile goes from the file to the socket in the kernel, only on the tcp
+    // frame transport without ssl: the websocket frames of the client are masked and the ssl
+    // stream encrypts in the user space through its memory bios, which also rules out ktls
+    bool canSendFile() const { return m_isTcpFrame && !m_isSsl && !m_isUring; }
+
+    // Note: check canSendFile() first
+    void asyncWriteFile(const bcos::bytes& _header, int _fd, uint64_t _offset, std::size_t _size,
+        WsStreamRWHandler _handler)
+    {
+        if (m_isUnix)
+        {
+            m_unixFrameStream->asyncWriteFile(_header, _fd, _offset, _size, _handler);
+        }
+        else
+        {
+            m_rawFrameStream->asyncWriteFile(_header, _fd, _offset, _size, _handler);
+        }
     }
 
     void asyncRead(boost::beast::flat_buffer& _buffer, WsStreamRWHandler _handler)
     {
-        return m_isSsl ? m_sslStream->asyncRead(_buffer, _handler) :
-                         m_rawStream->asyncRead(_buffer, _handler);
+        visit([&_buffer, &_handler](auto& _stream) { _stream.asyncRead(_buffer, _handler); });
     }
 
     void asyncWsHandshake(const std::string& _host, const std::string& _target,
         std::function<void(boost::beast::error_code)> _handler)
     {
-        return m_isSsl ? m_sslStream->asyncHandshake(_host, _target, _handler) :
-                         m_rawStream->asyncHandshake(_host, _target, _handler);
+        visit([&_host, &_target, &_handler](
+                  auto& _stream) { _stream.asyncHandshake(_host, _target, _handler); });
     }
 
     void asyncAccept(
         bcos::boostssl::http::HttpRequest _httpRequest, WsStreamHandshakeHandler _handler)
     {
-        return m_isSsl ? m_sslStream->asyncAccept(_httpRequest, _handler) :
-                         m_rawStream->asyncAccept(_httpRequest, _handler);
+        visit([&_httpRequest, &_handler](
+                  auto& _stream) { _stream.asyncAccept(std::move(_httpRequest), _handler); });
     }
 
     void asyncHandshake(std::function<void(boost::beast::error_code)> _handler)
     {
-        if (m_isSsl)
+        if (!m_isSsl)
+        {  // callback directly
+            _handler(make_error_code(boost::system::errc::success));
+        }
+        else if (m_isTcpFrame)
         {
-            m_sslStream->stream()->next_layer().async_handshake(
+            m_sslFrameStream->stream()->async_handshake(
                 boost::asio::ssl::stream_base::client, _handler);
         }
         else
-        {  // callback directly
-            _handler(make_error_code(boost::system::errc::success));
+        {
+            m_sslStream->stream()->next_layer().async_handshake(
+                boost::asio::ssl::stream_base::client, _handler);
         }
     }
 
+    // Note: there is no tcp_stream on the unix domain socket transport, use executor() and
+    // expiresNever() for the common operations
     boost::beast::tcp_stream& tcpStream()
     {
-        return m_isSsl ? m_sslStream->tcpStream() : m_rawStream->tcpStream();
+        if (m_isUnix)
+        {
+            BOOST_THROW_EXCEPTION(std::logic_error("no tcp stream on the unix domain socket"));
+        }
+        if (m_isUring)
+        {
+            return m_uringFrameStream->tcpStream();
+        }
+        return m_isTcpFrame ? (m_isSsl ? m_sslFrameStream->tcpStream() :
+                                         m_rawFrameStream->tcpStream()) :
+                              (m_isSsl ? m_sslStream->tcpStream() : m_rawStream->tcpStream());
+    }
+
+    boost::beast::tcp_stream::executor_type executor()
+    {
+        return visit([](auto& _stream) { return _stream.lowestLayer().get_executor(); });
+    }
+
+    void expiresNever()
+    {
+        visit([](auto& _stream) { _stream.lowestLayer().expires_never(); });
+    }
+
+    // SO_BUSY_POLL polls the nic queue, nothing to poll for on the unix domain socket
+    void setBusyPoll(uint32_t _us)
+    {
+        if (m_isUnix)
+        {
+            return;
+        }
+        WsTools::setBusyPoll(tcpStream().socket(), _us);
     }
 
     void setVerifyCallback(bool _disableSsl, VerifyCallback callback, bool = true)
     {
-        if (!_disableSsl)
+        if (_disableSsl)
+        {
+            return;
+        }
+
+        if (m_isTcpFrame)
+        {
+            m_sslFrameStream->stream()->set_verify_callback(callback);
+        }
+        else
         {
             m_sslStream->stream()->next_layer().set_verify_callback(callback);
         }
     }
 
+    // the ssl handle of the stream, nullptr without ssl
+    SSL* nativeSslHandle()
+    {
+        if (!m_isSsl)
+        {
+            return nullptr;
+        }
+        return m_isTcpFrame ? m_sslFrameStream->stream()->native_handle() :
+                              m_sslStream->stream()->next_layer().native_handle();
+    }
+
 private:
     bool m_isSsl{false};
+    // length-prefixed tcp frame transport instead of websocket
+    bool m_isTcpFrame{false};
+    // unix domain socket instead of tcp, always without ssl
+    bool m_isUnix{false};
+    // shared memory rings negotiated on the unix domain socket
+    bool m_isShmRing{false};
+    // the tcp frame transport driven by io_uring, always without ssl
+    bool m_isUring{false};
 
     RawWsStream::Ptr m_rawStream;
     SslWsStream::Ptr m_sslStream;
+    RawTcpFrameStream::Ptr m_rawFrameStream;
+    SslTcpFrameStream::Ptr m_sslFrameStream;
+    UnixWsStream::Ptr m_unixStream;
+    UnixTcpFrameStream::Ptr m_unixFrameStream;
+    ShmRingStream::Ptr m_shmRingStream;
+    UringFrameStream::Ptr m_uringFrameStream;
 };
 
 class WsStreamDelegateBuilder
@@ -337,6 +477,76 @@ public:
             std::move(*_tcpStream), *_ctx);
         return build(sslStream, _moduleName);
     }
+
+    WsStreamDelegate::Ptr buildTcpFrame(
+        std::shared_ptr<boost::beast::tcp_stream> _tcpStream, std::string _moduleName)
+    {
+        _tcpStream->socket().set_option(boost::asio::ip::tcp::no_delay(true));
+        auto frameStream = std::make_shared<RawTcpFrameStream>(_tcpStream, _moduleName);
+        return std::make_shared<WsStreamDelegate>(frameStream);
+    }
+
+    WsStreamDelegate::Ptr buildTcpFrame(
+        std::shared_ptr<boost::beast::ssl_stream<boost::beast::tcp_stream>> _sslStream,
+        std::string _moduleName)
+    {
+        _sslStream->next_layer().socket().set_option(boost::asio::ip::tcp::no_delay(true));
+        auto frameStream = std::make_shared<SslTcpFrameStream>(_sslStream, _moduleName);
+        return std::make_shared<WsStreamDelegate>(frameStream);
+    }
+
+    WsStreamDelegate::Ptr buildTcpFrame(bool _disableSsl,
+        std::shared_ptr<boost::asio::ssl::context> _ctx,
+        std::shared_ptr<boost::beast::tcp_stream> _tcpStream, std::string _moduleName)
+    {
+        if (_disableSsl)
+        {
+            return m_ioUring ? buildUringFrame(_tcpStream, _moduleName) :
+                               buildTcpFrame(_tcpStream, _moduleName);
+        }
+
+        auto sslStream = std::make_shared<boost::beast::ssl_stream<boost::beast::tcp_stream>>(
+            std::move(*_tcpStream), *_ctx);
+        return buildTcpFrame(sslStream, _moduleName);
+    }
+
+    WsStreamDelegate::Ptr buildUringFrame(
+        std::shared_ptr<boost::beast::tcp_stream> _tcpStream, std::string _moduleName)
+    {
+        _tcpStream->socket().set_option(boost::asio::ip::tcp::no_delay(true));
+        auto frameStream = std::make_shared<UringFrameStream>(_tcpStream, _moduleName);
+        return std::make_shared<WsStreamDelegate>(frameStream);
+    }
+
+    WsStreamDelegate::Ptr build(std::shared_ptr<UnixStream> _unixStream, std::string _moduleName)
+    {
+        auto wsStream =
+            std::make_shared<boost::beast::websocket::stream<UnixStream>>(std::move(*_unixStream));
+        auto unixWsStream = std::make_shared<UnixWsStream>(wsStream, _moduleName);
+        return std::make_shared<WsStreamDelegate>(unixWsStream);
+    }
+
+    WsStreamDelegate::Ptr buildTcpFrame(
+        std::shared_ptr<UnixStream> _unixStream, std::string _moduleName)
+    {
+        auto frameStream = std::make_shared<UnixTcpFrameStream>(_unixStream, _moduleName);
+        return std::make_shared<WsStreamDelegate>(frameStream);
+    }
+
+    // _ringSize: the size of each ring on the client side, the server takes the client's
+    WsStreamDelegate::Ptr buildShmRing(
+        std::shared_ptr<UnixStream> _unixStream, uint32_t _ringSize, std::string _moduleName)
+    {
+        auto shmRingStream = std::make_shared<ShmRingStream>(_unixStream, _ringSize, _moduleName);
+        return std::make_shared<WsStreamDelegate>(shmRingStream);
+    }
+
+    // build the tcp frame transport without ssl on io_uring, the caller checks the support
+    bool ioUring() const { return m_ioUring; }
+    void setIoUring(bool _ioUring) { m_ioUring = _ioUring; }
+
+private:
+    bool m_ioUring{false};
 };
 
 }  // namespace ws
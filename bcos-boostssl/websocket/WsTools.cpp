@@ -21,15 +21,156 @@
 #include <bcos-boostssl/websocket/WsConfig.h>
 #include <bcos-boostssl/websocket/WsTools.h>
 #include <boost/algorithm/string.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#endif
 
 using namespace bcos;
 using namespace bcos::boostssl;
 using namespace bcos::boostssl::ws;
 
+namespace
+{
+// _sent of the _size bytes have been written
+template <typename SOCKET>
+void sendFileSome(SOCKET& _socket, int _fd, uint64_t _offset, std::size_t _size,
+    std::size_t _sent, WsTools::SendFileHandler _handler)
+{
+#ifdef __linux__
+    while (_sent < _size)
+    {
+        off_t offset = _offset + _sent;
+        auto n = ::sendfile(_socket.native_handle(), _fd, &offset, _size - _sent);
+        if (n > 0)
+        {
+            _sent += n;
+            continue;
+        }
+        if (n == 0)
+        {
+            // the file ends before the range
+            return _handler(boost::asio::error::eof, _sent);
+        }
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            return _handler(
+                boost::system::error_code(errno, boost::system::system_category()), _sent);
+        }
+        _socket.async_wait(SOCKET::wait_write,
+            [&_socket, _fd, _offset, _size, _sent, _handler](boost::system::error_code _ec) {
+                if (_ec)
+                {
+                    return _handler(_ec, _sent);
+                }
+                sendFileSome(_socket, _fd, _offset, _size, _sent, _handler);
+            });
+        return;
+    }
+    _handler(boost::system::error_code(), _sent);
+#else
+    boost::ignore_unused(_socket, _fd, _offset, _size, _sent);
+    _handler(boost::asio::error::operation_not_supported, 0);
+#endif
+}
+
+template <typename SOCKET>
+void sendFile(SOCKET& _socket, int _fd, uint64_t _offset, std::size_t _size,
+    WsTools::SendFileHandler _handler)
+{
+    boost::system::error_code ec;
+    _socket.native_non_blocking(true, ec);
+    if (ec)
+    {
+        return _handler(ec, 0);
+    }
+    sendFileSome(_socket, _fd, _offset, _size, 0, std::move(_handler));
+}
+
+// the busy poll of one io thread, lives as long as its spin or its backoff timer is queued
+class BusyPoller : public std::enable_shared_from_this<BusyPoller>
+{
+public:
+    BusyPoller(boost::asio::io_context& _ioc, std::chrono::microseconds _spin,
+        std::chrono::microseconds _backoff)
+      : m_ioc(_ioc), m_timer(_ioc), m_spin(_spin), m_backoff(_backoff)
+    {}
+
+    void spin()
+    {
+        // the nested poll() runs the ready handlers and polls the reactor without blocking
+        auto idleSince = std::chrono::steady_clock::now();
+        while (!m_ioc.stopped())
+        {
+            if (m_ioc.poll() > 0)
+            {
+                idleSince = std::chrono::steady_clock::now();
+                continue;
+            }
+            if (std::chrono::steady_clock::now() - idleSince >= m_spin)
+            {
+                break;
+            }
+        }
+        if (m_ioc.stopped())
+        {
+            return;
+        }
+
+        auto self = shared_from_this();
+        if (m_backoff.count() == 0)
+        {
+            boost::asio::post(m_ioc, [self]() { self->spin(); });
+            return;
+        }
+        // block in the reactor, the timer or any io that comes first wakes the thread up
+        m_timer.expires_after(m_backoff);
+        m_timer.async_wait([self](const boost::system::error_code& _ec) {
+            if (!_ec)
+            {
+                self->spin();
+            }
+        });
+    }
+
+private:
+    boost::asio::io_context& m_ioc;
+    boost::asio::steady_timer m_timer;
+    std::chrono::microseconds m_spin;
+    std::chrono::microseconds m_backoff;
+};
+}  // namespace
+
 bool WsTools::stringToEndPoint(const std::string& _peer, NodeIPEndpoint& _endpoint)
 {
     // ipv4: 127.0.0.1:12345 => NodeIPEndpoint
     // ipv6: [0:1]:12345 => NodeIPEndpoint
+    // unix domain socket: unix:/path/to/socket => NodeIPEndpoint
+
+    if (_peer.compare(0, UNIX_SOCKET_PREFIX.size(), UNIX_SOCKET_PREFIX) == 0)
+    {
+        if (_peer.size() == UNIX_SOCKET_PREFIX.size())
+        {
+            WEBSOCKET_TOOL(WARNING) << LOG_DESC("empty unix domain socket path")
+                                    << LOG_KV("peer", _peer);
+            return false;
+        }
+        _endpoint = NodeIPEndpoint(_peer, 0);
+        return true;
+    }
 
     std::string ip;
     uint16_t port = 0;
@@ -68,6 +209,24 @@ bool WsTools::stringToEndPoint(const std::string& _peer, NodeIPEndpoint& _endpoi
     return valid;
 }
 
+void WsTools::close(boost::asio::local::stream_protocol::socket& _socket)
+{
+    try
+    {
+        boost::beast::error_code ec;
+        _socket.shutdown(boost::asio::local::stream_protocol::socket::shutdown_both, ec);
+        if (_socket.is_open())
+        {
+            _socket.close();
+        }
+    }
+    catch (std::exception const& e)
+    {
+        WEBSOCKET_TOOL(WARNING) << LOG_DESC("WsTools close exception")
+                                << LOG_KV("error", boost::diagnostic_information(e));
+    }
+}
+
 void WsTools::close(boost::asio::ip::tcp::socket& _socket)
 {
     try
@@ -84,4 +243,145 @@ void WsTools::close(boost::asio::ip::tcp::socket& _socket)
         WEBSOCKET_TOOL(WARNING) << LOG_DESC("WsTools close exception")
                                 << LOG_KV("error", boost::diagnostic_information(e));
     }
-}
\ No newline at end of file
+}
+bool WsTools::setThreadAffinity(const std::vector<uint32_t>& _cpus)
+{
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto cpu : _cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+    if (CPU_COUNT(&cpuSet) == 0)
+    {
+        return false;
+    }
+
+    auto r = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+    if (r != 0)
+    {
+        WEBSOCKET_TOOL(WARNING) << LOG_DESC("pthread_setaffinity_np failed")
+                                << LOG_KV("error", r) << LOG_KV("cpus", _cpus.size());
+        return false;
+    }
+    return true;
+#else
+    WEBSOCKET_TOOL(WARNING) << LOG_DESC("thread affinity is not supported on this platform")
+                            << LOG_KV("cpus", _cpus.size());
+    return false;
+#endif
+}
+
+bool WsTools::removeStaleUnixSocket(const std::string& _path)
+{
+    struct stat st;
+    if (::lstat(_path.c_str(), &st) != 0)
+    {
+        return errno == ENOENT;
+    }
+    if (!S_ISSOCK(st.st_mode))
+    {
+        WEBSOCKET_TOOL(WARNING) << LOG_DESC("the unix domain socket path is not a socket")
+                                << LOG_KV("path", _path) << LOG_KV("mode", st.st_mode);
+        return false;
+    }
+
+    // only the socket no one accepts on refuses the connection, a live server keeps its file
+    boost::asio::io_context ioc;
+    boost::asio::local::stream_protocol::socket probe(ioc);
+    boost::system::error_code ec;
+    probe.connect(boost::asio::local::stream_protocol::endpoint(_path), ec);
+    probe.close();
+    if (ec != boost::asio::error::connection_refused)
+    {
+        WEBSOCKET_TOOL(WARNING) << LOG_DESC("the unix domain socket is in use")
+                                << LOG_KV("path", _path) << LOG_KV("error", ec.message());
+        return false;
+    }
+
+    if (::unlink(_path.c_str()) != 0 && errno != ENOENT)
+    {
+        WEBSOCKET_TOOL(WARNING) << LOG_DESC("unlink the stale unix domain socket failed")
+                                << LOG_KV("path", _path) << LOG_KV("errno", errno);
+        return false;
+    }
+    WEBSOCKET_TOOL(INFO) << LOG_DESC("remove the stale unix domain socket")
+                         << LOG_KV("path", _path);
+    return true;
+}
+
+uint32_t WsTools::numaNodeOfCpu(uint32_t _cpu)
+{
+    // the cpu directory contains a nodeN entry for the numa node it belongs to
+    try
+    {
+        boost::filesystem::path cpuPath("/sys/devices/system/cpu/cpu" + std::to_string(_cpu));
+        if (!boost::filesystem::exists(cpuPath))
+        {
+            return 0;
+        }
+
+        for (auto& entry : boost::filesystem::directory_iterator(cpuPath))
+        {
+            auto name = entry.path().filename().string();
+            if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+                std::all_of(name.begin() + 4, name.end(), ::isdigit))
+            {
+                return boost::lexical_cast<uint32_t>(name.substr(4));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        WEBSOCKET_TOOL(DEBUG) << LOG_DESC("numaNodeOfCpu exception") << LOG_KV("cpu", _cpu)
+                              << LOG_KV("error", e.what());
+    }
+    return 0;
+}
+
+void WsTools::busyPoll(
+    std::shared_ptr<boost::asio::io_context> _ioc, uint32_t _spinUs, uint32_t _cpuPercent)
+{
+    // spin / (spin + backoff) = cpuPercent / 100
+    auto cpuPercent = std::min<uint32_t>(std::max<uint32_t>(_cpuPercent, 1), 100);
+    auto backoff = (uint64_t)_spinUs * (100 - cpuPercent) / cpuPercent;
+    auto poller = std::make_shared<BusyPoller>(
+        *_ioc, std::chrono::microseconds(_spinUs), std::chrono::microseconds(backoff));
+    boost::asio::post(*_ioc, [poller]() { poller->spin(); });
+}
+
+bool WsTools::setBusyPoll(boost::asio::ip::tcp::socket& _socket, uint32_t _us)
+{
+#if defined(__linux__) && defined(SO_BUSY_POLL)
+    int value = _us;
+    auto r = ::setsockopt(_socket.native_handle(), SOL_SOCKET, SO_BUSY_POLL, &value, sizeof(value));
+    if (r == 0)
+    {
+        return true;
+    }
+    // raising it above net.core.busy_read needs CAP_NET_ADMIN
+    WEBSOCKET_TOOL(DEBUG) << LOG_DESC("setsockopt SO_BUSY_POLL failed") << LOG_KV("us", _us)
+                          << LOG_KV("errno", errno);
+    return false;
+#else
+    WEBSOCKET_TOOL(DEBUG) << LOG_DESC("SO_BUSY_POLL is not supported on this platform")
+                          << LOG_KV("us", _us);
+    return false;
+#endif
+}
+
+void WsTools::asyncSendFile(boost::asio::ip::tcp::socket& _socket, int _fd, uint64_t _offset,
+    std::size_t _size, SendFileHandler _handler)
+{
+    sendFile(_socket, _fd, _offset, _size, std::move(_handler));
+}
+
+void WsTools::asyncSendFile(boost::asio::local::stream_protocol::socket& _socket, int _fd,
+    uint64_t _offset, std::size_t _size, SendFileHandler _handler)
+{
+    sendFile(_socket, _fd, _offset, _size, std::move(_handler));
+}
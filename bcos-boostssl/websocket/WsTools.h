@@ -21,11 +21,13 @@
 #include "bcos-boostssl/websocket/WsConfig.h"
 #include <bcos-utilities/Common.h>
 #include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/thread/thread.hpp>
 #include <atomic>
+#include <functional>
 #include <unordered_map>
 
 namespace bcos
@@ -35,6 +37,10 @@ namespace boostssl
 namespace ws
 {
 static std::string m_moduleName = "DEFAULT";
+
+// the stream over the unix domain socket, for the co-located processes
+using UnixStream = boost::beast::basic_stream<boost::asio::local::stream_protocol>;
+
 class WsTools
 {
 public:
@@ -54,6 +60,57 @@ public:
     static bool stringToEndPoint(const std::string& peer, NodeIPEndpoint& _endpoint);
 
     static void close(boost::asio::ip::tcp::socket& skt);
+    static void close(boost::asio::local::stream_protocol::socket& skt);
+
+    // "ip:port" of the socket, throw if the socket is not connected
+    static std::string localEndPoint(boost::asio::ip::tcp::socket& _socket)
+    {
+        auto endpoint = _socket.local_endpoint();
+        return endpoint.address().to_string() + ":" + std::to_string(endpoint.port());
+    }
+    static std::string remoteEndPoint(boost::asio::ip::tcp::socket& _socket)
+    {
+        auto endpoint = _socket.remote_endpoint();
+        return endpoint.address().to_string() + ":" + std::to_string(endpoint.port());
+    }
+
+    // "unix:path#fd" of the socket, one side of the unix domain socket is unnamed, the fd tells
+    // the sessions on the same path apart
+    static std::string localEndPoint(boost::asio::local::stream_protocol::socket& _socket)
+    {
+        return UNIX_SOCKET_PREFIX + _socket.local_endpoint().path() + "#" +
+               std::to_string(_socket.native_handle());
+    }
+    static std::string remoteEndPoint(boost::asio::local::stream_protocol::socket& _socket)
+    {
+        return UNIX_SOCKET_PREFIX + _socket.remote_endpoint().path() + "#" +
+               std::to_string(_socket.native_handle());
+    }
+
+    // pin the calling thread to the cpus, return false if not supported or failed
+    static bool setThreadAffinity(const std::vector<uint32_t>& _cpus);
+    // remove the socket file a unix domain socket server left behind, false if the path is not a
+    // socket or a server still accepts on it, true if it is removed or there is nothing
+    static bool removeStaleUnixSocket(const std::string& _path);
+    // the numa node of the cpu, 0 if unknown
+    static uint32_t numaNodeOfCpu(uint32_t _cpu);
+
+    // Note: post from outside the io thread, the io thread runs the io_context with nested
+    // poll() until it has been idle for _spinUs, then blocks for as long as keeps the spinning
+    // within _cpuPercent of its cpu before spinning again
+    static void busyPoll(
+        std::shared_ptr<boost::asio::io_context> _ioc, uint32_t _spinUs, uint32_t _cpuPercent);
+    // set SO_BUSY_POLL of the socket, return false if not supported or failed
+    static bool setBusyPoll(boost::asio::ip::tcp::socket& _socket, uint32_t _us);
+
+    // write _size bytes of the file from _offset to the socket with sendfile, in the kernel
+    // without copying to the user space, the socket is switched to the native non-blocking mode
+    // and waited for when it is full, operation_not_supported off linux
+    using SendFileHandler = std::function<void(boost::system::error_code, std::size_t)>;
+    static void asyncSendFile(boost::asio::ip::tcp::socket& _socket, int _fd, uint64_t _offset,
+        std::size_t _size, SendFileHandler _handler);
+    static void asyncSendFile(boost::asio::local::stream_protocol::socket& _socket, int _fd,
+        uint64_t _offset, std::size_t _size, SendFileHandler _handler);
 
     static std::string moduleName() { return m_moduleName; }
     static void setModuleName(std::string _moduleName) { m_moduleName = _moduleName; }
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file WsTracer.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/WsTracer.h>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+const char* bcos::boostssl::ws::wsTraceEventName(WsTraceEvent _event)
+{
+    switch (_event)
+    {
+    case WsTraceEvent::SendStart:
+        return "SendStart";
+    case WsTraceEvent::Encoded:
+        return "Encoded";
+    case WsTraceEvent::Enqueued:
+        return "Enqueued";
+    case WsTraceEvent::WriteStart:
+        return "WriteStart";
+    case WsTraceEvent::Written:
+        return "Written";
+    case WsTraceEvent::Received:
+        return "Received";
+    case WsTraceEvent::Decoded:
+        return "Decoded";
+    case WsTraceEvent::Dispatched:
+        return "Dispatched";
+    case WsTraceEvent::Handled:
+        return "Handled";
+    case WsTraceEvent::TimedOut:
+        return "TimedOut";
+    default:
+        return "Unknown";
+    }
+}
+
+void WsRingTraceSink::onTrace(WsTraceRecord&& _record)
+{
+    std::lock_guard<std::mutex> l(x_records);
+    m_records[m_next % m_records.size()] = std::move(_record);
+    ++m_next;
+}
+
+std::vector<WsTraceRecord> WsRingTraceSink::records() const
+{
+    std::lock_guard<std::mutex> l(x_records);
+    std::vector<WsTraceRecord> records;
+    auto count = m_next < m_records.size() ? m_next : m_records.size();
+    records.reserve(count);
+    for (uint64_t i = m_next - count; i < m_next; ++i)
+    {
+        records.push_back(m_records[i % m_records.size()]);
+    }
+    return records;
+}
+
+void WsRingTraceSink::dump(std::ostream& _out) const
+{
+    for (const auto& record : records())
+    {
+        _out << record.timeNs << " " << wsTraceEventName(record.event) << " " << record.session
+             << " " << record.seq << " " << record.packetType << " " << record.size << "\n";
+    }
+}
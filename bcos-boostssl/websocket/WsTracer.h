@@ -0,0 +1,169 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief lifecycle tracing of the messages of the sessions, the sampled messages emit a
+ * timestamped event at every stage of the send and the receive path
+ * @file WsTracer.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+enum WsTraceEvent : uint8_t
+{
+    // send path: asyncSendMessage called, encoded, in the write queue, written to the socket
+    SendStart = 0,
+    Encoded = 1,
+    Enqueued = 2,
+    WriteStart = 3,
+    Written = 4,
+    // receive path: read from the socket, decoded, picked up by the thread pool, handled
+    Received = 5,
+    Decoded = 6,
+    Dispatched = 7,
+    Handled = 8,
+    // no response before the timeout
+    TimedOut = 9
+};
+
+const char* wsTraceEventName(WsTraceEvent _event);
+
+struct WsTraceRecord
+{
+    // steady clock
+    int64_t timeNs = 0;
+    const void* session = nullptr;
+    std::string seq;
+    uint16_t packetType = 0;
+    uint32_t size = 0;
+    WsTraceEvent event = WsTraceEvent::SendStart;
+};
+
+// the message a sampled trace follows through the stages
+struct WsTraceContext
+{
+    using Ptr = std::shared_ptr<WsTraceContext>;
+    std::string seq;
+    uint16_t packetType = 0;
+    uint32_t size = 0;
+};
+
+class WsTraceSink
+{
+public:
+    using Ptr = std::shared_ptr<WsTraceSink>;
+    virtual ~WsTraceSink() = default;
+
+    // called on the io threads and the worker threads
+    virtual void onTrace(WsTraceRecord&& _record) = 0;
+    virtual void dump(std::ostream&) const {}
+};
+
+// keeps the last capacity records in memory
+class WsRingTraceSink : public WsTraceSink
+{
+public:
+    using Ptr = std::shared_ptr<WsRingTraceSink>;
+    WsRingTraceSink(std::size_t _capacity) : m_records(_capacity > 0 ? _capacity : 1) {}
+
+    void onTrace(WsTraceRecord&& _record) override;
+
+    // the records oldest first
+    std::vector<WsTraceRecord> records() const;
+    // one record per line: timeNs event session seq type size
+    void dump(std::ostream& _out) const override;
+
+private:
+    mutable std::mutex x_records;
+    std::vector<WsTraceRecord> m_records;
+    uint64_t m_next = 0;
+};
+
+class WsTracer
+{
+public:
+    using Ptr = std::shared_ptr<WsTracer>;
+
+    // trace one message in _sampleRate
+    WsTracer(uint32_t _sampleRate, WsTraceSink::Ptr _sink)
+      : m_sampleRate(_sampleRate > 0 ? _sampleRate : 1), m_sink(std::move(_sink))
+    {}
+
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // decided by the seq so that the request and its response are sampled together
+    bool sampled(const std::string& _seq) const
+    {
+        return m_sampleRate == 1 || std::hash<std::string>()(_seq) % m_sampleRate == 0;
+    }
+
+    WsTraceContext::Ptr newTrace(const std::string& _seq, uint16_t _packetType, uint32_t _size)
+    {
+        if (!sampled(_seq))
+        {
+            return nullptr;
+        }
+        auto trace = std::make_shared<WsTraceContext>();
+        trace->seq = _seq;
+        trace->packetType = _packetType;
+        trace->size = _size;
+        return trace;
+    }
+
+    void trace(const void* _session, const WsTraceContext& _trace, WsTraceEvent _event,
+        int64_t _timeNs = now())
+    {
+        WsTraceRecord record;
+        record.timeNs = _timeNs;
+        record.session = _session;
+        record.seq = _trace.seq;
+        record.packetType = _trace.packetType;
+        record.size = _trace.size;
+        record.event = _event;
+        m_sink->onTrace(std::move(record));
+    }
+
+    uint32_t sampleRate() const { return m_sampleRate; }
+    WsTraceSink::Ptr sink() const { return m_sink; }
+    void dump(std::ostream& _out) const { m_sink->dump(_out); }
+
+private:
+    uint32_t m_sampleRate;
+    WsTraceSink::Ptr m_sink;
+};
+
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
@@ -67,6 +67,17 @@ macro(configure_project)
         add_definitions(-DFISCO_DEBUG)
     endif()
 
+    # the boostssl logs below the level are compiled out: TRACE DEBUG INFO WARNING ERROR FATAL
+    if (NOT DEFINED BOOSTSSL_MIN_LOG_LEVEL)
+        set(BOOSTSSL_MIN_LOG_LEVEL "TRACE")
+    endif()
+    string(TOUPPER "${BOOSTSSL_MIN_LOG_LEVEL}" BOOSTSSL_MIN_LOG_LEVEL)
+    set(BOOSTSSL_LOG_LEVELS TRACE DEBUG INFO WARNING ERROR FATAL)
+    if (NOT BOOSTSSL_MIN_LOG_LEVEL IN_LIST BOOSTSSL_LOG_LEVELS)
+        message(FATAL_ERROR "Invalid BOOSTSSL_MIN_LOG_LEVEL ${BOOSTSSL_MIN_LOG_LEVEL}, it should be one of: ${BOOSTSSL_LOG_LEVELS}")
+    endif()
+    # exported with the bcos-boostssl target, see bcos-boostssl/CMakeLists.txt
+
     # Suffix like "-rc1" e.t.c. to append to versions wherever needed.
     if (NOT DEFINED VERSION_SUFFIX)
         set(VERSION_SUFFIX "")
@@ -88,6 +99,7 @@ macro(print_config NAME)
     message("-- TESTS              Build tests                  ${TESTS}")
     message("-- ARCH_NATIVE        Enable native code           ${ARCH_NATIVE}")
     message("-- DEBUG                                           ${DEBUG}")
+    message("-- BOOSTSSL_MIN_LOG_LEVEL Compiled out log levels below ${BOOSTSSL_MIN_LOG_LEVEL}")
     message("------------------------------------------------------------------------")
     message("")
 endmacro()
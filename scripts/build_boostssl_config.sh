@@ -71,6 +71,8 @@ generate_config_ini() {
 [common]
     ; ssl or sm_ssl
     ssl_type=ssl
+    ; reuse the ssl session of the last connection when reconnecting
+    session_resumption=false
 
 [cert]
     ; directory the certificates located in
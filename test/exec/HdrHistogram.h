@@ -0,0 +1,256 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file HdrHistogram.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace perf
+{
+/**
+ * @brief: the high dynamic range histogram of the perf tools, the values from 0 to
+ * highestTrackable are recorded with significantDigits decimal digits of precision in
+ * log-linear buckets, record() is lock free and may be called from any thread
+ */
+class HdrHistogram
+{
+public:
+    using Ptr = std::shared_ptr<HdrHistogram>;
+
+    // default: up to one hour in microseconds with 3 significant digits
+    HdrHistogram(
+        uint64_t _highestTrackable = 3600ULL * 1000 * 1000, uint32_t _significantDigits = 3)
+      : m_highestTrackable(_highestTrackable)
+    {
+        // the sub buckets of each bucket tell 10^digits values apart at the top of the bucket
+        uint64_t largestSingleUnit = 2;
+        for (uint32_t i = 0; i < _significantDigits; ++i)
+        {
+            largestSingleUnit *= 10;
+        }
+        uint32_t subBucketCountMagnitude = 0;
+        while ((1ULL << subBucketCountMagnitude) < largestSingleUnit)
+        {
+            ++subBucketCountMagnitude;
+        }
+        m_subBucketHalfCountMagnitude = subBucketCountMagnitude - 1;
+        m_subBucketCount = 1ULL << subBucketCountMagnitude;
+        m_subBucketHalfCount = m_subBucketCount / 2;
+        m_subBucketMask = m_subBucketCount - 1;
+
+        // every bucket doubles the range of the previous one
+        uint64_t smallestUntrackable = m_subBucketCount;
+        uint32_t bucketCount = 1;
+        while (smallestUntrackable <= _highestTrackable)
+        {
+            if (smallestUntrackable > std::numeric_limits<uint64_t>::max() / 2)
+            {
+                ++bucketCount;
+                break;
+            }
+            smallestUntrackable <<= 1;
+            ++bucketCount;
+        }
+        m_counts = std::vector<std::atomic<uint64_t>>((bucketCount + 1) * m_subBucketHalfCount);
+    }
+
+    // the values above highestTrackable are recorded as highestTrackable
+    void record(uint64_t _value)
+    {
+        if (_value > m_highestTrackable)
+        {
+            _value = m_highestTrackable;
+        }
+        m_counts[countsIndex(_value)].fetch_add(1, std::memory_order_relaxed);
+        m_totalCount.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(_value, std::memory_order_relaxed);
+
+        auto min = m_min.load(std::memory_order_relaxed);
+        while (_value < min && !m_min.compare_exchange_weak(min, _value))
+        {
+        }
+        auto max = m_max.load(std::memory_order_relaxed);
+        while (_value > max && !m_max.compare_exchange_weak(max, _value))
+        {
+        }
+    }
+
+    void add(const HdrHistogram& _other)
+    {
+        for (std::size_t i = 0; i < m_counts.size() && i < _other.m_counts.size(); ++i)
+        {
+            m_counts[i].fetch_add(_other.m_counts[i].load(), std::memory_order_relaxed);
+        }
+        m_totalCount += _other.m_totalCount.load();
+        m_sum += _other.m_sum.load();
+        if (_other.min() < m_min.load())
+        {
+            m_min = _other.min();
+        }
+        if (_other.max() > m_max.load())
+        {
+            m_max = _other.max();
+        }
+    }
+
+    void reset()
+    {
+        for (auto& count : m_counts)
+        {
+            count.store(0, std::memory_order_relaxed);
+        }
+        m_totalCount = 0;
+        m_sum = 0;
+        m_min = std::numeric_limits<uint64_t>::max();
+        m_max = 0;
+    }
+
+    uint64_t totalCount() const { return m_totalCount.load(); }
+    uint64_t min() const { return totalCount() == 0 ? 0 : m_min.load(); }
+    uint64_t max() const { return m_max.load(); }
+    double mean() const
+    {
+        return totalCount() == 0 ? 0 : (double)m_sum.load() / (double)totalCount();
+    }
+
+    // the highest value equivalent to the value at the percentile, _percentile in [0, 100]
+    uint64_t valueAtPercentile(double _percentile) const
+    {
+        auto total = totalCount();
+        if (total == 0)
+        {
+            return 0;
+        }
+        if (_percentile > 100)
+        {
+            _percentile = 100;
+        }
+        auto countAtPercentile = (uint64_t)(_percentile / 100 * (double)total + 0.5);
+        countAtPercentile = countAtPercentile > 0 ? countAtPercentile : 1;
+
+        uint64_t count = 0;
+        for (std::size_t i = 0; i < m_counts.size(); ++i)
+        {
+            count += m_counts[i].load(std::memory_order_relaxed);
+            if (count >= countAtPercentile)
+            {
+                auto value = highestEquivalentValue(valueFromIndex(i));
+                return value < max() ? value : max();
+            }
+        }
+        return max();
+    }
+
+    // call _f(value, count) for every non-empty bucket in ascending order of value, value is the
+    // highest value equivalent to the bucket
+    template <typename F>
+    void forEach(F _f) const
+    {
+        for (std::size_t i = 0; i < m_counts.size(); ++i)
+        {
+            auto count = m_counts[i].load(std::memory_order_relaxed);
+            if (count > 0)
+            {
+                _f(highestEquivalentValue(valueFromIndex(i)), count);
+            }
+        }
+    }
+
+    // the percentile distribution in the csv layout of the HdrHistogram tools:
+    // Value,Percentile,TotalCount,1/(1-Percentile)
+    void outputPercentileDistribution(std::ostream& _out, double _valueScale = 1) const
+    {
+        _out << "Value,Percentile,TotalCount,1/(1-Percentile)\n";
+        auto total = totalCount();
+        uint64_t count = 0;
+        forEach([&](uint64_t _value, uint64_t _count) {
+            count += _count;
+            double percentile = (double)count / (double)total;
+            _out << (double)_value / _valueScale << "," << percentile << "," << count << ",";
+            if (count == total)
+            {
+                _out << "Infinity\n";
+            }
+            else
+            {
+                _out << 1 / (1 - percentile) << "\n";
+            }
+        });
+    }
+
+private:
+    std::size_t bucketIndex(uint64_t _value) const
+    {
+        // the power of two ceiling of the value, the values below the first bucket go into it
+        auto pow2Ceiling = 64 - __builtin_clzll(_value | m_subBucketMask);
+        return pow2Ceiling - (m_subBucketHalfCountMagnitude + 1);
+    }
+
+    std::size_t countsIndex(uint64_t _value) const
+    {
+        auto bucket = bucketIndex(_value);
+        auto subBucket = _value >> bucket;
+        return ((bucket + 1) << m_subBucketHalfCountMagnitude) + (subBucket - m_subBucketHalfCount);
+    }
+
+    uint64_t valueFromIndex(std::size_t _index) const
+    {
+        int64_t bucket = (int64_t)(_index >> m_subBucketHalfCountMagnitude) - 1;
+        uint64_t subBucket = (_index & (m_subBucketHalfCount - 1)) + m_subBucketHalfCount;
+        if (bucket < 0)
+        {
+            subBucket -= m_subBucketHalfCount;
+            bucket = 0;
+        }
+        return subBucket << bucket;
+    }
+
+    uint64_t highestEquivalentValue(uint64_t _value) const
+    {
+        auto bucket = bucketIndex(_value);
+        auto lowest = (_value >> bucket) << bucket;
+        return lowest + (1ULL << bucket) - 1;
+    }
+
+private:
+    uint64_t m_highestTrackable;
+    uint32_t m_subBucketHalfCountMagnitude = 0;
+    uint64_t m_subBucketCount = 0;
+    uint64_t m_subBucketHalfCount = 0;
+    uint64_t m_subBucketMask = 0;
+
+    std::vector<std::atomic<uint64_t>> m_counts;
+    std::atomic<uint64_t> m_totalCount{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_min{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> m_max{0};
+};
+
+}  // namespace perf
+}  // namespace boostssl
+}  // namespace bcos
@@ -0,0 +1,488 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief connection-scaling benchmark, the client opens tens of thousands of sessions to the
+ * server and keeps a low background rate on them, the server reports the memory per session,
+ * the accept rate, the latency of sessions() and the cost of a heartbeat round and a broadcast
+ * @file boostssl_conn_scale.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include "HdrHistogram.h"
+#include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/WsConnector.h>
+#include <bcos-boostssl/websocket/WsInitializer.h>
+#include <bcos-boostssl/websocket/WsService.h>
+#include <bcos-utilities/BoostLog.h>
+#include <bcos-utilities/BoostLogInitializer.h>
+#include <bcos-utilities/Common.h>
+#include <boost/asio/ip/address_v4.hpp>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+using namespace bcos::boostssl::http;
+using namespace bcos::boostssl::context;
+using namespace bcos::boostssl::perf;
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Usage: \n"
+              << " \t boostssl-conn-scale server <ip> <port> <disable_ssl> [probe_interval_s] "
+                 "[broadcast_size]\n"
+              << " \t boostssl-conn-scale client <ip> <port> <disable_ssl> <sessions> "
+                 "[address_count] [background_rate]\n"
+              << " \t address_count: the client connects to <ip>, <ip>+1, ... so that every "
+                 "address has its own ephemeral port range, the server should listen on 0.0.0.0\n"
+              << " \t background_rate: messages per second over all the sessions\n"
+              << " \t Note: raise the open file limit on both sides, e.g. ulimit -n 200000\n"
+              << "Example:\n"
+              << " \t ./boostssl-conn-scale server 0.0.0.0 20200 true 10 1024\n"
+              << " \t ./boostssl-conn-scale client 127.0.0.1 20200 true 50000 16 1000\n";
+    std::exit(0);
+}
+
+void initLog(const std::string& _configPath = "./clog.ini")
+{
+    boost::property_tree::ptree pt;
+    try
+    {
+        boost::property_tree::read_ini(_configPath, pt);
+    }
+    catch (const std::exception& e)
+    {
+        try
+        {
+            std::string defaultPath = "conf/clog.ini";
+            boost::property_tree::read_ini(defaultPath, pt);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Not found available log config(./clog.ini or ./conf/clog.ini), use "
+                         "the default configuration items"
+                      << std::endl;
+        }
+    }
+
+    auto logInitializer = new bcos::BoostLogInitializer();
+    logInitializer->initLog(pt, bcos::FileLogger, "cpp_sdk_log");
+}
+
+const static int HEARTBEAT_MSGTYPE = 9997;
+const static int BROADCAST_MSGTYPE = 9998;
+const static int BACKGROUND_MSGTYPE = 9999;
+
+void initSsl(std::shared_ptr<WsConfig> _config, bool _disableSsl)
+{
+    _config->setDisableSsl(_disableSsl);
+    if (!_config->disableSsl())
+    {
+        auto contextConfig = std::make_shared<ContextConfig>();
+        contextConfig->initConfig("./boostssl.ini");
+        _config->setContextConfig(contextConfig);
+    }
+}
+
+uint64_t rssBytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+double cpuSeconds()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec +
+           usage.ru_stime.tv_usec / 1e6;
+}
+
+// the memory grown since _baseRss divided by the sessions, in KB
+double rssPerSessionKB(uint64_t _rss, uint64_t _baseRss, uint64_t _sessions)
+{
+    if (_sessions == 0 || _rss < _baseRss)
+    {
+        return 0;
+    }
+    return (double)(_rss - _baseRss) / _sessions / 1024;
+}
+
+int64_t elapsedUs(std::chrono::steady_clock::time_point _since)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _since)
+        .count();
+}
+
+// the median latency of sessions() over a few calls, in microseconds
+int64_t sessionsLatencyUs(std::shared_ptr<WsService> _wsService)
+{
+    std::vector<int64_t> latencies;
+    for (int i = 0; i < 9; ++i)
+    {
+        auto startPoint = std::chrono::steady_clock::now();
+        auto ss = _wsService->sessions();
+        latencies.push_back(elapsedUs(startPoint));
+    }
+    std::sort(latencies.begin(), latencies.end());
+    return latencies[latencies.size() / 2];
+}
+
+// send a heartbeat to every session and wait until all of them have been echoed
+void probeHeartbeat(std::shared_ptr<WsService> _wsService, uint32_t _timeoutMs)
+{
+    struct Probe
+    {
+        HdrHistogram rtt;
+        std::atomic<uint64_t> done{0};
+        std::atomic<uint64_t> failed{0};
+    };
+    auto probe = std::make_shared<Probe>();
+    auto ss = _wsService->sessions();
+    auto payload = std::make_shared<bytes>(16, 'h');
+
+    auto cpu = cpuSeconds();
+    auto startPoint = std::chrono::steady_clock::now();
+    for (auto& session : ss)
+    {
+        auto msg = _wsService->messageFactory()->buildMessage();
+        msg->setPacketType(HEARTBEAT_MSGTYPE);
+        msg->setSeq(_wsService->messageFactory()->newSeq());
+        msg->setPayload(payload);
+        auto sendPoint = std::chrono::steady_clock::now();
+        session->asyncSendMessage(msg, Options(_timeoutMs),
+            [probe, sendPoint](
+                Error::Ptr _error, std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) {
+                if (_error && _error->errorCode() != 0)
+                {
+                    ++probe->failed;
+                }
+                else
+                {
+                    probe->rtt.record(elapsedUs(sendPoint));
+                }
+                ++probe->done;
+            });
+    }
+    auto sendUs = elapsedUs(startPoint);
+
+    auto deadline = startPoint + std::chrono::milliseconds(_timeoutMs + 1000);
+    while (probe->done < ss.size() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto roundUs = elapsedUs(startPoint);
+
+    std::cerr << " \t[heartbeat] sessions: " << ss.size() << ", send(us): " << sendUs
+              << ", all echoed(us): " << roundUs
+              << ", cpu(ms): " << (cpuSeconds() - cpu) * 1000
+              << ", rtt p50(us): " << probe->rtt.valueAtPercentile(50)
+              << ", rtt p99(us): " << probe->rtt.valueAtPercentile(99)
+              << ", rtt max(us): " << probe->rtt.max() << ", failed: " << probe->failed
+              << ", lost: " << ss.size() - probe->done << std::endl;
+}
+
+// broadcast one message and wait until the write queues of all the sessions are drained
+void probeBroadcast(std::shared_ptr<WsService> _wsService, std::size_t _size)
+{
+    auto ss = _wsService->sessions();
+    auto msg = _wsService->messageFactory()->buildMessage();
+    msg->setPacketType(BROADCAST_MSGTYPE);
+    msg->setSeq(_wsService->messageFactory()->newSeq());
+    msg->setPayload(std::make_shared<bytes>(_size, 'b'));
+
+    auto cpu = cpuSeconds();
+    auto startPoint = std::chrono::steady_clock::now();
+    _wsService->broadcastMessage(ss, msg);
+    auto callUs = elapsedUs(startPoint);
+
+    auto deadline = startPoint + std::chrono::seconds(30);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        std::size_t queued = 0;
+        for (auto& session : ss)
+        {
+            queued += session->msgQueueSize();
+        }
+        if (queued == 0)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto drainUs = elapsedUs(startPoint);
+
+    std::cerr << " \t[broadcast] sessions: " << ss.size() << ", size: " << _size
+              << ", call(us): " << callUs << ", drained(us): " << drainUs
+              << ", cpu(ms): " << (cpuSeconds() - cpu) * 1000 << std::endl;
+}
+
+void workAsServer(std::string listenIp, uint16_t listenPort, bool disableSsl,
+    uint32_t probeIntervalS, std::size_t broadcastSize)
+{
+    std::cerr << " ==> boostssl_conn_scale work as server." << std::endl
+              << " \t listenIp: " << listenIp << std::endl
+              << " \t listenPort: " << listenPort << std::endl
+              << " \t disableSsl: " << disableSsl << std::endl
+              << " \t probeIntervalS: " << probeIntervalS << std::endl
+              << " \t broadcastSize: " << broadcastSize << std::endl;
+
+    auto config = std::make_shared<WsConfig>();
+    config->setModel(WsModel::Server);
+    config->setListenIP(listenIp);
+    config->setListenPort(listenPort);
+    initSsl(config, disableSsl);
+    config->setThreadPoolSize(std::max<uint32_t>(std::thread::hardware_concurrency(), 4));
+
+    auto wsService = std::make_shared<ws::WsService>("boostssl-conn-scale-server");
+    auto wsInitializer = std::make_shared<WsInitializer>();
+    wsInitializer->setConfig(config);
+    wsInitializer->initWsService(wsService);
+
+    std::atomic<uint64_t> backgroundC{0};
+    wsService->registerMsgHandler(BACKGROUND_MSGTYPE,
+        [&backgroundC](std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) {
+            ++backgroundC;
+        });
+
+    wsService->start();
+
+    // the memory of the idle service, the sessions are measured against it
+    auto baseRss = rssBytes();
+    std::size_t lastSessions = 0;
+    uint64_t lastBackgroundC = 0;
+    auto lastCpu = cpuSeconds();
+    uint32_t seconds = 0;
+    while (true)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        ++seconds;
+
+        auto sessionCount = wsService->sessions().size();
+        auto rss = rssBytes();
+        auto cpu = cpuSeconds();
+        std::cerr << " boostssl conn scale working as server: " << std::endl;
+        std::cerr << " \tsessions: " << sessionCount
+                  << ", accept rate(/s): " << (int64_t)sessionCount - (int64_t)lastSessions
+                  << ", rss(MB): " << rss / (1024 * 1024)
+                  << ", rss per session(KB): " << rssPerSessionKB(rss, baseRss, sessionCount)
+                  << ", sessions() latency(us): " << sessionsLatencyUs(wsService)
+                  << ", cpu(%): " << (cpu - lastCpu) * 100
+                  << ", background rate(/s): " << backgroundC - lastBackgroundC << std::endl;
+        lastSessions = sessionCount;
+        lastBackgroundC = backgroundC;
+        lastCpu = cpu;
+
+        if (sessionCount > 0 && probeIntervalS > 0 && seconds % probeIntervalS == 0)
+        {
+            probeHeartbeat(wsService, 10000);
+            probeBroadcast(wsService, broadcastSize);
+            lastCpu = cpuSeconds();
+        }
+    }
+}
+
+void workAsClient(std::string serverIp, uint16_t serverPort, bool disableSsl, uint32_t sessionCount,
+    uint32_t addressCount, uint64_t backgroundRate)
+{
+    std::cerr << " ==> boostssl_conn_scale work as client. \n"
+              << " \t serverIp: " << serverIp << "\n"
+              << " \t serverPort: " << serverPort << "\n"
+              << " \t disableSsl: " << disableSsl << "\n"
+              << " \t sessions: " << sessionCount << "\n"
+              << " \t addressCount: " << addressCount << "\n"
+              << " \t backgroundRate: " << backgroundRate << "\n\n\n";
+
+    auto config = std::make_shared<WsConfig>();
+    config->setModel(WsModel::Client);
+    initSsl(config, disableSsl);
+    config->setThreadPoolSize(std::max<uint32_t>(std::thread::hardware_concurrency(), 4));
+
+    auto wsService = std::make_shared<ws::WsService>("boostssl-conn-scale-client");
+    auto wsInitializer = std::make_shared<WsInitializer>();
+    wsInitializer->setConfig(config);
+    wsInitializer->initWsService(wsService);
+
+    std::atomic<uint64_t> broadcastC{0};
+    wsService->registerMsgHandler(HEARTBEAT_MSGTYPE,
+        [](std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession> _session) {
+            _session->asyncSendMessage(_msg);
+        });
+    wsService->registerMsgHandler(BROADCAST_MSGTYPE,
+        [&broadcastC](std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) {
+            ++broadcastC;
+        });
+    wsService->start();
+    auto baseRss = rssBytes();
+
+    // the connector connects to an endpoint one at a time, every address connects its share
+    // of the sessions on a thread of its own
+    std::mutex sessionsMutex;
+    std::vector<std::shared_ptr<WsSession>> sessions;
+    std::atomic<uint64_t> connectedC{0};
+    std::atomic<uint64_t> failedC{0};
+    auto baseAddress = boost::asio::ip::make_address_v4(serverIp).to_uint();
+    std::vector<std::thread> connectThreads;
+    for (uint32_t a = 0; a < addressCount; ++a)
+    {
+        auto address = boost::asio::ip::address_v4(baseAddress + a).to_string();
+        auto count = sessionCount / addressCount + (a < sessionCount % addressCount ? 1 : 0);
+        connectThreads.emplace_back([&, address, count]() {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                std::promise<std::shared_ptr<WsSession>> p;
+                auto f = p.get_future();
+                auto connectedEndPoint =
+                    address + ":" + std::to_string(serverPort) + "#" + std::to_string(i);
+                wsService->connector()->connectToWsServer(address, serverPort, disableSsl, false,
+                    [&p, &wsService, connectedEndPoint](boost::beast::error_code _ec,
+                        const std::string&, std::shared_ptr<WsStreamDelegate> _wsStreamDelegate,
+                        std::shared_ptr<std::string> _nodeId) {
+                        if (_ec)
+                        {
+                            p.set_value(nullptr);
+                            return;
+                        }
+                        auto session = wsService->newSession(_wsStreamDelegate, *_nodeId);
+                        session->setConnectedEndPoint(connectedEndPoint);
+                        session->startAsClient();
+                        p.set_value(session);
+                    });
+                auto session = f.get();
+                if (!session)
+                {
+                    ++failedC;
+                    continue;
+                }
+                ++connectedC;
+                std::lock_guard<std::mutex> l(sessionsMutex);
+                sessions.push_back(session);
+            }
+        });
+    }
+
+    auto startPoint = std::chrono::steady_clock::now();
+    uint64_t lastConnectedC = 0;
+    while (connectedC + failedC < sessionCount)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        std::cerr << " \t...connected: " << connectedC << ", failed: " << failedC
+                  << ", connect rate(/s): " << connectedC - lastConnectedC
+                  << ", rss per session(KB): " << rssPerSessionKB(rssBytes(), baseRss, connectedC)
+                  << std::endl;
+        lastConnectedC = connectedC;
+    }
+    for (auto& thread : connectThreads)
+    {
+        thread.join();
+    }
+    std::cerr << " ==> connected: " << connectedC << ", failed: " << failedC
+              << ", elapsed(ms): " << elapsedUs(startPoint) / 1000 << std::endl;
+    if (sessions.empty())
+    {
+        std::exit(1);
+    }
+
+    // the background traffic, round robin over the sessions
+    auto payload = std::make_shared<bytes>(64, 'a');
+    auto interval = std::chrono::nanoseconds(1000000000ULL / std::max<uint64_t>(backgroundRate, 1));
+    auto nextSend = std::chrono::steady_clock::now();
+    auto nextReport = nextSend + std::chrono::seconds(1);
+    uint64_t sent = 0;
+    while (true)
+    {
+        if (backgroundRate > 0)
+        {
+            std::this_thread::sleep_until(nextSend);
+            nextSend += interval;
+            auto msg = wsService->messageFactory()->buildMessage();
+            msg->setPacketType(BACKGROUND_MSGTYPE);
+            msg->setSeq(wsService->messageFactory()->newSeq());
+            msg->setPayload(payload);
+            sessions[sent++ % sessions.size()]->asyncSendMessage(msg);
+        }
+        else
+        {
+            std::this_thread::sleep_until(nextReport);
+        }
+
+        if (std::chrono::steady_clock::now() >= nextReport)
+        {
+            nextReport += std::chrono::seconds(1);
+            std::cerr << " boostssl conn scale working as client: " << std::endl;
+            std::cerr << " \tsessions: " << wsService->sessions().size()
+                      << ", background sent: " << sent << ", broadcast received: " << broadcastC
+                      << ", rss(MB): " << rssBytes() / (1024 * 1024) << std::endl;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        usage();
+    }
+
+    std::string workModel = argv[1];
+    std::string host = argv[2];
+    uint16_t port = atoi(argv[3]);
+    bool disableSsl = ("true" == std::string(argv[4])) ? true : false;
+
+    initLog();
+
+    if (workModel == "server")
+    {
+        uint32_t probeIntervalS = argc > 5 ? std::stoul(std::string(argv[5])) : 10;
+        std::size_t broadcastSize = argc > 6 ? std::stoull(std::string(argv[6])) : 1024;
+        workAsServer(host, port, disableSsl, probeIntervalS, broadcastSize);
+    }
+    else if (workModel == "client")
+    {
+        if (argc < 6)
+        {
+            usage();
+        }
+        uint32_t sessionCount = std::stoul(std::string(argv[5]));
+        uint32_t addressCount = argc > 6 ? std::stoul(std::string(argv[6])) : 1;
+        uint64_t backgroundRate = argc > 7 ? std::stoull(std::string(argv[7])) : 100;
+        workAsClient(host, port, disableSsl, sessionCount, std::max<uint32_t>(addressCount, 1),
+            backgroundRate);
+    }
+    else
+    {
+        usage();
+    }
+}
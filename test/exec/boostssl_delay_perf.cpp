@@ -25,10 +25,12 @@
 #include <bcos-utilities/BoostLogInitializer.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/ThreadPool.h>
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
 
 using namespace bcos;
 using namespace bcos::boostssl;
@@ -41,12 +43,18 @@ using namespace bcos::boostssl::context;
 void usage()
 {
     std::cerr << "Usage: \n"
-              << " \t boostssl-delay-perf server <ip> <port> <disable_ssl> \n "
+              << " \t boostssl-delay-perf server <ip> <port> <disable_ssl> [unix_socket_path] "
+                 "[busy_poll_us] [busy_poll_cpu_percent] \n "
               << " \t boostssl-delay-perf client <ip> <port> <disable_ssl> <echo_count> "
-                 "<msg_size> \n"
+                 "<msg_size> [unix_socket_path] [busy_poll_us] [busy_poll_cpu_percent] \n"
               << "Example:\n"
               << " \t ./boostssl-delay-perf server 127.0.0.1 20200 true \n"
-              << " \t ./boostssl-delay-perf client 127.0.0.1 20200 true 100000 1024 \n";
+              << " \t ./boostssl-delay-perf client 127.0.0.1 20200 true 100000 1024 \n"
+              << " \t ./boostssl-delay-perf server 127.0.0.1 20200 true /tmp/boostssl.sock \n"
+              << " \t ./boostssl-delay-perf client 127.0.0.1 20200 true 100000 1024 "
+                 "/tmp/boostssl.sock \n"
+              << " \t ./boostssl-delay-perf server 127.0.0.1 20200 true \"\" 50 100 \n"
+              << " \t ./boostssl-delay-perf client 127.0.0.1 20200 true 100000 1024 \"\" 50 100 \n";
     std::exit(0);
 }
 
@@ -78,21 +86,57 @@ void initLog(const std::string& _configPath = "./clog.ini")
 
 const static int DELAY_PERF_MSGTYPE = 9999;
 
-void workAsClient(
-    std::string serverIp, uint16_t serverPort, bool disableSsl, uint64_t echoC, uint64_t msgSize)
+// busy_poll_us 0 keeps the io threads blocking in epoll, the spinners of the client and the server
+// need cpus of their own, on a shared cpu they starve each other and the echo waits for the
+// time slice
+void initBusyPoll(std::shared_ptr<WsConfig> _config, uint32_t _busyPollUs, uint32_t _cpuPercent)
+{
+    if (_busyPollUs == 0)
+    {
+        return;
+    }
+    _config->setBusyPollThreads(_config->ioThreadPoolSize());
+    _config->setBusyPollUs(_busyPollUs);
+    _config->setBusyPollCpuPercent(_cpuPercent);
+}
+
+// the latency at the _p-th percentile of the sorted latencies
+uint64_t percentile(const std::vector<uint64_t>& _sorted, double _p)
+{
+    if (_sorted.empty())
+    {
+        return 0;
+    }
+    auto index = (std::size_t)(_p / 100 * (_sorted.size() - 1));
+    return _sorted[index];
+}
+
+void workAsClient(std::string serverIp, uint16_t serverPort, bool disableSsl, uint64_t echoC,
+    uint64_t msgSize, const std::string& unixSocketPath, uint32_t busyPollUs,
+    uint32_t busyPollCpuPercent)
 {
     std::cerr << " ==> boostssl_delay_perf work as client. \n"
               << " \t serverIp: " << serverIp << "\n"
               << " \t serverPort: " << serverPort << "\n"
               << " \t disableSsl: " << disableSsl << "\n"
               << " \t echoC: " << echoC << "\n"
-              << " \t msgSize: " << msgSize << "\n\n\n";
+              << " \t msgSize: " << msgSize << "\n"
+              << " \t unixSocketPath: " << unixSocketPath << "\n"
+              << " \t busyPollUs: " << busyPollUs << "\n"
+              << " \t busyPollCpuPercent: " << busyPollCpuPercent << "\n\n\n";
 
     auto config = std::make_shared<WsConfig>();
     config->setModel(WsModel::Client);
 
     auto peers = std::make_shared<EndPoints>();
-    peers->insert(NodeIPEndpoint(serverIp, serverPort));
+    if (unixSocketPath.empty())
+    {
+        peers->insert(NodeIPEndpoint(serverIp, serverPort));
+    }
+    else
+    {
+        peers->insert(NodeIPEndpoint(UNIX_SOCKET_PREFIX + unixSocketPath, 0));
+    }
     config->setConnectPeers(peers);
 
     config->setThreadPoolSize(4);
@@ -103,6 +147,7 @@ void workAsClient(
         contextConfig->initConfig("./boostssl.ini");
         config->setContextConfig(contextConfig);
     }
+    initBusyPoll(config, busyPollUs, busyPollCpuPercent);
 
     auto wsService = std::make_shared<ws::WsService>("boostssl-delay-perf-client");
     auto wsInitializer = std::make_shared<WsInitializer>();
@@ -121,6 +166,9 @@ void workAsClient(
     uint64_t nSucC = 0;
     uint64_t nFailedC = 0;
 
+    std::vector<uint64_t> latencies;
+    latencies.reserve(echoC);
+
     uint64_t i = 0;
     uint64_t _10Per = echoC / 10;
     auto startPoint = std::chrono::high_resolution_clock::now();
@@ -135,6 +183,7 @@ void workAsClient(
         }
 
         msg->setSeq(wsService->messageFactory()->newSeq());
+        auto sendPoint = std::chrono::high_resolution_clock::now();
         wsService->asyncSendMessage(msg, Options(-1),
             [&p, &nFailedC, &nSucC](Error::Ptr _error, std::shared_ptr<MessageFace> _msg,
                 std::shared_ptr<WsSession> _session) {
@@ -151,6 +200,9 @@ void workAsClient(
                 nSucC++;
             });
         f.get();
+        auto recvPoint = std::chrono::high_resolution_clock::now();
+        latencies.push_back(
+            std::chrono::duration_cast<std::chrono::microseconds>(recvPoint - sendPoint).count());
     }
     auto endPoint = std::chrono::high_resolution_clock::now();
 
@@ -161,22 +213,32 @@ void workAsClient(
     std::cerr << " ==> boostssl_delay_perf result: " << std::endl;
     std::cerr << " \t total time(us): " << totalTime << std::endl;
     std::cerr << " \t average time(us): " << ((double)totalTime / echoC) << std::endl;
+    std::sort(latencies.begin(), latencies.end());
+    std::cerr << " \t p50(us): " << percentile(latencies, 50) << std::endl;
+    std::cerr << " \t p99(us): " << percentile(latencies, 99) << std::endl;
+    std::cerr << " \t p999(us): " << percentile(latencies, 99.9) << std::endl;
+    std::cerr << " \t max(us): " << (latencies.empty() ? 0 : latencies.back()) << std::endl;
     std::cerr << " \t nSucC: " << nSucC << std::endl;
     std::cerr << " \t nFailedC: " << nFailedC << std::endl;
 }
 
-void workAsServer(std::string listenIp, uint16_t listenPort, bool disableSsl)
+void workAsServer(std::string listenIp, uint16_t listenPort, bool disableSsl,
+    const std::string& unixSocketPath, uint32_t busyPollUs, uint32_t busyPollCpuPercent)
 {
     std::cerr << " ==> boostssl_delay_perf work as server." << std::endl
               << " \t listenIp: " << listenIp << std::endl
               << " \t listenPort: " << listenPort << std::endl
-              << " \t disableSsl: " << disableSsl << "\n";
+              << " \t disableSsl: " << disableSsl << std::endl
+              << " \t unixSocketPath: " << unixSocketPath << "\n"
+              << " \t busyPollUs: " << busyPollUs << "\n"
+              << " \t busyPollCpuPercent: " << busyPollCpuPercent << "\n";
 
     auto config = std::make_shared<WsConfig>();
     config->setModel(WsModel::Server);
 
     config->setListenIP(listenIp);
     config->setListenPort(listenPort);
+    config->setUnixSocketPath(unixSocketPath);
     config->setThreadPoolSize(4);
     config->setDisableSsl(disableSsl);
     if (!config->disableSsl())
@@ -185,6 +247,7 @@ void workAsServer(std::string listenIp, uint16_t listenPort, bool disableSsl)
         contextConfig->initConfig("./boostssl.ini");
         config->setContextConfig(contextConfig);
     }
+    initBusyPoll(config, busyPollUs, busyPollCpuPercent);
 
     auto wsService = std::make_shared<ws::WsService>("boostssl-delay-perf-server");
     auto wsInitializer = std::make_shared<WsInitializer>();
@@ -224,7 +287,10 @@ int main(int argc, char** argv)
 
     if (workModel == "server")
     {
-        workAsServer(host, port, disableSsl);
+        std::string unixSocketPath = argc > 5 ? argv[5] : "";
+        uint32_t busyPollUs = argc > 6 ? std::stoul(std::string(argv[6])) : 0;
+        uint32_t busyPollCpuPercent = argc > 7 ? std::stoul(std::string(argv[7])) : 50;
+        workAsServer(host, port, disableSsl, unixSocketPath, busyPollUs, busyPollCpuPercent);
     }
     else if (workModel == "client")
     {
@@ -239,7 +305,11 @@ int main(int argc, char** argv)
         {
             msgSize = std::stoull(std::string(argv[6]));
         }
-        workAsClient(host, port, disableSsl, echoCount, msgSize);
+        std::string unixSocketPath = argc > 7 ? argv[7] : "";
+        uint32_t busyPollUs = argc > 8 ? std::stoul(std::string(argv[8])) : 0;
+        uint32_t busyPollCpuPercent = argc > 9 ? std::stoul(std::string(argv[9])) : 50;
+        workAsClient(host, port, disableSsl, echoCount, msgSize, unixSocketPath, busyPollUs,
+            busyPollCpuPercent);
     }
     else
     {
@@ -0,0 +1,247 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief handshake throughput benchmark, connects to a server in the same process over and
+ * over and reports the handshakes per second and the latency of every phase of the connection:
+ * resolve, tcp connect, ssl handshake and websocket upgrade
+ * @file boostssl_handshake_perf.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include "HdrHistogram.h"
+#include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/WsConnector.h>
+#include <bcos-boostssl/websocket/WsInitializer.h>
+#include <bcos-boostssl/websocket/WsService.h>
+#include <bcos-utilities/BoostLog.h>
+#include <bcos-utilities/BoostLogInitializer.h>
+#include <bcos-utilities/Common.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+using namespace bcos::boostssl::http;
+using namespace bcos::boostssl::context;
+using namespace bcos::boostssl::perf;
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Usage: \n"
+              << " \t boostssl-handshake-perf <ssl_config> <port> <connections> <concurrency> "
+                 "[session_resumption]\n"
+              << " \t ssl_config: the boostssl.ini of the ssl context, its ssl_type selects "
+                 "the normal or the sm ssl context, \"none\" disables ssl\n"
+              << " \t concurrency: the connecting threads, every thread connects to its own "
+                 "address 127.0.0.1, 127.0.0.2, ...\n"
+              << " \t session_resumption: true or false, default false\n"
+              << "Example:\n"
+              << " \t ./boostssl-handshake-perf ./boostssl.ini 20200 10000 4\n"
+              << " \t ./boostssl-handshake-perf ./boostssl_sm.ini 20200 10000 4 true\n"
+              << " \t ./boostssl-handshake-perf none 20200 10000 4\n";
+    std::exit(0);
+}
+
+void initLog(const std::string& _configPath = "./clog.ini")
+{
+    boost::property_tree::ptree pt;
+    try
+    {
+        boost::property_tree::read_ini(_configPath, pt);
+    }
+    catch (const std::exception& e)
+    {
+        try
+        {
+            std::string defaultPath = "conf/clog.ini";
+            boost::property_tree::read_ini(defaultPath, pt);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Not found available log config(./clog.ini or ./conf/clog.ini), use "
+                         "the default configuration items"
+                      << std::endl;
+        }
+    }
+
+    auto logInitializer = new bcos::BoostLogInitializer();
+    logInitializer->initLog(pt, bcos::FileLogger, "cpp_sdk_log");
+}
+
+void initSsl(
+    std::shared_ptr<WsConfig> _config, const std::string& _sslConfig, bool _sessionResumption)
+{
+    _config->setDisableSsl(_sslConfig == "none");
+    if (!_config->disableSsl())
+    {
+        auto contextConfig = std::make_shared<ContextConfig>();
+        contextConfig->initConfig(_sslConfig);
+        contextConfig->setSessionResumption(_sessionResumption);
+        _config->setContextConfig(contextConfig);
+    }
+}
+
+// the latency of every phase of the connections, in microseconds
+struct PhaseStat
+{
+    HdrHistogram resolve;
+    HdrHistogram connect;
+    HdrHistogram sslHandshake;
+    HdrHistogram wsHandshake;
+    HdrHistogram total;
+    std::atomic<uint64_t> reused{0};
+};
+
+void printPhase(const std::string& _name, const HdrHistogram& _latency)
+{
+    std::cerr << " \t " << _name << "(us): "
+              << " count=" << _latency.totalCount() << " mean=" << _latency.mean()
+              << " p50=" << _latency.valueAtPercentile(50)
+              << " p99=" << _latency.valueAtPercentile(99) << " max=" << _latency.max()
+              << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        usage();
+    }
+
+    std::string sslConfig = argv[1];
+    uint16_t port = atoi(argv[2]);
+    uint64_t connections = std::stoull(std::string(argv[3]));
+    uint32_t concurrency = std::max(atoi(argv[4]), 1);
+    bool sessionResumption = argc > 5 && std::string(argv[5]) == "true";
+
+    initLog();
+
+    std::cerr << " ==> boostssl_handshake_perf. \n"
+              << " \t sslConfig: " << sslConfig << "\n"
+              << " \t port: " << port << "\n"
+              << " \t connections: " << connections << "\n"
+              << " \t concurrency: " << concurrency << "\n"
+              << " \t sessionResumption: " << sessionResumption << "\n\n\n";
+
+    auto serverConfig = std::make_shared<WsConfig>();
+    serverConfig->setModel(WsModel::Server);
+    serverConfig->setListenIP("0.0.0.0");
+    serverConfig->setListenPort(port);
+    initSsl(serverConfig, sslConfig, sessionResumption);
+
+    auto server = std::make_shared<ws::WsService>("boostssl-handshake-perf-server");
+    auto serverInitializer = std::make_shared<WsInitializer>();
+    serverInitializer->setConfig(serverConfig);
+    serverInitializer->initWsService(server);
+    server->start();
+
+    auto clientConfig = std::make_shared<WsConfig>();
+    clientConfig->setModel(WsModel::Client);
+    initSsl(clientConfig, sslConfig, sessionResumption);
+
+    auto client = std::make_shared<ws::WsService>("boostssl-handshake-perf-client");
+    auto clientInitializer = std::make_shared<WsInitializer>();
+    clientInitializer->setConfig(clientConfig);
+    clientInitializer->initWsService(client);
+    client->start();
+
+    auto stat = std::make_shared<PhaseStat>();
+    client->connector()->setConnectObserver(
+        [stat](const std::string&, const ConnectTimings& _timings) {
+            stat->resolve.record(_timings.resolveUs);
+            stat->connect.record(_timings.connectUs);
+            stat->sslHandshake.record(_timings.sslHandshakeUs);
+            stat->wsHandshake.record(_timings.wsHandshakeUs);
+            stat->total.record(_timings.resolveUs + _timings.connectUs +
+                               _timings.sslHandshakeUs + _timings.wsHandshakeUs);
+            if (_timings.sslSessionReused)
+            {
+                stat->reused++;
+            }
+        });
+
+    // the connector connects to an endpoint one at a time, every thread has its own address
+    std::atomic<uint64_t> next{0};
+    std::atomic<uint64_t> failed{0};
+    auto disableSsl = clientConfig->disableSsl();
+    auto startPoint = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < concurrency; ++t)
+    {
+        auto address = "127.0.0." + std::to_string(1 + t);
+        threads.emplace_back([&client, &next, &failed, address, port, connections, disableSsl]() {
+            while (next++ < connections)
+            {
+                std::promise<bool> p;
+                auto f = p.get_future();
+                client->connector()->connectToWsServer(address, port, disableSsl,
+                    [&p](boost::beast::error_code _ec, const std::string& _extErrorMsg,
+                        std::shared_ptr<WsStreamDelegate> _wsStreamDelegate,
+                        std::shared_ptr<std::string>) {
+                        if (_ec)
+                        {
+                            std::cerr << " connect failed: " << _ec.message() << " "
+                                      << _extErrorMsg << std::endl;
+                            p.set_value(false);
+                            return;
+                        }
+                        _wsStreamDelegate->close();
+                        p.set_value(true);
+                    });
+                if (!f.get())
+                {
+                    failed++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startPoint)
+                       .count();
+
+    auto succeeded = stat->total.totalCount();
+    std::cerr << " ==> handshake perf result: \n"
+              << " \t succeeded: " << succeeded << "\n"
+              << " \t failed: " << failed.load() << "\n"
+              << " \t sessionReused: " << stat->reused.load() << "\n"
+              << " \t elapsed(ms): " << elapsed / 1000 << "\n"
+              << " \t handshakes/s: " << (double)succeeded * 1000000 / std::max<int64_t>(elapsed, 1)
+              << std::endl;
+    printPhase("resolve", stat->resolve);
+    printPhase("connect", stat->connect);
+    printPhase("sslHandshake", stat->sslHandshake);
+    printPhase("wsHandshake", stat->wsHandshake);
+    printPhase("total", stat->total);
+
+    client->stop();
+    server->stop();
+    return EXIT_SUCCESS;
+}
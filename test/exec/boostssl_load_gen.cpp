@@ -0,0 +1,498 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief open-loop load generator, the requests are sent at a fixed rate whatever the responses
+ * do and the latency of a request is measured from the time it was scheduled to be sent, so a
+ * stalled server is not hidden by the client backing off (coordinated omission)
+ * @file boostssl_load_gen.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include "HdrHistogram.h"
+#include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/WsConnector.h>
+#include <bcos-boostssl/websocket/WsInitializer.h>
+#include <bcos-boostssl/websocket/WsService.h>
+#include <bcos-utilities/BoostLog.h>
+#include <bcos-utilities/BoostLogInitializer.h>
+#include <bcos-utilities/Common.h>
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+using namespace bcos::boostssl::http;
+using namespace bcos::boostssl::context;
+using namespace bcos::boostssl::perf;
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Usage: \n"
+              << " \t boostssl-load-gen server <ip> <port> <disable_ssl> [transport]\n"
+              << " \t boostssl-load-gen client <ip> <port> <disable_ssl> <sessions> <rate> "
+                 "<duration_s> <msg_sizes> [transport] [output_prefix] [timeout_ms]\n"
+              << " \t rate: requests per second over all the sessions\n"
+              << " \t msg_sizes: size[:weight],... the payload size of each request is picked "
+                 "by weight\n"
+              << " \t transport: ws(default), tcpframe, io_uring(tcpframe without ssl)\n"
+              << " \t output_prefix: writes <prefix>.json and <prefix>.csv, default load_gen\n"
+              << " \t timeout_ms: the request timeout, default 10000, the failed and the lost "
+                 "requests count as at least this late in the latency\n"
+              << "Example:\n"
+              << " \t ./boostssl-load-gen server 127.0.0.1 20200 true\n"
+              << " \t ./boostssl-load-gen client 127.0.0.1 20200 true 64 50000 60 "
+                 "64:50,1024:40,65536:10\n"
+              << " \t ./boostssl-load-gen client 127.0.0.1 20200 true 64 50000 60 1024 "
+                 "tcpframe result_tcpframe\n";
+    std::exit(0);
+}
+
+void initLog(const std::string& _configPath = "./clog.ini")
+{
+    boost::property_tree::ptree pt;
+    try
+    {
+        boost::property_tree::read_ini(_configPath, pt);
+    }
+    catch (const std::exception& e)
+    {
+        try
+        {
+            std::string defaultPath = "conf/clog.ini";
+            boost::property_tree::read_ini(defaultPath, pt);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Not found available log config(./clog.ini or ./conf/clog.ini), use "
+                         "the default configuration items"
+                      << std::endl;
+        }
+    }
+
+    auto logInitializer = new bcos::BoostLogInitializer();
+    logInitializer->initLog(pt, bcos::FileLogger, "cpp_sdk_log");
+}
+
+const static int LOAD_GEN_MSGTYPE = 9999;
+
+void initTransport(std::shared_ptr<WsConfig> _config, const std::string& _transport)
+{
+    if (_transport == "ws")
+    {
+        return;
+    }
+    if (_config->asServer())
+    {
+        _config->setAcceptTcpFrame(true);
+    }
+    if (_transport == "io_uring")
+    {
+        _config->setIOBackend(IOBackend::IoUring);
+    }
+}
+
+void initSsl(std::shared_ptr<WsConfig> _config, bool _disableSsl)
+{
+    _config->setDisableSsl(_disableSsl);
+    if (!_config->disableSsl())
+    {
+        auto contextConfig = std::make_shared<ContextConfig>();
+        contextConfig->initConfig("./boostssl.ini");
+        _config->setContextConfig(contextConfig);
+    }
+}
+
+// "64:50,1024:40,65536:10" => {{64, 50}, {1024, 40}, {65536, 10}}, the weight defaults to 1
+std::vector<std::pair<uint64_t, uint64_t>> parseMsgSizes(const std::string& _msgSizes)
+{
+    std::vector<std::pair<uint64_t, uint64_t>> sizes;
+    std::vector<std::string> items;
+    boost::split(items, _msgSizes, boost::is_any_of(","), boost::token_compress_on);
+    for (auto& item : items)
+    {
+        if (item.empty())
+        {
+            continue;
+        }
+        auto pos = item.find(':');
+        uint64_t size = std::stoull(item.substr(0, pos));
+        uint64_t weight = pos == std::string::npos ? 1 : std::stoull(item.substr(pos + 1));
+        if (weight > 0)
+        {
+            sizes.emplace_back(size, weight);
+        }
+    }
+    if (sizes.empty())
+    {
+        std::cerr << "invalid msg_sizes: " << _msgSizes << std::endl;
+        usage();
+    }
+    return sizes;
+}
+
+// the latency of the requests of one payload size, in microseconds
+struct SizeStat
+{
+    uint64_t size;
+    HdrHistogram latency;
+    std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> failed{0};
+};
+
+void writeLatencyJson(std::ostream& _out, const HdrHistogram& _latency, const std::string& _indent)
+{
+    _out << _indent << "\"count\": " << _latency.totalCount() << ",\n"
+         << _indent << "\"min_us\": " << _latency.min() << ",\n"
+         << _indent << "\"mean_us\": " << _latency.mean() << ",\n"
+         << _indent << "\"p50_us\": " << _latency.valueAtPercentile(50) << ",\n"
+         << _indent << "\"p90_us\": " << _latency.valueAtPercentile(90) << ",\n"
+         << _indent << "\"p99_us\": " << _latency.valueAtPercentile(99) << ",\n"
+         << _indent << "\"p999_us\": " << _latency.valueAtPercentile(99.9) << ",\n"
+         << _indent << "\"p9999_us\": " << _latency.valueAtPercentile(99.99) << ",\n"
+         << _indent << "\"max_us\": " << _latency.max();
+}
+
+void workAsClient(std::string serverIp, uint16_t serverPort, bool disableSsl, uint32_t sessionCount,
+    uint64_t rate, uint64_t durationS, const std::string& msgSizes, const std::string& transport,
+    const std::string& outputPrefix, uint32_t timeoutMs)
+{
+    std::cerr << " ==> boostssl_load_gen work as client. \n"
+              << " \t serverIp: " << serverIp << "\n"
+              << " \t serverPort: " << serverPort << "\n"
+              << " \t disableSsl: " << disableSsl << "\n"
+              << " \t sessions: " << sessionCount << "\n"
+              << " \t rate: " << rate << "\n"
+              << " \t durationS: " << durationS << "\n"
+              << " \t msgSizes: " << msgSizes << "\n"
+              << " \t transport: " << transport << "\n"
+              << " \t outputPrefix: " << outputPrefix << "\n"
+              << " \t timeoutMs: " << timeoutMs << "\n\n\n";
+
+    auto sizes = parseMsgSizes(msgSizes);
+
+    auto config = std::make_shared<WsConfig>();
+    config->setModel(WsModel::Client);
+    initTransport(config, transport);
+    initSsl(config, disableSsl);
+    config->setThreadPoolSize(std::max<uint32_t>(std::thread::hardware_concurrency(), 4));
+
+    auto wsService = std::make_shared<ws::WsService>("boostssl-load-gen-client");
+    auto wsInitializer = std::make_shared<WsInitializer>();
+    wsInitializer->setConfig(config);
+    wsInitializer->initWsService(wsService);
+    wsService->start();
+
+    // the service keeps one session for each peer, the sessions of the load generator are
+    // connected one by one and told apart by the index in their connected endpoint
+    std::vector<std::shared_ptr<WsSession>> sessions;
+    bool tcpFrame = transport != "ws";
+    for (uint32_t i = 0; i < sessionCount; ++i)
+    {
+        std::promise<std::shared_ptr<WsSession>> p;
+        auto f = p.get_future();
+        auto connectedEndPoint =
+            serverIp + ":" + std::to_string(serverPort) + "#" + std::to_string(i);
+        wsService->connector()->connectToWsServer(serverIp, serverPort, disableSsl, tcpFrame,
+            [&p, &wsService, connectedEndPoint](boost::beast::error_code _ec,
+                const std::string& _extErrorMsg,
+                std::shared_ptr<WsStreamDelegate> _wsStreamDelegate,
+                std::shared_ptr<std::string> _nodeId) {
+                if (_ec)
+                {
+                    std::cerr << " connect failed: " << _ec.message() << " " << _extErrorMsg
+                              << std::endl;
+                    p.set_value(nullptr);
+                    return;
+                }
+                auto session = wsService->newSession(_wsStreamDelegate, *_nodeId);
+                session->setConnectedEndPoint(connectedEndPoint);
+                session->startAsClient();
+                p.set_value(session);
+            });
+        auto session = f.get();
+        if (session)
+        {
+            sessions.push_back(session);
+        }
+    }
+    if (sessions.empty())
+    {
+        std::cerr << " no session connected" << std::endl;
+        std::exit(1);
+    }
+    std::cerr << " \t...connected sessions: " << sessions.size() << std::endl;
+
+    // the payloads are shared by the requests of the same size
+    std::vector<std::shared_ptr<SizeStat>> stats;
+    std::vector<std::shared_ptr<bytes>> payloads;
+    std::vector<uint64_t> weights;
+    for (auto& size : sizes)
+    {
+        auto stat = std::make_shared<SizeStat>();
+        stat->size = size.first;
+        stats.push_back(stat);
+        payloads.push_back(std::make_shared<bytes>(size.first, 'a'));
+        weights.push_back(size.second);
+    }
+    std::mt19937_64 rng(0);
+    std::discrete_distribution<std::size_t> pickSize(weights.begin(), weights.end());
+
+    // the failed requests are recorded at the timeout or later, a request that timed out or was
+    // dropped never got its response, leaving it out would hide the tail the percentiles are for
+    HdrHistogram latency;
+    uint64_t timeoutUs = (uint64_t)timeoutMs * 1000;
+    // how late the generator was against the schedule, it saturated if this grows
+    HdrHistogram sendLag;
+    std::atomic<uint64_t> sent{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> failed{0};
+    // set once the results are taken, the responses after it are not counted
+    std::atomic<bool> finished{false};
+
+    auto interval = std::chrono::nanoseconds(1000000000ULL / std::max<uint64_t>(rate, 1));
+    auto total = rate * durationS;
+    auto startPoint = std::chrono::steady_clock::now();
+    auto nextReport = startPoint + std::chrono::seconds(1);
+    for (uint64_t i = 0; i < total; ++i)
+    {
+        auto intended = startPoint + interval * i;
+        // never send ahead of the schedule, sleep when far ahead and spin when close
+        auto now = std::chrono::steady_clock::now();
+        while (now < intended)
+        {
+            if (intended - now > std::chrono::microseconds(200))
+            {
+                std::this_thread::sleep_for(intended - now - std::chrono::microseconds(100));
+            }
+            now = std::chrono::steady_clock::now();
+        }
+        sendLag.record(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - intended).count());
+
+        auto index = pickSize(rng);
+        auto stat = stats[index];
+        auto msg = wsService->messageFactory()->buildMessage();
+        msg->setPacketType(LOAD_GEN_MSGTYPE);
+        msg->setSeq(wsService->messageFactory()->newSeq());
+        msg->setPayload(payloads[index]);
+
+        ++sent;
+        ++stat->sent;
+        sessions[i % sessions.size()]->asyncSendMessage(msg, Options(timeoutMs),
+            [intended, stat, timeoutUs, &latency, &completed, &failed, &finished](
+                Error::Ptr _error, std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) {
+                if (finished)
+                {
+                    return;
+                }
+                auto now = std::chrono::steady_clock::now();
+                uint64_t us =
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - intended).count();
+                if (_error && _error->errorCode() != 0)
+                {
+                    us = std::max(us, timeoutUs);
+                    latency.record(us);
+                    stat->latency.record(us);
+                    ++failed;
+                    ++stat->failed;
+                    return;
+                }
+                latency.record(us);
+                stat->latency.record(us);
+                ++completed;
+                ++stat->completed;
+            });
+
+        if (now >= nextReport)
+        {
+            nextReport += std::chrono::seconds(1);
+            std::cerr << "\t...sent: " << sent << ", completed: " << completed
+                      << ", failed: " << failed << ", p99(us): " << latency.valueAtPercentile(99)
+                      << std::endl;
+        }
+    }
+    auto sendEndPoint = std::chrono::steady_clock::now();
+
+    // wait for the responses in flight, the requests time out after timeoutMs
+    auto drainDeadline = sendEndPoint + std::chrono::milliseconds(timeoutMs + 1000);
+    while (completed + failed < sent && std::chrono::steady_clock::now() < drainDeadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    finished = true;
+    // the requests still without a response are later than the timeout
+    uint64_t lost = sent - completed - failed;
+    for (uint64_t i = 0; i < lost; ++i)
+    {
+        latency.record(timeoutUs);
+    }
+    auto sendSeconds =
+        std::chrono::duration_cast<std::chrono::duration<double>>(sendEndPoint - startPoint)
+            .count();
+
+    std::ofstream json(outputPrefix + ".json");
+    json << "{\n"
+         << "  \"sessions\": " << sessions.size() << ",\n"
+         << "  \"target_rate\": " << rate << ",\n"
+         << "  \"achieved_rate\": " << (double)sent / sendSeconds << ",\n"
+         << "  \"duration_s\": " << sendSeconds << ",\n"
+         << "  \"msg_sizes\": \"" << msgSizes << "\",\n"
+         << "  \"transport\": \"" << transport << "\",\n"
+         << "  \"disable_ssl\": " << (disableSsl ? "true" : "false") << ",\n"
+         << "  \"sent\": " << sent << ",\n"
+         << "  \"completed\": " << completed << ",\n"
+         << "  \"failed\": " << failed << ",\n"
+         << "  \"lost\": " << lost << ",\n"
+         << "  \"timeout_ms\": " << timeoutMs << ",\n"
+         << "  \"latency\": {\n";
+    writeLatencyJson(json, latency, "    ");
+    json << "\n  },\n"
+         << "  \"send_lag\": {\n";
+    writeLatencyJson(json, sendLag, "    ");
+    json << "\n  },\n"
+         << "  \"sizes\": [";
+    for (std::size_t i = 0; i < stats.size(); ++i)
+    {
+        json << (i == 0 ? "\n" : ",\n") << "    {\n"
+             << "      \"size\": " << stats[i]->size << ",\n"
+             << "      \"sent\": " << stats[i]->sent << ",\n"
+             << "      \"completed\": " << stats[i]->completed << ",\n"
+             << "      \"failed\": " << stats[i]->failed << ",\n";
+        writeLatencyJson(json, stats[i]->latency, "      ");
+        json << "\n    }";
+    }
+    json << "\n  ],\n"
+         << "  \"histogram\": [";
+    // the full histogram, [highest equivalent value in us, count] of each non-empty bucket
+    bool first = true;
+    latency.forEach([&json, &first](uint64_t _value, uint64_t _count) {
+        json << (first ? "" : ", ") << "[" << _value << ", " << _count << "]";
+        first = false;
+    });
+    json << "]\n}\n";
+
+    std::ofstream csv(outputPrefix + ".csv");
+    latency.outputPercentileDistribution(csv);
+
+    std::cerr << std::endl << std::endl;
+    std::cerr << " ==> boostssl_load_gen result: " << std::endl;
+    std::cerr << " \t achieved rate: " << (double)sent / sendSeconds << std::endl;
+    std::cerr << " \t sent: " << sent << ", completed: " << completed << ", failed: " << failed
+              << ", lost: " << lost << std::endl;
+    std::cerr << " \t p50(us): " << latency.valueAtPercentile(50) << std::endl;
+    std::cerr << " \t p99(us): " << latency.valueAtPercentile(99) << std::endl;
+    std::cerr << " \t p999(us): " << latency.valueAtPercentile(99.9) << std::endl;
+    std::cerr << " \t max(us): " << latency.max() << std::endl;
+    std::cerr << " \t send lag max(us): " << sendLag.max() << std::endl;
+    std::cerr << " \t output: " << outputPrefix << ".json, " << outputPrefix << ".csv"
+              << std::endl;
+
+    wsService->stop();
+    std::exit(0);
+}
+
+void workAsServer(std::string listenIp, uint16_t listenPort, bool disableSsl,
+    const std::string& transport)
+{
+    std::cerr << " ==> boostssl_load_gen work as server." << std::endl
+              << " \t listenIp: " << listenIp << std::endl
+              << " \t listenPort: " << listenPort << std::endl
+              << " \t disableSsl: " << disableSsl << std::endl
+              << " \t transport: " << transport << std::endl;
+
+    auto config = std::make_shared<WsConfig>();
+    config->setModel(WsModel::Server);
+    config->setListenIP(listenIp);
+    config->setListenPort(listenPort);
+    initTransport(config, transport);
+    initSsl(config, disableSsl);
+    config->setThreadPoolSize(std::max<uint32_t>(std::thread::hardware_concurrency(), 4));
+
+    auto wsService = std::make_shared<ws::WsService>("boostssl-load-gen-server");
+    auto wsInitializer = std::make_shared<WsInitializer>();
+    wsInitializer->setConfig(config);
+    wsInitializer->initWsService(wsService);
+
+    wsService->registerMsgHandler(LOAD_GEN_MSGTYPE,
+        [](std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession> _session) {
+            _session->asyncSendMessage(_msg);
+        });
+
+    wsService->start();
+
+    while (true)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10000));
+        std::cerr << " \t...sessions: " << wsService->sessions().size() << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        usage();
+    }
+
+    std::string workModel = argv[1];
+    std::string host = argv[2];
+    uint16_t port = atoi(argv[3]);
+    bool disableSsl = ("true" == std::string(argv[4])) ? true : false;
+
+    initLog();
+
+    if (workModel == "server")
+    {
+        std::string transport = argc > 5 ? argv[5] : "ws";
+        workAsServer(host, port, disableSsl, transport);
+    }
+    else if (workModel == "client")
+    {
+        if (argc < 9)
+        {
+            usage();
+        }
+        uint32_t sessionCount = std::stoul(std::string(argv[5]));
+        uint64_t rate = std::stoull(std::string(argv[6]));
+        uint64_t durationS = std::stoull(std::string(argv[7]));
+        std::string msgSizes = argv[8];
+        std::string transport = argc > 9 ? argv[9] : "ws";
+        std::string outputPrefix = argc > 10 ? argv[10] : "load_gen";
+        uint32_t timeoutMs = argc > 11 ? std::stoul(std::string(argv[11])) : 10000;
+        workAsClient(host, port, disableSsl, sessionCount, rate, durationS, msgSizes, transport,
+            outputPrefix, timeoutMs);
+    }
+    else
+    {
+        usage();
+    }
+}
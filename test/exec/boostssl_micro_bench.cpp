@@ -0,0 +1,339 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief microbenchmarks of the hot paths of the message codec, the dispatch and the response
+ * callbacks, each case reports ns/op and the heap allocations per op
+ * @file boostssl_micro_bench.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-boostssl/websocket/WsService.h>
+#include <bcos-boostssl/websocket/WsSession.h>
+#include <bcos-utilities/Common.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+// every heap allocation of the process is counted, the cases read the difference
+static std::atomic<uint64_t> g_allocations{0};
+static std::atomic<uint64_t> g_allocatedBytes{0};
+
+void* operator new(std::size_t _size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(_size, std::memory_order_relaxed);
+    if (auto p = std::malloc(_size ? _size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t _size)
+{
+    return operator new(_size);
+}
+void* operator new(std::size_t _size, const std::nothrow_t&) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(_size, std::memory_order_relaxed);
+    return std::malloc(_size ? _size : 1);
+}
+void* operator new[](std::size_t _size, const std::nothrow_t& _tag) noexcept
+{
+    return operator new(_size, _tag);
+}
+void operator delete(void* _p) noexcept
+{
+    std::free(_p);
+}
+void operator delete[](void* _p) noexcept
+{
+    std::free(_p);
+}
+void operator delete(void* _p, std::size_t) noexcept
+{
+    std::free(_p);
+}
+void operator delete[](void* _p, std::size_t) noexcept
+{
+    std::free(_p);
+}
+
+// keep the compiler from dropping the result of the benchmarked code
+template <typename T>
+inline void doNotOptimize(T const& _value)
+{
+    asm volatile("" : : "r,m"(_value) : "memory");
+}
+
+void usage()
+{
+    std::cerr << "Usage: \n"
+              << " \t boostssl-micro-bench [filter] [min_time_ms]\n"
+              << " \t filter: run the cases whose name contains it, default all\n"
+              << "Example:\n"
+              << " \t ./boostssl-micro-bench\n"
+              << " \t ./boostssl-micro-bench encode 2000\n";
+    std::exit(0);
+}
+
+struct BenchContext
+{
+    std::string filter;
+    std::chrono::milliseconds minTime{500};
+};
+
+// run _f(iterations) with growing iterations until it takes minTime, then report per op
+void runBench(
+    const BenchContext& _context, const std::string& _name, std::function<void(uint64_t)> _f)
+{
+    if (!_context.filter.empty() && _name.find(_context.filter) == std::string::npos)
+    {
+        return;
+    }
+
+    // warm up the caches and the allocator
+    _f(1);
+
+    uint64_t iterations = 1;
+    while (true)
+    {
+        auto allocations = g_allocations.load();
+        auto bytes = g_allocatedBytes.load();
+        auto startPoint = std::chrono::steady_clock::now();
+        _f(iterations);
+        auto elapsed = std::chrono::steady_clock::now() - startPoint;
+
+        if (elapsed >= _context.minTime || iterations >= (1ULL << 40))
+        {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+            std::cout << std::left << std::setw(40) << _name << std::right << std::setw(14)
+                      << std::fixed << std::setprecision(1) << (double)ns / iterations
+                      << " ns/op" << std::setw(12) << std::setprecision(2)
+                      << (double)(g_allocations.load() - allocations) / iterations
+                      << " allocs/op" << std::setw(14) << std::setprecision(0)
+                      << (double)(g_allocatedBytes.load() - bytes) / iterations << " B/op"
+                      << std::setw(14) << iterations << " iters" << std::endl;
+            return;
+        }
+
+        // aim past minTime from the measured speed, at most 100x per round
+        auto ns = std::max<int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), 1);
+        auto target = std::chrono::nanoseconds(_context.minTime).count();
+        auto next = (uint64_t)((double)iterations * target * 1.2 / ns);
+        iterations = std::min(std::max(next, iterations + 1), iterations * 100);
+    }
+}
+
+// exposes the response callbacks of the session and reports it connected without a stream
+class BenchSession : public WsSession
+{
+public:
+    using WsSession::addRespCallback;
+    using WsSession::CallBack;
+    using WsSession::getAndRemoveRespCallback;
+    using WsSession::WsSession;
+
+    bool isConnected() override { return true; }
+};
+
+static const std::vector<std::size_t> PAYLOAD_SIZES = {64, 1024, 16 * 1024, 1024 * 1024};
+
+void benchCodec(const BenchContext& _context)
+{
+    auto factory = std::make_shared<WsMessageFactory>();
+    for (auto size : PAYLOAD_SIZES)
+    {
+        auto msg = std::dynamic_pointer_cast<WsMessage>(factory->buildMessage());
+        msg->setPacketType(9999);
+        msg->setSeq(factory->newSeq());
+        msg->setPayload(std::make_shared<bytes>(size, 'a'));
+
+        // the buffer keeps its capacity between the rounds as the session write path does
+        bytes buffer;
+        runBench(_context, "WsMessage::encode/" + std::to_string(size),
+            [&msg, &buffer](uint64_t _iterations) {
+                for (uint64_t i = 0; i < _iterations; ++i)
+                {
+                    msg->encode(buffer);
+                    doNotOptimize(buffer.data());
+                }
+            });
+
+        // the session read path decodes every frame into a new message
+        bytes encoded;
+        msg->encode(encoded);
+        runBench(_context, "WsMessage::decode/" + std::to_string(size),
+            [&factory, &encoded](uint64_t _iterations) {
+                for (uint64_t i = 0; i < _iterations; ++i)
+                {
+                    auto decoded = factory->buildMessage();
+                    auto r = decoded->decode(bytesConstRef(encoded.data(), encoded.size()));
+                    doNotOptimize(r);
+                }
+            });
+    }
+}
+
+void benchSeq(const BenchContext& _context)
+{
+    auto factory = std::make_shared<WsMessageFactory>();
+    runBench(_context, "WsMessageFactory::newSeq", [&factory](uint64_t _iterations) {
+        for (uint64_t i = 0; i < _iterations; ++i)
+        {
+            auto seq = factory->newSeq();
+            doNotOptimize(seq.data());
+        }
+    });
+}
+
+void benchMsgHandler(const BenchContext& _context)
+{
+    auto service = std::make_shared<WsService>("boostssl-micro-bench");
+    for (uint16_t type = 1000; type < 1016; ++type)
+    {
+        service->registerMsgHandler(type, [](std::shared_ptr<MessageFace>, WsSession::Ptr) {});
+    }
+
+    runBench(_context, "WsService::getMsgHandler/hit", [&service](uint64_t _iterations) {
+        for (uint64_t i = 0; i < _iterations; ++i)
+        {
+            auto handler = service->getMsgHandler(1000 + (i & 15));
+            doNotOptimize(handler);
+        }
+    });
+    runBench(_context, "WsService::getMsgHandler/miss", [&service](uint64_t _iterations) {
+        for (uint64_t i = 0; i < _iterations; ++i)
+        {
+            auto handler = service->getMsgHandler(2000);
+            doNotOptimize(handler);
+        }
+    });
+}
+
+void benchRespCallback(const BenchContext& _context)
+{
+    auto factory = std::make_shared<WsMessageFactory>();
+    for (std::size_t pending : {0, 1000})
+    {
+        auto session = std::make_shared<BenchSession>("boostssl-micro-bench");
+        for (std::size_t i = 0; i < pending; ++i)
+        {
+            session->addRespCallback(factory->newSeq(), std::make_shared<BenchSession::CallBack>());
+        }
+
+        // the seqs are made ahead, newSeq has a case of its own
+        std::vector<std::string> seqs;
+        for (std::size_t i = 0; i < 1024; ++i)
+        {
+            seqs.push_back(factory->newSeq());
+        }
+
+        runBench(_context, "WsSession::respCallback/add+remove/" + std::to_string(pending),
+            [&session, &seqs](uint64_t _iterations) {
+                for (uint64_t i = 0; i < _iterations; ++i)
+                {
+                    auto& seq = seqs[i & 1023];
+                    auto callback = std::make_shared<BenchSession::CallBack>();
+                    callback->respCallBack = [](Error::Ptr, std::shared_ptr<MessageFace>,
+                                                 std::shared_ptr<WsSession>) {};
+                    session->addRespCallback(seq, callback);
+                    auto found = session->getAndRemoveRespCallback(seq);
+                    doNotOptimize(found);
+                }
+            });
+
+        runBench(_context, "WsSession::respCallback/get/" + std::to_string(pending),
+            [&session, &seqs](uint64_t _iterations) {
+                session->addRespCallback(seqs[0], std::make_shared<BenchSession::CallBack>());
+                for (uint64_t i = 0; i < _iterations; ++i)
+                {
+                    auto found = session->getAndRemoveRespCallback(seqs[0], false);
+                    doNotOptimize(found);
+                }
+                session->getAndRemoveRespCallback(seqs[0]);
+            });
+    }
+}
+
+void benchSessions(const BenchContext& _context)
+{
+    for (std::size_t count : {10, 100, 1000, 10000})
+    {
+        auto service = std::make_shared<WsService>("boostssl-micro-bench");
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto session = std::make_shared<BenchSession>("boostssl-micro-bench");
+            session->setEndPoint("127.0.0.1:" + std::to_string(10000 + i));
+            session->setConnectedEndPoint(session->endPoint());
+            service->addSession(session);
+        }
+
+        runBench(_context, "WsService::sessions/" + std::to_string(count),
+            [&service](uint64_t _iterations) {
+                for (uint64_t i = 0; i < _iterations; ++i)
+                {
+                    auto sessions = service->sessions();
+                    doNotOptimize(sessions.data());
+                }
+            });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help"))
+    {
+        usage();
+    }
+
+    BenchContext context;
+    if (argc > 1)
+    {
+        context.filter = argv[1];
+    }
+    if (argc > 2)
+    {
+        context.minTime = std::chrono::milliseconds(std::stoull(std::string(argv[2])));
+    }
+
+    std::cout << std::left << std::setw(40) << "case" << std::right << std::setw(20) << "time"
+              << std::setw(22) << "allocs" << std::setw(19) << "bytes" << std::setw(20)
+              << "iterations" << std::endl;
+    benchCodec(context);
+    benchSeq(context);
+    benchMsgHandler(context);
+    benchRespCallback(context);
+    benchSessions(context);
+
+    return EXIT_SUCCESS;
+}
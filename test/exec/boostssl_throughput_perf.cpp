@@ -45,12 +45,17 @@ using namespace bcos::boostssl::context;
 void usage()
 {
     std::cerr << "Usage: \n"
-              << " \t boostssl-throughput-perf server <ip> <port> <disable_ssl> <thread_count>\n "
+              << " \t boostssl-throughput-perf server <ip> <port> <disable_ssl> <thread_count> "
+                 "[transport]\n "
               << " \t boostssl-throughput-perf client <ip> <port> <disable_ssl> <thread_count> "
-                 "<msg_size> <send rate>\n"
+                 "<msg_size> <send rate> [transport]\n"
+              << " \t transport: ws(default), tcpframe, io_uring(tcpframe without ssl)\n"
               << "Example:\n"
               << " \t ./boostssl-throughput-perf server 127.0.0.1 20200 true 16\n"
-              << " \t ./boostssl-throughput-perf client 127.0.0.1 20200 true 16 1024 1000\n";
+              << " \t ./boostssl-throughput-perf client 127.0.0.1 20200 true 16 1024 1000\n"
+              << " \t ./boostssl-throughput-perf server 127.0.0.1 20200 true 16 io_uring\n"
+              << " \t ./boostssl-throughput-perf client 127.0.0.1 20200 true 16 1024 1000 "
+                 "io_uring\n";
     std::exit(0);
 }
 
@@ -82,8 +87,28 @@ void initLog(const std::string& _configPath = "./clog.ini")
 
 const static int DELAY_PERF_MSGTYPE = 9999;
 
+void initTransport(std::shared_ptr<WsConfig> _config, const std::string& _transport)
+{
+    if (_transport == "ws")
+    {
+        return;
+    }
+    if (_config->asServer())
+    {
+        _config->setAcceptTcpFrame(true);
+    }
+    if (_config->asClient())
+    {
+        _config->setTcpFramePeers(_config->connectPeers());
+    }
+    if (_transport == "io_uring")
+    {
+        _config->setIOBackend(IOBackend::IoUring);
+    }
+}
+
 void workAsClient(std::string serverIp, uint16_t serverPort, bool disableSsl, uint64_t sendRate,
-    uint64_t msgSize, uint32_t threadCount)
+    uint64_t msgSize, uint32_t threadCount, const std::string& transport)
 {
     std::cerr << " boostssl_throughput_perf work as client." << std::endl
               << " \t serverIp: " << serverIp << std::endl
@@ -91,7 +116,8 @@ void workAsClient(std::string serverIp, uint16_t serverPort, bool disableSsl, ui
               << " \t disableSsl: " << disableSsl << std::endl
               << " \t sendRate: " << sendRate << std::endl
               << " \t msgSize: " << msgSize << std::endl
-              << " \t threadCount: " << threadCount << "\n\n\n";
+              << " \t threadCount: " << threadCount << std::endl
+              << " \t transport: " << transport << "\n\n\n";
 
     auto config = std::make_shared<WsConfig>();
     config->setModel(WsModel::Client);
@@ -100,6 +126,7 @@ void workAsClient(std::string serverIp, uint16_t serverPort, bool disableSsl, ui
     peers->insert(NodeIPEndpoint(serverIp, serverPort));
 
     config->setConnectPeers(peers);
+    initTransport(config, transport);
 
     config->setThreadPoolSize(threadCount);
     config->setDisableSsl(disableSsl);
@@ -192,19 +219,22 @@ void workAsClient(std::string serverIp, uint16_t serverPort, bool disableSsl, ui
     }
 }
 
-void workAsServer(std::string listenIp, uint16_t listenPort, bool disableSsl, uint32_t threadCount)
+void workAsServer(std::string listenIp, uint16_t listenPort, bool disableSsl, uint32_t threadCount,
+    const std::string& transport)
 {
     std::cerr << " boostssl_throughput_perf work as server." << std::endl
               << " \t listenIp: " << listenIp << std::endl
               << " \t listenPort: " << listenPort << std::endl
               << " \t disableSsl: " << disableSsl << std::endl
-              << " \t threadCount: " << threadCount << std::endl;
+              << " \t threadCount: " << threadCount << std::endl
+              << " \t transport: " << transport << std::endl;
 
     auto config = std::make_shared<WsConfig>();
     config->setModel(WsModel::Server);
 
     config->setListenIP(listenIp);
     config->setListenPort(listenPort);
+    initTransport(config, transport);
     config->setThreadPoolSize(threadCount);
     config->setDisableSsl(disableSsl);
     if (!config->disableSsl())
@@ -226,8 +256,8 @@ void workAsServer(std::string listenIp, uint16_t listenPort, bool disableSsl, ui
     wsService->registerMsgHandler(DELAY_PERF_MSGTYPE,
         [&totalRecvDataSize, &lastSecTotalRecvDataSize, &lastRecvDataCount](
             std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession> _session) {
-            totalRecvDataSize += _msg->payload()->size();
-            lastSecTotalRecvDataSize += _msg->payload()->size();
+            totalRecvDataSize += _msg->payloadRef().size();
+            lastSecTotalRecvDataSize += _msg->payloadRef().size();
             lastRecvDataCount++;
             _session->asyncSendMessage(_msg);
         });
@@ -268,7 +298,8 @@ int main(int argc, char** argv)
 
     if (workModel == "server")
     {
-        workAsServer(host, port, disableSsl, threadCount);
+        std::string transport = argc > 6 ? argv[6] : "ws";
+        workAsServer(host, port, disableSsl, threadCount, transport);
     }
     else if (workModel == "client")
     {
@@ -285,7 +316,8 @@ int main(int argc, char** argv)
             sendRate = std::stoull(std::string(argv[7]));
         }
 
-        workAsClient(host, port, disableSsl, sendRate, msgSize, threadCount);
+        std::string transport = argc > 8 ? argv[8] : "ws";
+        workAsClient(host, port, disableSsl, sendRate, msgSize, threadCount, transport);
     }
     else
     {
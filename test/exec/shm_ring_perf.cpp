@@ -0,0 +1,283 @@
+/*
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file shm_ring_perf.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/Common.h>
+#include <bcos-boostssl/websocket/WsInitializer.h>
+#include <bcos-boostssl/websocket/WsService.h>
+#include <bcos-utilities/BoostLog.h>
+#include <bcos-utilities/BoostLogInitializer.h>
+#include <bcos-utilities/Common.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+using namespace bcos::boostssl::http;
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+void usage()
+{
+    std::cerr << "Usage: \n"
+              << " \t shm-ring-perf server <unix_socket_path> \n "
+              << " \t shm-ring-perf client <unix_socket_path> <unix|shm> <echo_count> "
+                 "<msg_size> <window> \n"
+              << "Example:\n"
+              << " \t ./shm-ring-perf server /tmp/boostssl.sock \n"
+              << " \t ./shm-ring-perf client /tmp/boostssl.sock unix 100000 1024 64 \n"
+              << " \t ./shm-ring-perf client /tmp/boostssl.sock shm 100000 1024 64 \n";
+    std::exit(0);
+}
+
+void initLog(const std::string& _configPath = "./clog.ini")
+{
+    boost::property_tree::ptree pt;
+    try
+    {
+        boost::property_tree::read_ini(_configPath, pt);
+    }
+    catch (const std::exception& e)
+    {
+        try
+        {
+            std::string defaultPath = "conf/clog.ini";
+            boost::property_tree::read_ini(defaultPath, pt);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Not found available log config(./clog.ini or ./conf/clog.ini), use "
+                         "the default configuration items"
+                      << std::endl;
+        }
+    }
+
+    auto logInitializer = new bcos::BoostLogInitializer();
+    logInitializer->initLog(pt, bcos::FileLogger, "cpp_sdk_log");
+}
+
+const static int SHM_RING_PERF_MSGTYPE = 9999;
+
+std::shared_ptr<WsMessage> buildMessage(WsService::Ptr _wsService, uint64_t _msgSize)
+{
+    auto msg = std::dynamic_pointer_cast<WsMessage>(_wsService->messageFactory()->buildMessage());
+    msg->setPacketType(SHM_RING_PERF_MSGTYPE);
+    msg->setPayload(std::make_shared<bytes>(_msgSize, 'a'));
+    msg->setSeq(_wsService->messageFactory()->newSeq());
+    return msg;
+}
+
+// one message in flight at a time, report the round-trip time distribution
+void latencyTest(WsService::Ptr _wsService, uint64_t _echoC, uint64_t _msgSize)
+{
+    std::vector<int64_t> rtts;
+    rtts.reserve(_echoC);
+    uint64_t nFailedC = 0;
+    for (uint64_t i = 0; i < _echoC; ++i)
+    {
+        std::promise<bool> p;
+        auto f = p.get_future();
+        auto msg = buildMessage(_wsService, _msgSize);
+        auto startPoint = std::chrono::high_resolution_clock::now();
+        _wsService->asyncSendMessage(msg, Options(-1),
+            [&p](Error::Ptr _error, std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) {
+                p.set_value(!_error || _error->errorCode() == 0);
+            });
+        if (!f.get())
+        {
+            nFailedC++;
+            continue;
+        }
+        rtts.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - startPoint)
+                           .count());
+    }
+
+    std::sort(rtts.begin(), rtts.end());
+    auto percentile = [&rtts](double _p) -> double {
+        if (rtts.empty())
+        {
+            return 0;
+        }
+        return rtts[std::min<std::size_t>(rtts.size() - 1, rtts.size() * _p)] / 1000.0;
+    };
+
+    std::cerr << " ==> latency(us): " << std::endl;
+    std::cerr << " \t p50: " << percentile(0.5) << std::endl;
+    std::cerr << " \t p99: " << percentile(0.99) << std::endl;
+    std::cerr << " \t p999: " << percentile(0.999) << std::endl;
+    std::cerr << " \t max: " << percentile(1) << std::endl;
+    std::cerr << " \t nFailedC: " << nFailedC << std::endl;
+}
+
+// keep _window messages in flight, report the message rate
+void throughputTest(WsService::Ptr _wsService, uint64_t _echoC, uint64_t _msgSize, uint64_t _window)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t inFlight = 0;
+    uint64_t nDoneC = 0;
+    uint64_t nFailedC = 0;
+
+    auto startPoint = std::chrono::high_resolution_clock::now();
+    for (uint64_t i = 0; i < _echoC; ++i)
+    {
+        {
+            std::unique_lock<std::mutex> l(mutex);
+            cv.wait(l, [&]() { return inFlight < _window; });
+            inFlight++;
+        }
+
+        auto msg = buildMessage(_wsService, _msgSize);
+        _wsService->asyncSendMessage(msg, Options(-1),
+            [&](Error::Ptr _error, std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) {
+                std::lock_guard<std::mutex> l(mutex);
+                inFlight--;
+                nDoneC++;
+                if (_error && _error->errorCode() != 0)
+                {
+                    nFailedC++;
+                }
+                cv.notify_all();
+            });
+    }
+    {
+        std::unique_lock<std::mutex> l(mutex);
+        cv.wait(l, [&]() { return nDoneC == _echoC; });
+    }
+    auto totalTime = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - startPoint)
+                         .count();
+
+    std::cerr << " ==> throughput: " << std::endl;
+    std::cerr << " \t total time(us): " << totalTime << std::endl;
+    std::cerr << " \t msg/s: " << (double)_echoC * 1000000 / totalTime << std::endl;
+    std::cerr << " \t MB/s: " << (double)_echoC * _msgSize / totalTime << std::endl;
+    std::cerr << " \t nFailedC: " << nFailedC << std::endl;
+}
+
+void workAsClient(const std::string& unixSocketPath, const std::string& transport, uint64_t echoC,
+    uint64_t msgSize, uint64_t window)
+{
+    std::cerr << " ==> shm_ring_perf work as client. \n"
+              << " \t unixSocketPath: " << unixSocketPath << "\n"
+              << " \t transport: " << transport << "\n"
+              << " \t echoC: " << echoC << "\n"
+              << " \t msgSize: " << msgSize << "\n"
+              << " \t window: " << window << "\n\n\n";
+
+    auto config = std::make_shared<WsConfig>();
+    config->setModel(WsModel::Client);
+
+    auto peers = std::make_shared<EndPoints>();
+    peers->insert(NodeIPEndpoint(UNIX_SOCKET_PREFIX + unixSocketPath, 0));
+    config->setConnectPeers(peers);
+    if (transport == "shm")
+    {
+        config->setShmRingPeers(peers);
+    }
+
+    config->setThreadPoolSize(4);
+    config->setIOThreadPoolSize(1);
+    config->setDisableSsl(true);
+
+    auto wsService = std::make_shared<ws::WsService>("shm-ring-perf-client");
+    auto wsInitializer = std::make_shared<WsInitializer>();
+
+    wsInitializer->setConfig(config);
+    wsInitializer->initWsService(wsService);
+    wsService->start();
+
+    latencyTest(wsService, echoC, msgSize);
+    throughputTest(wsService, echoC, msgSize, window);
+}
+
+void workAsServer(const std::string& unixSocketPath)
+{
+    std::cerr << " ==> shm_ring_perf work as server." << std::endl
+              << " \t unixSocketPath: " << unixSocketPath << "\n";
+
+    auto config = std::make_shared<WsConfig>();
+    config->setModel(WsModel::Server);
+
+    // the tcp listener is required, the peers come in through the unix domain socket
+    config->setListenIP("127.0.0.1");
+    config->setListenPort(20299);
+    config->setUnixSocketPath(unixSocketPath);
+    config->setAcceptShmRing(true);
+    config->setThreadPoolSize(4);
+    config->setIOThreadPoolSize(1);
+    config->setDisableSsl(true);
+
+    auto wsService = std::make_shared<ws::WsService>("shm-ring-perf-server");
+    auto wsInitializer = std::make_shared<WsInitializer>();
+
+    wsInitializer->setConfig(config);
+    wsInitializer->initWsService(wsService);
+
+    wsService->registerMsgHandler(SHM_RING_PERF_MSGTYPE,
+        [](std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession> _session) {
+            _session->asyncSendMessage(_msg);
+        });
+
+    wsService->start();
+
+    while (true)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10000));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        usage();
+    }
+
+    std::string workModel = argv[1];
+    std::string unixSocketPath = argv[2];
+
+    initLog();
+
+    if (workModel == "server")
+    {
+        workAsServer(unixSocketPath);
+    }
+    else if (workModel == "client")
+    {
+        std::string transport = argc > 3 ? argv[3] : "shm";
+        uint64_t echoCount = argc > 4 ? std::stoull(std::string(argv[4])) : 10000;
+        uint64_t msgSize = argc > 5 ? std::stoull(std::string(argv[5])) : 1024;
+        uint64_t window = argc > 6 ? std::stoull(std::string(argv[6])) : 64;
+        workAsClient(unixSocketPath, transport, echoCount, msgSize, window);
+    }
+    else
+    {
+        usage();
+    }
+}
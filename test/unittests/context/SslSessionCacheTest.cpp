@@ -0,0 +1,203 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the ssl session resumption and the node id of the resumed sessions
+ * @file SslSessionCacheTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/context/NodeInfoTools.h>
+#include <bcos-boostssl/context/SslSessionCache.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <string>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::context;
+
+namespace
+{
+// a self-signed certificate both peers trust, the node id is its public key
+struct TestCert
+{
+    std::shared_ptr<EVP_PKEY> key;
+    std::shared_ptr<X509> cert;
+};
+
+TestCert newTestCert()
+{
+    TestCert testCert;
+    std::shared_ptr<EVP_PKEY_CTX> keyCtx(
+        EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr), EVP_PKEY_CTX_free);
+    EVP_PKEY* key = nullptr;
+    BOOST_REQUIRE(EVP_PKEY_keygen_init(keyCtx.get()) == 1);
+    BOOST_REQUIRE(
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyCtx.get(), NID_X9_62_prime256v1) == 1);
+    BOOST_REQUIRE(EVP_PKEY_keygen(keyCtx.get(), &key) == 1);
+    testCert.key.reset(key, EVP_PKEY_free);
+
+    testCert.cert.reset(X509_new(), X509_free);
+    auto cert = testCert.cert.get();
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+    auto name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(
+        name, "CN", MBSTRING_ASC, (const unsigned char*)"boostssl-test", -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    BOOST_REQUIRE(X509_sign(cert, key, EVP_sha256()) > 0);
+    return testCert;
+}
+
+std::shared_ptr<boost::asio::ssl::context> newContext(
+    bool _server, const TestCert& _testCert, boost::asio::ssl::context::method _method)
+{
+    auto sslContext = std::make_shared<boost::asio::ssl::context>(_method);
+    auto ctx = sslContext->native_handle();
+    SSL_CTX_use_certificate(ctx, _testCert.cert.get());
+    SSL_CTX_use_PrivateKey(ctx, _testCert.key.get());
+    X509_STORE_add_cert(SSL_CTX_get_cert_store(ctx), _testCert.cert.get());
+    sslContext->set_verify_mode(boost::asio::ssl::verify_peer |
+                                boost::asio::ssl::verify_fail_if_no_peer_cert);
+    SslSessionCache::initContext(_server, *sslContext);
+    return sslContext;
+}
+
+struct ConnectResult
+{
+    bool clientReused = false;
+    bool serverReused = false;
+    // the node ids filled by the verify callbacks
+    std::string clientVerifiedNodeId;
+    std::string serverVerifiedNodeId;
+    // the node ids of the resumed sessions
+    std::string clientResumedNodeId;
+    std::string serverResumedNodeId;
+};
+
+// one connection over loopback, a byte goes from the server to the client after the handshake so
+// the client reads the session tickets of tls 1.3
+ConnectResult connectOnce(boost::asio::ssl::context& _serverCtx,
+    boost::asio::ssl::context& _clientCtx, SslSessionCache::Ptr _cache)
+{
+    boost::asio::io_context ioc;
+    boost::asio::ip::tcp::acceptor acceptor(
+        ioc, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    boost::asio::ssl::stream<boost::asio::ip::tcp::socket> client(ioc, _clientCtx);
+    boost::asio::ssl::stream<boost::asio::ip::tcp::socket> server(ioc, _serverCtx);
+    client.next_layer().connect(acceptor.local_endpoint());
+    acceptor.accept(server.next_layer());
+
+    auto clientNodeId = std::make_shared<std::string>();
+    auto serverNodeId = std::make_shared<std::string>();
+    client.set_verify_callback(NodeInfoTools::newVerifyCallback(clientNodeId));
+    server.set_verify_callback(NodeInfoTools::newVerifyCallback(serverNodeId));
+    _cache->offer("127.0.0.1:20200", client.native_handle());
+
+    boost::system::error_code clientEc;
+    boost::system::error_code serverEc;
+    uint8_t in = 0;
+    uint8_t out = 1;
+    client.async_handshake(
+        boost::asio::ssl::stream_base::client, [&](boost::system::error_code _ec) {
+            clientEc = _ec;
+            if (!_ec)
+            {
+                boost::asio::async_read(client, boost::asio::buffer(&in, 1),
+                    [&](boost::system::error_code _ec, std::size_t) { clientEc = _ec; });
+            }
+        });
+    server.async_handshake(
+        boost::asio::ssl::stream_base::server, [&](boost::system::error_code _ec) {
+            serverEc = _ec;
+            if (!_ec)
+            {
+                boost::asio::async_write(server, boost::asio::buffer(&out, 1),
+                    [&](boost::system::error_code _ec, std::size_t) { serverEc = _ec; });
+            }
+        });
+    ioc.run();
+    BOOST_REQUIRE(!clientEc);
+    BOOST_REQUIRE(!serverEc);
+    BOOST_CHECK_EQUAL(in, out);
+
+    ConnectResult result;
+    result.clientReused = SSL_session_reused(client.native_handle());
+    result.serverReused = SSL_session_reused(server.native_handle());
+    result.clientVerifiedNodeId = *clientNodeId;
+    result.serverVerifiedNodeId = *serverNodeId;
+    NodeInfoTools::resumedSessionNodeId(client.native_handle(), result.clientResumedNodeId);
+    NodeInfoTools::resumedSessionNodeId(server.native_handle(), result.serverResumedNodeId);
+    return result;
+}
+
+void checkResumption(boost::asio::ssl::context::method _method)
+{
+    auto testCert = newTestCert();
+    auto serverCtx = newContext(true, testCert, _method);
+    auto clientCtx = newContext(false, testCert, _method);
+    auto cache = std::make_shared<SslSessionCache>();
+
+    // the full handshake verifies the peers and keeps the session
+    auto first = connectOnce(*serverCtx, *clientCtx, cache);
+    BOOST_CHECK(!first.clientReused);
+    BOOST_CHECK(!first.serverReused);
+    BOOST_CHECK(!first.clientVerifiedNodeId.empty());
+    BOOST_CHECK_EQUAL(first.clientVerifiedNodeId, first.serverVerifiedNodeId);
+    BOOST_CHECK(first.clientResumedNodeId.empty());
+    BOOST_CHECK(cache->session("127.0.0.1:20200") != nullptr);
+
+    // the resumed one skips the verify callbacks, the node ids come from the session
+    auto second = connectOnce(*serverCtx, *clientCtx, cache);
+    BOOST_CHECK(second.clientReused);
+    BOOST_CHECK(second.serverReused);
+    BOOST_CHECK(second.clientVerifiedNodeId.empty());
+    BOOST_CHECK(second.serverVerifiedNodeId.empty());
+    BOOST_CHECK_EQUAL(second.clientResumedNodeId, first.clientVerifiedNodeId);
+    BOOST_CHECK_EQUAL(second.serverResumedNodeId, first.serverVerifiedNodeId);
+
+    // without a session for the endpoint it is a full handshake again
+    cache->eraseSession("127.0.0.1:20200");
+    auto third = connectOnce(*serverCtx, *clientCtx, cache);
+    BOOST_CHECK(!third.clientReused);
+    BOOST_CHECK_EQUAL(third.clientVerifiedNodeId, first.clientVerifiedNodeId);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SslSessionCacheTest)
+
+BOOST_AUTO_TEST_CASE(test_resumedNodeIdTls12)
+{
+    checkResumption(boost::asio::ssl::context::tlsv12);
+}
+
+BOOST_AUTO_TEST_CASE(test_resumedNodeIdTls13)
+{
+    checkResumption(boost::asio::ssl::context::tls);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,251 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the batch frames written by WsSession
+ * @file WsBatchTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include "WsSessionPair.h"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+// the messages the server received, the advertisements of type 0 left out, the thread pool
+// may hand them over out of order
+struct ReceivedMessages
+{
+    WsRecvMessageHandler handler()
+    {
+        return [this](std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession>) {
+            if (_msg->packetType() == 0)
+            {
+                return;
+            }
+            std::lock_guard<std::mutex> l(mutex);
+            messages.push_back(_msg);
+        };
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard<std::mutex> l(mutex);
+        return messages.size();
+    }
+
+    // the messages by type
+    std::map<uint16_t, std::shared_ptr<MessageFace>> byType()
+    {
+        std::lock_guard<std::mutex> l(mutex);
+        std::map<uint16_t, std::shared_ptr<MessageFace>> types;
+        for (const auto& message : messages)
+        {
+            types[message->packetType()] = message;
+        }
+        return types;
+    }
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<MessageFace>> messages;
+};
+
+std::vector<WsFrameRecord> framesSince(const WsSession::Ptr& _session, std::size_t _from)
+{
+    auto frames = std::dynamic_pointer_cast<WsFrameTapSession>(_session)->frames();
+    return std::vector<WsFrameRecord>(frames.begin() + _from, frames.end());
+}
+
+std::size_t framesOf(const WsSession::Ptr& _session)
+{
+    return std::dynamic_pointer_cast<WsFrameTapSession>(_session)->frames().size();
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(WsBatchTest)
+
+BOOST_AUTO_TEST_CASE(test_batchLinger)
+{
+    WsSessionPair pair(std::make_shared<WsFrameTapSessionFactory>());
+    pair.client->setBatchMaxBytes(64 * 1024);
+    pair.client->setBatchLingerUs(50 * 1000);
+    pair.server->setBatchMaxBytes(64 * 1024);
+    ReceivedMessages received;
+    pair.server->setRecvMessageHandler(received.handler());
+    pair.start();
+    pair.exchangeAdvertisements();
+
+    // a message alone is written as it is when the linger expires
+    auto from = framesOf(pair.server);
+    auto start = std::chrono::steady_clock::now();
+    pair.client->asyncSendMessage(pair.newMessage(100, 10));
+    BOOST_REQUIRE(WsSessionPair::waitFor([&received]() { return received.size() == 1; }));
+    BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50));
+    auto frames = framesSince(pair.server, from);
+    BOOST_REQUIRE_EQUAL(frames.size(), 1);
+    BOOST_CHECK_EQUAL(frames[0].kind, WsFrameRecord::Message);
+    BOOST_CHECK_EQUAL(frames[0].packetType, 100);
+
+    // the messages sent within the linger go in batch frames
+    from = framesOf(pair.server);
+    for (uint16_t i = 0; i < 10; ++i)
+    {
+        pair.client->asyncSendMessage(pair.newMessage(10 + i, 100));
+    }
+    BOOST_REQUIRE(WsSessionPair::waitFor([&received]() { return received.size() == 11; }));
+    auto types = received.byType();
+    for (uint16_t i = 0; i < 10; ++i)
+    {
+        BOOST_CHECK(types.count(10 + i));
+    }
+    frames = framesSince(pair.server, from);
+    std::size_t messages = 0;
+    for (const auto& frame : frames)
+    {
+        messages += frame.messages;
+    }
+    BOOST_CHECK_EQUAL(messages, 10);
+    BOOST_CHECK(frames.size() < 10);
+    BOOST_CHECK_EQUAL(frames.front().kind, WsFrameRecord::Batch);
+}
+
+BOOST_AUTO_TEST_CASE(test_batchMaxBytes)
+{
+    WsSessionPair pair(std::make_shared<WsFrameTapSessionFactory>());
+    pair.client->setBatchMaxBytes(4096);
+    pair.client->setBatchLingerUs(100 * 1000);
+    pair.server->setBatchMaxBytes(4096);
+    ReceivedMessages received;
+    pair.server->setRecvMessageHandler(received.handler());
+    pair.start();
+    pair.exchangeAdvertisements();
+
+    // a filled batch ends the linger, no batch frame is larger than the cap
+    auto from = framesOf(pair.server);
+    for (uint16_t i = 0; i < 20; ++i)
+    {
+        pair.client->asyncSendMessage(pair.newMessage(10 + i, 1000));
+    }
+    BOOST_REQUIRE(WsSessionPair::waitFor([&received]() { return received.size() == 20; }));
+    auto types = received.byType();
+    for (uint16_t i = 0; i < 20; ++i)
+    {
+        BOOST_REQUIRE(types.count(10 + i));
+        BOOST_CHECK_EQUAL(types[10 + i]->payloadRef().size(), 1000);
+    }
+    auto frames = framesSince(pair.server, from);
+    std::size_t messages = 0;
+    std::size_t batches = 0;
+    for (const auto& frame : frames)
+    {
+        messages += frame.messages;
+        if (frame.kind == WsFrameRecord::Batch)
+        {
+            ++batches;
+            BOOST_CHECK_LE(frame.size, 4096);
+            BOOST_CHECK(frame.messages > 1 && frame.messages < 4);
+        }
+    }
+    BOOST_CHECK_EQUAL(messages, 20);
+    BOOST_CHECK(batches > 0);
+}
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(test_batchExcludesFiles)
+{
+    char path[] = "/tmp/boostssl-batch-XXXXXX";
+    auto fd = ::mkstemp(path);
+    BOOST_REQUIRE(fd >= 0);
+    ::unlink(path);
+    std::string content(10000, 'f');
+    BOOST_REQUIRE_EQUAL(::write(fd, content.data(), content.size()), (ssize_t)content.size());
+
+    WsSessionPair pair(std::make_shared<WsFrameTapSessionFactory>());
+    pair.client->setBatchMaxBytes(64 * 1024);
+    pair.client->setBatchLingerUs(50 * 1000);
+    pair.server->setBatchMaxBytes(64 * 1024);
+    ReceivedMessages received;
+    pair.server->setRecvMessageHandler(received.handler());
+    pair.start();
+    pair.exchangeAdvertisements();
+
+    // the file goes in a frame of its own between the batches of the small messages
+    auto from = framesOf(pair.server);
+    for (uint16_t i = 0; i < 3; ++i)
+    {
+        pair.client->asyncSendMessage(pair.newMessage(10 + i, 100));
+    }
+    pair.client->asyncSendFile(pair.newMessage(50, 0), fd, 0, content.size());
+    for (uint16_t i = 3; i < 6; ++i)
+    {
+        pair.client->asyncSendMessage(pair.newMessage(10 + i, 100));
+    }
+    ::close(fd);
+    BOOST_REQUIRE(WsSessionPair::waitFor([&received]() { return received.size() == 7; }));
+    auto types = received.byType();
+    BOOST_REQUIRE(types.count(50));
+    auto payload = types[50]->payloadRef();
+    BOOST_CHECK(std::string((const char*)payload.data(), payload.size()) == content);
+
+    auto frames = framesSince(pair.server, from);
+    std::size_t messages = 0;
+    std::size_t files = 0;
+    for (const auto& frame : frames)
+    {
+        messages += frame.messages;
+        if (frame.kind == WsFrameRecord::Message && frame.packetType == 50)
+        {
+            ++files;
+            BOOST_CHECK(frame.size > content.size());
+        }
+        if (frame.kind == WsFrameRecord::Batch)
+        {
+            BOOST_CHECK(frame.size < content.size());
+        }
+    }
+    BOOST_CHECK_EQUAL(messages, 7);
+    BOOST_CHECK_EQUAL(files, 1);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(test_batchAdvertisementIgnored)
+{
+    // the server does not batch, the 0x80 of the client is the user's flag and stays in the ext
+    WsSessionPair pair;
+    ReceivedMessages received;
+    pair.server->setRecvMessageHandler(received.handler());
+    pair.start();
+
+    auto message = pair.newMessage(100, 10);
+    message->setExt(MessageExtFieldFlag::BatchSupported);
+    pair.client->asyncSendMessage(message);
+    BOOST_REQUIRE(WsSessionPair::waitFor([&received]() { return received.size() == 1; }));
+    BOOST_CHECK_EQUAL(received.byType()[100]->ext(), MessageExtFieldFlag::BatchSupported);
+    BOOST_CHECK(!pair.server->peerBatch());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,92 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the busy poll of the io threads
+ * @file WsBusyPollTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/WsTools.h>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+// run the io_context on a thread busy polling with the budget for _idle, return the cpu seconds
+// the thread used
+double runBusyPoll(uint32_t _spinUs, uint32_t _cpuPercent, std::chrono::milliseconds _idle,
+    std::atomic<int>& _handled)
+{
+    auto ioc = std::make_shared<boost::asio::io_context>();
+    auto work = boost::asio::make_work_guard(*ioc);
+    double cpu = 0;
+    std::thread ioThread([ioc, &cpu]() {
+        ioc->run();
+        struct timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        cpu = ts.tv_sec + ts.tv_nsec / 1e9;
+    });
+    WsTools::busyPoll(ioc, _spinUs, _cpuPercent);
+
+    // the handlers posted while the thread spins or backs off still run
+    for (int i = 0; i < 10; ++i)
+    {
+        std::this_thread::sleep_for(_idle / 10);
+        boost::asio::post(*ioc, [&_handled]() { ++_handled; });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ioc->stop();
+    ioThread.join();
+    return cpu;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(WsBusyPollTest)
+
+BOOST_AUTO_TEST_CASE(test_busyPollBudget)
+{
+    // an idle thread spins for 200us, then blocks for 1800us to stay at 10% of the cpu
+    std::atomic<int> handled{0};
+    auto idle = std::chrono::milliseconds(500);
+    auto cpu = runBusyPoll(200, 10, idle, handled);
+    BOOST_CHECK_EQUAL(handled.load(), 10);
+    // well below the 100% of a spinning thread, with room for the scheduler and the handlers
+    BOOST_CHECK_LT(cpu, 0.35 * idle.count() / 1000);
+    BOOST_TEST_MESSAGE("busy poll at 10%: " << cpu << "s of cpu in " << idle.count() << "ms");
+}
+
+BOOST_AUTO_TEST_CASE(test_busyPollBudgetClamped)
+{
+    // 0% is raised to 1%, the thread still spins now and then and runs the handlers
+    std::atomic<int> handled{0};
+    auto idle = std::chrono::milliseconds(300);
+    auto cpu = runBusyPoll(50, 0, idle, handled);
+    BOOST_CHECK_EQUAL(handled.load(), 10);
+    BOOST_CHECK_LT(cpu, 0.35 * idle.count() / 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,173 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the payload compression
+ * @file WsCompressorTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include "WsSessionPair.h"
+#include <bcos-boostssl/websocket/WsCompressor.h>
+#include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-boostssl/websocket/WsMetrics.h>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+BOOST_AUTO_TEST_SUITE(WsCompressorTest)
+
+BOOST_AUTO_TEST_CASE(test_WsCompressor)
+{
+    WsCompressor compressor(1024, 1);
+    std::string text;
+    for (int i = 0; text.size() < 10000; ++i)
+    {
+        text += "transaction " + std::to_string(i % 100) + " of the block;";
+    }
+    bytes payload(text.begin(), text.end());
+
+    bytes compressed;
+    BOOST_CHECK(!compressor.compress(bytesConstRef(payload.data(), 1023), compressed));
+    BOOST_CHECK(compressor.compress(bytesConstRef(payload.data(), payload.size()), compressed));
+    BOOST_CHECK(compressed.size() * 3 < payload.size());
+
+    bytes decompressed;
+    auto compressedRef = bytesConstRef(compressed.data(), compressed.size());
+    BOOST_CHECK(compressor.decompress(compressedRef, decompressed, payload.size()));
+    BOOST_CHECK(decompressed == payload);
+    // larger than accepted, truncated, corrupted
+    BOOST_CHECK(!compressor.decompress(compressedRef, decompressed, payload.size() - 1));
+    BOOST_CHECK(!compressor.decompress(
+        bytesConstRef(compressed.data(), compressed.size() / 2), decompressed, payload.size()));
+    compressed[WsCompressor::SIZE_PREFIX_LENGTH] ^= 0xff;
+    BOOST_CHECK(!compressor.decompress(compressedRef, decompressed, payload.size()));
+
+    // random bytes do not get smaller
+    bytes noise(4096);
+    uint32_t seed = 1;
+    for (auto& b : noise)
+    {
+        seed = seed * 1103515245 + 12345;
+        b = (byte)(seed >> 16);
+    }
+    BOOST_CHECK(!compressor.compress(bytesConstRef(noise.data(), noise.size()), compressed));
+
+    auto snapshot = compressor.metrics();
+    BOOST_CHECK_EQUAL(snapshot.compressed, 1);
+    BOOST_CHECK_EQUAL(snapshot.incompressible, 1);
+    BOOST_CHECK_EQUAL(snapshot.rawBytes, payload.size());
+    BOOST_CHECK(snapshot.compressedBytes * 3 < snapshot.rawBytes);
+    BOOST_CHECK_EQUAL(snapshot.decompressed, 1);
+    BOOST_CHECK_EQUAL(snapshot.decompressErrors, 3);
+    BOOST_CHECK_EQUAL(snapshot.compressTime.count, 2);
+
+    // the flags and the compressed payload only go to the buffer
+    auto msg = std::make_shared<WsMessage>(std::make_shared<bytes>(payload));
+    msg->setSeq("0123456789");
+    BOOST_CHECK(compressor.compress(msg->payloadRef(), compressed));
+    bytes frame;
+    BOOST_CHECK(msg->encode(frame, bytesConstRef(compressed.data(), compressed.size()),
+        MessageExtFieldFlag::Compressed | MessageExtFieldFlag::CompressSupported));
+    BOOST_CHECK_EQUAL(msg->ext(), 0);
+    auto decodeMsg = std::make_shared<WsMessage>();
+    BOOST_CHECK(decodeMsg->decode(bytesConstRef(frame.data(), frame.size())) > 0);
+    BOOST_CHECK(decodeMsg->ext() & MessageExtFieldFlag::Compressed);
+    BOOST_CHECK(compressor.decompress(decodeMsg->payloadRef(), decompressed, payload.size()));
+    BOOST_CHECK(decompressed == payload);
+
+    WsServiceSnapshot serviceSnapshot;
+    serviceSnapshot.compression = compressor.metrics();
+    auto metrics = renderPrometheus(serviceSnapshot, "test");
+    BOOST_CHECK(metrics.find("boostssl_compressed_messages_total{module=\"test\"} 2\n") !=
+                std::string::npos);
+    BOOST_CHECK(metrics.find("boostssl_compress_duration_microseconds_count{module=\"test\"} "
+                             "3\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_compressedFlagWithoutCompression)
+{
+    // the flags are the user's unless the compression is on here and the peer advertised it
+    for (auto serverCompression : {false, true})
+    {
+        std::mutex mutex;
+        std::shared_ptr<MessageFace> received;
+        WsSessionPair pair;
+        if (serverCompression)
+        {
+            pair.server->setCompressor(std::make_shared<WsCompressor>(0, 1));
+        }
+        pair.server->setRecvMessageHandler(
+            [&mutex, &received](std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession>) {
+                std::lock_guard<std::mutex> l(mutex);
+                received = _msg;
+            });
+        pair.start();
+
+        // the client compresses nothing and advertises nothing, with the compression on the
+        // server would take the 0x20 as the advertisement
+        auto message = pair.newMessage(100, 1000);
+        message->setExt(serverCompression ?
+                            MessageExtFieldFlag::Compressed :
+                            MessageExtFieldFlag::Compressed | MessageExtFieldFlag::CompressSupported);
+        pair.client->asyncSendMessage(message);
+        BOOST_REQUIRE(WsSessionPair::waitFor([&mutex, &received]() {
+            std::lock_guard<std::mutex> l(mutex);
+            return received != nullptr;
+        }));
+        std::lock_guard<std::mutex> l(mutex);
+        BOOST_CHECK_EQUAL(received->ext(), message->ext());
+        auto payload = received->payloadRef();
+        BOOST_CHECK(bytes(payload.data(), payload.data() + payload.size()) == *message->payload());
+        BOOST_CHECK(!pair.server->peerCompress());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_mixedAdvertisements)
+{
+    // only the compression is on in the server, the peer's other advertisements stay in the ext
+    std::mutex mutex;
+    std::shared_ptr<MessageFace> received;
+    WsSessionPair pair;
+    pair.server->setCompressor(std::make_shared<WsCompressor>(0, 1));
+    pair.server->setRecvMessageHandler(
+        [&mutex, &received](std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession>) {
+            std::lock_guard<std::mutex> l(mutex);
+            received = _msg;
+        });
+    pair.start();
+
+    auto message = pair.newMessage(100, 10);
+    message->setExt(MessageExtFieldFlag::CompressSupported | MessageExtFieldFlag::BatchSupported |
+                    MessageExtFieldFlag::FragmentSupported);
+    pair.client->asyncSendMessage(message);
+    BOOST_REQUIRE(WsSessionPair::waitFor([&mutex, &received]() {
+        std::lock_guard<std::mutex> l(mutex);
+        return received != nullptr;
+    }));
+    std::lock_guard<std::mutex> l(mutex);
+    BOOST_CHECK_EQUAL(received->ext(),
+        MessageExtFieldFlag::BatchSupported | MessageExtFieldFlag::FragmentSupported);
+    BOOST_CHECK(pair.server->peerCompress());
+    BOOST_CHECK(!pair.server->peerBatch());
+    BOOST_CHECK(!pair.server->peerFragment());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
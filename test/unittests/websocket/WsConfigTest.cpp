@@ -46,6 +46,23 @@ BOOST_AUTO_TEST_CASE(test_WsConfigTest)
         auto peers = std::make_shared<EndPoints>();
         config->setConnectPeers(peers);
         BOOST_CHECK_EQUAL(config->connectPeers()->size(), 0);
+
+        BOOST_CHECK_EQUAL(config->reusePort(), false);
+        BOOST_CHECK_EQUAL(config->ioBackend(), IOBackend::Epoll);
+        BOOST_CHECK(config->ioThreadPoolSize() > 0);
+        BOOST_CHECK(config->ioThreadCpus().empty());
+        BOOST_CHECK(config->threadPoolCpus().empty());
+        BOOST_CHECK_EQUAL(config->busyPollThreads(), 0);
+        BOOST_CHECK(config->metricsPath().empty());
+        BOOST_CHECK_EQUAL(config->metricsPeriod(), 1000);
+        BOOST_CHECK_EQUAL(config->slowSendThreshold(), 5000);
+        BOOST_CHECK_EQUAL(config->compressThreshold(), 0);
+        BOOST_CHECK_EQUAL(config->compressLevel(), 1);
+        BOOST_CHECK_EQUAL(config->batchMaxBytes(), 0);
+        BOOST_CHECK_EQUAL(config->batchLingerUs(), 0);
+        BOOST_CHECK_EQUAL(config->streamWindow(), 0);
+        BOOST_CHECK_EQUAL(config->streamChunkSize(), 256 * 1024);
+        BOOST_CHECK_EQUAL(config->fragmentSize(), 0);
     }
 
     {
@@ -69,6 +86,61 @@ BOOST_AUTO_TEST_CASE(test_WsConfigTest)
         auto peers = std::make_shared<EndPoints>();
         config->setConnectPeers(peers);
         BOOST_CHECK_EQUAL(config->connectPeers()->size(), 0);
+
+        config->setIOThreadPoolSize(8);
+        config->setReusePort(true);
+        BOOST_CHECK_EQUAL(config->ioThreadPoolSize(), 8);
+        BOOST_CHECK_EQUAL(config->reusePort(), true);
+        config->setIOBackend(IOBackend::IoUring);
+        BOOST_CHECK_EQUAL(config->ioBackend(), IOBackend::IoUring);
+
+        config->setIOThreadCpus({0, 1});
+        config->setThreadPoolCpus({2, 3, 4});
+        BOOST_CHECK_EQUAL(config->ioThreadCpus().size(), 2);
+        BOOST_CHECK_EQUAL(config->threadPoolCpus().size(), 3);
+
+        config->setBusyPollThreads(2);
+        config->setBusyPollUs(100);
+        config->setBusyPollCpuPercent(30);
+        BOOST_CHECK_EQUAL(config->busyPollThreads(), 2);
+        BOOST_CHECK_EQUAL(config->busyPollUs(), 100);
+        BOOST_CHECK_EQUAL(config->busyPollCpuPercent(), 30);
+        // the budget is a share of one cpu
+        config->setBusyPollCpuPercent(0);
+        BOOST_CHECK_EQUAL(config->busyPollCpuPercent(), 1);
+        config->setBusyPollCpuPercent(200);
+        BOOST_CHECK_EQUAL(config->busyPollCpuPercent(), 100);
+
+        auto tcpFramePeers = std::make_shared<EndPoints>();
+        tcpFramePeers->insert(NodeIPEndpoint("127.0.0.1", 12345));
+        config->setTcpFramePeers(tcpFramePeers);
+        config->setAcceptTcpFrame(true);
+        BOOST_CHECK_EQUAL(config->isTcpFramePeer(NodeIPEndpoint("127.0.0.1", 12345)), true);
+        BOOST_CHECK_EQUAL(config->isTcpFramePeer(NodeIPEndpoint("127.0.0.1", 12346)), false);
+        BOOST_CHECK_EQUAL(config->acceptTcpFrame(), true);
+
+        config->setUnixSocketPath("/tmp/boostssl.sock");
+        BOOST_CHECK_EQUAL(config->unixSocketPath(), "/tmp/boostssl.sock");
+
+        NodeIPEndpoint unixPeer;
+        BOOST_CHECK_EQUAL(WsTools::stringToEndPoint("unix:/tmp/boostssl.sock", unixPeer), true);
+        auto shmRingPeers = std::make_shared<EndPoints>();
+        shmRingPeers->insert(unixPeer);
+        shmRingPeers->insert(NodeIPEndpoint("127.0.0.1", 12345));
+        config->setShmRingPeers(shmRingPeers);
+        config->setAcceptShmRing(true);
+        config->setShmRingSize(1024 * 1024);
+        BOOST_CHECK_EQUAL(config->isShmRingPeer(unixPeer), true);
+        // the rings are negotiated on the unix domain socket only
+        BOOST_CHECK_EQUAL(config->isShmRingPeer(NodeIPEndpoint("127.0.0.1", 12345)), false);
+        BOOST_CHECK_EQUAL(config->acceptShmRing(), true);
+        BOOST_CHECK_EQUAL(config->shmRingSize(), 1024 * 1024);
+
+        config->setMetricsPath("/metrics");
+        BOOST_CHECK_EQUAL(config->metricsPath(), "/metrics");
+
+        config->setSlowSendThreshold(100);
+        BOOST_CHECK_EQUAL(config->slowSendThreshold(), 100);
     }
 }
 
@@ -84,6 +156,14 @@ BOOST_AUTO_TEST_CASE(test_WsToolsTest)
     BOOST_CHECK_EQUAL(WsTools::validPort(1111), true);
     BOOST_CHECK_EQUAL(WsTools::validPort(10), true);
     BOOST_CHECK_EQUAL(WsTools::validPort(65535), true);
+
+    NodeIPEndpoint endpoint;
+    BOOST_CHECK_EQUAL(WsTools::stringToEndPoint("unix:/tmp/boostssl.sock", endpoint), true);
+    BOOST_CHECK_EQUAL(endpoint.isUnixSocket(), true);
+    BOOST_CHECK_EQUAL(endpoint.unixSocketPath(), "/tmp/boostssl.sock");
+    BOOST_CHECK_EQUAL(WsTools::stringToEndPoint("unix:", endpoint), false);
+    BOOST_CHECK_EQUAL(WsTools::stringToEndPoint("127.0.0.1:12345", endpoint), true);
+    BOOST_CHECK_EQUAL(endpoint.isUnixSocket(), false);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,163 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the fragment frames written by WsSession
+ * @file WsFragmentTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include "WsSessionPair.h"
+#include <bcos-boostssl/websocket/WsError.h>
+#include <boost/asio/post.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+// the messages the server received by type, the advertisements of type 0 left out
+struct ReceivedMessages
+{
+    WsRecvMessageHandler handler()
+    {
+        return [this](std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession>) {
+            if (_msg->packetType() == 0)
+            {
+                return;
+            }
+            std::lock_guard<std::mutex> l(mutex);
+            messages[_msg->packetType()] = _msg;
+        };
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard<std::mutex> l(mutex);
+        return messages.size();
+    }
+
+    std::mutex mutex;
+    std::map<uint16_t, std::shared_ptr<MessageFace>> messages;
+};
+
+// the payloads of WsSessionPair::newMessage are filled with the type
+bool filledWith(const std::shared_ptr<MessageFace>& _msg, uint16_t _type, std::size_t _size)
+{
+    auto payload = _msg->payloadRef();
+    return payload.size() == _size &&
+           std::all_of(payload.data(), payload.data() + payload.size(),
+               [_type](bcos::byte b) { return b == (bcos::byte)_type; });
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(WsFragmentTest)
+
+BOOST_AUTO_TEST_CASE(test_fragmentInterleave)
+{
+    WsSessionPair pair(std::make_shared<WsFrameTapSessionFactory>());
+    pair.client->setFragmentSize(4096);
+    pair.server->setFragmentSize(4096);
+    ReceivedMessages received;
+    pair.server->setRecvMessageHandler(received.handler());
+    pair.start();
+    pair.exchangeAdvertisements();
+
+    // the small message sent after the large one is written between its fragments, both are
+    // sent on the io thread so the first fragment is not written before the small one is queued
+    auto tap = std::dynamic_pointer_cast<WsFrameTapSession>(pair.server);
+    auto from = tap->frames().size();
+    auto large = pair.newMessage(200, 256 * 1024);
+    auto small = pair.newMessage(201, 10);
+    boost::asio::post(*pair.ioc(), [&pair, large, small]() {
+        pair.client->asyncSendMessage(large);
+        pair.client->asyncSendMessage(small);
+    });
+    BOOST_REQUIRE(WsSessionPair::waitFor([&received]() { return received.size() == 2; }));
+    BOOST_CHECK(filledWith(received.messages[200], 200, 256 * 1024));
+    BOOST_CHECK(filledWith(received.messages[201], 201, 10));
+
+    auto frames = tap->frames();
+    std::size_t fragments = 0;
+    std::size_t smallFrame = 0;
+    std::size_t last = 0;
+    for (auto i = from; i < frames.size(); ++i)
+    {
+        if (frames[i].kind == WsFrameRecord::Fragment)
+        {
+            ++fragments;
+            BOOST_CHECK_LE(frames[i].size, 4096 + WsMessage::MESSAGE_MIN_LENGTH + 1);
+            last = frames[i].last ? i : last;
+        }
+        else if (frames[i].packetType == 201)
+        {
+            smallFrame = i;
+        }
+    }
+    BOOST_CHECK(fragments >= 256 * 1024 / 4096);
+    BOOST_CHECK(smallFrame > from && smallFrame < last);
+}
+
+BOOST_AUTO_TEST_CASE(test_fragmentMaxSize)
+{
+    constexpr std::size_t maxSize = 64 * 1024;
+    WsSessionPair pair;
+    pair.client->setFragmentSize(4096);
+    pair.server->setFragmentSize(4096);
+    pair.server->setMaxWriteMsgSize(maxSize);
+    ReceivedMessages received;
+    pair.server->setRecvMessageHandler(received.handler());
+    pair.start();
+    pair.exchangeAdvertisements();
+
+    // reassembled up to the largest message the receiver takes
+    pair.client->asyncSendMessage(pair.newMessage(300, maxSize));
+    BOOST_REQUIRE(WsSessionPair::waitFor([&received]() { return received.size() == 1; }));
+    BOOST_CHECK(filledWith(received.messages[300], 300, maxSize));
+
+    // the fragments beyond it drop the session before the message is complete
+    pair.client->asyncSendMessage(pair.newMessage(301, maxSize + 128 * 1024));
+    BOOST_REQUIRE(WsSessionPair::waitFor([&pair]() { return !pair.server->isConnected(); }));
+    BOOST_CHECK_EQUAL(pair.server->dropReason(), WsError::PacketError);
+    BOOST_CHECK_EQUAL(received.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_fragmentAdvertisementIgnored)
+{
+    // the server does not reassemble, the 0x800 of the client is the user's flag and stays in
+    // the ext
+    WsSessionPair pair;
+    ReceivedMessages received;
+    pair.server->setRecvMessageHandler(received.handler());
+    pair.start();
+
+    auto message = pair.newMessage(100, 10);
+    message->setExt(MessageExtFieldFlag::FragmentSupported);
+    pair.client->asyncSendMessage(message);
+    BOOST_REQUIRE(WsSessionPair::waitFor([&received]() { return received.size() == 1; }));
+    std::lock_guard<std::mutex> l(received.mutex);
+    BOOST_CHECK_EQUAL(received.messages[100]->ext(), MessageExtFieldFlag::FragmentSupported);
+    BOOST_CHECK(filledWith(received.messages[100], 100, 10));
+    BOOST_CHECK(!pair.server->peerFragment());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -19,13 +19,73 @@
  * @date 2021-07-12
  */
 
+#include <bcos-boostssl/websocket/WsChunkStream.h>
 #include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-boostssl/websocket/WsMessagePool.h>
 #include <boost/test/unit_test.hpp>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
 
 using namespace bcos;
 using namespace bcos::boostssl;
 using namespace bcos::boostssl::ws;
 
+namespace
+{
+// the allocations of the thread while the counting is on
+thread_local bool t_countAllocations = false;
+thread_local uint64_t t_allocations = 0;
+
+// one request received and its response encoded, the messages released at the end
+void roundTrip(MessageFaceFactory& _factory, const bytes& _frame)
+{
+    auto request = _factory.buildMessage();
+    request->decode(bytesConstRef(_frame.data(), _frame.size()));
+    auto response = _factory.buildMessage();
+    response->setPacketType(request->packetType());
+    response->setPayload(request->payload());
+    auto buffer = _factory.buildBuffer();
+    response->encode(*buffer);
+}
+
+uint64_t countAllocations(MessageFaceFactory& _factory, const bytes& _frame, int _rounds)
+{
+    t_allocations = 0;
+    t_countAllocations = true;
+    for (int i = 0; i < _rounds; ++i)
+    {
+        roundTrip(_factory, _frame);
+    }
+    t_countAllocations = false;
+    return t_allocations;
+}
+}  // namespace
+
+void* operator new(std::size_t _size)
+{
+    if (t_countAllocations)
+    {
+        ++t_allocations;
+    }
+    if (auto p = std::malloc(_size > 0 ? _size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* _p) noexcept
+{
+    std::free(_p);
+}
+
+void operator delete(void* _p, std::size_t) noexcept
+{
+    std::free(_p);
+}
+
 BOOST_AUTO_TEST_SUITE(WsMessageTest)
 
 BOOST_AUTO_TEST_CASE(test_WsMessage)
@@ -123,4 +183,288 @@ BOOST_AUTO_TEST_CASE(test_buildMessage)
     auto invalidMsgBytes = bcos::bytes(invalidMessage.begin(), invalidMessage.end());
     BOOST_CHECK_THROW(wsMessage->decode(ref(invalidMsgBytes)), std::out_of_range);
 }
+
+BOOST_AUTO_TEST_CASE(test_inlinePayload)
+{
+    WsMessageFactory factory;
+    for (auto size : {(size_t)0, (size_t)10, WsMessage::INLINE_PAYLOAD_SIZE,
+             WsMessage::INLINE_PAYLOAD_SIZE + 1, (size_t)1000})
+    {
+        std::string data(size, 'a');
+        auto msg = factory.buildMessage(111, std::make_shared<bytes>(data.begin(), data.end()));
+        msg->setSeq(factory.newSeq());
+        bytes frame;
+        BOOST_CHECK(msg->encode(frame));
+
+        auto decodeMsg = std::make_shared<WsMessage>();
+        t_allocations = 0;
+        t_countAllocations = true;
+        BOOST_CHECK(decodeMsg->decode(bytesConstRef(frame.data(), frame.size())) > 0);
+        t_countAllocations = false;
+        auto inlined = size <= WsMessage::INLINE_PAYLOAD_SIZE;
+        BOOST_CHECK_EQUAL(decodeMsg->inlinePayload(), inlined);
+        // the seq is the only allocation when the payload is inline, otherwise the payload
+        // buffer is allocated by decode
+        BOOST_CHECK_EQUAL(t_allocations, inlined ? 1 : 3);
+
+        auto payloadRef = decodeMsg->payloadRef();
+        BOOST_CHECK_EQUAL(std::string(payloadRef.data(), payloadRef.data() + payloadRef.size()),
+            data);
+        // the inline message encodes the same frame
+        bytes reencoded;
+        BOOST_CHECK(decodeMsg->encode(reencoded));
+        BOOST_CHECK(reencoded == frame);
+
+        // the payload is moved out of the message on demand
+        auto payload = decodeMsg->payload();
+        BOOST_CHECK(!decodeMsg->inlinePayload());
+        BOOST_CHECK_EQUAL(std::string(payload->begin(), payload->end()), data);
+        BOOST_CHECK(decodeMsg->payload() == payload);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_lazyPayload)
+{
+    // no payload buffer until it is asked for
+    t_allocations = 0;
+    t_countAllocations = true;
+    auto msg = std::make_unique<WsMessage>();
+    t_countAllocations = false;
+    BOOST_CHECK_EQUAL(t_allocations, 1);
+    BOOST_CHECK_EQUAL(msg->payloadRef().size(), 0);
+    auto payload = msg->payload();
+    BOOST_REQUIRE(payload);
+    BOOST_CHECK(payload->empty());
+    BOOST_CHECK(msg->payload() == payload);
+
+    // a null payload reads as empty
+    msg->setPayload(nullptr);
+    BOOST_CHECK_EQUAL(msg->payloadRef().size(), 0);
+    BOOST_CHECK(msg->payload() && msg->payload()->empty());
+
+    WsMessageFactory factory;
+    for (auto size : {(size_t)10, (size_t)1000})
+    {
+        std::string data(size, 'a');
+        auto encodeMsg =
+            factory.buildMessage(111, std::make_shared<bytes>(data.begin(), data.end()));
+        bytes frame;
+        BOOST_CHECK(encodeMsg->encode(frame));
+
+        // decode after reset() released the payload
+        msg->reset();
+        BOOST_CHECK(msg->decode(bytesConstRef(frame.data(), frame.size())) > 0);
+        auto payloadRef = msg->payloadRef();
+        BOOST_CHECK_EQUAL(std::string(payloadRef.data(), payloadRef.data() + payloadRef.size()),
+            data);
+
+        // the handlers sharing the message get the same payload
+        std::vector<std::shared_ptr<bytes>> payloads(4);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < payloads.size(); ++i)
+        {
+            threads.emplace_back([&msg, &payloads, i]() { payloads[i] = msg->payload(); });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (auto& p : payloads)
+        {
+            BOOST_CHECK(p == payloads[0]);
+            BOOST_CHECK_EQUAL(std::string(p->begin(), p->end()), data);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_WsPooledMessageFactory)
+{
+    WsPooledMessageFactory factory;
+    std::string data(1000, 'a');
+    auto msg = factory.buildMessage(111, std::make_shared<bytes>(data.begin(), data.end()));
+    msg->setSeq(factory.newSeq());
+    bytes frame;
+    BOOST_CHECK(msg->encode(frame));
+
+    // the recycled message and payload are reset
+    auto decodeMsg = factory.buildMessage();
+    BOOST_CHECK(decodeMsg->decode(bytesConstRef(frame.data(), frame.size())) > 0);
+    BOOST_CHECK_EQUAL(decodeMsg->seq(), msg->seq());
+    BOOST_CHECK_EQUAL(decodeMsg->payload()->size(), data.size());
+    auto payload = decodeMsg->payload();
+    decodeMsg.reset();
+    decodeMsg = factory.buildMessage();
+    BOOST_CHECK_EQUAL(decodeMsg->packetType(), 0);
+    BOOST_CHECK(decodeMsg->seq().empty());
+    BOOST_CHECK(decodeMsg->payload()->empty());
+    // the payload outlives its message
+    BOOST_CHECK_EQUAL(payload->size(), data.size());
+    BOOST_CHECK(payload != decodeMsg->payload());
+
+    // the buffers grown past the limit are freed rather than recycled
+    auto buffer = factory.buildBuffer();
+    buffer->resize(WsMessagePool::MAX_POOLED_BUFFER + 1);
+    buffer.reset();
+    BOOST_CHECK(factory.buildBuffer()->capacity() <= WsMessagePool::MAX_POOLED_BUFFER);
+
+    int rounds = 1000;
+    WsMessageFactory plainFactory;
+    countAllocations(factory, frame, rounds);
+    auto plain = countAllocations(plainFactory, frame, rounds);
+    auto pooled = countAllocations(factory, frame, rounds);
+    BOOST_TEST_MESSAGE("allocations per round trip, plain: " << (double)plain / rounds
+                                                             << " pooled: "
+                                                             << (double)pooled / rounds);
+    BOOST_CHECK(plain >= (uint64_t)rounds * 4);
+    BOOST_CHECK_EQUAL(pooled, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_batchFrame)
+{
+    WsMessageFactory factory;
+    bytes batch;
+    WsMessage::beginBatch(batch);
+    std::vector<std::shared_ptr<WsMessage>> msgs;
+    for (auto size : {0, 10, 1000})
+    {
+        std::string data(size, 'a' + msgs.size());
+        auto msg = factory.buildMessage(111, std::make_shared<bytes>(data.begin(), data.end()));
+        msg->setSeq(factory.newSeq());
+        bytes frame;
+        BOOST_CHECK(msg->encode(frame));
+        // a plain frame is not a batch frame
+        bytesConstRef payload;
+        BOOST_CHECK(!WsMessage::batchPayload(bytesConstRef(frame.data(), frame.size()), payload));
+        WsMessage::appendToBatch(batch, bytesConstRef(frame.data(), frame.size()));
+        msgs.push_back(msg);
+    }
+
+    // the batch frame decodes as a message without seq
+    auto batchMsg = std::make_shared<WsMessage>();
+    BOOST_CHECK(batchMsg->decode(bytesConstRef(batch.data(), batch.size())) > 0);
+    BOOST_CHECK(batchMsg->seq().empty());
+    BOOST_CHECK_EQUAL(batchMsg->ext(), MessageExtFieldFlag::Batch);
+
+    bytesConstRef payload;
+    BOOST_CHECK(WsMessage::batchPayload(bytesConstRef(batch.data(), batch.size()), payload));
+    BOOST_CHECK_EQUAL(payload.size(), batch.size() - WsMessage::MESSAGE_MIN_LENGTH);
+    std::size_t offset = 0;
+    for (const auto& msg : msgs)
+    {
+        auto p = payload.data() + offset;
+        uint32_t length = ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+        offset += WsMessage::BATCH_LENGTH_PREFIX;
+        auto decodeMsg = std::make_shared<WsMessage>();
+        BOOST_CHECK_EQUAL(
+            decodeMsg->decode(bytesConstRef(payload.data() + offset, length)), length);
+        offset += length;
+        BOOST_CHECK_EQUAL(decodeMsg->seq(), msg->seq());
+        BOOST_CHECK(*decodeMsg->payload() == *msg->payload());
+    }
+    BOOST_CHECK_EQUAL(offset, payload.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_fragmentFrame)
+{
+    WsMessageFactory factory;
+    std::string data(10000, 'a');
+    auto msg = factory.buildMessage(111, std::make_shared<bytes>(data.begin(), data.end()));
+    msg->setSeq(factory.newSeq());
+    bytes frame;
+    BOOST_CHECK(msg->encode(frame));
+    bytesConstRef slice;
+    bool last = false;
+    BOOST_CHECK(
+        !WsMessage::fragmentPayload(bytesConstRef(frame.data(), frame.size()), slice, last));
+
+    // the slices of the frame reassemble into the frame
+    std::size_t fragmentSize = 3000;
+    bytes reassembled;
+    std::size_t fragments = 0;
+    for (std::size_t offset = 0; offset < frame.size(); offset += fragmentSize)
+    {
+        auto size = std::min(fragmentSize, frame.size() - offset);
+        bytes fragment;
+        WsMessage::encodeFragment(
+            fragment, bytesConstRef(frame.data() + offset, size), offset + size == frame.size());
+        BOOST_CHECK_EQUAL(fragment.size(), WsMessage::MESSAGE_MIN_LENGTH + 1 + size);
+        BOOST_CHECK(WsMessage::fragmentPayload(
+            bytesConstRef(fragment.data(), fragment.size()), slice, last));
+        BOOST_CHECK_EQUAL(last, offset + size == frame.size());
+        reassembled.insert(reassembled.end(), slice.data(), slice.data() + slice.size());
+        ++fragments;
+    }
+    BOOST_CHECK_EQUAL(fragments, 4);
+    BOOST_CHECK(reassembled == frame);
+
+    auto decodeMsg = std::make_shared<WsMessage>();
+    BOOST_CHECK(decodeMsg->decode(bytesConstRef(reassembled.data(), reassembled.size())) > 0);
+    BOOST_CHECK_EQUAL(decodeMsg->seq(), msg->seq());
+    BOOST_CHECK(*decodeMsg->payload() == *msg->payload());
+}
+
+BOOST_AUTO_TEST_CASE(test_peekHeader)
+{
+    WsMessageFactory factory;
+    std::string data(1000, 'a');
+    auto msg = factory.buildMessage(111, std::make_shared<bytes>(data.begin(), data.end()));
+    msg->setSeq(factory.newSeq());
+    msg->setStatus(-3);
+    msg->setExt(MessageExtFieldFlag::Response | MessageExtFieldFlag::CompressSupported);
+    bytes frame;
+    BOOST_CHECK(msg->encode(frame));
+
+    WsMessageHeader header;
+    BOOST_CHECK(WsMessage::peekHeader(bytesConstRef(frame.data(), frame.size()), header));
+    BOOST_CHECK_EQUAL(header.packetType, 111);
+    BOOST_CHECK_EQUAL(header.status, -3);
+    BOOST_CHECK_EQUAL(header.ext, msg->ext());
+    BOOST_CHECK_EQUAL(std::string((const char*)header.seq.data(), header.seq.size()), msg->seq());
+    BOOST_CHECK_EQUAL(header.payload.size(), data.size());
+    BOOST_CHECK(header.payload.data() == frame.data() + frame.size() - data.size());
+
+    // the ext is rewritten in place and the rest of the frame is kept
+    BOOST_CHECK(WsMessage::setFrameExt(frame, MessageExtFieldFlag::Response));
+    auto decodeMsg = std::make_shared<WsMessage>();
+    BOOST_CHECK(decodeMsg->decode(bytesConstRef(frame.data(), frame.size())) > 0);
+    BOOST_CHECK_EQUAL(decodeMsg->ext(), MessageExtFieldFlag::Response);
+    BOOST_CHECK_EQUAL(decodeMsg->seq(), msg->seq());
+    BOOST_CHECK(*decodeMsg->payload() == *msg->payload());
+
+    // the seq longer than the frame
+    frame.resize(WsMessage::MESSAGE_MIN_LENGTH + 4);
+    BOOST_CHECK(!WsMessage::peekHeader(bytesConstRef(frame.data(), frame.size()), header));
+    BOOST_CHECK(!WsMessage::setFrameExt(frame, 0));
+}
+
+BOOST_AUTO_TEST_CASE(test_streamCredit)
+{
+    auto buffer = WsChunkStream::encodeCredit(
+        std::make_shared<bytes>(), 0x01020304, WsChunkFlag::ChunkEnd);
+    BOOST_CHECK_EQUAL(buffer->size(), WsChunkStream::CREDIT_LENGTH);
+    BOOST_CHECK_EQUAL((*buffer)[0], 0x01);
+    BOOST_CHECK_EQUAL((*buffer)[3], 0x04);
+
+    uint32_t grant = 0;
+    uint8_t flags = 0;
+    BOOST_CHECK(
+        WsChunkStream::decodeCredit(bytesConstRef(buffer->data(), buffer->size()), grant, flags));
+    BOOST_CHECK_EQUAL(grant, 0x01020304);
+    BOOST_CHECK_EQUAL(flags, WsChunkFlag::ChunkEnd);
+    BOOST_CHECK(!WsChunkStream::decodeCredit(
+        bytesConstRef(buffer->data(), buffer->size() - 1), grant, flags));
+
+    // the credits and the chunks are carried by the plain messages
+    WsMessageFactory factory;
+    auto msg = factory.buildMessage(111, buffer);
+    msg->setSeq(factory.newSeq());
+    msg->setExt(MessageExtFieldFlag::ChunkCredit);
+    bytes frame;
+    BOOST_CHECK(msg->encode(frame));
+    auto decodeMsg = std::make_shared<WsMessage>();
+    BOOST_CHECK(decodeMsg->decode(bytesConstRef(frame.data(), frame.size())) > 0);
+    BOOST_CHECK_EQUAL(decodeMsg->ext(), MessageExtFieldFlag::ChunkCredit);
+    BOOST_CHECK(WsChunkStream::decodeCredit(decodeMsg->payloadRef(), grant, flags));
+    BOOST_CHECK_EQUAL(grant, 0x01020304);
+}
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,165 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the transport metrics and their prometheus text
+ * @file WsMetricsTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include "WsSessionPair.h"
+#include <bcos-boostssl/websocket/WsError.h>
+#include <bcos-boostssl/websocket/WsMetrics.h>
+#include <bcos-boostssl/websocket/WsService.h>
+#include <boost/asio/post.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+BOOST_AUTO_TEST_SUITE(WsMetricsTest)
+
+BOOST_AUTO_TEST_CASE(test_WsMetrics)
+{
+    WsTrafficMetrics traffic;
+    traffic.onRead(100);
+    traffic.onRead(50);
+    traffic.onWrite(10);
+    traffic.onTimeout();
+    auto snapshot = traffic.snapshot();
+    BOOST_CHECK_EQUAL(snapshot.bytesIn, 150);
+    BOOST_CHECK_EQUAL(snapshot.msgsIn, 2);
+    BOOST_CHECK_EQUAL(snapshot.bytesOut, 10);
+    BOOST_CHECK_EQUAL(snapshot.msgsOut, 1);
+    BOOST_CHECK_EQUAL(snapshot.timeouts, 1);
+
+    snapshot += traffic.snapshot();
+    BOOST_CHECK_EQUAL(snapshot.bytesIn, 300);
+    BOOST_CHECK_EQUAL(snapshot.timeouts, 2);
+
+    WsLatencyMetrics latency;
+    BOOST_CHECK_EQUAL(latency.snapshot().percentileUs(50), 0);
+    for (uint64_t i = 1; i <= 100; ++i)
+    {
+        latency.record(i);
+    }
+    auto latencySnapshot = latency.snapshot();
+    BOOST_CHECK_EQUAL(latencySnapshot.count, 100);
+    BOOST_CHECK_EQUAL(latencySnapshot.sumUs, 5050);
+    BOOST_CHECK_EQUAL(latencySnapshot.maxUs, 100);
+    // the 50th value falls into [32, 64)
+    BOOST_CHECK_EQUAL(latencySnapshot.percentileUs(50), 63);
+    BOOST_CHECK_EQUAL(latencySnapshot.percentileUs(100), 100);
+
+    WsServiceSnapshot serviceSnapshot;
+    serviceSnapshot.traffic = snapshot;
+    serviceSnapshot.drops[WsError::ReadError] = 3;
+    serviceSnapshot.handlers[1000] = latencySnapshot;
+    auto text = renderPrometheus(serviceSnapshot, "test");
+    BOOST_CHECK(text.find("boostssl_received_bytes_total{module=\"test\"} 300\n") !=
+                std::string::npos);
+    BOOST_CHECK(text.find("boostssl_session_drops_total{module=\"test\","
+                          "reason=\"ReadError\"} 3\n") != std::string::npos);
+    BOOST_CHECK(text.find("boostssl_handler_duration_microseconds_bucket{module=\"test\","
+                          "type=\"1000\",le=\"63\"} 63\n") != std::string::npos);
+    BOOST_CHECK(text.find("boostssl_handler_duration_microseconds_count{module=\"test\","
+                          "type=\"1000\"} 100\n") != std::string::npos);
+    BOOST_CHECK(text.find("boostssl_send_latency_microseconds_count{module=\"test\"} 0\n") !=
+                std::string::npos);
+
+    auto merged = latencySnapshot;
+    merged += latencySnapshot;
+    BOOST_CHECK_EQUAL(merged.count, 200);
+    BOOST_CHECK_EQUAL(merged.maxUs, 100);
+    BOOST_CHECK_EQUAL(merged.percentileUs(50), 63);
+}
+
+BOOST_AUTO_TEST_CASE(test_WsSendMetrics)
+{
+    WsSessionPair pair;
+    pair.client->setSlowSendThreshold(10);
+    pair.start();
+
+    // a send written right away is recorded and is not slow
+    pair.client->asyncSendMessage(pair.newMessage(1000, 16));
+    BOOST_REQUIRE(WsSessionPair::waitFor(
+        [&pair]() { return pair.client->metrics().sendLatency.count == 1; }));
+    BOOST_CHECK_EQUAL(pair.client->metrics().traffic.slowSends, 0);
+
+    // the io thread is held up between the send and the end of its write, the write completion
+    // is queued behind the sleep posted after the send
+    auto ioc = pair.ioc();
+    auto client = pair.client;
+    auto message = pair.newMessage(1000, 16);
+    boost::asio::post(*ioc, [ioc, client, message]() {
+        client->asyncSendMessage(message);
+        boost::asio::post(
+            *ioc, []() { std::this_thread::sleep_for(std::chrono::milliseconds(30)); });
+    });
+    BOOST_REQUIRE(WsSessionPair::waitFor(
+        [&pair]() { return pair.client->metrics().sendLatency.count == 2; }));
+    auto snapshot = pair.client->metrics();
+    BOOST_CHECK_EQUAL(snapshot.traffic.slowSends, 1);
+    BOOST_CHECK(snapshot.sendLatency.maxUs >= 30 * 1000);
+
+    WsServiceSnapshot serviceSnapshot;
+    serviceSnapshot.traffic = snapshot.traffic;
+    serviceSnapshot.sendLatency = snapshot.sendLatency;
+    auto text = renderPrometheus(serviceSnapshot, "test");
+    BOOST_CHECK(text.find("boostssl_send_latency_microseconds_count{module=\"test\"} 2\n") !=
+                std::string::npos);
+    BOOST_CHECK(text.find("boostssl_slow_sends_total{module=\"test\"} 1\n") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_WsServiceMetricsOnDisconnect)
+{
+    WsSessionPair pair;
+    pair.start();
+    pair.exchangeAdvertisements();
+    auto msgsIn = pair.client->metrics().traffic.msgsIn;
+    BOOST_REQUIRE(msgsIn > 0);
+
+    // the totals never go down while the session moves from the live ones to the closed ones
+    auto service = std::make_shared<WsService>("test");
+    std::atomic_bool stop = false;
+    std::atomic_bool decreased = false;
+    std::thread poller([&service, &stop, &decreased]() {
+        uint64_t last = 0;
+        while (!stop)
+        {
+            auto current = service->metrics().traffic.msgsIn;
+            decreased = decreased || current < last;
+            last = current;
+        }
+    });
+    int rounds = 1000;
+    for (int i = 0; i < rounds; ++i)
+    {
+        service->addSession(pair.client);
+        service->onDisconnect(nullptr, pair.client);
+    }
+    stop = true;
+    poller.join();
+    BOOST_CHECK(!decreased);
+    BOOST_CHECK_EQUAL(service->metrics().traffic.msgsIn, msgsIn * rounds);
+    BOOST_CHECK(service->sessions().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
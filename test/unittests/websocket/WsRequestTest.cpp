@@ -0,0 +1,226 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for WsSession::asyncRequest and its response waiters
+ * @file WsRequestTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include "WsSessionPair.h"
+#include <bcos-boostssl/websocket/WsError.h>
+#include <bcos-boostssl/websocket/WsResponseWaiter.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+// the outcome of a request, set once by its handler
+struct RequestResult
+{
+    std::atomic_bool done = false;
+    bcos::Error::Ptr error;
+    std::shared_ptr<MessageFace> response;
+    std::thread::id thread;
+
+    auto handler()
+    {
+        return [this](bcos::Error::Ptr _error, std::shared_ptr<MessageFace> _response) {
+            error = std::move(_error);
+            response = std::move(_response);
+            thread = std::this_thread::get_id();
+            done = true;
+        };
+    }
+};
+
+std::thread::id ioThreadId(boost::asio::io_context& _ioc)
+{
+    std::atomic_bool posted = false;
+    std::thread::id id;
+    boost::asio::post(_ioc, [&]() {
+        id = std::this_thread::get_id();
+        posted = true;
+    });
+    WsSessionPair::waitFor([&posted]() { return posted.load(); });
+    return id;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(WsRequestTest)
+
+BOOST_AUTO_TEST_CASE(test_WsResponseWaiter)
+{
+    // the handler runs on the executor of the io context, not on the completing thread
+    boost::asio::io_context ioc;
+    int called = 0;
+    bcos::Error::Ptr error;
+    std::thread::id handlerThread;
+    auto handler = [&](bcos::Error::Ptr _error, std::shared_ptr<MessageFace> _response) {
+        ++called;
+        error = _error;
+        BOOST_CHECK(!_response);
+        handlerThread = std::this_thread::get_id();
+    };
+    using Waiter = WsResponseWaiterImpl<decltype(handler), boost::asio::io_context::executor_type>;
+    WsResponseWaiter::UniquePtr waiter = std::make_unique<Waiter>(handler, ioc.get_executor());
+    std::thread completer([&waiter]() {
+        waiter->complete(
+            std::make_shared<bcos::Error>(WsError::RequestCancelled, "cancelled"), nullptr);
+    });
+    completer.join();
+    BOOST_CHECK_EQUAL(called, 0);
+    // the work guard kept the io context running until the completion
+    ioc.run();
+    BOOST_CHECK_EQUAL(called, 1);
+    BOOST_CHECK(error && error->errorCode() == WsError::RequestCancelled);
+    BOOST_CHECK(handlerThread == std::this_thread::get_id());
+
+    // completed once, the destruction does not call the handler again
+    waiter.reset();
+    ioc.restart();
+    ioc.run();
+    BOOST_CHECK_EQUAL(called, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_WsResponseWaiterDropped)
+{
+    // the waiter destroyed before it completes still completes the handler
+    boost::asio::io_context ioc;
+    int called = 0;
+    bcos::Error::Ptr error;
+    auto handler = [&](bcos::Error::Ptr _error, std::shared_ptr<MessageFace>) {
+        ++called;
+        error = _error;
+    };
+    using Waiter = WsResponseWaiterImpl<decltype(handler), boost::asio::io_context::executor_type>;
+    WsResponseWaiter::UniquePtr waiter = std::make_unique<Waiter>(handler, ioc.get_executor());
+    waiter.reset();
+    ioc.run();
+    BOOST_CHECK_EQUAL(called, 1);
+    BOOST_CHECK(error && error->errorCode() == WsError::RequestDropped);
+}
+
+BOOST_AUTO_TEST_CASE(test_asyncRequest)
+{
+    WsSessionPair pair;
+    pair.echo(100);
+    std::atomic<int> received = 0;
+    pair.client->setRecvMessageHandler(
+        [&received](std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) { ++received; });
+    pair.start();
+    auto ioThread = ioThreadId(*pair.ioc());
+
+    // the response is taken by the waiter on the io thread and the handler runs on the io
+    // context of the session, the thread pool and the recv handler are not involved
+    RequestResult result;
+    auto request = pair.newMessage(1, 10);
+    pair.client->asyncRequest(request, Options(5000), result.handler());
+    BOOST_REQUIRE(WsSessionPair::waitFor([&result]() { return result.done.load(); }));
+    BOOST_CHECK(!result.error);
+    BOOST_REQUIRE(result.response);
+    BOOST_CHECK_EQUAL(result.response->seq(), request->seq());
+    BOOST_CHECK_EQUAL(result.response->payloadRef().size(), 100);
+    BOOST_CHECK(result.thread == ioThread);
+    BOOST_CHECK_EQUAL(received.load(), 0);
+    BOOST_CHECK_EQUAL(pair.client->metrics().callbacks, 0);
+
+    // the requests in flight at the same time get their own responses
+    constexpr int count = 50;
+    std::vector<std::unique_ptr<RequestResult>> results;
+    for (int i = 0; i < count; ++i)
+    {
+        results.push_back(std::make_unique<RequestResult>());
+        pair.client->asyncRequest(
+            pair.newMessage(1, i), Options(5000), results.back()->handler());
+    }
+    BOOST_REQUIRE(WsSessionPair::waitFor([&results]() {
+        for (auto& r : results)
+        {
+            if (!r->done)
+            {
+                return false;
+            }
+        }
+        return true;
+    }));
+    for (auto& r : results)
+    {
+        BOOST_CHECK(!r->error && r->response);
+    }
+    BOOST_CHECK_EQUAL(pair.client->metrics().callbacks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_asyncRequestTimeout)
+{
+    // the server never answers
+    WsSessionPair pair;
+    pair.start();
+
+    RequestResult result;
+    pair.client->asyncRequest(pair.newMessage(1, 10), Options(50), result.handler());
+    BOOST_REQUIRE(WsSessionPair::waitFor([&result]() { return result.done.load(); }));
+    BOOST_CHECK(result.error && result.error->errorCode() == WsError::TimeOut);
+    BOOST_CHECK(!result.response);
+    BOOST_CHECK_EQUAL(pair.client->metrics().callbacks, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_asyncRequestCancel)
+{
+    WsSessionPair pair;
+    pair.start();
+
+    RequestResult result;
+    auto request = pair.newMessage(1, 10);
+    pair.client->asyncRequest(request, Options(5000), result.handler());
+    BOOST_CHECK(pair.client->cancelRequest(request->seq()));
+    BOOST_REQUIRE(WsSessionPair::waitFor([&result]() { return result.done.load(); }));
+    BOOST_CHECK(result.error && result.error->errorCode() == WsError::RequestCancelled);
+    BOOST_CHECK_EQUAL(pair.client->metrics().callbacks, 0);
+
+    // completed already, neither a second cancel nor the timer complete it again
+    BOOST_CHECK(!pair.client->cancelRequest(request->seq()));
+    BOOST_CHECK(!pair.client->cancelRequest("unknown"));
+}
+
+BOOST_AUTO_TEST_CASE(test_asyncRequestDrop)
+{
+    WsSessionPair pair;
+    pair.start();
+
+    // no timeout, only the drop completes the request
+    RequestResult result;
+    pair.client->asyncRequest(pair.newMessage(1, 10), Options(), result.handler());
+    BOOST_CHECK_EQUAL(pair.client->metrics().callbacks, 1);
+    pair.client->drop(WsError::UserDisconnect);
+    BOOST_REQUIRE(WsSessionPair::waitFor([&result]() { return result.done.load(); }));
+    BOOST_CHECK(result.error && result.error->errorCode() == WsError::SessionDisconnect);
+
+    // a request on the dropped session completes at once
+    RequestResult late;
+    pair.client->asyncRequest(pair.newMessage(1, 10), Options(), late.handler());
+    BOOST_REQUIRE(WsSessionPair::waitFor([&late]() { return late.done.load(); }));
+    BOOST_CHECK(late.error && late.error->errorCode() == WsError::SessionDisconnect);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
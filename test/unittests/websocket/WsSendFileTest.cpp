@@ -0,0 +1,112 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the sendfile of WsTools
+ * @file WsSendFileTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/WsError.h>
+#include <bcos-boostssl/websocket/WsSession.h>
+#include <bcos-boostssl/websocket/WsTools.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+BOOST_AUTO_TEST_SUITE(WsSendFileTest)
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE(test_WsToolsSendFile)
+{
+    char path[] = "/tmp/boostssl-sendfile-XXXXXX";
+    auto fd = ::mkstemp(path);
+    BOOST_CHECK(fd >= 0);
+    ::unlink(path);
+    std::string content;
+    for (int i = 0; i < 100000; ++i)
+    {
+        content.push_back((char)('a' + i % 26));
+    }
+    BOOST_CHECK_EQUAL(::write(fd, content.data(), content.size()), (ssize_t)content.size());
+
+    boost::asio::io_context ioc;
+    boost::asio::local::stream_protocol::socket sender(ioc);
+    boost::asio::local::stream_protocol::socket receiver(ioc);
+    boost::asio::local::connect_pair(sender, receiver);
+
+    // larger than the socket buffer, the send waits for the reader
+    std::size_t offset = 1000;
+    std::size_t size = content.size() - 2 * offset;
+    boost::system::error_code sendEc;
+    std::size_t sent = 0;
+    WsTools::asyncSendFile(
+        sender, fd, offset, size, [&](boost::system::error_code _ec, std::size_t _sent) {
+            sendEc = _ec;
+            sent = _sent;
+        });
+    std::string received(size, 0);
+    boost::asio::async_read(receiver, boost::asio::buffer(received),
+        [](boost::system::error_code _ec, std::size_t) { BOOST_CHECK(!_ec); });
+    ioc.run();
+    BOOST_CHECK(!sendEc);
+    BOOST_CHECK_EQUAL(sent, size);
+    BOOST_CHECK(received == content.substr(offset, size));
+
+    // the range past the end of the file
+    ioc.restart();
+    WsTools::asyncSendFile(
+        sender, fd, content.size() - 10, 20, [&](boost::system::error_code _ec, std::size_t _sent) {
+            sendEc = _ec;
+            sent = _sent;
+        });
+    ioc.run();
+    BOOST_CHECK(sendEc == boost::asio::error::eof);
+    BOOST_CHECK_EQUAL(sent, 10);
+    ::close(fd);
+}
+
+BOOST_AUTO_TEST_CASE(test_asyncSendFileOverflow)
+{
+    char path[] = "/tmp/boostssl-sendfile-XXXXXX";
+    auto fd = ::mkstemp(path);
+    BOOST_CHECK(fd >= 0);
+    ::unlink(path);
+
+    // no stream to send the file from, the fallback reads the range into the payload, the range
+    // over the limit fails before the payload is allocated
+    auto session = std::make_shared<WsSession>("TEST");
+    auto factory = std::make_shared<WsMessageFactory>();
+    session->setMessageFactory(factory);
+    session->setMaxWriteMsgSize(1024);
+    bcos::Error::Ptr error;
+    session->asyncSendFile(factory->buildMessage(), fd, 0, (std::size_t)1 << 40, Options(),
+        [&error](bcos::Error::Ptr _error, std::shared_ptr<MessageFace>,
+            std::shared_ptr<WsSession>) { error = _error; });
+    BOOST_REQUIRE(error);
+    BOOST_CHECK_EQUAL(error->errorCode(), WsError::MessageOverflow);
+    ::close(fd);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,258 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief two sessions connected over a unix socket pair for the session level tests
+ * @file WsSessionPair.h
+ * @author: octopus
+ * @date 2026-10-16
+ */
+#pragma once
+
+#include <bcos-boostssl/websocket/WsError.h>
+#include <bcos-boostssl/websocket/WsMessage.h>
+#include <bcos-boostssl/websocket/WsSession.h>
+#include <bcos-boostssl/websocket/WsStream.h>
+#include <bcos-utilities/ThreadPool.h>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bcos
+{
+namespace boostssl
+{
+namespace ws
+{
+// a frame read by a WsFrameTapSession, before it is handled
+struct WsFrameRecord
+{
+    enum Kind
+    {
+        Message,
+        Batch,
+        Fragment
+    };
+    Kind kind = Message;
+    std::size_t size = 0;
+    // the messages packed in a batch frame
+    std::size_t messages = 1;
+    // the last fragment of a message
+    bool last = false;
+    uint16_t packetType = 0;
+};
+
+// records the frames it reads, for the tests of the batching and the fragmentation
+class WsFrameTapSession : public WsSession
+{
+public:
+    using WsSession::WsSession;
+
+    std::vector<WsFrameRecord> frames() const
+    {
+        std::lock_guard<std::mutex> l(x_frames);
+        return m_frames;
+    }
+
+protected:
+    void onRead(boost::system::error_code _ec, std::size_t _size) override
+    {
+        if (!_ec)
+        {
+            auto data = boost::asio::buffer_cast<const bcos::byte*>(
+                boost::beast::buffers_front(buffer().data()));
+            record(bytesConstRef(data, buffer().size()));
+        }
+        WsSession::onRead(_ec, _size);
+    }
+
+private:
+    void record(bytesConstRef _frame)
+    {
+        WsFrameRecord frame;
+        frame.size = _frame.size();
+        bytesConstRef payload;
+        if (WsMessage::batchPayload(_frame, payload))
+        {
+            frame.kind = WsFrameRecord::Batch;
+            frame.messages = 0;
+            for (std::size_t offset = 0; offset + WsMessage::BATCH_LENGTH_PREFIX <= payload.size();
+                 ++frame.messages)
+            {
+                uint32_t length = 0;
+                for (std::size_t i = 0; i < WsMessage::BATCH_LENGTH_PREFIX; ++i)
+                {
+                    length = (length << 8) | payload.data()[offset + i];
+                }
+                offset += WsMessage::BATCH_LENGTH_PREFIX + length;
+            }
+        }
+        else if (WsMessage::fragmentPayload(_frame, payload, frame.last))
+        {
+            frame.kind = WsFrameRecord::Fragment;
+        }
+        else
+        {
+            WsMessageHeader header;
+            if (WsMessage::peekHeader(_frame, header))
+            {
+                frame.packetType = header.packetType;
+            }
+        }
+        std::lock_guard<std::mutex> l(x_frames);
+        m_frames.push_back(frame);
+    }
+
+    mutable std::mutex x_frames;
+    std::vector<WsFrameRecord> m_frames;
+};
+
+class WsFrameTapSessionFactory : public WsSessionFactory
+{
+public:
+    WsSession::Ptr createSession(std::string _moduleName) override
+    {
+        return std::make_shared<WsFrameTapSession>(_moduleName);
+    }
+};
+
+// the client and the server session on the tcp frame transport, configured between the
+// construction and start(), the io thread runs until the sessions are dropped
+class WsSessionPair
+{
+public:
+    explicit WsSessionPair(
+        WsSessionFactory::Ptr _sessionFactory = std::make_shared<WsSessionFactory>())
+      : m_sessionFactory(std::move(_sessionFactory)),
+        m_ioc(std::make_shared<boost::asio::io_context>()),
+        m_work(boost::asio::make_work_guard(*m_ioc)),
+        m_threadPool(std::make_shared<bcos::ThreadPool>("t_ws_test", 2)),
+        m_messageFactory(std::make_shared<WsMessageFactory>())
+    {
+        auto clientStream = std::make_shared<UnixStream>(*m_ioc);
+        auto serverStream = std::make_shared<UnixStream>(*m_ioc);
+        boost::asio::local::connect_pair(clientStream->socket(), serverStream->socket());
+        WsStreamDelegateBuilder builder;
+        client = newSession(builder.buildTcpFrame(clientStream, "TEST"), "client");
+        server = newSession(builder.buildTcpFrame(serverStream, "TEST"), "server");
+    }
+
+    ~WsSessionPair()
+    {
+        client->drop(WsError::UserDisconnect);
+        server->drop(WsError::UserDisconnect);
+        // the io thread returns when the reads and the timers of the sessions are done
+        m_work.reset();
+        if (m_ioThread.joinable())
+        {
+            m_ioThread.join();
+        }
+        m_threadPool->stop();
+    }
+
+    void start()
+    {
+        client->startAsClient();
+        server->startAsClient();
+        m_ioThread = std::thread([ioc = m_ioc]() { ioc->run(); });
+    }
+
+    std::shared_ptr<WsMessage> newMessage(uint16_t _type, std::size_t _size)
+    {
+        auto message = m_messageFactory->buildMessage(
+            _type, std::make_shared<bcos::bytes>(_size, (bcos::byte)_type));
+        message->setSeq(m_messageFactory->newSeq());
+        return message;
+    }
+
+    // the server answers every message with a response of _size bytes
+    void echo(std::size_t _size = 0)
+    {
+        server->setRecvMessageHandler(
+            [this, _size](std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession> _session) {
+                auto response = newMessage(_msg->packetType(), _size);
+                response->setSeq(_msg->seq());
+                response->setRespPacket();
+                _session->asyncSendMessage(response);
+            });
+    }
+
+    // polls _done until it holds or a few seconds passed
+    static bool waitFor(std::function<bool()> _done)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!_done())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    std::shared_ptr<boost::asio::io_context> ioc() const { return m_ioc; }
+
+    // the peers learn what the other side supports from the first message it sends, the recv
+    // handlers get the messages of _type
+    void exchangeAdvertisements(uint16_t _type = 0)
+    {
+        client->asyncSendMessage(newMessage(_type, 1));
+        server->asyncSendMessage(newMessage(_type, 1));
+        // the sends after it run after the read on the io thread
+        waitFor([this]() {
+            return client->metrics().traffic.msgsIn > 0 && server->metrics().traffic.msgsIn > 0;
+        });
+    }
+
+    WsSession::Ptr client;
+    WsSession::Ptr server;
+
+private:
+    WsSession::Ptr newSession(WsStreamDelegate::Ptr _stream, const std::string& _endPoint)
+    {
+        auto session = m_sessionFactory->createSession("TEST");
+        session->setWsStreamDelegate(_stream);
+        session->setIoc(m_ioc);
+        session->setThreadPool(m_threadPool);
+        session->setMessageFactory(m_messageFactory);
+        session->setEndPoint(_endPoint);
+        session->setConnectedEndPoint(_endPoint);
+        session->setMaxWriteMsgSize(32 * 1024 * 1024);
+        session->setConnectHandler([](bcos::Error::Ptr, std::shared_ptr<WsSession>) {});
+        session->setDisconnectHandler([](bcos::Error::Ptr, std::shared_ptr<WsSession>) {});
+        session->setRecvMessageHandler(
+            [](std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) {});
+        return session;
+    }
+
+    WsSessionFactory::Ptr m_sessionFactory;
+    std::shared_ptr<boost::asio::io_context> m_ioc;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> m_work;
+    std::shared_ptr<bcos::ThreadPool> m_threadPool;
+    std::shared_ptr<WsMessageFactory> m_messageFactory;
+    std::thread m_ioThread;
+};
+
+}  // namespace ws
+}  // namespace boostssl
+}  // namespace bcos
@@ -0,0 +1,160 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the shared memory ring
+ * @file WsShmRingTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/ShmRingStream.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+// one ring of the minimal size as it is laid out in the shared memory
+struct alignas(64) RingRegion
+{
+    uint8_t bytes[sizeof(ShmRing) + SHM_RING_MIN_SIZE];
+};
+
+std::vector<uint8_t> pattern(std::size_t _size, uint8_t _seed)
+{
+    std::vector<uint8_t> data(_size);
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+        data[i] = (uint8_t)(i * 31 + _seed);
+    }
+    return data;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(WsShmRingTest)
+
+BOOST_AUTO_TEST_CASE(test_shmRingSize)
+{
+    BOOST_CHECK(ShmRing::validSize(SHM_RING_MIN_SIZE));
+    BOOST_CHECK(ShmRing::validSize(SHM_RING_DEFAULT_SIZE));
+    BOOST_CHECK(ShmRing::validSize(SHM_RING_MAX_SIZE));
+    BOOST_CHECK(!ShmRing::validSize(0));
+    BOOST_CHECK(!ShmRing::validSize(SHM_RING_MIN_SIZE / 2));
+    BOOST_CHECK(!ShmRing::validSize(SHM_RING_MIN_SIZE + 1));
+    BOOST_CHECK(!ShmRing::validSize(3 * SHM_RING_MIN_SIZE));
+    BOOST_CHECK(!ShmRing::validSize((uint64_t)SHM_RING_MAX_SIZE * 2));
+}
+
+BOOST_AUTO_TEST_CASE(test_shmRingFullAndEmpty)
+{
+    auto region = std::make_unique<RingRegion>();
+    auto ring = new (region->bytes) ShmRing();
+    ShmRingView view(ring, SHM_RING_MIN_SIZE);
+    BOOST_CHECK(view);
+    BOOST_CHECK_EQUAL(view.capacity(), SHM_RING_MIN_SIZE);
+
+    // empty
+    std::vector<uint8_t> out(SHM_RING_MIN_SIZE + 1);
+    BOOST_CHECK_EQUAL(view.readable(), 0u);
+    BOOST_CHECK_EQUAL(view.read(out.data(), out.size()), 0u);
+
+    // full, the last byte does not fit
+    auto in = pattern(SHM_RING_MIN_SIZE + 1, 7);
+    BOOST_CHECK_EQUAL(view.write(in.data(), in.size()), SHM_RING_MIN_SIZE);
+    BOOST_CHECK_EQUAL(view.readable(), SHM_RING_MIN_SIZE);
+    BOOST_CHECK_EQUAL(view.write(in.data(), 1), 0u);
+
+    // one byte out makes room for one byte in
+    BOOST_CHECK_EQUAL(view.read(out.data(), 1), 1u);
+    BOOST_CHECK_EQUAL(out[0], in[0]);
+    BOOST_CHECK_EQUAL(view.write(in.data() + SHM_RING_MIN_SIZE, 2), 1u);
+
+    // drained in order back to empty
+    BOOST_CHECK_EQUAL(view.read(out.data(), out.size()), SHM_RING_MIN_SIZE);
+    BOOST_CHECK(std::equal(in.begin() + 1, in.end(), out.begin()));
+    BOOST_CHECK_EQUAL(view.readable(), 0u);
+    BOOST_CHECK_EQUAL(view.read(out.data(), out.size()), 0u);
+    BOOST_CHECK(!view.corrupted());
+}
+
+BOOST_AUTO_TEST_CASE(test_shmRingWraparound)
+{
+    auto region = std::make_unique<RingRegion>();
+    auto ring = new (region->bytes) ShmRing();
+    ShmRingView view(ring, SHM_RING_MIN_SIZE);
+
+    // move the indexes close to the end of the ring, the next write is split in two copies
+    auto in = pattern(3000, 1);
+    std::vector<uint8_t> out(SHM_RING_MIN_SIZE);
+    BOOST_CHECK_EQUAL(view.write(in.data(), in.size()), in.size());
+    BOOST_CHECK_EQUAL(view.read(out.data(), in.size()), in.size());
+
+    in = pattern(2000, 2);
+    BOOST_CHECK_EQUAL(view.write(in.data(), in.size()), in.size());
+    BOOST_CHECK_EQUAL(view.readable(), in.size());
+    BOOST_CHECK_EQUAL(view.read(out.data(), out.size()), in.size());
+    BOOST_CHECK(std::equal(in.begin(), in.end(), out.begin()));
+
+    // the 64 bit indexes wrap around too
+    ring->head.store(UINT64_MAX - 100);
+    ring->tail.store(UINT64_MAX - 100);
+    in = pattern(SHM_RING_MIN_SIZE, 3);
+    BOOST_CHECK_EQUAL(view.write(in.data(), in.size()), in.size());
+    BOOST_CHECK_EQUAL(view.readable(), in.size());
+    BOOST_CHECK_EQUAL(view.read(out.data(), out.size()), in.size());
+    BOOST_CHECK(std::equal(in.begin(), in.end(), out.begin()));
+    BOOST_CHECK(!view.corrupted());
+}
+
+BOOST_AUTO_TEST_CASE(test_shmRingCorrupted)
+{
+    auto region = std::make_unique<RingRegion>();
+    auto ring = new (region->bytes) ShmRing();
+    std::vector<uint8_t> out(SHM_RING_MIN_SIZE);
+
+    // the capacity in the shared memory is never used to index the data
+    ring->capacity = UINT64_MAX;
+    ShmRingView view(ring, SHM_RING_MIN_SIZE);
+    auto in = pattern(SHM_RING_MIN_SIZE, 4);
+    BOOST_CHECK_EQUAL(view.write(in.data(), in.size()), in.size());
+    BOOST_CHECK_EQUAL(view.read(out.data(), out.size()), in.size());
+
+    // the head runs more than the capacity ahead of the tail
+    ring->head.store(ring->tail.load() + SHM_RING_MIN_SIZE + 1);
+    BOOST_CHECK_EQUAL(view.read(out.data(), out.size()), 0u);
+    BOOST_CHECK(view.corrupted());
+    // nothing is copied anymore even after the indexes look sane again
+    ring->head.store(ring->tail.load() + 1);
+    BOOST_CHECK_EQUAL(view.read(out.data(), out.size()), 0u);
+    BOOST_CHECK_EQUAL(view.readable(), 0u);
+
+    // the tail passes the head
+    auto region2 = std::make_unique<RingRegion>();
+    auto ring2 = new (region2->bytes) ShmRing();
+    ShmRingView view2(ring2, SHM_RING_MIN_SIZE);
+    ring2->tail.store(1);
+    BOOST_CHECK_EQUAL(view2.write(in.data(), in.size()), 0u);
+    BOOST_CHECK(view2.corrupted());
+    BOOST_CHECK_EQUAL(ring2->head.load(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
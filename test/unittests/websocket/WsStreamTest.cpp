@@ -0,0 +1,301 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the streams of chunks sent with WsSession::asyncSendStream
+ * @file WsStreamTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include "WsSessionPair.h"
+#include <bcos-boostssl/websocket/WsCompressor.h>
+#include <bcos-boostssl/websocket/WsError.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+constexpr uint16_t STREAM_TYPE = 1000;
+
+// the payload of a stream read in pieces, _abortAt makes the source fail at that offset
+struct StreamSource
+{
+    explicit StreamSource(std::size_t _size, std::size_t _abortAt = SIZE_MAX)
+      : abortAt(_abortAt)
+    {
+        for (std::size_t i = 0; data.size() < _size; ++i)
+        {
+            data += "chunk " + std::to_string(i % 1000) + " of the stream;";
+        }
+        data.resize(_size);
+    }
+
+    WsStreamSource source()
+    {
+        return [this](bcos::byte* _data, std::size_t _size) -> int64_t {
+            if (offset >= abortAt)
+            {
+                return -1;
+            }
+            auto size = std::min(_size, data.size() - offset);
+            ::memcpy(_data, data.data() + offset, size);
+            offset += size;
+            return (int64_t)size;
+        };
+    }
+
+    std::string data;
+    std::size_t abortAt;
+    std::atomic<std::size_t> offset = 0;
+};
+
+// the result of a stream on both sides, the receiver blocks in its handler while held
+struct StreamResult
+{
+    WsStreamHandler handler()
+    {
+        return [this](std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) {
+            return [this](bcos::Error::Ptr _error, bytesConstRef _chunk, bool _end) {
+                while (hold)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                std::lock_guard<std::mutex> l(mutex);
+                received.append((const char*)_chunk.data(), _chunk.size());
+                receiverError = _error;
+                receiverDone = _end || _error;
+            };
+        };
+    }
+
+    WsStreamSendCallback callback()
+    {
+        return [this](bcos::Error::Ptr _error) {
+            senderError = std::move(_error);
+            senderDone = true;
+        };
+    }
+
+    std::atomic_bool hold = false;
+    std::mutex mutex;
+    std::string received;
+    bcos::Error::Ptr receiverError;
+    std::atomic_bool receiverDone = false;
+    bcos::Error::Ptr senderError;
+    std::atomic_bool senderDone = false;
+};
+
+// the streams are off by default, both sessions of the pair take them with _window
+void enableStreams(WsSessionPair& _pair, uint32_t _window = 4 * 1024 * 1024)
+{
+    _pair.client->setStreamWindow(_window);
+    _pair.server->setStreamWindow(_window);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(WsStreamTest)
+
+BOOST_AUTO_TEST_CASE(test_streamWindow)
+{
+    WsSessionPair pair;
+    pair.client->setStreamChunkSize(16 * 1024);
+    enableStreams(pair, 64 * 1024);
+    StreamResult result;
+    pair.server->setStreamHandler(result.handler());
+    pair.start();
+
+    // the receiver holds the first chunk, the sender stops at the window
+    StreamSource source(1024 * 1024);
+    result.hold = true;
+    pair.client->asyncSendStream(STREAM_TYPE, source.source(), result.callback());
+    BOOST_REQUIRE(WsSessionPair::waitFor([&source]() { return source.offset >= 64 * 1024; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    BOOST_CHECK_EQUAL(source.offset.load(), 64 * 1024);
+    BOOST_CHECK(!result.senderDone);
+
+    // the grants let the rest through in order
+    result.hold = false;
+    BOOST_REQUIRE(WsSessionPair::waitFor([&result]() { return result.senderDone.load(); }));
+    BOOST_CHECK(!result.senderError);
+    BOOST_CHECK(result.receiverDone);
+    BOOST_CHECK(!result.receiverError);
+    BOOST_CHECK(result.received == source.data);
+}
+
+BOOST_AUTO_TEST_CASE(test_streamRejected)
+{
+    // the server has no handler for the type and aborts the stream at the open
+    WsSessionPair pair;
+    enableStreams(pair);
+    pair.server->setStreamHandler(
+        [](std::shared_ptr<MessageFace>, std::shared_ptr<WsSession>) { return nullptr; });
+    pair.start();
+
+    StreamSource source(1024);
+    StreamResult result;
+    pair.client->asyncSendStream(STREAM_TYPE, source.source(), result.callback());
+    BOOST_REQUIRE(WsSessionPair::waitFor([&result]() { return result.senderDone.load(); }));
+    BOOST_CHECK(result.senderError && result.senderError->errorCode() == WsError::StreamAborted);
+    BOOST_CHECK_EQUAL(source.offset.load(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_streamSourceAbort)
+{
+    WsSessionPair pair;
+    enableStreams(pair);
+    pair.client->setStreamChunkSize(4 * 1024);
+    StreamResult result;
+    pair.server->setStreamHandler(result.handler());
+    pair.start();
+
+    // the source fails after a few chunks, both sides see the abort
+    StreamSource source(64 * 1024, 16 * 1024);
+    pair.client->asyncSendStream(STREAM_TYPE, source.source(), result.callback());
+    BOOST_REQUIRE(WsSessionPair::waitFor(
+        [&result]() { return result.senderDone.load() && result.receiverDone.load(); }));
+    BOOST_CHECK(result.senderError && result.senderError->errorCode() == WsError::StreamAborted);
+    BOOST_CHECK(
+        result.receiverError && result.receiverError->errorCode() == WsError::StreamAborted);
+    BOOST_CHECK(result.received == source.data.substr(0, 16 * 1024));
+    BOOST_CHECK(pair.client->isConnected());
+}
+
+BOOST_AUTO_TEST_CASE(test_streamDisconnect)
+{
+    WsSessionPair pair;
+    pair.client->setStreamChunkSize(16 * 1024);
+    enableStreams(pair, 64 * 1024);
+    StreamResult result;
+    pair.server->setStreamHandler(result.handler());
+    pair.start();
+
+    // the connection goes away while the receiver holds a chunk
+    StreamSource source(1024 * 1024);
+    result.hold = true;
+    pair.client->asyncSendStream(STREAM_TYPE, source.source(), result.callback());
+    BOOST_REQUIRE(WsSessionPair::waitFor([&source]() { return source.offset >= 64 * 1024; }));
+    pair.client->drop(WsError::UserDisconnect);
+    BOOST_REQUIRE(WsSessionPair::waitFor([&result]() { return result.senderDone.load(); }));
+    BOOST_CHECK(
+        result.senderError && result.senderError->errorCode() == WsError::SessionDisconnect);
+    BOOST_REQUIRE(WsSessionPair::waitFor([&pair]() { return !pair.server->isConnected(); }));
+
+    // the receiver gets the error after the chunk it held
+    result.hold = false;
+    BOOST_REQUIRE(WsSessionPair::waitFor([&result]() { return result.receiverDone.load(); }));
+    BOOST_CHECK(
+        result.receiverError && result.receiverError->errorCode() == WsError::SessionDisconnect);
+    BOOST_CHECK(result.received.size() < source.data.size());
+
+    // a stream on the dropped session fails at once
+    StreamResult late;
+    pair.client->asyncSendStream(STREAM_TYPE, source.source(), late.callback());
+    BOOST_REQUIRE(WsSessionPair::waitFor([&late]() { return late.senderDone.load(); }));
+    BOOST_CHECK(late.senderError && late.senderError->errorCode() == WsError::SessionDisconnect);
+}
+
+BOOST_AUTO_TEST_CASE(test_streamCompressed)
+{
+    WsSessionPair pair;
+    auto clientCompressor = std::make_shared<WsCompressor>(1024, 1);
+    auto serverCompressor = std::make_shared<WsCompressor>(1024, 1);
+    pair.client->setCompressor(clientCompressor);
+    pair.server->setCompressor(serverCompressor);
+    pair.client->setStreamChunkSize(16 * 1024);
+    enableStreams(pair, 64 * 1024);
+    StreamResult result;
+    pair.server->setStreamHandler(result.handler());
+    pair.start();
+
+    // the chunks after the open are compressed, the window counts their data
+    StreamSource source(1024 * 1024);
+    pair.client->asyncSendStream(STREAM_TYPE, source.source(), result.callback());
+    BOOST_REQUIRE(WsSessionPair::waitFor([&result]() { return result.senderDone.load(); }));
+    BOOST_CHECK(!result.senderError);
+    BOOST_CHECK(!result.receiverError);
+    BOOST_CHECK(result.received == source.data);
+    BOOST_CHECK(clientCompressor->metrics().compressed > 0);
+    BOOST_CHECK_EQUAL(
+        serverCompressor->metrics().decompressed, clientCompressor->metrics().compressed);
+    BOOST_CHECK_EQUAL(serverCompressor->metrics().decompressErrors, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_streamDisabled)
+{
+    // the server is a peer with the streams off as by default, the chunk flags are the user's,
+    // the raw handler and the recv handler get the message as it is
+    WsSessionPair pair;
+    pair.client->setStreamWindow(4 * 1024 * 1024);
+    std::mutex mutex;
+    uint16_t rawExt = 0;
+    std::shared_ptr<MessageFace> received;
+    auto rawFrameEnabled = std::make_shared<std::atomic_bool>(true);
+    pair.server->setRawFrameHandler(
+        [&mutex, &rawExt, rawFrameEnabled](
+            const WsMessageHeader& _header, bytesConstRef, std::shared_ptr<WsSession>) {
+            std::lock_guard<std::mutex> l(mutex);
+            rawExt = _header.ext;
+            // the next message goes to the recv handler
+            rawFrameEnabled->store(false);
+            return true;
+        },
+        rawFrameEnabled);
+    pair.server->setRecvMessageHandler(
+        [&mutex, &received](std::shared_ptr<MessageFace> _msg, std::shared_ptr<WsSession>) {
+            std::lock_guard<std::mutex> l(mutex);
+            received = _msg;
+        });
+    pair.start();
+
+    for (int i = 0; i < 2; ++i)
+    {
+        auto message = pair.newMessage(STREAM_TYPE, 1);
+        message->payload()->assign(1, (bcos::byte)WsChunkFlag::ChunkOpen);
+        message->setExt(MessageExtFieldFlag::Chunk);
+        pair.client->asyncSendMessage(message);
+    }
+    BOOST_REQUIRE(WsSessionPair::waitFor([&mutex, &received]() {
+        std::lock_guard<std::mutex> l(mutex);
+        return received != nullptr;
+    }));
+    {
+        std::lock_guard<std::mutex> l(mutex);
+        BOOST_CHECK_EQUAL(rawExt, MessageExtFieldFlag::Chunk);
+        BOOST_CHECK_EQUAL(received->ext(), MessageExtFieldFlag::Chunk);
+        BOOST_CHECK_EQUAL(received->payloadRef().size(), 1);
+    }
+
+    // a stream cannot be sent from a session with the streams off
+    StreamSource source(1024);
+    StreamResult result;
+    pair.server->asyncSendStream(STREAM_TYPE, source.source(), result.callback());
+    BOOST_REQUIRE(WsSessionPair::waitFor([&result]() { return result.senderDone.load(); }));
+    BOOST_CHECK(result.senderError && result.senderError->errorCode() == WsError::StreamAborted);
+    BOOST_CHECK_EQUAL(source.offset.load(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
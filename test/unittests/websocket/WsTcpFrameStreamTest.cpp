@@ -0,0 +1,307 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the length-prefixed tcp frame transport
+ * @file WsTcpFrameStreamTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/TcpFrameStream.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+// the two ends of a loopback tcp connection
+std::pair<std::shared_ptr<boost::beast::tcp_stream>, std::shared_ptr<boost::beast::tcp_stream>>
+makeTcpPair(boost::asio::io_context& _ioc)
+{
+    boost::asio::ip::tcp::acceptor acceptor(
+        _ioc, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    boost::asio::ip::tcp::socket client(_ioc);
+    client.connect(acceptor.local_endpoint());
+    boost::asio::ip::tcp::socket server(_ioc);
+    acceptor.accept(server);
+    return {std::make_shared<boost::beast::tcp_stream>(std::move(client)),
+        std::make_shared<boost::beast::tcp_stream>(std::move(server))};
+}
+
+std::pair<RawTcpFrameStream::Ptr, RawTcpFrameStream::Ptr> makeStreamPair(
+    boost::asio::io_context& _ioc)
+{
+    auto tcpPair = makeTcpPair(_ioc);
+    return {std::make_shared<RawTcpFrameStream>(tcpPair.first, "DEFAULT"),
+        std::make_shared<RawTcpFrameStream>(tcpPair.second, "DEFAULT")};
+}
+
+// the idle timer keeps the io_context busy, run it until _done holds instead of out of work
+void runUntil(
+    boost::asio::io_context& _ioc, std::function<bool()> _done, std::chrono::milliseconds _timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + _timeout;
+    while (!_done() && _ioc.run_one_until(deadline) > 0)
+    {
+    }
+    _ioc.restart();
+}
+
+bcos::bytes pattern(std::size_t _size, uint8_t _seed)
+{
+    bcos::bytes data(_size);
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+        data[i] = (uint8_t)(i * 31 + _seed);
+    }
+    return data;
+}
+
+// read frames one after another like the session does, until an error or _count frames
+void readFrames(RawTcpFrameStream::Ptr _stream, std::shared_ptr<boost::beast::flat_buffer> _buffer,
+    std::shared_ptr<std::vector<bcos::bytes>> _frames, std::size_t _count,
+    std::shared_ptr<boost::system::error_code> _error)
+{
+    _stream->asyncRead(
+        *_buffer, [_stream, _buffer, _frames, _count, _error](
+                      boost::system::error_code _ec, std::size_t _size) {
+            if (_ec)
+            {
+                *_error = _ec;
+                return;
+            }
+            auto data = reinterpret_cast<const uint8_t*>(_buffer->data().data());
+            _frames->emplace_back(data, data + _size);
+            _buffer->consume(_buffer->size());
+            if (_frames->size() < _count)
+            {
+                readFrames(_stream, _buffer, _frames, _count, _error);
+            }
+        });
+}
+
+// write the frames one after another, the buffers outlive the writes
+void writeFrames(RawTcpFrameStream::Ptr _stream, std::shared_ptr<std::vector<bcos::bytes>> _frames,
+    std::size_t _index, std::shared_ptr<boost::system::error_code> _error)
+{
+    if (_index == _frames->size())
+    {
+        return;
+    }
+    _stream->asyncWrite((*_frames)[_index],
+        [_stream, _frames, _index, _error](boost::system::error_code _ec, std::size_t _size) {
+            if (_ec || _size != (*_frames)[_index].size())
+            {
+                *_error = _ec ? _ec : boost::asio::error::message_size;
+                return;
+            }
+            writeFrames(_stream, _frames, _index + 1, _error);
+        });
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(WsTcpFrameStreamTest)
+
+BOOST_AUTO_TEST_CASE(test_tcpFrameWire)
+{
+    boost::asio::io_context ioc;
+    auto tcpPair = makeTcpPair(ioc);
+    auto client = std::make_shared<RawTcpFrameStream>(tcpPair.first, "DEFAULT");
+
+    // the client selects the transport with the preamble
+    auto handshakeError = std::make_shared<boost::system::error_code>(
+        boost::asio::error::would_block);
+    client->asyncHandshake(
+        "", "", [handshakeError](boost::system::error_code _ec) { *handshakeError = _ec; });
+    ioc.run_for(std::chrono::seconds(5));
+    ioc.restart();
+    BOOST_REQUIRE(!*handshakeError);
+    std::array<uint8_t, TCP_FRAME_PREAMBLE.size()> preamble;
+    boost::asio::read(tcpPair.second->socket(), boost::asio::buffer(preamble));
+    BOOST_CHECK(preamble == TCP_FRAME_PREAMBLE);
+
+    // a frame is the big endian length followed by the message
+    auto frames = std::make_shared<std::vector<bcos::bytes>>();
+    frames->push_back(pattern(0x010203, 1));
+    auto writeError = std::make_shared<boost::system::error_code>();
+    writeFrames(client, frames, 0, writeError);
+    ioc.run_for(std::chrono::seconds(5));
+    ioc.restart();
+    BOOST_CHECK(!*writeError);
+
+    std::array<uint8_t, TCP_FRAME_HEADER_SIZE> header;
+    boost::asio::read(tcpPair.second->socket(), boost::asio::buffer(header));
+    BOOST_CHECK(header == (std::array<uint8_t, TCP_FRAME_HEADER_SIZE>{0x00, 0x01, 0x02, 0x03}));
+    bcos::bytes message(frames->front().size());
+    boost::asio::read(tcpPair.second->socket(), boost::asio::buffer(message));
+    BOOST_CHECK(message == frames->front());
+    client->close();
+}
+
+BOOST_AUTO_TEST_CASE(test_tcpFrameRoundTrip)
+{
+    boost::asio::io_context ioc;
+    auto streams = makeStreamPair(ioc);
+
+    // the empty frame is a frame as well, only the keepalive length is skipped
+    auto frames = std::make_shared<std::vector<bcos::bytes>>();
+    frames->push_back(pattern(5, 1));
+    frames->push_back(bcos::bytes());
+    frames->push_back(pattern(4 * 1024 * 1024 + 3, 2));
+    frames->push_back(pattern(100, 3));
+
+    auto received = std::make_shared<std::vector<bcos::bytes>>();
+    auto readError = std::make_shared<boost::system::error_code>();
+    auto writeError = std::make_shared<boost::system::error_code>();
+    readFrames(streams.second, std::make_shared<boost::beast::flat_buffer>(), received,
+        frames->size(), readError);
+    writeFrames(streams.first, frames, 0, writeError);
+
+    runUntil(
+        ioc, [&]() { return received->size() == frames->size() || *readError; },
+        std::chrono::seconds(10));
+    BOOST_CHECK(!*readError);
+    BOOST_CHECK(!*writeError);
+    BOOST_REQUIRE_EQUAL(received->size(), frames->size());
+    for (std::size_t i = 0; i < frames->size(); ++i)
+    {
+        BOOST_CHECK((*received)[i] == (*frames)[i]);
+    }
+    streams.first->close();
+    streams.second->close();
+    ioc.run_for(std::chrono::seconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(test_tcpFrameOversize)
+{
+    boost::asio::io_context ioc;
+    auto streams = makeStreamPair(ioc);
+    streams.second->setMaxReadMsgSize(16);
+
+    // the frame at the limit is read, the larger one is rejected by its length prefix
+    auto frames = std::make_shared<std::vector<bcos::bytes>>();
+    frames->push_back(pattern(16, 1));
+    frames->push_back(pattern(17, 2));
+
+    auto received = std::make_shared<std::vector<bcos::bytes>>();
+    auto readError = std::make_shared<boost::system::error_code>();
+    auto writeError = std::make_shared<boost::system::error_code>();
+    readFrames(streams.second, std::make_shared<boost::beast::flat_buffer>(), received,
+        frames->size(), readError);
+    writeFrames(streams.first, frames, 0, writeError);
+
+    runUntil(ioc, [&]() { return bool(*readError); }, std::chrono::seconds(5));
+    BOOST_CHECK(!*writeError);
+    BOOST_CHECK(*readError == boost::asio::error::message_size);
+    BOOST_REQUIRE_EQUAL(received->size(), 1u);
+    BOOST_CHECK(received->front() == frames->front());
+    streams.first->close();
+    streams.second->close();
+    ioc.run_for(std::chrono::seconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(test_tcpFrameReleasedWhilePending)
+{
+    boost::asio::io_context ioc;
+    auto streams = makeStreamPair(ioc);
+    streams.first->setIdleTimeout(0);
+
+    // the session drops its stream with a read and a write in flight, the aborted handlers
+    // still run on a live stream
+    std::weak_ptr<RawTcpFrameStream> weak = streams.first;
+    auto buffer = std::make_shared<boost::beast::flat_buffer>();
+    auto frame = std::make_shared<bcos::bytes>(pattern(4 * 1024 * 1024, 3));
+    int done = 0;
+    bool alive = true;
+    auto handler = [&done, &alive, weak, buffer, frame](boost::system::error_code, std::size_t) {
+        alive = alive && !weak.expired();
+        ++done;
+    };
+    streams.first->asyncRead(*buffer, handler);
+    streams.first->asyncWrite(*frame, handler);
+    streams.first->close();
+    streams.first.reset();
+
+    runUntil(ioc, [&done]() { return done == 2; }, std::chrono::seconds(5));
+    BOOST_CHECK_EQUAL(done, 2);
+    BOOST_CHECK(alive);
+    BOOST_CHECK(weak.expired());
+    streams.second->close();
+    ioc.run_for(std::chrono::milliseconds(100));
+}
+
+BOOST_AUTO_TEST_CASE(test_tcpFrameIdleTimeout)
+{
+    boost::asio::io_context ioc;
+
+    // both ends read, the keepalive frames keep the idle link open
+    auto streams = makeStreamPair(ioc);
+    streams.first->setIdleTimeout(300);
+    streams.second->setIdleTimeout(300);
+    auto received = std::make_shared<std::vector<bcos::bytes>>();
+    auto firstError = std::make_shared<boost::system::error_code>();
+    auto secondError = std::make_shared<boost::system::error_code>();
+    readFrames(streams.first, std::make_shared<boost::beast::flat_buffer>(), received, 1,
+        firstError);
+    readFrames(streams.second, std::make_shared<boost::beast::flat_buffer>(), received, 1,
+        secondError);
+    ioc.run_for(std::chrono::milliseconds(1000));
+    ioc.restart();
+    BOOST_CHECK(!*firstError);
+    BOOST_CHECK(!*secondError);
+    BOOST_CHECK(received->empty());
+    BOOST_CHECK(streams.first->open());
+    BOOST_CHECK(streams.second->open());
+
+    // a frame still goes through between the keepalives
+    auto frames = std::make_shared<std::vector<bcos::bytes>>();
+    frames->push_back(pattern(10, 1));
+    auto writeError = std::make_shared<boost::system::error_code>();
+    writeFrames(streams.first, frames, 0, writeError);
+    runUntil(ioc, [&]() { return !received->empty(); }, std::chrono::seconds(5));
+    BOOST_CHECK(!*writeError);
+    BOOST_REQUIRE_EQUAL(received->size(), 1u);
+    BOOST_CHECK(received->front() == frames->front());
+    streams.first->close();
+    streams.second->close();
+    ioc.run_for(std::chrono::seconds(1));
+    ioc.restart();
+
+    // the peer never reads nor sends a keepalive, the reader times out and closes the link
+    auto silent = makeStreamPair(ioc);
+    silent.second->setIdleTimeout(300);
+    auto silentError = std::make_shared<boost::system::error_code>();
+    readFrames(silent.second, std::make_shared<boost::beast::flat_buffer>(), received, 1,
+        silentError);
+    ioc.run_for(std::chrono::milliseconds(1000));
+    ioc.restart();
+    BOOST_CHECK(*silentError);
+    BOOST_CHECK(!silent.second->open());
+    silent.first->close();
+    ioc.run_for(std::chrono::seconds(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
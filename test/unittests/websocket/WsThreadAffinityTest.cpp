@@ -0,0 +1,240 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the pinning of the io threads and the thread pools
+ * @file WsThreadAffinityTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/WsConfig.h>
+#include <bcos-boostssl/websocket/WsInitializer.h>
+#include <bcos-boostssl/websocket/WsService.h>
+#include <bcos-boostssl/websocket/WsTools.h>
+#include <bcos-utilities/IOServicePool.h>
+#include <bcos-utilities/ThreadPool.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/test/unit_test.hpp>
+#include <future>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+BOOST_AUTO_TEST_SUITE(WsThreadAffinityTest)
+
+#ifdef __linux__
+namespace
+{
+// the cpus the process may run on, the container may not own cpu 0
+std::vector<uint32_t> allowedCpus(std::size_t _max)
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    std::vector<uint32_t> cpus;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    {
+        return cpus;
+    }
+    for (uint32_t cpu = 0; cpu < CPU_SETSIZE && cpus.size() < _max; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &allowed))
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+bool pinPermitted(uint32_t _cpu)
+{
+    bool pinned = false;
+    std::thread t([&pinned, _cpu]() { pinned = WsTools::setThreadAffinity({_cpu}); });
+    t.join();
+    return pinned;
+}
+
+std::set<uint32_t> threadCpus()
+{
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    pthread_getaffinity_np(pthread_self(), sizeof(mask), &mask);
+    std::set<uint32_t> cpus;
+    for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &mask))
+        {
+            cpus.insert(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::set<uint32_t> ioThreadCpus(std::shared_ptr<boost::asio::io_context> _ioc)
+{
+    auto promise = std::make_shared<std::promise<std::set<uint32_t>>>();
+    auto future = promise->get_future();
+    boost::asio::post(*_ioc, [promise]() { promise->set_value(threadCpus()); });
+    return future.get();
+}
+
+std::vector<std::set<uint32_t>> poolThreadCpus(
+    std::shared_ptr<ThreadPool> _threadPool, std::size_t _tasks)
+{
+    std::vector<std::future<std::set<uint32_t>>> futures;
+    for (std::size_t i = 0; i < _tasks; ++i)
+    {
+        auto promise = std::make_shared<std::promise<std::set<uint32_t>>>();
+        futures.push_back(promise->get_future());
+        _threadPool->enqueue([promise]() { promise->set_value(threadCpus()); });
+    }
+    std::vector<std::set<uint32_t>> result;
+    for (auto& future : futures)
+    {
+        result.push_back(future.get());
+    }
+    return result;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(test_ioThreadAffinity)
+{
+    auto cpus = allowedCpus(4);
+    BOOST_REQUIRE(!cpus.empty());
+    if (!pinPermitted(cpus.front()))
+    {
+        BOOST_TEST_MESSAGE("thread affinity is not permitted here, skipped");
+        return;
+    }
+
+    // more io threads than cpus, the cpus are taken round robin
+    auto config = std::make_shared<WsConfig>();
+    config->setIOThreadCpus(cpus);
+    auto initializer = std::make_shared<WsInitializer>();
+    initializer->setConfig(config);
+
+    std::size_t ioThreadNum = cpus.size() + 1;
+    auto ioServicePool = std::make_shared<IOServicePool>(ioThreadNum);
+    std::vector<std::shared_ptr<boost::asio::io_context>> ioServices;
+    for (std::size_t i = 0; i < ioThreadNum; ++i)
+    {
+        ioServices.push_back(ioServicePool->getIOService());
+    }
+    initializer->initIOThreadAffinity(ioServices);
+    ioServicePool->start();
+
+    for (std::size_t i = 0; i < ioThreadNum; ++i)
+    {
+        BOOST_CHECK(ioThreadCpus(ioServices[i]) == std::set<uint32_t>{cpus[i % cpus.size()]});
+    }
+    ioServicePool->stop();
+
+    // the cpus out of the cpu set are ignored, there is nothing left to pin to
+    BOOST_CHECK(!WsTools::setThreadAffinity({CPU_SETSIZE}));
+}
+
+BOOST_AUTO_TEST_CASE(test_threadPoolAffinity)
+{
+    auto cpus = allowedCpus(8);
+    BOOST_REQUIRE(!cpus.empty());
+    if (!pinPermitted(cpus.front()))
+    {
+        BOOST_TEST_MESSAGE("thread affinity is not permitted here, skipped");
+        return;
+    }
+
+    std::map<uint32_t, std::set<uint32_t>> node2Cpus;
+    for (auto cpu : cpus)
+    {
+        node2Cpus[WsTools::numaNodeOfCpu(cpu)].insert(cpu);
+    }
+
+    // an io thread on every worker cpu, so every numa node has an io thread mapped to it
+    auto config = std::make_shared<WsConfig>();
+    config->setIOThreadCpus(cpus);
+    config->setThreadPoolCpus(cpus);
+    auto initializer = std::make_shared<WsInitializer>();
+    initializer->setConfig(config);
+
+    auto ioServicePool = std::make_shared<IOServicePool>(cpus.size());
+    std::vector<std::shared_ptr<boost::asio::io_context>> ioServices;
+    for (std::size_t i = 0; i < cpus.size(); ++i)
+    {
+        ioServices.push_back(ioServicePool->getIOService());
+    }
+    auto wsService = std::make_shared<WsService>();
+    std::size_t threadPoolSize = 2 * cpus.size();
+    auto threadPool = initializer->initThreadPoolAffinity(wsService, ioServices, threadPoolSize);
+    BOOST_REQUIRE(threadPool);
+    wsService->setThreadPool(threadPool);
+
+    // the default thread pool is the one of the first numa node
+    std::map<uint32_t, std::shared_ptr<ThreadPool>> node2ThreadPool;
+    for (std::size_t i = 0; i < ioServices.size(); ++i)
+    {
+        auto node = WsTools::numaNodeOfCpu(cpus[i]);
+        auto ioThreadPool = wsService->affinityThreadPool(ioServices[i].get());
+        BOOST_REQUIRE(ioThreadPool);
+        auto it = node2ThreadPool.emplace(node, ioThreadPool).first;
+        // the io threads of a numa node share its thread pool
+        BOOST_CHECK(it->second == ioThreadPool);
+        if (node == node2Cpus.begin()->first)
+        {
+            BOOST_CHECK(ioThreadPool == threadPool);
+        }
+    }
+
+    // one thread pool per numa node, its workers are pinned to the cpus of that node
+    std::set<std::shared_ptr<ThreadPool>> threadPools;
+    for (auto& [node, nodeThreadPool] : node2ThreadPool)
+    {
+        threadPools.insert(nodeThreadPool);
+        auto& nodeCpus = node2Cpus[node];
+        auto threadNum = threadPoolSize * nodeCpus.size() / cpus.size();
+        for (auto& workerCpus : poolThreadCpus(nodeThreadPool, 2 * threadNum))
+        {
+            BOOST_CHECK(workerCpus == nodeCpus);
+        }
+    }
+    BOOST_CHECK_EQUAL(threadPools.size(), node2Cpus.size());
+
+    // the io_context out of the mapping falls back to the default thread pool
+    boost::asio::io_context ioc;
+    BOOST_CHECK(wsService->affinityThreadPool(&ioc) == threadPool);
+
+    for (auto& [node, nodeThreadPool] : node2ThreadPool)
+    {
+        nodeThreadPool->stop();
+    }
+}
+#else
+BOOST_AUTO_TEST_CASE(test_ioThreadAffinity)
+{
+    BOOST_TEST_MESSAGE("thread affinity is not supported on this platform, skipped");
+    BOOST_CHECK(!WsTools::setThreadAffinity({0}));
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,72 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the message lifecycle tracing
+ * @file WsTracerTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/WsTracer.h>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+BOOST_AUTO_TEST_SUITE(WsTracerTest)
+
+BOOST_AUTO_TEST_CASE(test_WsTracer)
+{
+    auto sink = std::make_shared<WsRingTraceSink>(3);
+    auto tracer = std::make_shared<WsTracer>(1, sink);
+    BOOST_CHECK(tracer->sampled("seq"));
+
+    auto trace = tracer->newTrace("seq", 1000, 64);
+    BOOST_CHECK(trace);
+    tracer->trace(nullptr, *trace, WsTraceEvent::SendStart, 1);
+    tracer->trace(nullptr, *trace, WsTraceEvent::Encoded, 2);
+    BOOST_CHECK_EQUAL(sink->records().size(), 2);
+
+    // the oldest records are overwritten
+    tracer->trace(nullptr, *trace, WsTraceEvent::Enqueued, 3);
+    tracer->trace(nullptr, *trace, WsTraceEvent::WriteStart, 4);
+    auto records = sink->records();
+    BOOST_CHECK_EQUAL(records.size(), 3);
+    BOOST_CHECK_EQUAL(records.front().timeNs, 2);
+    BOOST_CHECK_EQUAL(records.back().event, WsTraceEvent::WriteStart);
+    BOOST_CHECK_EQUAL(records.back().seq, "seq");
+    BOOST_CHECK_EQUAL(records.back().packetType, 1000);
+
+    std::ostringstream out;
+    tracer->dump(out);
+    BOOST_CHECK(out.str().find("4 WriteStart") != std::string::npos);
+
+    // the same seq is always sampled the same way
+    auto sampled = std::make_shared<WsTracer>(4, sink);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        auto seq = std::to_string(i);
+        BOOST_CHECK_EQUAL(sampled->sampled(seq), sampled->sampled(seq));
+        count += sampled->sampled(seq) ? 1 : 0;
+    }
+    BOOST_CHECK(count > 0 && count < 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the cleanup of the unix domain socket file
+ * @file WsUnixSocketTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/WsConfig.h>
+#include <bcos-boostssl/websocket/WsTools.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+BOOST_AUTO_TEST_SUITE(WsUnixSocketTest)
+
+BOOST_AUTO_TEST_CASE(test_removeStaleUnixSocket)
+{
+    std::string path = "/tmp/ws-unix-socket-test-" + std::to_string(::getpid()) + ".sock";
+    ::unlink(path.c_str());
+    struct stat st;
+
+    // nothing to remove
+    BOOST_CHECK(WsTools::removeStaleUnixSocket(path));
+
+    // a regular file is never removed
+    {
+        std::ofstream file(path);
+        file << "not a socket";
+    }
+    BOOST_CHECK(!WsTools::removeStaleUnixSocket(path));
+    BOOST_CHECK_EQUAL(::lstat(path.c_str(), &st), 0);
+    ::unlink(path.c_str());
+
+    boost::asio::io_context ioc;
+    boost::asio::local::stream_protocol::endpoint endpoint(path);
+    {
+        // the socket a server listens on is kept
+        boost::asio::local::stream_protocol::acceptor acceptor(ioc, endpoint);
+        BOOST_CHECK(!WsTools::removeStaleUnixSocket(path));
+        BOOST_CHECK_EQUAL(::lstat(path.c_str(), &st), 0);
+        BOOST_CHECK(S_ISSOCK(st.st_mode));
+    }
+
+    // the server exited without removing the file, the socket is stale
+    BOOST_CHECK_EQUAL(::lstat(path.c_str(), &st), 0);
+    BOOST_CHECK(WsTools::removeStaleUnixSocket(path));
+    BOOST_CHECK_NE(::lstat(path.c_str(), &st), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_unixSocketMode)
+{
+    auto config = std::make_shared<WsConfig>();
+    BOOST_CHECK_EQUAL(config->unixSocketMode(), 0u);
+    config->setUnixSocketMode(0660);
+    BOOST_CHECK_EQUAL(config->unixSocketMode(), 0660u);
+    // only the permission bits are kept
+    config->setUnixSocketMode(0104770);
+    BOOST_CHECK_EQUAL(config->unixSocketMode(), 0770u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,351 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for the tcp frame transport driven by io_uring
+ * @file WsUringFrameStreamTest.cpp
+ * @author: octopus
+ * @date 2026-10-16
+ */
+
+#include <bcos-boostssl/websocket/UringFrameStream.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::boostssl;
+using namespace bcos::boostssl::ws;
+
+namespace
+{
+// the two ends of a loopback tcp connection, each one driven by io_uring
+std::pair<UringFrameStream::Ptr, UringFrameStream::Ptr> makeStreamPair(
+    boost::asio::io_context& _ioc)
+{
+    boost::asio::ip::tcp::acceptor acceptor(
+        _ioc, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+    boost::asio::ip::tcp::socket client(_ioc);
+    client.connect(acceptor.local_endpoint());
+    boost::asio::ip::tcp::socket server(_ioc);
+    acceptor.accept(server);
+
+    auto clientStream = std::make_shared<UringFrameStream>(
+        std::make_shared<boost::beast::tcp_stream>(std::move(client)), "DEFAULT");
+    auto serverStream = std::make_shared<UringFrameStream>(
+        std::make_shared<boost::beast::tcp_stream>(std::move(server)), "DEFAULT");
+    return {clientStream, serverStream};
+}
+
+// the idle timer keeps the io_context busy, run it until _done holds instead of out of work
+void runUntil(
+    boost::asio::io_context& _ioc, std::function<bool()> _done, std::chrono::milliseconds _timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + _timeout;
+    while (!_done() && _ioc.run_one_until(deadline) > 0)
+    {
+    }
+    _ioc.restart();
+}
+
+bcos::bytes pattern(std::size_t _size, uint8_t _seed)
+{
+    bcos::bytes data(_size);
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+        data[i] = (uint8_t)(i * 31 + _seed);
+    }
+    return data;
+}
+
+// read _count frames one after another like the session does
+void readFrames(UringFrameStream::Ptr _stream, std::shared_ptr<boost::beast::flat_buffer> _buffer,
+    std::shared_ptr<std::vector<bcos::bytes>> _frames, std::size_t _count,
+    std::shared_ptr<boost::system::error_code> _error)
+{
+    _stream->asyncRead(
+        *_buffer, [_stream, _buffer, _frames, _count, _error](
+                      boost::system::error_code _ec, std::size_t _size) {
+            if (_ec)
+            {
+                *_error = _ec;
+                return;
+            }
+            auto data = reinterpret_cast<const uint8_t*>(_buffer->data().data());
+            _frames->emplace_back(data, data + _size);
+            _buffer->consume(_buffer->size());
+            if (_frames->size() < _count)
+            {
+                readFrames(_stream, _buffer, _frames, _count, _error);
+            }
+        });
+}
+
+// write the frames one after another, the buffers outlive the writes
+void writeFrames(UringFrameStream::Ptr _stream, std::shared_ptr<std::vector<bcos::bytes>> _frames,
+    std::size_t _index, std::shared_ptr<boost::system::error_code> _error)
+{
+    if (_index == _frames->size())
+    {
+        return;
+    }
+    _stream->asyncWrite((*_frames)[_index],
+        [_stream, _frames, _index, _error](boost::system::error_code _ec, std::size_t _size) {
+            if (_ec || _size != (*_frames)[_index].size())
+            {
+                *_error = _ec ? _ec : boost::asio::error::message_size;
+                return;
+            }
+            writeFrames(_stream, _frames, _index + 1, _error);
+        });
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(WsUringFrameStreamTest)
+
+BOOST_AUTO_TEST_CASE(test_uringFrames)
+{
+    if (!IoUringService::supported())
+    {
+        BOOST_TEST_MESSAGE("io_uring is not supported here, skipped");
+        return;
+    }
+
+    boost::asio::io_context ioc;
+    auto streams = makeStreamPair(ioc);
+
+    // small frames share one registered buffer, the large one is received into the frame directly
+    auto frames = std::make_shared<std::vector<bcos::bytes>>();
+    frames->push_back(pattern(5, 1));
+    frames->push_back(bcos::bytes());
+    frames->push_back(pattern(URING_FIXED_BUFFER_SIZE * 4 + 3, 2));
+    frames->push_back(pattern(100, 3));
+
+    auto received = std::make_shared<std::vector<bcos::bytes>>();
+    auto readError = std::make_shared<boost::system::error_code>();
+    auto writeError = std::make_shared<boost::system::error_code>();
+    // the read is waiting before anything is sent, it goes through the poll
+    readFrames(streams.second, std::make_shared<boost::beast::flat_buffer>(), received,
+        frames->size(), readError);
+    writeFrames(streams.first, frames, 0, writeError);
+
+    runUntil(
+        ioc, [&]() { return received->size() == frames->size() || *readError; },
+        std::chrono::seconds(10));
+    BOOST_CHECK(!*readError);
+    BOOST_CHECK(!*writeError);
+    BOOST_REQUIRE_EQUAL(received->size(), frames->size());
+    for (std::size_t i = 0; i < frames->size(); ++i)
+    {
+        BOOST_CHECK((*received)[i] == (*frames)[i]);
+    }
+    streams.first->close();
+    streams.second->close();
+}
+
+BOOST_AUTO_TEST_CASE(test_uringWriteWaitsForRoom)
+{
+    if (!IoUringService::supported())
+    {
+        BOOST_TEST_MESSAGE("io_uring is not supported here, skipped");
+        return;
+    }
+
+    boost::asio::io_context ioc;
+    auto streams = makeStreamPair(ioc);
+
+    // larger than the socket buffers, the send waits for the peer to read
+    auto frames = std::make_shared<std::vector<bcos::bytes>>();
+    frames->push_back(pattern(16 * 1024 * 1024, 4));
+    auto writeError = std::make_shared<boost::system::error_code>();
+    writeFrames(streams.first, frames, 0, writeError);
+    ioc.run_for(std::chrono::milliseconds(100));
+    ioc.restart();
+
+    auto received = std::make_shared<std::vector<bcos::bytes>>();
+    auto readError = std::make_shared<boost::system::error_code>();
+    readFrames(streams.second, std::make_shared<boost::beast::flat_buffer>(), received, 1,
+        readError);
+    runUntil(
+        ioc, [&]() { return !received->empty() || *readError; }, std::chrono::seconds(10));
+    BOOST_CHECK(!*readError);
+    BOOST_CHECK(!*writeError);
+    BOOST_REQUIRE_EQUAL(received->size(), 1u);
+    BOOST_CHECK(received->front() == frames->front());
+    streams.first->close();
+    streams.second->close();
+}
+
+BOOST_AUTO_TEST_CASE(test_uringCloseInflight)
+{
+    if (!IoUringService::supported())
+    {
+        BOOST_TEST_MESSAGE("io_uring is not supported here, skipped");
+        return;
+    }
+
+    boost::asio::io_context ioc;
+    auto streams = makeStreamPair(ioc);
+
+    // nothing is sent, the read stays in the ring until the stream is closed
+    auto received = std::make_shared<std::vector<bcos::bytes>>();
+    auto readError = std::make_shared<boost::system::error_code>();
+    readFrames(streams.second, std::make_shared<boost::beast::flat_buffer>(), received, 1,
+        readError);
+    ioc.run_for(std::chrono::milliseconds(50));
+    ioc.restart();
+    BOOST_CHECK(!*readError);
+    BOOST_CHECK(streams.second->tcpStream().socket().is_open());
+
+    // the fd is closed only after the read completes
+    streams.second->close();
+    BOOST_CHECK(!streams.second->open());
+    ioc.run_for(std::chrono::seconds(1));
+    ioc.restart();
+    BOOST_CHECK(*readError);
+    BOOST_CHECK(received->empty());
+    BOOST_CHECK(!streams.second->tcpStream().socket().is_open());
+
+    // the peer sees the connection closed
+    auto peerError = std::make_shared<boost::system::error_code>();
+    readFrames(streams.first, std::make_shared<boost::beast::flat_buffer>(), received, 1,
+        peerError);
+    runUntil(ioc, [&]() { return bool(*peerError); }, std::chrono::seconds(1));
+    BOOST_CHECK(*peerError);
+    BOOST_CHECK(received->empty());
+    streams.first->close();
+}
+
+BOOST_AUTO_TEST_CASE(test_uringIdleTimeout)
+{
+    if (!IoUringService::supported())
+    {
+        BOOST_TEST_MESSAGE("io_uring is not supported here, skipped");
+        return;
+    }
+
+    boost::asio::io_context ioc;
+
+    // both ends read, the keepalive frames keep the idle link open and a frame still goes through
+    auto streams = makeStreamPair(ioc);
+    streams.first->setIdleTimeout(300);
+    streams.second->setIdleTimeout(300);
+    auto received = std::make_shared<std::vector<bcos::bytes>>();
+    auto firstError = std::make_shared<boost::system::error_code>();
+    auto secondError = std::make_shared<boost::system::error_code>();
+    readFrames(streams.first, std::make_shared<boost::beast::flat_buffer>(), received, 1,
+        firstError);
+    readFrames(streams.second, std::make_shared<boost::beast::flat_buffer>(), received, 1,
+        secondError);
+    ioc.run_for(std::chrono::milliseconds(1000));
+    ioc.restart();
+    BOOST_CHECK(!*firstError);
+    BOOST_CHECK(!*secondError);
+    BOOST_CHECK(received->empty());
+    BOOST_CHECK(streams.first->open());
+    BOOST_CHECK(streams.second->open());
+
+    auto frames = std::make_shared<std::vector<bcos::bytes>>();
+    frames->push_back(pattern(10, 1));
+    auto writeError = std::make_shared<boost::system::error_code>();
+    writeFrames(streams.first, frames, 0, writeError);
+    runUntil(ioc, [&]() { return !received->empty(); }, std::chrono::seconds(5));
+    BOOST_CHECK(!*writeError);
+    BOOST_REQUIRE_EQUAL(received->size(), 1u);
+    BOOST_CHECK(received->front() == frames->front());
+    streams.first->close();
+    streams.second->close();
+    ioc.run_for(std::chrono::seconds(1));
+    ioc.restart();
+
+    // the peer never reads nor sends a keepalive, the reader times out and closes the link
+    auto silent = makeStreamPair(ioc);
+    silent.second->setIdleTimeout(300);
+    auto silentError = std::make_shared<boost::system::error_code>();
+    readFrames(silent.second, std::make_shared<boost::beast::flat_buffer>(), received, 1,
+        silentError);
+    runUntil(ioc, [&]() { return bool(*silentError); }, std::chrono::seconds(2));
+    BOOST_CHECK(*silentError);
+    BOOST_CHECK(!silent.second->open());
+    silent.first->close();
+    ioc.run_for(std::chrono::seconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(test_uringDeferredCompletions)
+{
+    if (!IoUringService::supported())
+    {
+        BOOST_TEST_MESSAGE("io_uring is not supported here, skipped");
+        return;
+    }
+
+    // more nops than the submission queue holds, the full queue is flushed inside submit and the
+    // nops reaped there complete later on the io thread, never inside submit
+    boost::asio::io_context ioc;
+    auto& service = boost::asio::use_service<IoUringService>(ioc);
+    BOOST_REQUIRE(service.ready());
+    std::size_t total = URING_ENTRIES + 16;
+    std::size_t completed = 0;
+    bool submitting = false;
+    bool reentered = false;
+    boost::asio::post(ioc, [&]() {
+        submitting = true;
+        for (std::size_t i = 0; i < total; ++i)
+        {
+            // a zeroed sqe is IORING_OP_NOP
+            service.submit([](io_uring_sqe&) {},
+                [&](int) {
+                    reentered = reentered || submitting;
+                    ++completed;
+                });
+        }
+        submitting = false;
+    });
+    runUntil(ioc, [&]() { return completed == total; }, std::chrono::seconds(5));
+    BOOST_CHECK(!reentered);
+    BOOST_CHECK_EQUAL(completed, total);
+}
+
+BOOST_AUTO_TEST_CASE(test_uringFixedBuffersAfterShutdown)
+{
+    if (!IoUringService::supported())
+    {
+        BOOST_TEST_MESSAGE("io_uring is not supported here, skipped");
+        return;
+    }
+
+    UringFixedBuffers::Ptr buffers;
+    int index = -1;
+    {
+        boost::asio::io_context ioc;
+        buffers = boost::asio::use_service<IoUringService>(ioc).fixedBuffers();
+        index = buffers->acquire();
+    }
+
+    // the service is gone with its io_context, the buffer of a late stream goes nowhere
+    if (index >= 0)
+    {
+        buffers->data(index)[0] = 1;
+        buffers->release(index);
+    }
+    BOOST_CHECK_EQUAL(buffers->acquire(), -1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()